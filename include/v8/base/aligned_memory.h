@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+namespace v8 { namespace base {
+
+/**
+ * \brief Allocates a block of memory with the specified alignment.
+ * \param size          Size of the block, in bytes.
+ * \param alignment     Alignment, must be a power of two.
+ * \return  Pointer to the block, or nullptr on failure. Release it with
+ *          aligned_free().
+ * \remarks The address of the block returned by malloc() is stored right
+ *          before the aligned block.
+ */
+inline
+void*
+aligned_malloc(
+    size_t size,
+    size_t alignment
+    )
+{
+    assert(alignment && !(alignment & (alignment - 1)));
+    if (alignment < sizeof(void*))
+        alignment = sizeof(void*);
+
+    void* raw_block = std::malloc(size + alignment + sizeof(void*));
+    if (!raw_block)
+        return nullptr;
+
+    const size_t aligned_addr = 
+        (reinterpret_cast<size_t>(raw_block) + sizeof(void*) + alignment - 1) 
+        & ~(alignment - 1);
+    void* aligned_block = reinterpret_cast<void*>(aligned_addr);
+    std::memcpy(static_cast<unsigned char*>(aligned_block) - sizeof(void*),
+                &raw_block, sizeof(void*));
+    return aligned_block;
+}
+
+/**
+ * \brief Releases a block of memory allocated with aligned_malloc().
+ *        Passing nullptr is allowed and does nothing.
+ */
+inline
+void
+aligned_free(
+    void* block
+    )
+{
+    if (!block)
+        return;
+
+    void* raw_block;
+    std::memcpy(&raw_block, 
+                static_cast<unsigned char*>(block) - sizeof(void*),
+                sizeof(void*));
+    std::free(raw_block);
+}
+
+} // namespace base
+} // namespace v8
@@ -36,6 +36,15 @@
 #error Unknown compiler system.
 #endif
 
+/**
+ * \brief V8_SIMD_ENABLED is defined when the SSE code paths of the library
+ *  can be used. Define V8_NO_SIMD before including any library header to
+ *  force the generic (scalar) code paths.
+ */
+#if defined(V8_SSE2_AVAILABLE) && !defined(V8_NO_SIMD)
+#define V8_SIMD_ENABLED
+#endif
+
 /**
  * \brief Small macro to disable implicit generation of
  * 	copy constructor and copy assign operator. Must be used
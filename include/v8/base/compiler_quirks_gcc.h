@@ -31,3 +31,14 @@
 #ifndef NOEXCEPT
 #define NOEXCEPT noexcept
 #endif
+
+//
+// Instruction set extensions the compiler is allowed to emit code for
+// (-msse2, -mavx, -march=...).
+#if !defined(V8_SSE2_AVAILABLE) && defined(__SSE2__)
+#define V8_SSE2_AVAILABLE
+#endif
+
+#if !defined(V8_AVX_AVAILABLE) && defined(__AVX__)
+#define V8_AVX_AVAILABLE
+#endif
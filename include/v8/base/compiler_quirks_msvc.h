@@ -33,3 +33,15 @@
 #ifndef NOEXCEPT
 #define NOEXCEPT
 #endif
+
+//
+// SSE2 is always present on x64 targets. For x86 targets it is available
+// when building with /arch:SSE2 or higher. /arch:AVX defines __AVX__.
+#if !defined(V8_SSE2_AVAILABLE) \
+    && (defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define V8_SSE2_AVAILABLE
+#endif
+
+#if !defined(V8_AVX_AVAILABLE) && defined(__AVX__)
+#define V8_AVX_AVAILABLE
+#endif
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+namespace v8 { namespace base {
+
+/**
+ * \brief   Instruction set extensions that can be detected at runtime.
+ */
+struct cpu_feature {
+    enum {
+        sse2 = 1 << 0,
+        sse3 = 1 << 1,
+        ssse3 = 1 << 2,
+        sse41 = 1 << 3,
+        sse42 = 1 << 4,
+        avx = 1 << 5,
+        avx2 = 1 << 6,
+        fma = 1 << 7,
+        avx512f = 1 << 8
+    };
+};
+
+/**
+ * \brief   Levels of SIMD support, in increasing order. Kernels are
+ *          selected based on the highest level available.
+ */
+enum simd_tier {
+    simd_tier_scalar,
+    simd_tier_sse2,
+    simd_tier_sse41,
+    simd_tier_avx,
+    /// AVX2 and FMA
+    simd_tier_avx2,
+    simd_tier_avx512,
+    simd_tier_count
+};
+
+/**
+ * \brief   Queries the processor (cpuid) and returns a combination of
+ *          cpu_feature flags. AVX and higher are reported only if the
+ *          operating system saves the extended registers (xgetbv).
+ *          The result is computed on the first call and then cached.
+ */
+unsigned int
+cpu_features();
+
+/**
+ * \brief   Returns the highest SIMD tier supported by the processor.
+ *          If the V8_SIMD_TIER environment variable is set to one of
+ *          "scalar", "sse2", "sse41", "avx", "avx2", "avx512", the result is
+ *          limited to that tier. This allows benchmarking every
+ *          implementation on the same machine. The value is computed on the
+ *          first call and then cached.
+ */
+simd_tier
+host_simd_tier();
+
+/**
+ * \brief   Returns the name of a tier, as accepted by V8_SIMD_TIER.
+ */
+const char*
+simd_tier_name(simd_tier tier);
+
+/**
+ * \brief   Converts a name to a tier.
+ * \return  True if the name is valid, false otherwise.
+ */
+bool
+simd_tier_from_name(const char* name, simd_tier* tier);
+
+} // namespace base
+} // namespace v8
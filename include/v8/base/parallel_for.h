@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include "v8/base/thread_pool.h"
+
+namespace v8 { namespace base {
+
+/**
+ * \brief Splits the [0, count) range into contiguous chunks and calls
+ *      fn(first, last) for each chunk. The chunks are processed in parallel,
+ *      on at most max_threads threads of thread_pool::shared() (the calling
+ *      thread included). The function returns after all the chunks have 
+ *      been processed.
+ * \param count         Number of elements in the range.
+ * \param grain_size    Minimum number of elements in a chunk. Chunk
+ *                      boundaries are always a multiple of this value, so
+ *                      that threads do not write to the same cache lines.
+ * \param max_threads   Maximum number of threads, 0 to use all the
+ *                      hardware threads.
+ * \param fn            Callable object, with the signature
+ *                      void (size_t first, size_t last).
+ */
+template<typename Fn>
+void
+parallel_for(
+    size_t count,
+    size_t grain_size,
+    unsigned int max_threads,
+    Fn fn
+    )
+{
+    if (!count)
+        return;
+
+    if (!grain_size)
+        grain_size = 1;
+
+    const size_t grain_count = (count + grain_size - 1) / grain_size;
+    size_t chunk_count = effective_thread_count(max_threads);
+    if (chunk_count > grain_count)
+        chunk_count = grain_count;
+
+    if (chunk_count <= 1) {
+        fn(size_t(0), count);
+        return;
+    }
+
+    const size_t grains_per_chunk = grain_count / chunk_count;
+    const size_t extra_grains = grain_count % chunk_count;
+
+    //
+    // One chunk per thread. If the pool gives fewer threads (it is busy),
+    // the threads of the region take the chunks in turn.
+    thread_pool::shared().run(static_cast<unsigned int>(chunk_count), 
+                              [&](parallel_region& region) {
+        for (size_t i = region.thread_index(); i < chunk_count; 
+             i += region.thread_count()) {
+            const size_t first = 
+                (i * grains_per_chunk + (i < extra_grains ? i : extra_grains)) 
+                * grain_size;
+            size_t last = 
+                first + (grains_per_chunk + (i < extra_grains ? 1 : 0)) * grain_size;
+            if (last > count)
+                last = count;
+
+            fn(first, last);
+        }
+    });
+}
+
+} // namespace base
+} // namespace v8
@@ -0,0 +1,184 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "v8/base/compiler_quirks.h"
+
+namespace v8 { namespace base {
+
+class thread_pool;
+
+/**
+ * \brief   Returns the number of threads to use for a job, given the maximum
+ *          number of threads requested by the caller. A value of 0 means
+ *          "as many threads as there are hardware threads".
+ */
+inline unsigned int effective_thread_count(unsigned int max_threads) {
+    const unsigned int hw_threads = std::thread::hardware_concurrency();
+    if (!max_threads)
+        return hw_threads ? hw_threads : 1;
+    return max_threads;
+}
+
+/**
+ * \class   parallel_region
+ *
+ * \brief   Passed to the function run by thread_pool::run(). Identifies the
+ *          calling thread among the threads of the region, and lets them
+ *          synchronize.
+ */
+class parallel_region {
+public :
+    /**
+     * \brief   Index of the thread in the region, in [0, thread_count()).
+     *          The thread that called thread_pool::run() has index 0.
+     */
+    unsigned int thread_index() const {
+        return thread_index_;
+    }
+
+    unsigned int thread_count() const {
+        return thread_count_;
+    }
+
+    /**
+     * \brief   Blocks until all the threads of the region have called
+     *          barrier(). Writes made before the barrier are visible to all
+     *          the threads after it.
+     */
+    void barrier();
+
+private :
+    friend class thread_pool;
+
+    parallel_region(
+        thread_pool* pool,
+        unsigned int thread_index,
+        unsigned int thread_count
+        )
+        : pool_(pool), thread_index_(thread_index),
+          thread_count_(thread_count) {}
+
+    thread_pool*    pool_;
+    unsigned int    thread_index_;
+    unsigned int    thread_count_;
+};
+
+/**
+ * \class   thread_pool
+ *
+ * \brief   A set of worker threads that are created once and then wait for
+ *          work, so starting a parallel job costs a wake up instead of a
+ *          thread creation and a join per thread.
+ *          A job is a function that is run once by each thread of a
+ *          parallel_region, the calling thread included. Only one job runs
+ *          at a time; a job submitted while the pool is busy (from another
+ *          thread, or from inside a job) runs on the calling thread alone,
+ *          with a region of one thread.
+ * \remarks Use shared() to get the pool used by base::parallel_for() and
+ *          by the math library, rather than creating more pools.
+ */
+class thread_pool {
+public :
+    /**
+     * \param   thread_count    Number of threads that can take part in a job,
+     *                          the calling thread included, 0 for one per
+     *                          hardware thread. thread_count - 1 workers
+     *                          are started.
+     */
+    explicit thread_pool(unsigned int thread_count = 0);
+
+    ~thread_pool();
+
+    /**
+     * \brief   The process wide pool, with one thread per hardware thread.
+     *          Created on first use.
+     */
+    static thread_pool& shared();
+
+    /**
+     * \brief   Maximum number of threads in a region, the calling thread
+     *          included.
+     */
+    unsigned int thread_count() const {
+        return static_cast<unsigned int>(workers_.size()) + 1;
+    }
+
+    /**
+     * \brief   Calls fn(region) on up to max_threads threads (0 for all the
+     *          threads of the pool), and returns after all of them are done.
+     * \param   fn  Callable object, with the signature
+     *              void (parallel_region& region).
+     */
+    template<typename Fn>
+    void run(unsigned int max_threads, Fn fn) {
+        dispatch(max_threads, &invoke<Fn>, &fn);
+    }
+
+private :
+    NO_CC_ASSIGN(thread_pool);
+
+    friend class parallel_region;
+
+    typedef void (*job_fn_t)(void*, parallel_region&);
+
+    template<typename Fn>
+    static void invoke(void* context, parallel_region& region) {
+        (*static_cast<Fn*>(context))(region);
+    }
+
+    void dispatch(unsigned int max_threads, job_fn_t job, void* context);
+
+    void worker_loop(unsigned int thread_index);
+
+    void region_barrier(unsigned int thread_count);
+
+    std::vector<std::thread>    workers_;
+    std::mutex                  lock_;
+    std::condition_variable     work_ready_;
+    std::condition_variable     work_done_;
+    job_fn_t                    job_;
+    void*                       job_context_;
+    unsigned int                job_threads_;
+    /// Workers that have not finished the current job.
+    unsigned int                pending_;
+    unsigned int                generation_;
+    bool                        stop_;
+    /// Set by the thread that submitted the running job, until it is done.
+    std::atomic<bool>           busy_;
+    std::atomic<unsigned int>   barrier_arrived_;
+    std::atomic<unsigned int>   barrier_generation_;
+};
+
+} // namespace base
+} // namespace v8
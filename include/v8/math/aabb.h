@@ -0,0 +1,274 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include "v8/math/matrix4X4.h"
+#include "v8/math/vector3.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \class   aabb
+ *
+ * \brief   Axis aligned bounding box, stored as the minimum and maximum
+ *          corners. A box with min_ > max_ on any axis is empty; the
+ *          default constructed box is left uninitialized, use 
+ *          aabb::empty() to start accumulating points.
+ */
+template<typename real_t>
+class aabb {
+public :
+    typedef real_t              element_type;
+    typedef vector3<real_t>     vector3_t;
+    typedef aabb<real_t>        aabb_t;
+
+    vector3_t   min_;
+    vector3_t   max_;
+
+    aabb() {}
+
+    aabb(const vector3_t& min_pt, const vector3_t& max_pt)
+        : min_(min_pt), max_(max_pt) {}
+
+    /**
+     * \brief   Returns a box that contains nothing. Adding a point to it
+     *          gives the box that contains only that point.
+     */
+    static aabb_t empty() {
+        const real_t big = std::numeric_limits<real_t>::max();
+        return aabb_t(vector3_t(big, big, big), vector3_t(-big, -big, -big));
+    }
+
+    /**
+     * \brief   Returns the bounding box of count points.
+     */
+    static aabb_t from_points(const vector3_t* points, size_t count) {
+        aabb_t box(empty());
+        for (size_t i = 0; i < count; ++i)
+            box.add_point(points[i]);
+        return box;
+    }
+
+    bool is_empty() const {
+        return min_.x_ > max_.x_ || min_.y_ > max_.y_ || min_.z_ > max_.z_;
+    }
+
+    vector3_t center() const {
+        return vector3_t((min_.x_ + max_.x_) / 2, (min_.y_ + max_.y_) / 2,
+                         (min_.z_ + max_.z_) / 2);
+    }
+
+    /**
+     * \brief   Returns the half size of the box, on each axis.
+     */
+    vector3_t extents() const {
+        return vector3_t((max_.x_ - min_.x_) / 2, (max_.y_ - min_.y_) / 2,
+                         (max_.z_ - min_.z_) / 2);
+    }
+
+    vector3_t size() const {
+        return vector3_t(max_.x_ - min_.x_, max_.y_ - min_.y_,
+                         max_.z_ - min_.z_);
+    }
+
+    /**
+     * \brief   Grows the box to contain pt.
+     */
+    aabb_t& add_point(const vector3_t& pt) {
+        min_.x_ = std::min(min_.x_, pt.x_);
+        min_.y_ = std::min(min_.y_, pt.y_);
+        min_.z_ = std::min(min_.z_, pt.z_);
+        max_.x_ = std::max(max_.x_, pt.x_);
+        max_.y_ = std::max(max_.y_, pt.y_);
+        max_.z_ = std::max(max_.z_, pt.z_);
+        return *this;
+    }
+
+    /**
+     * \brief   Grows the box to contain another box.
+     */
+    aabb_t& add_aabb(const aabb_t& other) {
+        min_.x_ = std::min(min_.x_, other.min_.x_);
+        min_.y_ = std::min(min_.y_, other.min_.y_);
+        min_.z_ = std::min(min_.z_, other.min_.z_);
+        max_.x_ = std::max(max_.x_, other.max_.x_);
+        max_.y_ = std::max(max_.y_, other.max_.y_);
+        max_.z_ = std::max(max_.z_, other.max_.z_);
+        return *this;
+    }
+};
+
+template<typename real_t>
+inline 
+bool 
+operator==(const aabb<real_t>& lhs, const aabb<real_t>& rhs) {
+    return lhs.min_ == rhs.min_ && lhs.max_ == rhs.max_;
+}
+
+template<typename real_t>
+inline 
+bool 
+operator!=(const aabb<real_t>& lhs, const aabb<real_t>& rhs) {
+    return !(lhs == rhs);
+}
+
+/**
+ * \brief   Returns the smallest box that contains both boxes.
+ */
+template<typename real_t>
+inline
+aabb<real_t>
+merge(
+    const aabb<real_t>& lhs,
+    const aabb<real_t>& rhs
+    )
+{
+    aabb<real_t> result(lhs);
+    return result.add_aabb(rhs);
+}
+
+/**
+ * \brief   Returns the box common to both boxes. If they do not overlap
+ *          the result is empty (see aabb::is_empty()).
+ */
+template<typename real_t>
+inline
+aabb<real_t>
+intersection(
+    const aabb<real_t>& lhs,
+    const aabb<real_t>& rhs
+    )
+{
+    return aabb<real_t>(
+        vector3<real_t>(std::max(lhs.min_.x_, rhs.min_.x_),
+                        std::max(lhs.min_.y_, rhs.min_.y_),
+                        std::max(lhs.min_.z_, rhs.min_.z_)),
+        vector3<real_t>(std::min(lhs.max_.x_, rhs.max_.x_),
+                        std::min(lhs.max_.y_, rhs.max_.y_),
+                        std::min(lhs.max_.z_, rhs.max_.z_)));
+}
+
+/**
+ * \brief   Tests if two boxes overlap. Boxes that only touch overlap.
+ */
+template<typename real_t>
+inline
+bool
+aabb_overlap(
+    const aabb<real_t>& lhs,
+    const aabb<real_t>& rhs
+    )
+{
+    return lhs.min_.x_ <= rhs.max_.x_ && rhs.min_.x_ <= lhs.max_.x_ &&
+           lhs.min_.y_ <= rhs.max_.y_ && rhs.min_.y_ <= lhs.max_.y_ &&
+           lhs.min_.z_ <= rhs.max_.z_ && rhs.min_.z_ <= lhs.max_.z_;
+}
+
+/**
+ * \brief   Tests if a point is inside a box (or on its boundary).
+ */
+template<typename real_t>
+inline
+bool
+point_in_aabb(
+    const vector3<real_t>& pt,
+    const aabb<real_t>& box
+    )
+{
+    return pt.x_ >= box.min_.x_ && pt.x_ <= box.max_.x_ &&
+           pt.y_ >= box.min_.y_ && pt.y_ <= box.max_.y_ &&
+           pt.z_ >= box.min_.z_ && pt.z_ <= box.max_.z_;
+}
+
+/**
+ * \brief   Tests if a sphere overlaps a box, using the squared distance
+ *          from the center to the box.
+ */
+template<typename real_t>
+inline
+bool
+aabb_sphere_overlap(
+    const aabb<real_t>& box,
+    const vector3<real_t>& center,
+    real_t radius
+    )
+{
+    real_t dist_sq = real_t(0);
+    for (size_t i = 0; i < 3; ++i) {
+        const real_t d = std::max(
+            std::max(box.min_.elements_[i] - center.elements_[i], 
+                     center.elements_[i] - box.max_.elements_[i]), 
+            real_t(0));
+        dist_sq += d * d;
+    }
+    return dist_sq <= radius * radius;
+}
+
+/**
+ * \brief   Returns the bounding box of a box transformed by an affine 
+ *          matrix (the last row of mtx is ignored), using Arvo's method :
+ *          for every row i of mtx, the new limits start at the translation
+ *          a(i,4) and for every column j they get min/max(a(i,j) * min(j),
+ *          a(i,j) * max(j)) added. This is exact for the 8 corners and
+ *          much cheaper than transforming them. The box cannot be empty.
+ */
+template<typename real_t>
+inline
+aabb<real_t>
+transform_aabb(
+    const matrix_4X4<real_t>& mtx,
+    const aabb<real_t>& box
+    )
+{
+    const real_t* bmin = box.min_.elements_;
+    const real_t* bmax = box.max_.elements_;
+    aabb<real_t> result;
+
+    for (size_t row = 0; row < 3; ++row) {
+        const real_t* a = mtx.elements_ + row * 4;
+        real_t new_min = a[3];
+        real_t new_max = a[3];
+        for (size_t col = 0; col < 3; ++col) {
+            const real_t e = a[col] * bmin[col];
+            const real_t f = a[col] * bmax[col];
+            new_min += std::min(e, f);
+            new_max += std::max(e, f);
+        }
+        result.min_.elements_[row] = new_min;
+        result.max_.elements_[row] = new_max;
+    }
+
+    return result;
+}
+
+typedef aabb<float>     aabbF;
+
+typedef aabb<double>    aabbD;
+
+} // namespace math
+} // namespace v8
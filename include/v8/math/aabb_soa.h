@@ -0,0 +1,272 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include "v8/base/compiler_quirks.h"
+#include "v8/base/parallel_for.h"
+#include "v8/math/aabb.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/vector3_soa.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \brief   Number of elements processed by a thread, when the aabb_soa
+ *          batch functions use more than one thread.
+ */
+const size_t kAabbBatchGrainSize = 4096;
+
+namespace internals {
+
+/**
+ * \brief   Scalar kernels for the aabb_soa batch functions. A set of boxes
+ *          is passed as an array of 6 component pointers (min x, y, z,
+ *          max x, y, z) and the kernels process the elements in 
+ *          [first, last). Boolean results are written as 0/1 bytes.
+ */
+template<typename real_t>
+struct aabb_soa_scalar_kernels {
+    static void transform(
+        const matrix_4X4<real_t>& mtx, const real_t* const* in,
+        real_t* const* out, size_t first, size_t last
+        );
+
+    static void contains_points(
+        const aabb<real_t>& box, 
+        const real_t* x, const real_t* y, const real_t* z,
+        uint8_t* result, size_t first, size_t last
+        );
+
+    static void overlap(
+        const aabb<real_t>& box, const real_t* const* boxes,
+        uint8_t* result, size_t first, size_t last
+        );
+
+    static void sphere_overlap(
+        const vector3<real_t>& center, real_t radius,
+        const real_t* const* boxes, uint8_t* result, size_t first, size_t last
+        );
+};
+
+/**
+ * \brief   Kernels used by aabb_soa. The float version is specialized in
+ *          aabb_soa_sse.inl.
+ */
+template<typename real_t>
+struct aabb_soa_kernels : public aabb_soa_scalar_kernels<real_t> {};
+
+} // namespace internals
+
+/**
+ * \class   aabb_soa
+ *
+ * \brief   An array of axis aligned boxes, stored as two vector3_soa 
+ *          streams for the minimum and the maximum corners. Use it for
+ *          large sets of bounds that get the same operation (transform,
+ *          point or overlap test) applied to all of them.
+ * \remarks For real_t = float, when V8_SIMD_ENABLED is defined the batch
+ *          functions use SSE and process 4 boxes at a time.
+ */
+template<typename real_t>
+class aabb_soa {
+public :
+    typedef real_t                  element_type;
+    typedef aabb<real_t>            aabb_t;
+    typedef vector3_soa<real_t>     vector3_soa_t;
+    typedef aabb_soa<real_t>        aabb_soa_t;
+
+    aabb_soa() {}
+
+    /**
+     * \brief   Constructs count boxes, all degenerated to the point (0, 0, 0).
+     */
+    explicit aabb_soa(size_t count) : mins_(count), maxs_(count) {}
+
+    /**
+     * \brief   Constructs a copy of count aabb objects.
+     */
+    aabb_soa(const aabb_t* src, size_t count) {
+        assign(src, count);
+    }
+
+    void swap(aabb_soa_t& other) {
+        mins_.swap(other.mins_);
+        maxs_.swap(other.maxs_);
+    }
+
+    size_t size() const {
+        return mins_.size();
+    }
+
+    bool empty() const {
+        return mins_.empty();
+    }
+
+    /**
+     * \brief   Changes the number of boxes. Existing boxes are kept, new
+     *          ones are degenerated to the point (0, 0, 0).
+     */
+    void resize(size_t count) {
+        mins_.resize(count);
+        maxs_.resize(count);
+    }
+
+    void reserve(size_t count) {
+        mins_.reserve(count);
+        maxs_.reserve(count);
+    }
+
+    void clear() {
+        mins_.clear();
+        maxs_.clear();
+    }
+
+    /**
+     * \brief   The minimum corners of the boxes.
+     */
+    vector3_soa_t& mins() {
+        return mins_;
+    }
+
+    const vector3_soa_t& mins() const {
+        return mins_;
+    }
+
+    /**
+     * \brief   The maximum corners of the boxes.
+     */
+    vector3_soa_t& maxs() {
+        return maxs_;
+    }
+
+    const vector3_soa_t& maxs() const {
+        return maxs_;
+    }
+
+    aabb_t get(size_t index) const {
+        return aabb_t(mins_.get(index), maxs_.get(index));
+    }
+
+    void set(size_t index, const aabb_t& box) {
+        mins_.set(index, box.min_);
+        maxs_.set(index, box.max_);
+    }
+
+    /**
+     * \brief   Replaces the contents with a copy of count aabb objects.
+     */
+    void assign(const aabb_t* src, size_t count);
+
+    /**
+     * \brief   Copies the boxes to an array of size() aabb objects.
+     */
+    void copy_to(aabb_t* dst) const;
+
+private :
+    vector3_soa_t   mins_;
+    vector3_soa_t   maxs_;
+};
+
+/**
+ * \brief   Returns the box that contains all the boxes. boxes cannot be
+ *          empty.
+ */
+template<typename real_t>
+aabb<real_t>
+merge(
+    const math::aabb_soa<real_t>& boxes
+    );
+
+/**
+ * \brief   out[i] = transform_aabb(mtx, in[i]) (Arvo's method). out is 
+ *          resized to match and can be the same as in.
+ * \param   max_threads     Maximum number of threads to use, 0 for all the
+ *                          hardware threads (see base::parallel_for).
+ */
+template<typename real_t>
+void
+transform_aabbs(
+    const math::matrix_4X4<real_t>& mtx,
+    const math::aabb_soa<real_t>& in,
+    math::aabb_soa<real_t>* out,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   result[i] = point_in_aabb(points[i], box). result must have
+ *          room for points.size() elements.
+ */
+template<typename real_t>
+void
+points_in_aabb(
+    const math::vector3_soa<real_t>& points,
+    const math::aabb<real_t>& box,
+    uint8_t* result,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   result[i] = aabb_overlap(box, boxes[i]). result must have room
+ *          for boxes.size() elements.
+ */
+template<typename real_t>
+void
+aabb_overlap(
+    const math::aabb<real_t>& box,
+    const math::aabb_soa<real_t>& boxes,
+    uint8_t* result,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   result[i] = aabb_sphere_overlap(boxes[i], center, radius). 
+ *          result must have room for boxes.size() elements.
+ */
+template<typename real_t>
+void
+aabb_sphere_overlap(
+    const math::aabb_soa<real_t>& boxes,
+    const math::vector3<real_t>& center,
+    real_t radius,
+    uint8_t* result,
+    unsigned int max_threads = 1
+    );
+
+typedef aabb_soa<float>     aabb_soaF;
+
+typedef aabb_soa<double>    aabb_soaD;
+
+} // namespace math
+} // namespace v8
+
+#include "aabb_soa.inl"
+
+#if defined(V8_SIMD_ENABLED)
+#include "aabb_soa_sse.inl"
+#endif
@@ -0,0 +1,202 @@
+template<typename real_t>
+void
+v8::math::internals::aabb_soa_scalar_kernels<real_t>::transform(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    const real_t* const* in,
+    real_t* const* out,
+    size_t first,
+    size_t last
+    )
+{
+    for (size_t i = first; i < last; ++i) {
+        const aabb<real_t> result = transform_aabb(mtx, aabb<real_t>(
+            vector3<real_t>(in[0][i], in[1][i], in[2][i]),
+            vector3<real_t>(in[3][i], in[4][i], in[5][i])));
+
+        out[0][i] = result.min_.x_;
+        out[1][i] = result.min_.y_;
+        out[2][i] = result.min_.z_;
+        out[3][i] = result.max_.x_;
+        out[4][i] = result.max_.y_;
+        out[5][i] = result.max_.z_;
+    }
+}
+
+template<typename real_t>
+void
+v8::math::internals::aabb_soa_scalar_kernels<real_t>::contains_points(
+    const v8::math::aabb<real_t>& box,
+    const real_t* x,
+    const real_t* y,
+    const real_t* z,
+    uint8_t* result,
+    size_t first,
+    size_t last
+    )
+{
+    for (size_t i = first; i < last; ++i)
+        result[i] = point_in_aabb(vector3<real_t>(x[i], y[i], z[i]), box);
+}
+
+template<typename real_t>
+void
+v8::math::internals::aabb_soa_scalar_kernels<real_t>::overlap(
+    const v8::math::aabb<real_t>& box,
+    const real_t* const* boxes,
+    uint8_t* result,
+    size_t first,
+    size_t last
+    )
+{
+    for (size_t i = first; i < last; ++i)
+        result[i] = aabb_overlap(box, aabb<real_t>(
+            vector3<real_t>(boxes[0][i], boxes[1][i], boxes[2][i]),
+            vector3<real_t>(boxes[3][i], boxes[4][i], boxes[5][i])));
+}
+
+template<typename real_t>
+void
+v8::math::internals::aabb_soa_scalar_kernels<real_t>::sphere_overlap(
+    const v8::math::vector3<real_t>& center,
+    real_t radius,
+    const real_t* const* boxes,
+    uint8_t* result,
+    size_t first,
+    size_t last
+    )
+{
+    for (size_t i = first; i < last; ++i)
+        result[i] = aabb_sphere_overlap(aabb<real_t>(
+            vector3<real_t>(boxes[0][i], boxes[1][i], boxes[2][i]),
+            vector3<real_t>(boxes[3][i], boxes[4][i], boxes[5][i])), 
+            center, radius);
+}
+
+template<typename real_t>
+void
+v8::math::aabb_soa<real_t>::assign(
+    const aabb_t* src,
+    size_t count
+    )
+{
+    resize(count);
+    for (size_t i = 0; i < count; ++i)
+        set(i, src[i]);
+}
+
+template<typename real_t>
+void
+v8::math::aabb_soa<real_t>::copy_to(
+    aabb_t* dst
+    ) const
+{
+    for (size_t i = 0; i < size(); ++i)
+        dst[i] = get(i);
+}
+
+template<typename real_t>
+v8::math::aabb<real_t>
+v8::math::merge(
+    const v8::math::aabb_soa<real_t>& boxes
+    )
+{
+    assert(!boxes.empty());
+
+    //
+    // min_max() computes both limits, only the min of the minimum corners
+    // and the max of the maximum corners are used.
+    aabb<real_t> result;
+    vector3<real_t> unused;
+    min_max(boxes.mins(), &result.min_, &unused);
+    min_max(boxes.maxs(), &unused, &result.max_);
+    return result;
+}
+
+template<typename real_t>
+void
+v8::math::transform_aabbs(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    const v8::math::aabb_soa<real_t>& in,
+    v8::math::aabb_soa<real_t>* out,
+    unsigned int max_threads
+    )
+{
+    out->resize(in.size());
+
+    const real_t* src[6] = { 
+        in.mins().x(), in.mins().y(), in.mins().z(),
+        in.maxs().x(), in.maxs().y(), in.maxs().z()
+    };
+    real_t* dst[6] = {
+        out->mins().x(), out->mins().y(), out->mins().z(),
+        out->maxs().x(), out->maxs().y(), out->maxs().z()
+    };
+
+    base::parallel_for(in.size(), kAabbBatchGrainSize, max_threads,
+                       [&mtx, &src, &dst](size_t first, size_t last) {
+        internals::aabb_soa_kernels<real_t>::transform(
+            mtx, src, dst, first, last);
+    });
+}
+
+template<typename real_t>
+void
+v8::math::points_in_aabb(
+    const v8::math::vector3_soa<real_t>& points,
+    const v8::math::aabb<real_t>& box,
+    uint8_t* result,
+    unsigned int max_threads
+    )
+{
+    const real_t* x = points.x();
+    const real_t* y = points.y();
+    const real_t* z = points.z();
+    base::parallel_for(points.size(), kAabbBatchGrainSize, max_threads,
+                       [&box, x, y, z, result](size_t first, size_t last) {
+        internals::aabb_soa_kernels<real_t>::contains_points(
+            box, x, y, z, result, first, last);
+    });
+}
+
+template<typename real_t>
+void
+v8::math::aabb_overlap(
+    const v8::math::aabb<real_t>& box,
+    const v8::math::aabb_soa<real_t>& boxes,
+    uint8_t* result,
+    unsigned int max_threads
+    )
+{
+    const real_t* src[6] = { 
+        boxes.mins().x(), boxes.mins().y(), boxes.mins().z(),
+        boxes.maxs().x(), boxes.maxs().y(), boxes.maxs().z()
+    };
+
+    base::parallel_for(boxes.size(), kAabbBatchGrainSize, max_threads,
+                       [&box, &src, result](size_t first, size_t last) {
+        internals::aabb_soa_kernels<real_t>::overlap(
+            box, src, result, first, last);
+    });
+}
+
+template<typename real_t>
+void
+v8::math::aabb_sphere_overlap(
+    const v8::math::aabb_soa<real_t>& boxes,
+    const v8::math::vector3<real_t>& center,
+    real_t radius,
+    uint8_t* result,
+    unsigned int max_threads
+    )
+{
+    const real_t* src[6] = { 
+        boxes.mins().x(), boxes.mins().y(), boxes.mins().z(),
+        boxes.maxs().x(), boxes.maxs().y(), boxes.maxs().z()
+    };
+
+    base::parallel_for(boxes.size(), kAabbBatchGrainSize, max_threads,
+                       [&center, radius, &src, result](size_t first, size_t last) {
+        internals::aabb_soa_kernels<real_t>::sphere_overlap(
+            center, radius, src, result, first, last);
+    });
+}
@@ -0,0 +1,157 @@
+#include <xmmintrin.h>
+
+namespace v8 { namespace math { namespace internals {
+
+/**
+ * \brief   SSE kernels for aabb_soa<float>. Each iteration processes 4 
+ *          boxes (or points), the remaining elements are handled by the 
+ *          scalar kernels. The transform uses the same operation order as
+ *          transform_aabb(), so the results are identical.
+ */
+template<>
+struct aabb_soa_kernels<float> {
+    typedef aabb_soa_scalar_kernels<float> scalar_kernels_t;
+
+    static void transform(
+        const matrix_4X4<float>& mtx, const float* const* in,
+        float* const* out, size_t first, size_t last
+        )
+    {
+        __m128 m[12];
+        for (size_t row = 0; row < 3; ++row)
+            for (size_t col = 0; col < 4; ++col)
+                m[row * 4 + col] = _mm_set1_ps(mtx.elements_[row * 4 + col]);
+
+        const size_t simd_last = first + ((last - first) & ~size_t(3));
+        for (size_t i = first; i < simd_last; i += 4) {
+            const __m128 bmin[3] = {
+                _mm_loadu_ps(in[0] + i), _mm_loadu_ps(in[1] + i),
+                _mm_loadu_ps(in[2] + i)
+            };
+            const __m128 bmax[3] = {
+                _mm_loadu_ps(in[3] + i), _mm_loadu_ps(in[4] + i),
+                _mm_loadu_ps(in[5] + i)
+            };
+
+            __m128 new_min[3];
+            __m128 new_max[3];
+            for (size_t row = 0; row < 3; ++row) {
+                const __m128* a = m + row * 4;
+                new_min[row] = a[3];
+                new_max[row] = a[3];
+                for (size_t col = 0; col < 3; ++col) {
+                    const __m128 e = _mm_mul_ps(a[col], bmin[col]);
+                    const __m128 f = _mm_mul_ps(a[col], bmax[col]);
+                    new_min[row] = _mm_add_ps(new_min[row], _mm_min_ps(e, f));
+                    new_max[row] = _mm_add_ps(new_max[row], _mm_max_ps(e, f));
+                }
+            }
+
+            for (size_t row = 0; row < 3; ++row) {
+                _mm_storeu_ps(out[row] + i, new_min[row]);
+                _mm_storeu_ps(out[row + 3] + i, new_max[row]);
+            }
+        }
+
+        scalar_kernels_t::transform(mtx, in, out, simd_last, last);
+    }
+
+    static void contains_points(
+        const aabb<float>& box, 
+        const float* x, const float* y, const float* z,
+        uint8_t* result, size_t first, size_t last
+        )
+    {
+        const __m128 min_x = _mm_set1_ps(box.min_.x_);
+        const __m128 min_y = _mm_set1_ps(box.min_.y_);
+        const __m128 min_z = _mm_set1_ps(box.min_.z_);
+        const __m128 max_x = _mm_set1_ps(box.max_.x_);
+        const __m128 max_y = _mm_set1_ps(box.max_.y_);
+        const __m128 max_z = _mm_set1_ps(box.max_.z_);
+
+        const size_t simd_last = first + ((last - first) & ~size_t(3));
+        for (size_t i = first; i < simd_last; i += 4) {
+            const __m128 px = _mm_loadu_ps(x + i);
+            const __m128 py = _mm_loadu_ps(y + i);
+            const __m128 pz = _mm_loadu_ps(z + i);
+            const __m128 inside = _mm_and_ps(
+                _mm_and_ps(
+                    _mm_and_ps(_mm_cmpge_ps(px, min_x), _mm_cmple_ps(px, max_x)),
+                    _mm_and_ps(_mm_cmpge_ps(py, min_y), _mm_cmple_ps(py, max_y))),
+                _mm_and_ps(_mm_cmpge_ps(pz, min_z), _mm_cmple_ps(pz, max_z)));
+
+            const int bits = _mm_movemask_ps(inside);
+            for (size_t j = 0; j < 4; ++j)
+                result[i + j] = static_cast<uint8_t>((bits >> j) & 1);
+        }
+
+        scalar_kernels_t::contains_points(box, x, y, z, result, simd_last, last);
+    }
+
+    static void overlap(
+        const aabb<float>& box, const float* const* boxes,
+        uint8_t* result, size_t first, size_t last
+        )
+    {
+        const __m128 min_x = _mm_set1_ps(box.min_.x_);
+        const __m128 min_y = _mm_set1_ps(box.min_.y_);
+        const __m128 min_z = _mm_set1_ps(box.min_.z_);
+        const __m128 max_x = _mm_set1_ps(box.max_.x_);
+        const __m128 max_y = _mm_set1_ps(box.max_.y_);
+        const __m128 max_z = _mm_set1_ps(box.max_.z_);
+
+        const size_t simd_last = first + ((last - first) & ~size_t(3));
+        for (size_t i = first; i < simd_last; i += 4) {
+            const __m128 overlaps = _mm_and_ps(
+                _mm_and_ps(
+                    _mm_and_ps(_mm_cmple_ps(min_x, _mm_loadu_ps(boxes[3] + i)),
+                               _mm_cmple_ps(_mm_loadu_ps(boxes[0] + i), max_x)),
+                    _mm_and_ps(_mm_cmple_ps(min_y, _mm_loadu_ps(boxes[4] + i)),
+                               _mm_cmple_ps(_mm_loadu_ps(boxes[1] + i), max_y))),
+                _mm_and_ps(_mm_cmple_ps(min_z, _mm_loadu_ps(boxes[5] + i)),
+                           _mm_cmple_ps(_mm_loadu_ps(boxes[2] + i), max_z)));
+
+            const int bits = _mm_movemask_ps(overlaps);
+            for (size_t j = 0; j < 4; ++j)
+                result[i + j] = static_cast<uint8_t>((bits >> j) & 1);
+        }
+
+        scalar_kernels_t::overlap(box, boxes, result, simd_last, last);
+    }
+
+    static void sphere_overlap(
+        const vector3<float>& center, float radius,
+        const float* const* boxes, uint8_t* result, size_t first, size_t last
+        )
+    {
+        const __m128 c[3] = {
+            _mm_set1_ps(center.x_), _mm_set1_ps(center.y_), 
+            _mm_set1_ps(center.z_)
+        };
+        const __m128 radius_sq = _mm_set1_ps(radius * radius);
+        const __m128 zero = _mm_setzero_ps();
+
+        const size_t simd_last = first + ((last - first) & ~size_t(3));
+        for (size_t i = first; i < simd_last; i += 4) {
+            __m128 dist_sq = zero;
+            for (size_t axis = 0; axis < 3; ++axis) {
+                const __m128 d = _mm_max_ps(
+                    _mm_max_ps(_mm_sub_ps(_mm_loadu_ps(boxes[axis] + i), c[axis]),
+                               _mm_sub_ps(c[axis], _mm_loadu_ps(boxes[axis + 3] + i))),
+                    zero);
+                dist_sq = _mm_add_ps(dist_sq, _mm_mul_ps(d, d));
+            }
+
+            const int bits = _mm_movemask_ps(_mm_cmple_ps(dist_sq, radius_sq));
+            for (size_t j = 0; j < 4; ++j)
+                result[i + j] = static_cast<uint8_t>((bits >> j) & 1);
+        }
+
+        scalar_kernels_t::sphere_overlap(
+            center, radius, boxes, result, simd_last, last);
+    }
+};
+
+} // namespace internals
+} // namespace math
+} // namespace v8
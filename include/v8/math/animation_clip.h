@@ -0,0 +1,210 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "v8/base/compiler_quirks.h"
+#include "v8/math/quaternion.h"
+#include "v8/math/quaternion_soa.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \brief   Number of samplers in a chunk, when sample_animations() is 
+ *          split across threads.
+ */
+const size_t kAnimationSamplingGrainSize = 16;
+
+class animation_sampler;
+
+/**
+ * \class   animation_clip
+ *
+ * \brief   Compressed skeletal animation. Every track (bone) has a rotation
+ *          and a translation, built from poses sampled at a fixed rate.
+ *          - Key reduction : a track only keeps the frames that cannot be
+ *            rebuilt, within the tolerances, by interpolating between the 
+ *            kept neighbours (the first and last frames are always kept).
+ *          - Rotations : smallest three, the largest component is dropped
+ *            (made positive and recomputed from the others), the other
+ *            three are quantized to 16 bits in [-1/sqrt(2), 1/sqrt(2)].
+ *          - Translations : range reduced, each component is quantized to
+ *            16 bits between the minimum and maximum of its track.
+ *          A key takes 18 bytes (frame number, 4 uint16 for the rotation, 
+ *          4 uint16 for the translation), against 28 for a raw quaternionF
+ *          and vector3F.
+ *          Use animation_sampler to evaluate the clip.
+ */
+class animation_clip {
+public :
+    animation_clip();
+
+    /**
+     * \brief   Compresses a clip. 
+     * \param   rotations       Unit rotations, rotations[frame * track_count 
+     *                          + track].
+     * \param   translations    Translations, same layout.
+     * \param   track_count     Number of tracks.
+     * \param   frame_count     Number of frames, at most 65536.
+     * \param   sample_rate     Frames per second.
+     * \param   rotation_tolerance      Maximum rotation error introduced by
+     *                                  key reduction, in radians.
+     * \param   translation_tolerance   Maximum translation error introduced
+     *                                  by key reduction.
+     * \remarks Key reduction costs O(frame_count * track_count), with at
+     *          most 256 error evaluations per frame and track (kept keys
+     *          are at most 256 frames apart). Samplers attached to the clip
+     *          must be attached again with set_clip() afterwards.
+     */
+    void build(
+        const quaternionF* rotations,
+        const vector3F* translations,
+        size_t track_count,
+        size_t frame_count,
+        float sample_rate,
+        float rotation_tolerance = 1.0e-3f,
+        float translation_tolerance = 1.0e-3f
+        );
+
+    size_t track_count() const {
+        return track_first_key_.size() - 1;
+    }
+
+    size_t frame_count() const {
+        return frame_count_;
+    }
+
+    float sample_rate() const {
+        return sample_rate_;
+    }
+
+    /**
+     * \brief   Time of the last frame, in seconds.
+     */
+    float duration() const {
+        return frame_count_ ? (frame_count_ - 1) / sample_rate_ : 0.0f;
+    }
+
+    size_t key_count(size_t track) const {
+        assert(track < track_count());
+        return track_first_key_[track + 1] - track_first_key_[track];
+    }
+
+    size_t total_key_count() const {
+        return key_frames_.size();
+    }
+
+    /**
+     * \brief   Memory used by the compressed data.
+     */
+    size_t size_in_bytes() const;
+
+private :
+    friend class animation_sampler;
+
+    size_t                  frame_count_;
+    float                   sample_rate_;
+    std::vector<uint32_t>   track_first_key_;
+    std::vector<uint16_t>   key_frames_;
+    std::vector<uint16_t>   rotation_keys_;
+    std::vector<uint16_t>   translation_keys_;
+    vector3_soaF            translation_min_;
+    vector3_soaF            translation_scale_;
+
+private :
+    NO_CC_ASSIGN(animation_clip);
+};
+
+/**
+ * \class   animation_sampler
+ *
+ * \brief   Evaluates all the tracks of a clip at a given time, with one 
+ *          pass over the tracks that decodes the two keys around the time 
+ *          and interpolates them (nlerp for the rotations). The results are
+ *          SoA streams, ready for make_transform_palette_3X4() or the 
+ *          level_hierarchy streams. 
+ *          Every animated character needs its own sampler; it remembers the
+ *          current key of each track, so playing forward does not search 
+ *          the keys. The cursors are sized when the clip is attached, so
+ *          after the clip is built again the sampler must be re-attached 
+ *          with set_clip().
+ * \remarks When V8_SIMD_ENABLED is defined, 4 tracks are decoded and 
+ *          interpolated at a time with SSE.
+ */
+class animation_sampler {
+public :
+    animation_sampler() : clip_(nullptr) {}
+
+    explicit animation_sampler(const animation_clip* clip) : clip_(nullptr) {
+        set_clip(clip);
+    }
+
+    void set_clip(const animation_clip* clip);
+
+    const animation_clip* clip() const {
+        return clip_;
+    }
+
+    /**
+     * \brief   Evaluates the clip at time seconds, clamped to 
+     *          [0, clip()->duration()].
+     */
+    void sample(float time);
+
+    const quaternion_soaF& rotations() const {
+        return rotations_;
+    }
+
+    const vector3_soaF& translations() const {
+        return translations_;
+    }
+
+private :
+    const animation_clip*   clip_;
+    std::vector<uint32_t>   cursors_;
+    quaternion_soaF         rotations_;
+    vector3_soaF            translations_;
+};
+
+/**
+ * \brief   Calls samplers[i].sample(times[i]) for count samplers, on at 
+ *          most max_threads threads (0 to use all the hardware threads).
+ */
+void sample_animations(
+    animation_sampler* samplers,
+    const float* times,
+    size_t count,
+    unsigned int max_threads = 1
+    );
+
+} // namespace math
+} // namespace v8
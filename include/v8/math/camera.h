@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include "v8/math/frustum.h"
 #include "v8/math/vector3.h"
 #include "v8/math/vector4.h"
 #include "v8/math/matrix4X4.h"
@@ -39,6 +40,12 @@ namespace v8 { namespace math {
  * 			The vectors for the camera's frame are always expressed in world 
  * 			space coordinates. The camera uses a left handed coordinate
  * 			system.
+ * \remarks The setters do not rebuild the matrices, they only mark them
+ *          as out of date. Each matrix is rebuilt the first time it is
+ *          read after a change, so a controller can call several setters
+ *          per frame and pay for the rebuild once. Because of this, the
+ *          getters of a camera that was just modified must not be called
+ *          from several threads at the same time.
  */
 class camera {
 public :
@@ -74,13 +81,53 @@ private :
     vector3F            view_side_;	///< The side direction vector (x axis) */
     vector3F            view_up_;  ///< The up direction vector (y axis) */
     vector3F            view_dir_; ///< The look direction vector (z axis) */
-    matrix_4X4F         view_matrix_;   /*!< Stores the view space transform */
-    matrix_4X4F         projection_matrix_; /*!< Stores the projection matrix */
+    mutable matrix_4X4F view_matrix_;   /*!< Stores the view space transform */
+    mutable matrix_4X4F projection_matrix_; /*!< Stores the projection matrix */
     /*!
      *\brief Stores the product of the projection and view matrices.
      */
-    matrix_4X4F         projection_view_matrix_;
+    mutable matrix_4X4F projection_view_matrix_;
+    mutable matrix_4X4F inverse_view_matrix_; /*!< Inverse of view_matrix_ */
+    /*!
+     *\brief Inverse of the projection * view matrix.
+     */
+    mutable matrix_4X4F inverse_projection_view_matrix_;
     int                 projection_type_;   /*!< Type of the projection (orhthographic/perspective) */
+    /*!
+     *\brief Matrices that must be rebuilt before their next use 
+     *       (Dirty_Flag_t values).
+     */
+    mutable unsigned int    dirty_flags_;
+    /*!
+     *\brief Number of times a matrix was invalidated while it was already 
+     *       out of date, that is rebuilds that were skipped.
+     */
+    size_t              rebuilds_avoided_;
+    /*!
+     *\brief True when the projection matrix was set with 
+     *       set_projection_matrix(), rather than built from the frustrum
+     *       parameters.
+     */
+    bool                custom_projection_;
+
+    enum Dirty_Flag_t {
+        Dirty_View = 1 << 0,
+        Dirty_Projection = 1 << 1,
+        Dirty_Projection_View = 1 << 2,
+        Dirty_Inverse_View = 1 << 3,
+        Dirty_Inverse_Projection_View = 1 << 4
+    };
+
+    /**
+     * \brief   Marks matrices as out of date. They are rebuilt by the 
+     *          getters, the first time they are used.
+     */
+    inline void invalidate(unsigned int flags);
+
+    /**
+     * \brief   Called after a change of the view frame.
+     */
+    inline void handle_view_frame_change();
 
     /**
      * \brief   Constructs the world space to view space transformation matrix.
@@ -104,18 +151,19 @@ private :
      *          [wx, wy, wz, -dot(w, t)]
      *          [0,  0,  0,  1         ].
      */
-    void update_view_matrix();
+    void update_view_matrix() const;
 
     /**
-     * Recompute projection * view matrix.
+     * \brief   Rebuilds the projection matrix from the frustrum parameter
+     *          values.
      */
-    inline void update_projection_view_transform();
+    void update_projection_matrix() const;
 
     /**
-     * \brief   Rebuilds the projection matrix after a change in the frustrum
-     *          parameter values.
+     * \brief   Marks the projection matrix as out of date, after a change 
+     *          in the frustrum parameter values.
      */
-    void handle_frustrum_param_change();
+    inline void handle_frustrum_param_change();
 
 public :
 
@@ -311,6 +359,12 @@ public :
      */
     inline const math::matrix_4X4F& get_view_transform() const;
 
+    /**
+     * \brief   Gets the inverse of the view transform (view to world 
+     *          space). Computed on the first call after a change.
+     */
+    inline const math::matrix_4X4F& get_inverse_view_transform() const;
+
     /**
      * Returns the projection transform matrix.
      */
@@ -345,7 +399,11 @@ public :
     inline int get_projection_type() const;
 
     /**
-     * \brief   Sets the projection's type.
+     * \brief   Sets the projection's type. The projection matrix is rebuilt
+     *          from the frustrum parameters, unless it was set with 
+     *          set_projection_matrix(); in that case only the type is 
+     *          recorded, and the custom matrix is kept until the next call
+     *          to set_frustrum() or set_symmetric_frustrum().
      */
     inline void set_projection_type(int proj_type);
 
@@ -353,6 +411,26 @@ public :
      * Return the product of P (projection matrix) * V (view matrix).
      */
     inline const math::matrix_4X4F& get_projection_wiew_transform() const;
+
+    /**
+     * \brief   Returns the inverse of P * V (clip space to world space).
+     *          Computed on the first call after a change.
+     */
+    inline const math::matrix_4X4F& get_inverse_projection_view_transform() const;
+
+    /**
+     * \brief   Returns the number of matrix rebuilds that were skipped,
+     *          because a matrix was changed again before being used.
+     */
+    size_t get_rebuilds_avoided() const {
+        return rebuilds_avoided_;
+    }
+
+    /**
+     * \brief   Returns the clip planes of the view volume, in world space
+     *          coordinates (extracted from the projection * view matrix).
+     */
+    inline math::frustum get_frustum() const;
 };
 
 } // namespace math
@@ -1,15 +1,31 @@
-inline void v8::math::camera::update_projection_view_transform() {
-    projection_view_matrix_ = projection_matrix_ * view_matrix_;
+inline void v8::math::camera::invalidate(unsigned int flags) {
+    //
+    // Only the matrices that used to be rebuilt by every setter are counted.
+    const unsigned int already_dirty = 
+        dirty_flags_ & flags 
+        & (Dirty_View | Dirty_Projection | Dirty_Projection_View);
+    for (unsigned int bit = already_dirty; bit; bit &= bit - 1)
+        ++rebuilds_avoided_;
+
+    dirty_flags_ |= flags;
+}
+
+inline void v8::math::camera::handle_view_frame_change() {
+    invalidate(Dirty_View | Dirty_Projection_View | Dirty_Inverse_View 
+               | Dirty_Inverse_Projection_View);
+}
+
+inline void v8::math::camera::handle_frustrum_param_change() {
+    custom_projection_ = false;
+    invalidate(Dirty_Projection | Dirty_Projection_View 
+               | Dirty_Inverse_Projection_View);
 }
 
 inline v8::math::camera& v8::math::camera::set_origin(
     const math::vector3F& origin
     ) {
     view_pos_ = origin;
-
-    update_view_matrix();
-    update_projection_view_transform();
-
+    handle_view_frame_change();
     return *this;
 }
 
@@ -30,12 +46,26 @@ inline const v8::math::vector3F& v8::math::camera::get_right_vector() const {
 }
 
 inline const v8::math::matrix_4X4F& v8::math::camera::get_view_transform() const {
+    if (dirty_flags_ & Dirty_View)
+        update_view_matrix();
     return view_matrix_;
 }
 
+inline 
+const v8::math::matrix_4X4F& 
+v8::math::camera::get_inverse_view_transform() const {
+    if (dirty_flags_ & Dirty_Inverse_View) {
+        get_view_transform().get_inverse_affine(&inverse_view_matrix_);
+        dirty_flags_ &= ~Dirty_Inverse_View;
+    }
+    return inverse_view_matrix_;
+}
+
 inline 
 const v8::math::matrix_4X4F& 
 v8::math::camera::get_projection_transform() const {
+    if (dirty_flags_ & Dirty_Projection)
+        update_projection_matrix();
     return projection_matrix_;
 }
 
@@ -45,19 +75,49 @@ v8::math::camera::set_projection_matrix(
     const v8::math::matrix_4X4F& mtx
     ) {
     projection_matrix_ = mtx;
-    update_projection_view_transform();
+    custom_projection_ = true;
+    dirty_flags_ &= ~Dirty_Projection;
+    invalidate(Dirty_Projection_View | Dirty_Inverse_Projection_View);
 }
 
 inline int v8::math::camera::get_projection_type() const {
     return projection_type_;
 }
 
+inline void v8::math::camera::set_projection_type(int proj_type) {
+    assert((proj_type >= Projection_Perspective) 
+           && (proj_type < Projection_Last));
+    projection_type_ = proj_type;
+    if (!custom_projection_)
+        handle_frustrum_param_change();
+}
+
 inline 
 const v8::math::matrix_4X4F&
 v8::math::camera::get_projection_wiew_transform() const {
+    if (dirty_flags_ & Dirty_Projection_View) {
+        projection_view_matrix_ = 
+            get_projection_transform() * get_view_transform();
+        dirty_flags_ &= ~Dirty_Projection_View;
+    }
     return projection_view_matrix_;
 }
 
+inline 
+const v8::math::matrix_4X4F& 
+v8::math::camera::get_inverse_projection_view_transform() const {
+    if (dirty_flags_ & Dirty_Inverse_Projection_View) {
+        get_projection_wiew_transform().get_inverse(
+            &inverse_projection_view_matrix_);
+        dirty_flags_ &= ~Dirty_Inverse_Projection_View;
+    }
+    return inverse_projection_view_matrix_;
+}
+
+inline v8::math::frustum v8::math::camera::get_frustum() const {
+    return frustum(get_projection_wiew_transform());
+}
+
 inline const float* v8::math::camera::get_frustrum() const {
     return frustrum_params_;
 }
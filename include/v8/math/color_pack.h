@@ -0,0 +1,216 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "v8/base/compiler_quirks.h"
+#include "v8/base/parallel_for.h"
+#include "v8/math/color.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \file    color_pack.h
+ *
+ * \brief   Conversions between arrays of color objects and arrays of 32 bit
+ *          packed colors (8 bits per channel), for whole images.
+ *          Unlike color::to_uint32_rgba() and friends, the components are
+ *          clamped to [0, 1] and rounded to the nearest integer (the per
+ *          color functions use ceil and do not clamp).
+ *          When V8_SIMD_ENABLED is defined, 4 colors are converted at a time
+ *          with SSE2.
+ */
+
+/**
+ * \brief   Layout of a packed color. The name lists the channels from the
+ *          most significant byte to the least significant one, the same as
+ *          in color::from_u32_rgba() or color::to_uint32_abgr(). On little
+ *          endian machines, the order of the bytes in memory is reversed,
+ *          so color_format_abgr is the usual R8G8B8A8 texture format and
+ *          color_format_argb is B8G8R8A8.
+ */
+enum color_format {
+    color_format_rgba,
+    color_format_bgra,
+    color_format_argb,
+    color_format_abgr
+};
+
+/**
+ * \brief   Bit offsets of the channels, for a color_format.
+ */
+template<color_format format>
+struct color_format_traits;
+
+template<>
+struct color_format_traits<color_format_rgba> {
+    enum { red_shift = 24, green_shift = 16, blue_shift = 8, alpha_shift = 0 };
+};
+
+template<>
+struct color_format_traits<color_format_bgra> {
+    enum { red_shift = 8, green_shift = 16, blue_shift = 24, alpha_shift = 0 };
+};
+
+template<>
+struct color_format_traits<color_format_argb> {
+    enum { red_shift = 16, green_shift = 8, blue_shift = 0, alpha_shift = 24 };
+};
+
+template<>
+struct color_format_traits<color_format_abgr> {
+    enum { red_shift = 0, green_shift = 8, blue_shift = 16, alpha_shift = 24 };
+};
+
+/**
+ * \brief   Minimum number of colors in a chunk, when splitting a conversion
+ *          across threads.
+ */
+const size_t kColorPackGrainSize = 16384;
+
+namespace internals {
+
+/**
+ * \brief   Scalar kernels for pack_colors() and unpack_colors().
+ */
+template<color_format format>
+struct color_pack_scalar_kernels {
+    typedef color_format_traits<format>     traits_t;
+
+    static uint32_t pack_channel(float value, int shift) {
+        //
+        // Written so that a NaN fails the first test and ends up as 0, the
+        // same as with _mm_max_ps/_mm_min_ps in the SSE kernel.
+        value = value > 0.0f ? value : 0.0f;
+        value = value < 1.0f ? value : 1.0f;
+        return static_cast<uint32_t>(value * 255.0f + 0.5f) << shift;
+    }
+
+    static float unpack_channel(uint32_t value, int shift) {
+        return static_cast<float>((value >> shift) & 0xFF) * (1.0f / 255.0f);
+    }
+
+    static void pack(const color* input, uint32_t* output, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            output[i] = pack_channel(input[i].r_, traits_t::red_shift) |
+                        pack_channel(input[i].g_, traits_t::green_shift) |
+                        pack_channel(input[i].b_, traits_t::blue_shift) |
+                        pack_channel(input[i].a_, traits_t::alpha_shift);
+        }
+    }
+
+    static void unpack(const uint32_t* input, color* output, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t value = input[i];
+            output[i].r_ = unpack_channel(value, traits_t::red_shift);
+            output[i].g_ = unpack_channel(value, traits_t::green_shift);
+            output[i].b_ = unpack_channel(value, traits_t::blue_shift);
+            output[i].a_ = unpack_channel(value, traits_t::alpha_shift);
+        }
+    }
+};
+
+#if defined(V8_SIMD_ENABLED)
+
+/**
+ * \brief   SSE2 kernels, defined in color_pack_sse.inl.
+ */
+template<color_format format>
+struct color_pack_sse_kernels;
+
+/**
+ * \brief   Kernels used by pack_colors() and unpack_colors().
+ */
+template<color_format format>
+struct color_pack_kernels : public color_pack_sse_kernels<format> {};
+
+#else
+
+template<color_format format>
+struct color_pack_kernels : public color_pack_scalar_kernels<format> {};
+
+#endif
+
+} // namespace internals
+
+/**
+ * \brief   Converts count colors to the packed format.
+ * \param   input           Array of count colors.
+ * \param   output          Receives count packed colors.
+ * \param   count           Number of colors.
+ * \param   max_threads     Maximum number of threads to use, 0 means one per
+ *          hardware thread.
+ */
+template<color_format format>
+inline
+void
+pack_colors(
+    const color* input,
+    uint32_t* output,
+    size_t count,
+    unsigned int max_threads = 1
+    )
+{
+    base::parallel_for(count, kColorPackGrainSize, max_threads,
+                       [input, output](size_t first, size_t last) {
+        internals::color_pack_kernels<format>::pack(
+            input + first, output + first, last - first);
+    });
+}
+
+/**
+ * \brief   Converts count packed colors to color objects.
+ * \param   input           Array of count packed colors.
+ * \param   output          Receives count colors.
+ * \param   count           Number of colors.
+ * \param   max_threads     Maximum number of threads to use, 0 means one per
+ *          hardware thread.
+ */
+template<color_format format>
+inline
+void
+unpack_colors(
+    const uint32_t* input,
+    color* output,
+    size_t count,
+    unsigned int max_threads = 1
+    )
+{
+    base::parallel_for(count, kColorPackGrainSize, max_threads,
+                       [input, output](size_t first, size_t last) {
+        internals::color_pack_kernels<format>::unpack(
+            input + first, output + first, last - first);
+    });
+}
+
+} // namespace math
+} // namespace v8
+
+#if defined(V8_SIMD_ENABLED)
+#include "color_pack_sse.inl"
+#endif
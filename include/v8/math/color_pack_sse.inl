@@ -0,0 +1,80 @@
+#include <emmintrin.h>
+
+namespace v8 { namespace math { namespace internals {
+
+/**
+ * \brief   SSE2 kernels for pack_colors()/unpack_colors(). The channels are
+ *          moved with shifts and masks on 32 bit lanes, so one register holds
+ *          the same channel of 4 colors; _MM_TRANSPOSE4_PS converts between
+ *          that and the layout of the color objects. Same rounding as the 
+ *          scalar kernels (truncation after adding 0.5), so both give the 
+ *          same results.
+ */
+template<color_format format>
+struct color_pack_sse_kernels {
+    typedef color_pack_scalar_kernels<format>   scalar_kernels_t;
+    typedef color_format_traits<format>         traits_t;
+
+    static __m128i pack_channel(__m128 value, int shift) {
+        value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), 
+                           _mm_set1_ps(1.0f));
+        const __m128i bits = _mm_cvttps_epi32(
+            _mm_add_ps(_mm_mul_ps(value, _mm_set1_ps(255.0f)), 
+                       _mm_set1_ps(0.5f)));
+        return _mm_sll_epi32(bits, _mm_cvtsi32_si128(shift));
+    }
+
+    static __m128 unpack_channel(__m128i value, int shift) {
+        const __m128i bits = _mm_and_si128(
+            _mm_srl_epi32(value, _mm_cvtsi32_si128(shift)), 
+            _mm_set1_epi32(0xFF));
+        return _mm_mul_ps(_mm_cvtepi32_ps(bits), _mm_set1_ps(1.0f / 255.0f));
+    }
+
+    static void pack(const color* input, uint32_t* output, size_t count) {
+        const size_t simd_count = count & ~size_t(3);
+        for (size_t i = 0; i < simd_count; i += 4) {
+            __m128 r = _mm_loadu_ps(input[i].components_);
+            __m128 g = _mm_loadu_ps(input[i + 1].components_);
+            __m128 b = _mm_loadu_ps(input[i + 2].components_);
+            __m128 a = _mm_loadu_ps(input[i + 3].components_);
+            _MM_TRANSPOSE4_PS(r, g, b, a);
+
+            const __m128i packed = _mm_or_si128(
+                _mm_or_si128(pack_channel(r, traits_t::red_shift),
+                             pack_channel(g, traits_t::green_shift)),
+                _mm_or_si128(pack_channel(b, traits_t::blue_shift),
+                             pack_channel(a, traits_t::alpha_shift)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), packed);
+        }
+
+        scalar_kernels_t::pack(input + simd_count, output + simd_count,
+                               count - simd_count);
+    }
+
+    static void unpack(const uint32_t* input, color* output, size_t count) {
+        const size_t simd_count = count & ~size_t(3);
+        for (size_t i = 0; i < simd_count; i += 4) {
+            const __m128i packed = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(input + i));
+
+            __m128 r = unpack_channel(packed, traits_t::red_shift);
+            __m128 g = unpack_channel(packed, traits_t::green_shift);
+            __m128 b = unpack_channel(packed, traits_t::blue_shift);
+            __m128 a = unpack_channel(packed, traits_t::alpha_shift);
+            _MM_TRANSPOSE4_PS(r, g, b, a);
+
+            _mm_storeu_ps(output[i].components_, r);
+            _mm_storeu_ps(output[i + 1].components_, g);
+            _mm_storeu_ps(output[i + 2].components_, b);
+            _mm_storeu_ps(output[i + 3].components_, a);
+        }
+
+        scalar_kernels_t::unpack(input + simd_count, output + simd_count,
+                                 count - simd_count);
+    }
+};
+
+} // namespace internals
+} // namespace math
+} // namespace v8
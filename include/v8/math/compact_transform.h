@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "v8/math/matrix4X4.h"
+#include "v8/math/quaternion.h"
+#include "v8/math/vector3.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \class   compact_transform
+ *
+ * \brief   Rotation, translation and uniform scale, stored as a unit 
+ *          quaternion, a vector3 and a scalar (32 bytes for floats, against
+ *          120 for a transform). Maps a point p to 
+ *          rotation_(scale_ * p) + translation_.
+ *          Composition, inversion and point/vector transforms work on the
+ *          components directly; a matrix is only built when asked for.
+ *          The default constructor leaves the object uninitialized, use
+ *          compact_transform::identity.
+ * \remarks A uniform scale commutes with any rotation, so the product of
+ *          two compact transforms is again a compact transform (this is
+ *          not true for non-uniform scales).
+ */
+template<typename real_t>
+class compact_transform {
+public :
+    typedef real_t                      element_type;
+    typedef compact_transform<real_t>   compact_transform_t;
+
+    quaternion<real_t>      rotation_;
+    vector3<real_t>         translation_;
+    real_t                  scale_;
+
+    static const compact_transform<real_t>  identity;
+
+    compact_transform() {}
+
+    inline compact_transform(
+        const quaternion<real_t>& rotation,
+        const vector3<real_t>& translation,
+        real_t scale = real_t(1)
+        );
+
+    /**
+     * \brief   Applies rotation and scale, without the translation.
+     */
+    inline vector3<real_t> transform_vector(const vector3<real_t>& v) const;
+
+    inline vector3<real_t> transform_point(const vector3<real_t>& p) const;
+
+    /**
+     * \brief   this = this * rhs, the transform that applies rhs first and
+     *          then this one (the order of matrix_4X4 multiplication, so
+     *          world = parent * local).
+     */
+    inline compact_transform<real_t>& operator*=(
+        const compact_transform<real_t>& rhs
+        );
+
+    /**
+     * \brief   Inverts the transform. The rotation must be unit length and
+     *          the scale non zero.
+     */
+    inline compact_transform<real_t>& invert();
+
+    /**
+     * \brief   Builds the equivalent affine matrix, T * R * S.
+     */
+    void get_matrix(matrix_4X4<real_t>* mtx) const;
+
+    matrix_4X4<real_t> get_matrix() const {
+        matrix_4X4<real_t> mtx;
+        get_matrix(&mtx);
+        return mtx;
+    }
+};
+
+template<typename real_t>
+const compact_transform<real_t>
+compact_transform<real_t>::identity(
+    quaternion<real_t>(real_t(1), real_t(0), real_t(0), real_t(0)),
+    vector3<real_t>(real_t(0), real_t(0), real_t(0)),
+    real_t(1));
+
+template<typename real_t>
+inline
+compact_transform<real_t>
+operator*(
+    const compact_transform<real_t>& lhs,
+    const compact_transform<real_t>& rhs
+    );
+
+/**
+ * \brief   Returns the inverse of a transform.
+ */
+template<typename real_t>
+inline
+compact_transform<real_t>
+inverse_of(const compact_transform<real_t>& tfm);
+
+typedef compact_transform<float>    compact_transformF;
+typedef compact_transform<double>   compact_transformD;
+
+} // namespace math
+} // namespace v8
+
+#include "compact_transform.inl"
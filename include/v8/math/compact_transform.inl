@@ -0,0 +1,118 @@
+template<typename real_t>
+inline
+v8::math::compact_transform<real_t>::compact_transform(
+    const v8::math::quaternion<real_t>& rotation,
+    const v8::math::vector3<real_t>& translation,
+    real_t scale
+    )
+    : rotation_(rotation), translation_(translation), scale_(scale) {}
+
+template<typename real_t>
+inline
+v8::math::vector3<real_t>
+v8::math::compact_transform<real_t>::transform_vector(
+    const v8::math::vector3<real_t>& v
+    ) const {
+    //
+    // v' = v + 2w (q x v) + 2 q x (q x v), for a unit quaternion (w, q).
+    const quaternion<real_t>& r = rotation_;
+    const real_t tx = real_t(2) * (r.y_ * v.z_ - r.z_ * v.y_);
+    const real_t ty = real_t(2) * (r.z_ * v.x_ - r.x_ * v.z_);
+    const real_t tz = real_t(2) * (r.x_ * v.y_ - r.y_ * v.x_);
+
+    return vector3<real_t>(
+        scale_ * (v.x_ + r.w_ * tx + r.y_ * tz - r.z_ * ty),
+        scale_ * (v.y_ + r.w_ * ty + r.z_ * tx - r.x_ * tz),
+        scale_ * (v.z_ + r.w_ * tz + r.x_ * ty - r.y_ * tx));
+}
+
+template<typename real_t>
+inline
+v8::math::vector3<real_t>
+v8::math::compact_transform<real_t>::transform_point(
+    const v8::math::vector3<real_t>& p
+    ) const {
+    vector3<real_t> result(transform_vector(p));
+    result += translation_;
+    return result;
+}
+
+template<typename real_t>
+inline
+v8::math::compact_transform<real_t>&
+v8::math::compact_transform<real_t>::operator*=(
+    const v8::math::compact_transform<real_t>& rhs
+    ) {
+    translation_ = transform_point(rhs.translation_);
+    rotation_ = rotation_ * rhs.rotation_;
+    scale_ *= rhs.scale_;
+    return *this;
+}
+
+template<typename real_t>
+inline
+v8::math::compact_transform<real_t>&
+v8::math::compact_transform<real_t>::invert() {
+    assert(scale_ != real_t(0));
+    rotation_.make_conjugate();
+    scale_ = real_t(1) / scale_;
+    translation_ = transform_vector(translation_);
+    translation_ = -translation_;
+    return *this;
+}
+
+template<typename real_t>
+void
+v8::math::compact_transform<real_t>::get_matrix(
+    v8::math::matrix_4X4<real_t>* mtx
+    ) const {
+    const quaternion<real_t>& r = rotation_;
+    const real_t s2 = real_t(2) * scale_;
+    const real_t xx = r.x_ * r.x_;
+    const real_t yy = r.y_ * r.y_;
+    const real_t zz = r.z_ * r.z_;
+    const real_t xy = r.x_ * r.y_;
+    const real_t xz = r.x_ * r.z_;
+    const real_t yz = r.y_ * r.z_;
+    const real_t wx = r.w_ * r.x_;
+    const real_t wy = r.w_ * r.y_;
+    const real_t wz = r.w_ * r.z_;
+
+    mtx->a11_ = scale_ - s2 * (yy + zz);
+    mtx->a12_ = s2 * (xy - wz);
+    mtx->a13_ = s2 * (xz + wy);
+    mtx->a14_ = translation_.x_;
+
+    mtx->a21_ = s2 * (xy + wz);
+    mtx->a22_ = scale_ - s2 * (xx + zz);
+    mtx->a23_ = s2 * (yz - wx);
+    mtx->a24_ = translation_.y_;
+
+    mtx->a31_ = s2 * (xz - wy);
+    mtx->a32_ = s2 * (yz + wx);
+    mtx->a33_ = scale_ - s2 * (xx + yy);
+    mtx->a34_ = translation_.z_;
+
+    mtx->a41_ = mtx->a42_ = mtx->a43_ = real_t(0);
+    mtx->a44_ = real_t(1);
+}
+
+template<typename real_t>
+inline
+v8::math::compact_transform<real_t>
+v8::math::operator*(
+    const v8::math::compact_transform<real_t>& lhs,
+    const v8::math::compact_transform<real_t>& rhs
+    ) {
+    compact_transform<real_t> result(lhs);
+    result *= rhs;
+    return result;
+}
+
+template<typename real_t>
+inline
+v8::math::compact_transform<real_t>
+v8::math::inverse_of(const v8::math::compact_transform<real_t>& tfm) {
+    compact_transform<real_t> result(tfm);
+    return result.invert();
+}
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include "v8/math/matrix4X4.h"
+#include "v8/math/quaternion.h"
+#include "v8/math/vector3.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \class   dual_quaternion
+ *
+ * \brief   Rigid transform (rotation followed by translation) stored as a
+ *          dual quaternion, real_ + e * dual_. The real part is the unit
+ *          rotation quaternion r, the dual part is 0.5 * (0, t) * r.
+ *          Dual quaternions can be blended linearly and renormalized
+ *          (dual quaternion skinning) without the volume loss of blended
+ *          matrices at twisted joints.
+ *          The default constructor leaves the object uninitialized, use
+ *          dual_quaternion::identity.
+ */
+template<typename real_t>
+class dual_quaternion {
+public :
+    typedef real_t                      element_type;
+    typedef dual_quaternion<real_t>     dual_quaternion_t;
+
+    quaternion<real_t>      real_;
+    quaternion<real_t>      dual_;
+
+    static const dual_quaternion<real_t>    identity;
+
+    dual_quaternion() {}
+
+    dual_quaternion(
+        const quaternion<real_t>& real_part,
+        const quaternion<real_t>& dual_part
+        )
+        : real_(real_part), dual_(dual_part) {}
+
+    /**
+     * \brief   Rotation followed by translation. The rotation must be unit
+     *          length.
+     */
+    inline dual_quaternion(
+        const quaternion<real_t>& rotation,
+        const vector3<real_t>& translation
+        );
+
+    inline vector3<real_t> get_translation() const;
+
+    /**
+     * \brief   Divides both parts by the length of the real part. Blended
+     *          dual quaternions must be normalized before use.
+     */
+    inline dual_quaternion<real_t>& normalize();
+
+    /**
+     * \brief   Conjugates both quaternions. For a unit dual quaternion this
+     *          is the inverse transform.
+     */
+    inline dual_quaternion<real_t>& make_conjugate();
+
+    /**
+     * \brief   Applies the rotation only (normals, directions).
+     */
+    inline vector3<real_t> transform_vector(const vector3<real_t>& v) const;
+
+    inline vector3<real_t> transform_point(const vector3<real_t>& p) const;
+
+    /**
+     * \brief   Builds the equivalent affine matrix.
+     */
+    void get_matrix(matrix_4X4<real_t>* mtx) const;
+};
+
+template<typename real_t>
+const dual_quaternion<real_t>
+dual_quaternion<real_t>::identity(
+    quaternion<real_t>(real_t(1), real_t(0), real_t(0), real_t(0)),
+    quaternion<real_t>(real_t(0), real_t(0), real_t(0), real_t(0)));
+
+/**
+ * \brief   Composition : the result applies rhs first, then lhs.
+ */
+template<typename real_t>
+inline
+dual_quaternion<real_t>
+operator*(
+    const dual_quaternion<real_t>& lhs,
+    const dual_quaternion<real_t>& rhs
+    );
+
+typedef dual_quaternion<float>      dual_quaternionF;
+typedef dual_quaternion<double>     dual_quaternionD;
+
+} // namespace math
+} // namespace v8
+
+#include "dual_quaternion.inl"
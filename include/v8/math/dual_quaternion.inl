@@ -0,0 +1,127 @@
+template<typename real_t>
+inline
+v8::math::dual_quaternion<real_t>::dual_quaternion(
+    const v8::math::quaternion<real_t>& rotation,
+    const v8::math::vector3<real_t>& translation
+    )
+    : real_(rotation) {
+    const quaternion<real_t>& r = rotation;
+    const vector3<real_t>& t = translation;
+    dual_.w_ = real_t(-0.5) * (t.x_ * r.x_ + t.y_ * r.y_ + t.z_ * r.z_);
+    dual_.x_ = real_t(0.5) * (t.x_ * r.w_ + t.y_ * r.z_ - t.z_ * r.y_);
+    dual_.y_ = real_t(0.5) * (t.y_ * r.w_ + t.z_ * r.x_ - t.x_ * r.z_);
+    dual_.z_ = real_t(0.5) * (t.z_ * r.w_ + t.x_ * r.y_ - t.y_ * r.x_);
+}
+
+template<typename real_t>
+inline
+v8::math::vector3<real_t>
+v8::math::dual_quaternion<real_t>::get_translation() const {
+    //
+    // t = 2 * dual * conjugate(real), the vector part.
+    const quaternion<real_t>& r = real_;
+    const quaternion<real_t>& d = dual_;
+    return vector3<real_t>(
+        real_t(2) * (r.w_ * d.x_ - d.w_ * r.x_ + r.y_ * d.z_ - r.z_ * d.y_),
+        real_t(2) * (r.w_ * d.y_ - d.w_ * r.y_ + r.z_ * d.x_ - r.x_ * d.z_),
+        real_t(2) * (r.w_ * d.z_ - d.w_ * r.z_ + r.x_ * d.y_ - r.y_ * d.x_));
+}
+
+template<typename real_t>
+inline
+v8::math::dual_quaternion<real_t>&
+v8::math::dual_quaternion<real_t>::normalize() {
+    const real_t len = std::sqrt(real_.length_squared());
+    assert(len > real_t(0));
+    const real_t inv_len = real_t(1) / len;
+    real_ *= inv_len;
+    dual_ *= inv_len;
+    return *this;
+}
+
+template<typename real_t>
+inline
+v8::math::dual_quaternion<real_t>&
+v8::math::dual_quaternion<real_t>::make_conjugate() {
+    real_.make_conjugate();
+    dual_.make_conjugate();
+    return *this;
+}
+
+template<typename real_t>
+inline
+v8::math::vector3<real_t>
+v8::math::dual_quaternion<real_t>::transform_vector(
+    const v8::math::vector3<real_t>& v
+    ) const {
+    //
+    // v' = v + 2 q x (q x v + w v), for the unit rotation (w, q).
+    const quaternion<real_t>& r = real_;
+    const real_t cx = r.y_ * v.z_ - r.z_ * v.y_ + r.w_ * v.x_;
+    const real_t cy = r.z_ * v.x_ - r.x_ * v.z_ + r.w_ * v.y_;
+    const real_t cz = r.x_ * v.y_ - r.y_ * v.x_ + r.w_ * v.z_;
+
+    return vector3<real_t>(
+        v.x_ + real_t(2) * (r.y_ * cz - r.z_ * cy),
+        v.y_ + real_t(2) * (r.z_ * cx - r.x_ * cz),
+        v.z_ + real_t(2) * (r.x_ * cy - r.y_ * cx));
+}
+
+template<typename real_t>
+inline
+v8::math::vector3<real_t>
+v8::math::dual_quaternion<real_t>::transform_point(
+    const v8::math::vector3<real_t>& p
+    ) const {
+    vector3<real_t> result(transform_vector(p));
+    result += get_translation();
+    return result;
+}
+
+template<typename real_t>
+void
+v8::math::dual_quaternion<real_t>::get_matrix(
+    v8::math::matrix_4X4<real_t>* mtx
+    ) const {
+    const quaternion<real_t>& r = real_;
+    const real_t xx = r.x_ * r.x_;
+    const real_t yy = r.y_ * r.y_;
+    const real_t zz = r.z_ * r.z_;
+    const real_t xy = r.x_ * r.y_;
+    const real_t xz = r.x_ * r.z_;
+    const real_t yz = r.y_ * r.z_;
+    const real_t wx = r.w_ * r.x_;
+    const real_t wy = r.w_ * r.y_;
+    const real_t wz = r.w_ * r.z_;
+    const vector3<real_t> t(get_translation());
+
+    mtx->a11_ = real_t(1) - real_t(2) * (yy + zz);
+    mtx->a12_ = real_t(2) * (xy - wz);
+    mtx->a13_ = real_t(2) * (xz + wy);
+    mtx->a14_ = t.x_;
+
+    mtx->a21_ = real_t(2) * (xy + wz);
+    mtx->a22_ = real_t(1) - real_t(2) * (xx + zz);
+    mtx->a23_ = real_t(2) * (yz - wx);
+    mtx->a24_ = t.y_;
+
+    mtx->a31_ = real_t(2) * (xz - wy);
+    mtx->a32_ = real_t(2) * (yz + wx);
+    mtx->a33_ = real_t(1) - real_t(2) * (xx + yy);
+    mtx->a34_ = t.z_;
+
+    mtx->a41_ = mtx->a42_ = mtx->a43_ = real_t(0);
+    mtx->a44_ = real_t(1);
+}
+
+template<typename real_t>
+inline
+v8::math::dual_quaternion<real_t>
+v8::math::operator*(
+    const v8::math::dual_quaternion<real_t>& lhs,
+    const v8::math::dual_quaternion<real_t>& rhs
+    ) {
+    dual_quaternion<real_t> result(lhs.real_ * rhs.real_, lhs.real_ * rhs.dual_);
+    result.dual_ += lhs.dual_ * rhs.real_;
+    return result;
+}
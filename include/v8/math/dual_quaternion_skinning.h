@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "v8/math/dual_quaternion.h"
+#include "v8/math/vector3_soa.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \brief   Number of vertices in a chunk, when skinning is split across
+ *          threads.
+ */
+const size_t kDualQuaternionSkinningGrainSize = 1024;
+
+/**
+ * \brief   Bone influences per vertex for skin_dual_quaternion().
+ */
+const size_t kDualQuaternionSkinningInfluences = 4;
+
+/**
+ * \brief   Dual quaternion skinning (linear blending of the bone dual
+ *          quaternions, then normalization). Vertex i is influenced by the 
+ *          bones bone_indices[4 * i + k] with the weights 
+ *          bone_weights[4 * i + k], k = 0..3. The weights of a vertex 
+ *          should add up to 1; vertices with fewer than 4 bones use a
+ *          weight of 0 for the unused influences (with any valid bone 
+ *          index). A bone is negated before blending when its rotation is
+ *          in the opposite hemisphere from the one of the first bone, so 
+ *          the blend follows the shortest arc.
+ * \param   palette             Skinning transforms (bind pose to current
+ *                              pose), one per bone.
+ * \param   positions           Bind pose positions.
+ * \param   normals             Bind pose normals, can be null.
+ * \param   skinned_positions   Receives the positions, resized to match.
+ *                              Must not be positions.
+ * \param   skinned_normals     Receives the normals (rotated only), can be
+ *                              null if normals is null. Must not be normals.
+ * \param   max_threads         Maximum number of threads, 0 to use all the 
+ *                              hardware threads.
+ * \remarks When V8_SIMD_ENABLED is defined, the vertices are skinned 4 at a
+ *          time with SSE.
+ */
+void skin_dual_quaternion(
+    const dual_quaternionF* palette,
+    const uint16_t* bone_indices,
+    const float* bone_weights,
+    const vector3_soaF& positions,
+    const vector3_soaF* normals,
+    vector3_soaF* skinned_positions,
+    vector3_soaF* skinned_normals,
+    unsigned int max_threads = 1
+    );
+
+} // namespace math
+} // namespace v8
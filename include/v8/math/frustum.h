@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include "v8/base/compiler_quirks.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/plane.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \brief   Number of spheres classified by a thread, when classify_spheres()
+ *          uses more than one thread.
+ */
+const size_t kFrustumCullGrainSize = 4096;
+
+/**
+ * \brief   Result of testing a bounding volume against a frustum.
+ */
+enum cull_result {
+    cull_inside,    ///< Completely inside all the planes.
+    cull_intersect, ///< Crosses at least one plane, but is not outside any.
+    cull_outside    ///< Completely outside at least one plane.
+};
+
+/**
+ * \class   frustum
+ *
+ * \brief   The six clip planes of a view volume, extracted from a
+ *          projection * view matrix (Gribb/Hartmann method). The planes
+ *          are normalized and their normals point inside the volume, so
+ *          a point p is inside when dot(n, p) + d >= 0 for all of them.
+ *          Besides the plane objects, the frustum keeps the plane
+ *          coefficients packed as four arrays (nx, ny, nz, d), which is
+ *          what the batched tests use.
+ * \remarks The matrix must use the Direct3D depth range (0 <= z <= w in
+ *          clip space), like the matrices built by camera.
+ */
+class frustum {
+public :
+    enum Plane_Id_t {
+        Plane_Left,
+        Plane_Right,
+        Plane_Bottom,
+        Plane_Top,
+        Plane_Near,
+        Plane_Far,
+        Plane_Count
+    };
+
+    frustum() {}
+
+    /**
+     * \brief   Constructs the frustum for a projection * view matrix.
+     */
+    explicit frustum(const matrix_4X4F& projection_view) {
+        extract_planes(projection_view);
+    }
+
+    /**
+     * \brief   Rebuilds the planes from a projection * view matrix. With
+     *          rows r1 - r4 of the matrix, the (unnormalized) planes are :
+     *          left = r4 + r1, right = r4 - r1, bottom = r4 + r2,
+     *          top = r4 - r2, near = r3, far = r4 - r3.
+     */
+    void extract_planes(const matrix_4X4F& projection_view);
+
+    /**
+     * \brief   Returns one of the planes (see Plane_Id_t).
+     */
+    const plane& get_plane(int plane_id) const {
+        assert(plane_id >= 0 && plane_id < Plane_Count);
+        return planes_[plane_id];
+    }
+
+    const plane* get_planes() const {
+        return planes_;
+    }
+
+    /**
+     * \brief   The packed plane coefficients. Each array has Plane_Count
+     *          elements, in Plane_Id_t order.
+     */
+    const float* normals_x() const {
+        return nx_;
+    }
+
+    const float* normals_y() const {
+        return ny_;
+    }
+
+    const float* normals_z() const {
+        return nz_;
+    }
+
+    const float* offsets() const {
+        return d_;
+    }
+
+    /**
+     * \brief   Classifies a single sphere. The radius cannot be negative.
+     */
+    cull_result classify_sphere(const vector3F& center, float radius) const;
+
+private :
+    plane   planes_[Plane_Count];
+    float   nx_[Plane_Count];
+    float   ny_[Plane_Count];
+    float   nz_[Plane_Count];
+    float   d_[Plane_Count];
+};
+
+/**
+ * \brief   Classifies count bounding spheres against the frustum, writing
+ *          a cull_result value for each one to result. The centers are
+ *          given as separate x, y, z arrays and the radii cannot be
+ *          negative.
+ * \param   max_threads     Maximum number of threads to use, 0 for all the
+ *                          hardware threads (see base::parallel_for).
+ * \remarks When V8_SIMD_ENABLED is defined the spheres are tested 4 at a
+ *          time, against all six planes, without branches.
+ */
+void
+classify_spheres(
+    const frustum& view_frustum,
+    const float* center_x,
+    const float* center_y,
+    const float* center_z,
+    const float* radius,
+    size_t count,
+    uint8_t* result,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Classifies centers.size() bounding spheres against the frustum.
+ *          radius and result must have room for centers.size() elements.
+ */
+void
+classify_spheres(
+    const frustum& view_frustum,
+    const vector3_soaF& centers,
+    const float* radius,
+    uint8_t* result,
+    unsigned int max_threads = 1
+    );
+
+} // namespace math
+} // namespace v8
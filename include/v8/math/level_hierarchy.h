@@ -0,0 +1,186 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "v8/base/compiler_quirks.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/quaternion.h"
+#include "v8/math/quaternion_soa.h"
+#include "v8/math/scene_hierarchy.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \brief   Minimum number of nodes in a chunk, when a level of a 
+ *          level_hierarchy is split across threads.
+ */
+const size_t kLevelHierarchyGrainSize = 2048;
+
+/**
+ * \class   level_hierarchy
+ *
+ * \brief   A transform hierarchy for scenes where most of the nodes move
+ *          every frame (animated crowds, particles attached to skeletons).
+ *          The nodes are sorted by depth level and their local transforms
+ *          are stored as SoA streams (rotation quaternion, translation, 
+ *          scale), in level order, with the parent indices.
+ *
+ *          update() builds all the local matrices with the SIMD palette 
+ *          functions (see transform_palette.h), then composes the world
+ *          matrices level by level, world = parent_world * local. All the
+ *          parents of a level are in the previous levels, so every level
+ *          is split in chunks that are processed in parallel. All the 
+ *          levels are composed in one job on base::thread_pool::shared(),
+ *          with a barrier between consecutive levels.
+ * \remarks The world matrices are stored as 3X4 row major matrices (the 
+ *          layout of make_transform_palette_3X4()), in level order. Use
+ *          sorted_index() to go from a node to its position in the streams.
+ */
+class level_hierarchy {
+public :
+    /**
+     * \param   max_threads Maximum number of threads used by update(), 0
+     *                      to use all hardware threads.
+     */
+    explicit level_hierarchy(unsigned int max_threads = 0);
+
+    /**
+     * \brief   Sorts the nodes by depth. parents[i] is the parent of node i,
+     *          or kInvalidNode for a root; the parents can be stored in any
+     *          order, but the graph must be a forest. The local transforms 
+     *          are reset to identity.
+     */
+    void build(const uint32_t* parents, size_t count);
+
+    size_t node_count() const {
+        return node_at_.size();
+    }
+
+    size_t level_count() const {
+        return level_first_.size() - 1;
+    }
+
+    /**
+     * \brief   Position of the first node of a level, in the streams.
+     */
+    size_t level_first(size_t level) const {
+        assert(level < level_count());
+        return level_first_[level];
+    }
+
+    size_t level_size(size_t level) const {
+        assert(level < level_count());
+        return level_first_[level + 1] - level_first_[level];
+    }
+
+    /**
+     * \brief   Position of a node in the streams.
+     */
+    uint32_t sorted_index(uint32_t node) const {
+        assert(node < node_count());
+        return sorted_index_[node];
+    }
+
+    /**
+     * \brief   Node at a position in the streams.
+     */
+    uint32_t node_at(uint32_t index) const {
+        assert(index < node_count());
+        return node_at_[index];
+    }
+
+    /**
+     * \brief   Parents, as positions in the streams (kInvalidNode for the
+     *          roots).
+     */
+    const uint32_t* sorted_parents() const {
+        return sorted_parents_.empty() ? nullptr : &sorted_parents_[0];
+    }
+
+    void set_local_transform(
+        uint32_t node,
+        const quaternionF& rotation,
+        const vector3F& translation,
+        const vector3F& scale
+        );
+
+    /**
+     * \brief   Local rotations in level order, for code that writes the 
+     *          transforms of all the nodes (animation sampling).
+     */
+    quaternion_soaF& rotations() {
+        return rotations_;
+    }
+
+    vector3_soaF& translations() {
+        return translations_;
+    }
+
+    vector3_soaF& scales() {
+        return scales_;
+    }
+
+    /**
+     * \brief   Computes the world matrices of all the nodes.
+     */
+    void update();
+
+    /**
+     * \brief   World matrices, 12 floats per node, in level order.
+     */
+    const float* world_palette() const {
+        return worlds_.empty() ? nullptr : &worlds_[0];
+    }
+
+    /**
+     * \brief   World matrix of a node, as of the last update().
+     */
+    matrix_4X4F world_matrix(uint32_t node) const;
+
+private :
+    unsigned int            max_threads_;
+    std::vector<uint32_t>   sorted_index_;
+    std::vector<uint32_t>   node_at_;
+    std::vector<uint32_t>   sorted_parents_;
+    std::vector<size_t>     level_first_;
+    quaternion_soaF         rotations_;
+    vector3_soaF            translations_;
+    vector3_soaF            scales_;
+    std::vector<float>      worlds_;
+
+private :
+    NO_CC_ASSIGN(level_hierarchy);
+};
+
+} // namespace math
+} // namespace v8
@@ -0,0 +1,200 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "v8/base/compiler_quirks.h"
+#include "v8/math/aabb_soa.h"
+#include "v8/math/camera.h"
+#include "v8/math/light.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \brief   Number of lights binned by a task, when light_clusters::assign()
+ *          uses more than one thread.
+ */
+const size_t kLightClusterGrainSize = 256;
+
+/**
+ * \class   light_clusters
+ *
+ * \brief   Clustered (froxel) light assignment. The view frustum of a 
+ *          perspective camera is divided into grid_x * grid_y screen 
+ *          tiles and grid_z depth slices, with exponentially growing 
+ *          depth. assign() finds the point and spot lights whose volumes
+ *          touch each cluster and stores them as one compact list of light
+ *          indices per cluster, that the shading code can walk.
+ *          The lights are packed into SoA form (view space positions and
+ *          ranges), each light's cluster range is found from its bounding
+ *          sphere, and only the clusters in that range are tested, 4 at a
+ *          time with SSE, against the sphere (aabb_sphere_overlap() on
+ *          the view space bounds of the clusters).
+ *          The lights are binned in parallel, each task records (cluster,
+ *          light) pairs in its own buffer, then the pairs are sorted into
+ *          the per cluster lists with a counting sort, so there are no 
+ *          locks and the light indices in a list are in increasing order.
+ * \remarks Spot lights are bound by the sphere of radius max_range around
+ *          their position, which is conservative. Directional lights
+ *          affect every cluster, they are skipped.
+ */
+class light_clusters {
+public :
+    /**
+     * \param   grid_x      Number of tiles along the x axis of the screen.
+     * \param   grid_y      Number of tiles along the y axis of the screen.
+     * \param   grid_z      Number of depth slices.
+     * \param   max_threads Maximum number of threads used by assign(),
+     *                      0 for all the hardware threads.
+     */
+    light_clusters(
+        size_t grid_x, 
+        size_t grid_y, 
+        size_t grid_z, 
+        unsigned int max_threads = 0
+        );
+
+    /**
+     * \brief   Assigns the lights to the clusters of the camera's view 
+     *          volume. The camera must use a perspective projection set
+     *          with set_frustrum()/set_symmetric_frustrum().
+     */
+    void assign(const camera& cam, const light* lights, size_t light_count);
+
+    size_t grid_x() const {
+        return grid_x_;
+    }
+
+    size_t grid_y() const {
+        return grid_y_;
+    }
+
+    size_t grid_z() const {
+        return grid_z_;
+    }
+
+    size_t cluster_count() const {
+        return grid_x_ * grid_y_ * grid_z_;
+    }
+
+    /**
+     * \brief   Index of a cluster, tiles are numbered from (rmin, umin).
+     */
+    size_t cluster_index(size_t x, size_t y, size_t z) const {
+        assert(x < grid_x_ && y < grid_y_ && z < grid_z_);
+        return (z * grid_y_ + y) * grid_x_ + x;
+    }
+
+    /**
+     * \brief   Returns the depth slice that contains a view space depth,
+     *          clamped to [0, grid_z).
+     */
+    size_t depth_slice(float view_depth) const;
+
+    /**
+     * \brief   Number of lights that touch a cluster.
+     */
+    size_t light_count(size_t cluster) const {
+        assert(cluster < cluster_count());
+        return offsets_[cluster + 1] - offsets_[cluster];
+    }
+
+    /**
+     * \brief   Indices (in the array given to assign()) of the lights that
+     *          touch a cluster, light_count(cluster) elements.
+     */
+    const uint32_t* light_indices(size_t cluster) const {
+        assert(cluster < cluster_count());
+        return indices_.empty() ? nullptr : &indices_[0] + offsets_[cluster];
+    }
+
+    /**
+     * \brief   Total number of (cluster, light) pairs.
+     */
+    size_t total_light_count() const {
+        return indices_.size();
+    }
+
+    /**
+     * \brief   View space bounding boxes of the clusters, from the last
+     *          call to assign().
+     */
+    const aabb_soaF& cluster_bounds() const {
+        return cluster_bounds_;
+    }
+
+private :
+    NO_CC_ASSIGN(light_clusters);
+
+    struct light_cluster_pair {
+        uint32_t    cluster;
+        uint32_t    light;
+    };
+
+    /**
+     * \brief   Rebuilds the cluster bounds, if the frustrum changed.
+     */
+    void update_cluster_bounds(const camera& cam);
+
+    /**
+     * \brief   Tests the lights in [first, last) against the clusters.
+     */
+    void bin_lights(
+        size_t first, 
+        size_t last, 
+        std::vector<light_cluster_pair>* pairs
+        ) const;
+
+    size_t                              grid_x_;
+    size_t                              grid_y_;
+    size_t                              grid_z_;
+    unsigned int                        max_threads_;
+    /// Frustrum parameters the cluster bounds were built for.
+    float                               frustrum_[camera::Frustrum_Params_Max];
+    /// log(dmax / dmin), used to find the depth slices.
+    float                               log_depth_ratio_;
+    /// The tile boundaries on the near plane.
+    std::vector<float>                  tile_x_;
+    std::vector<float>                  tile_y_;
+    /// Depth of the slice boundaries.
+    std::vector<float>                  slice_z_;
+    aabb_soaF                           cluster_bounds_;
+    /// Packed light data : view space positions, ranges, original indices.
+    vector3_soaF                        light_positions_;
+    std::vector<float>                  light_ranges_;
+    std::vector<uint32_t>               light_ids_;
+    std::vector<std::vector<light_cluster_pair> >   task_pairs_;
+    std::vector<uint32_t>               offsets_;
+    std::vector<uint32_t>               indices_;
+};
+
+} // namespace math
+} // namespace v8
@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "v8/math/light.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \brief   Number of surface points processed by a task, when the
+ *          light_set batch functions use more than one thread.
+ */
+const size_t kLightSetGrainSize = 256;
+
+/**
+ * \class   light_set
+ *
+ * \brief   Point and spot lights, stored column-wise (position, direction,
+ *          attenuation, max_range, spot_power and spot_cone_theta in 
+ *          separate arrays), for code that evaluates many lights on the
+ *          CPU, like lightmap baking. The batch functions below take a set
+ *          of surface points and produce a row of light_count() values
+ *          per point, result[point * light_count() + light].
+ * \remarks Point lights are stored as spot lights with a zero direction,
+ *          zero spot power and a cone of pi, so they go through the same
+ *          code and get a spot factor of 1. When V8_SIMD_ENABLED is 
+ *          defined, the lights are evaluated 4 at a time.
+ */
+class light_set {
+public :
+    light_set() {}
+
+    /**
+     * \brief   Adds the point and spot lights in [lights, lights + count),
+     *          directional lights are skipped.
+     */
+    light_set(const light* lights, size_t count);
+
+    /**
+     * \brief   Appends a point or a spot light and returns its index.
+     */
+    size_t add(const light& source);
+
+    void reserve(size_t count);
+
+    void clear();
+
+    size_t light_count() const {
+        return positions_.size();
+    }
+
+    bool empty() const {
+        return positions_.empty();
+    }
+
+    const vector3_soaF& positions() const {
+        return positions_;
+    }
+
+    /**
+     * \brief   Spot directions, (0, 0, 0) for point lights.
+     */
+    const vector3_soaF& directions() const {
+        return directions_;
+    }
+
+    /**
+     * \brief   Attenuation factors, x is the constant, y the linear and z
+     *          the quadratic term.
+     */
+    const vector3_soaF& attenuation() const {
+        return attenuation_;
+    }
+
+    const float* max_range() const {
+        return max_range_.data();
+    }
+
+    const float* spot_power() const {
+        return spot_power_.data();
+    }
+
+    const float* spot_cone_theta() const {
+        return spot_cone_theta_.data();
+    }
+
+    /**
+     * \brief   Cosine of spot_cone_theta, cached for the cone test.
+     */
+    const float* spot_cone_cos() const {
+        return spot_cone_cos_.data();
+    }
+
+private :
+    vector3_soaF        positions_;
+    vector3_soaF        directions_;
+    vector3_soaF        attenuation_;
+    std::vector<float>  max_range_;
+    std::vector<float>  spot_power_;
+    std::vector<float>  spot_cone_theta_;
+    std::vector<float>  spot_cone_cos_;
+};
+
+/**
+ * \brief   Range culling. in_range[p * light_count() + l] is set to 1 if
+ *          points[p] is within max_range of light l, 0 otherwise.
+ */
+void light_range_cull(
+    const light_set& lights,
+    const vector3_soaF& points,
+    uint8_t* in_range,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Distance attenuation, 1 / (a0 + a1 * d + a2 * d^2), where d is 
+ *          the distance from the point to the light. The range is not
+ *          taken into account.
+ */
+void light_distance_attenuation(
+    const light_set& lights,
+    const vector3_soaF& points,
+    float* attenuation,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Spot falloff, pow(max(cos_alpha, 0), spot_power) for the points
+ *          inside the cone (alpha <= spot_cone_theta, alpha being the angle
+ *          between the spot direction and the light to point vector), 
+ *          0 outside. Always 1 for point lights.
+ */
+void light_spot_falloff(
+    const light_set& lights,
+    const vector3_soaF& points,
+    float* falloff,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Combined light intensity, attenuation * spot falloff for the
+ *          points in range, 0 for the rest.
+ */
+void evaluate_lights(
+    const light_set& lights,
+    const vector3_soaF& points,
+    float* intensity,
+    unsigned int max_threads = 1
+    );
+
+} // namespace math
+} // namespace v8
@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "v8/math/matrix4X4.h"
+#include "v8/math/vector3_soa.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \brief   Number of vertices in a chunk, when skinning is split across
+ *          threads. A chunk of positions, normals, indices and weights 
+ *          (8 influences) stays under 64KB, so it fits in the L2 cache 
+ *          with the palette.
+ */
+const size_t kLinearBlendSkinningGrainSize = 512;
+
+/**
+ * \brief   Bones per vertex supported by skin_linear_blend(). Each value
+ *          has its own kernel.
+ */
+enum skinning_influences {
+    skinning_influences_1 = 1,
+    skinning_influences_2 = 2,
+    skinning_influences_4 = 4,
+    skinning_influences_8 = 8
+};
+
+/**
+ * \brief   Linear blend skinning, the position of a vertex is 
+ *          sum(w[k] * M[bone[k]]) * p. Vertex i is influenced by the bones
+ *          bone_indices[influences * i + k] with the weights
+ *          bone_weights[influences * i + k], k = 0..influences - 1. The
+ *          weights of a vertex should add up to 1, unused influences have
+ *          a weight of 0 (with any valid bone index).
+ * \param   palette_3X4         Skinning matrices, 12 floats per bone (the 
+ *                              first 3 rows, row major, see 
+ *                              make_transform_palette_3X4()).
+ * \param   influences          Bones per vertex.
+ * \param   positions           Bind pose positions.
+ * \param   normals             Bind pose normals, can be null. They are 
+ *                              multiplied with the blended 3X3 matrix and
+ *                              not renormalized.
+ * \param   skinned_positions   Receives the positions, resized to match.
+ *                              Must not be positions.
+ * \param   skinned_normals     Receives the normals, can be null if normals
+ *                              is null. Must not be normals.
+ * \param   max_threads         Maximum number of threads, 0 to use all the 
+ *                              hardware threads.
+ * \remarks When V8_SIMD_ENABLED is defined, the matrices are blended one 
+ *          row per register and the vertices are transformed 4 at a time.
+ */
+void skin_linear_blend(
+    const float* palette_3X4,
+    const uint16_t* bone_indices,
+    const float* bone_weights,
+    skinning_influences influences,
+    const vector3_soaF& positions,
+    const vector3_soaF* normals,
+    vector3_soaF* skinned_positions,
+    vector3_soaF* skinned_normals,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Same as above, with a palette of matrix_4X4F objects (the last
+ *          row is ignored).
+ */
+void skin_linear_blend(
+    const matrix_4X4F* palette,
+    const uint16_t* bone_indices,
+    const float* bone_weights,
+    skinning_influences influences,
+    const vector3_soaF& positions,
+    const vector3_soaF* normals,
+    vector3_soaF* skinned_positions,
+    vector3_soaF* skinned_normals,
+    unsigned int max_threads = 1
+    );
+
+} // namespace math
+} // namespace v8
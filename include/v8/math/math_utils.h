@@ -26,10 +26,34 @@
 
 #pragma once
 
+#include <cmath>
+#include <cstddef>
+#include "v8/base/compiler_quirks.h"
 #include "v8/base/fundamental_types.h"
 #include "v8/math/math_constants.h"
 
-namespace v8 { namespace math { namespace internals {
+namespace v8 { namespace math { 
+
+/**
+ * \brief   Selects the precision/speed trade-off of the reciprocal square root
+ *          functions (inv_sqrt(), normalize<policy>(), etc).
+ *          precision_exact     1 / sqrt(x), correctly rounded.
+ *          precision_fast      Hardware estimate refined with one Newton-
+ *                              Raphson step, relative error below 1.0e-6 
+ *                              for float.
+ *          precision_estimate  Hardware estimate only (rsqrtps), relative
+ *                              error below 4.0e-4 for float.
+ * \remarks The estimates are only available for float, when V8_SIMD_ENABLED
+ *          is defined. Other types and non SIMD builds always compute the
+ *          exact value.
+ */
+enum precision_policy {
+    precision_exact,
+    precision_fast,
+    precision_estimate
+};
+
+namespace internals {
 
 template<typename real_type, bool is_floating_point = false>
 struct op_eq_helper {
@@ -124,6 +148,53 @@ inv_sqrt(real_t val) {
     return real_t(1) / sqrt(val);
 }
 
+namespace internals {
+
+/**
+ * \brief   Reciprocal square root kernels, for a precision policy. The 
+ *          float version is specialized in math_utils_sse.inl.
+ */
+template<precision_policy policy, typename real_t>
+struct inv_sqrt_kernels {
+    static real_t eval(real_t val) {
+        return real_t(1) / std::sqrt(val);
+    }
+
+    static void eval(const real_t* input, real_t* output, size_t count) {
+        for (size_t i = 0; i < count; ++i)
+            output[i] = real_t(1) / std::sqrt(input[i]);
+    }
+};
+
+} // namespace internals
+
+/**
+ * \brief   Computes 1 / sqrt(val), with the specified precision.
+ *          Usage : inv_sqrt<precision_fast>(x).
+ */
+template<precision_policy policy, typename real_t>
+inline
+real_t
+inv_sqrt(real_t val) {
+    return internals::inv_sqrt_kernels<policy, real_t>::eval(val);
+}
+
+/**
+ * \brief   Computes output[i] = 1 / sqrt(input[i]), with the specified 
+ *          precision. output can be the same as input.
+ */
+template<precision_policy policy, typename real_t>
+inline
+void
+inv_sqrt(
+    const real_t* input, 
+    real_t* output, 
+    size_t count
+    ) 
+{
+    internals::inv_sqrt_kernels<policy, real_t>::eval(input, output, count);
+}
+
 template<typename T>
 inline T clamp(const T& val, const T& min, const T& max) {
   return (val <= min ? min : (val >= max ? max : val));
@@ -147,4 +218,8 @@ inline void swap(ty& left, ty& right) {
 }
 
 } // namespace math
-} // namespace v8
\ No newline at end of file
+} // namespace v8
+
+#if defined(V8_SIMD_ENABLED)
+#include "math_utils_sse.inl"
+#endif
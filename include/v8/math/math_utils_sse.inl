@@ -0,0 +1,58 @@
+#include <xmmintrin.h>
+
+namespace v8 { namespace math { namespace sse {
+
+/**
+ * \brief   Computes 1 / sqrt(v) for every element, with the specified 
+ *          precision (see precision_policy).
+ */
+template<precision_policy policy>
+inline __m128 inv_sqrt(__m128 v);
+
+template<>
+inline __m128 inv_sqrt<precision_exact>(__m128 v) {
+    return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(v));
+}
+
+template<>
+inline __m128 inv_sqrt<precision_fast>(__m128 v) {
+    //
+    // y = y0 * (1.5 - 0.5 * v * y0 * y0)
+    const __m128 y0 = _mm_rsqrt_ps(v);
+    const __m128 half_v_y0 = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), v), y0);
+    return _mm_mul_ps(y0, _mm_sub_ps(_mm_set1_ps(1.5f), 
+                                     _mm_mul_ps(half_v_y0, y0)));
+}
+
+template<>
+inline __m128 inv_sqrt<precision_estimate>(__m128 v) {
+    return _mm_rsqrt_ps(v);
+}
+
+} // namespace sse
+
+namespace internals {
+
+/**
+ * \brief   SSE reciprocal square root kernels for float.
+ */
+template<precision_policy policy>
+struct inv_sqrt_kernels<policy, float> {
+    static float eval(float val) {
+        return _mm_cvtss_f32(sse::inv_sqrt<policy>(_mm_set_ss(val)));
+    }
+
+    static void eval(const float* input, float* output, size_t count) {
+        const size_t simd_count = count & ~size_t(3);
+        for (size_t i = 0; i < simd_count; i += 4)
+            _mm_storeu_ps(output + i, 
+                          sse::inv_sqrt<policy>(_mm_loadu_ps(input + i)));
+
+        for (size_t i = simd_count; i < count; ++i)
+            output[i] = eval(input[i]);
+    }
+};
+
+} // namespace internals
+} // namespace math
+} // namespace v8
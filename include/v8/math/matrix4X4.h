@@ -30,6 +30,7 @@
 #include <cassert>
 #include <cmath>
 #include "v8/base/fundamental_types.h"
+#include "v8/base/compiler_quirks.h"
 #include "v8/base/compiler_warnings.h"
 #include "v8/math/math_utils.h"
 #include "v8/math/matrix3X3.h"
@@ -238,8 +239,44 @@ public :
      */
     matrix_4X4<real_t>& invert();
 
+    /**
+     * \fn    void matrix4X4::get_inverse(matrix4X4* mx) const
+     *
+     * \brief Computes the inverse of this matrix, without modifying it.
+     * \remarks Only call this function if is_invertible() returns true.
+     *          When V8_SIMD_ENABLED is defined, there is a specialization for
+     *          matrix_4X4<float> that uses SSE (Cramer's rule).
+     *
+     * \param [in,out]    mx  Receives the inverse. Can be this matrix.
+     */
     inline void get_inverse(math::matrix_4X4<real_t>* mx) const;
 
+    /**
+     * \fn    matrix4X4& matrix4X4::invert_affine()
+     *
+     * \brief Inverts a matrix that represents an affine transformation
+     *        (the last row is (0, 0, 0, 1)). Only the upper 3x3 part is
+     *        inverted, the translation is obtained as -inv(M3x3) * T.
+     *        This is much cheaper than invert().
+     * \remarks The upper 3x3 part must be invertible.
+     *
+     * \return    Reference to the matrix object.
+     */
+    matrix_4X4<real_t>& invert_affine() {
+        get_inverse_affine(this);
+        return *this;
+    }
+
+    /**
+     * \fn    void matrix4X4::get_inverse_affine(matrix4X4* mx) const
+     *
+     * \brief Computes the inverse of an affine transformation matrix.
+     * \see   invert_affine()
+     *
+     * \param [in,out]    mx  Receives the inverse. Can be this matrix.
+     */
+    void get_inverse_affine(math::matrix_4X4<real_t>* mx) const;
+
     /**
      * \fn    matrix4X4& matrix4X4::transpose()
      *
@@ -620,10 +657,43 @@ operator-(
     const math::matrix_4X4<real_t>& mtx
     );
 
+namespace internals {
+
+/**
+ * \brief   Generic (scalar) matrix multiplication, res = lhs * rhs.
+ * \remarks res must not alias lhs or rhs.
+ */
+template<typename real_t>
+inline
+void
+matrix4X4_multiply(
+    const math::matrix_4X4<real_t>& lhs,
+    const math::matrix_4X4<real_t>& rhs,
+    math::matrix_4X4<real_t>* res
+    );
+
+/**
+ * \brief   Generic (scalar) matrix inversion, computes the adjoint and
+ *          divides it by the determinant.
+ * \remarks res must not alias mtx. mtx must be invertible.
+ */
+template<typename real_t>
+inline
+void
+matrix4X4_inverse(
+    const math::matrix_4X4<real_t>& mtx,
+    math::matrix_4X4<real_t>* res
+    );
+
+} // namespace internals
+
 /**
  * \fn  matrix4X4 operator*( const math::matrix4X4& lhs, const math::matrix4X4& rhs );
  *
  * \brief   Multiplication operator.
+ * \remarks When V8_SIMD_ENABLED is defined, there is a specialization for
+ *          matrix_4X4<float> that uses SSE/AVX row broadcasts. It performs the
+ *          same operations, in the same order, as the generic version.
  */
 template<typename real_t>
 matrix_4X4<real_t>
@@ -679,3 +749,7 @@ typedef matrix_4X4<double>   matrix_4X4D;
 } // namespace v8
 
 #include "matrix4X4.inl"
+
+#if defined(V8_SIMD_ENABLED)
+#include "matrix4X4_sse.inl"
+#endif
@@ -145,7 +145,7 @@ v8::math::matrix_4X4<real_t>::determinant() const {
     const real_t l3 = a32_ * a43_ - a33_ * a42_;
 
     const real_t k4 = a12_ * a23_ - a13_ * a22_;
-    const real_t l4 = a31_ * a44_ - a43_ * a41_;
+    const real_t l4 = a31_ * a44_ - a34_ * a41_;
 
     const real_t k5 = a12_ * a24_ - a14_ * a22_;
     const real_t l5 = a31_ * a43_ - a33_ * a41_;
@@ -159,13 +159,9 @@ v8::math::matrix_4X4<real_t>::determinant() const {
 template<typename real_t>
 v8::math::matrix_4X4<real_t>&
 v8::math::matrix_4X4<real_t>::invert() {
-    const real_t kDetValue = determinant();
-    assert(!math::operands_eq(real_t(0), kDetValue));
-
-    matrix4X4_t adjoint;
-    get_adjoint(&adjoint);
-    adjoint /= kDetValue;
-    std::memcpy(elements_, adjoint.elements_, _countof(elements_) * sizeof(real_t));
+    matrix4X4_t inverse;
+    get_inverse(&inverse);
+    std::memcpy(elements_, inverse.elements_, _countof(elements_) * sizeof(real_t));
     return *this;
 }
 
@@ -237,11 +233,59 @@ void v8::math::matrix_4X4<real_t>::get_adjoint(v8::math::matrix_4X4<real_t>* mx)
 template<typename real_t>
 inline 
 void v8::math::matrix_4X4<real_t>::get_inverse(v8::math::matrix_4X4<real_t>* mx) const {
-    const real_t det = determinant();
+    if (mx != this) {
+        internals::matrix4X4_inverse(*this, mx);
+        return;
+    }
+
+    matrix4X4_t inverse;
+    internals::matrix4X4_inverse(*this, &inverse);
+    *mx = inverse;
+}
+
+template<typename real_t>
+void 
+v8::math::matrix_4X4<real_t>::get_inverse_affine(
+    v8::math::matrix_4X4<real_t>* mx
+    ) const 
+{
+    //
+    // inv(M) = | inv(R)  -inv(R) * T |
+    //          |   0           1     |
+    // inv(R) is computed from the cofactors of the upper 3x3 part.
+    const real_t c11 = a22_ * a33_ - a23_ * a32_;
+    const real_t c12 = a23_ * a31_ - a21_ * a33_;
+    const real_t c13 = a21_ * a32_ - a22_ * a31_;
+
+    const real_t det = a11_ * c11 + a12_ * c12 + a13_ * c13;
     assert(!math::operands_eq(real_t(0), det));
+    const real_t inv_det = real_t(1) / det;
+
+    const real_t r11 = c11 * inv_det;
+    const real_t r12 = (a13_ * a32_ - a12_ * a33_) * inv_det;
+    const real_t r13 = (a12_ * a23_ - a13_ * a22_) * inv_det;
+    const real_t r21 = c12 * inv_det;
+    const real_t r22 = (a11_ * a33_ - a13_ * a31_) * inv_det;
+    const real_t r23 = (a13_ * a21_ - a11_ * a23_) * inv_det;
+    const real_t r31 = c13 * inv_det;
+    const real_t r32 = (a12_ * a31_ - a11_ * a32_) * inv_det;
+    const real_t r33 = (a11_ * a22_ - a12_ * a21_) * inv_det;
+
+    const real_t tx = a14_;
+    const real_t ty = a24_;
+    const real_t tz = a34_;
+
+    mx->a11_ = r11; mx->a12_ = r12; mx->a13_ = r13; 
+    mx->a14_ = -(r11 * tx + r12 * ty + r13 * tz);
 
-    get_adjoint(mx);
-    *mx /= det;
+    mx->a21_ = r21; mx->a22_ = r22; mx->a23_ = r23;
+    mx->a24_ = -(r21 * tx + r22 * ty + r23 * tz);
+
+    mx->a31_ = r31; mx->a32_ = r32; mx->a33_ = r33;
+    mx->a34_ = -(r31 * tx + r32 * ty + r33 * tz);
+
+    mx->a41_ = mx->a42_ = mx->a43_ = real_t(0);
+    mx->a44_ = real_t(1);
 }
 
 template<typename real_t>
@@ -334,9 +378,13 @@ v8::math::matrix_4X4<Real_Ty>::transform_affine_vector(
     v8::math::vector3<Real_Ty2>* pvec
     ) const
 {
-    pvec->x_ = a11_ * pvec->x_ + a12_ * pvec->y_ + a13_ * pvec->z_;
-    pvec->y_ = a21_ * pvec->x_ + a22_ * pvec->y_ + a23_ * pvec->z_;
-    pvec->z_ = a31_ * pvec->x_ + a32_ * pvec->y_ + a33_ * pvec->z_;
+    const Real_Ty2 x = pvec->x_;
+    const Real_Ty2 y = pvec->y_;
+    const Real_Ty2 z = pvec->z_;
+
+    pvec->x_ = a11_ * x + a12_ * y + a13_ * z;
+    pvec->y_ = a21_ * x + a22_ * y + a23_ * z;
+    pvec->z_ = a31_ * x + a32_ * y + a33_ * z;
     return *this;
 }
 
@@ -347,9 +395,13 @@ v8::math::matrix_4X4<Real_Ty>::transform_affine_point(
     v8::math::vector3<Real_Ty2>* point
     ) const
 {
-    point->x_ = a11_ * point->x_ + a12_ * point->y_ + a13_ * point->z_ + a14_;
-    point->y_ = a21_ * point->x_ + a22_ * point->y_ + a23_ * point->z_ + a24_;
-    point->z_ = a31_ * point->x_ + a32_ * point->y_ + a33_ * point->z_ + a34_;
+    const Real_Ty2 x = point->x_;
+    const Real_Ty2 y = point->y_;
+    const Real_Ty2 z = point->z_;
+
+    point->x_ = a11_ * x + a12_ * y + a13_ * z + a14_;
+    point->y_ = a21_ * x + a22_ * y + a23_ * z + a24_;
+    point->z_ = a31_ * x + a32_ * y + a33_ * z + a34_;
     return *this;
 }
 
@@ -359,9 +411,13 @@ v8::math::matrix_4X4<real_t>::transform_affine_vector(
     v8::math::vector4<real_t>* pvec
     ) const
 {
-    pvec->x_ = a11_ * pvec->x_ + a12_ * pvec->y_ + a13_ * pvec->z_;
-    pvec->y_ = a21_ * pvec->x_ + a22_ * pvec->y_ + a23_ * pvec->z_;
-    pvec->z_ = a31_ * pvec->x_ + a32_ * pvec->y_ + a33_ * pvec->z_;
+    const real_t x = pvec->x_;
+    const real_t y = pvec->y_;
+    const real_t z = pvec->z_;
+
+    pvec->x_ = a11_ * x + a12_ * y + a13_ * z;
+    pvec->y_ = a21_ * x + a22_ * y + a23_ * z;
+    pvec->z_ = a31_ * x + a32_ * y + a33_ * z;
 
     return *this;
 }
@@ -372,9 +428,13 @@ v8::math::matrix_4X4<real_t>::transform_affine_point(
     v8::math::vector4<real_t>* apt
     ) const
 {
-    apt->x_ = a11_ * apt->x_ + a12_ * apt->y_ + a13_ * apt->z_ + a14_;
-    apt->y_ = a21_ * apt->x_ + a22_ * apt->y_ + a23_ * apt->z_ + a24_;
-    apt->z_ = a31_ * apt->x_ + a32_ * apt->y_ + a33_ * apt->z_ + a34_;
+    const real_t x = apt->x_;
+    const real_t y = apt->y_;
+    const real_t z = apt->z_;
+
+    apt->x_ = a11_ * x + a12_ * y + a13_ * z + a14_;
+    apt->y_ = a21_ * x + a22_ * y + a23_ * z + a24_;
+    apt->z_ = a31_ * x + a32_ * y + a33_ * z + a34_;
 
     return *this;
 }
@@ -385,10 +445,15 @@ v8::math::matrix_4X4<real_t>::transform_homogeneous_point(
     v8::math::vector4<real_t>* hpt
     ) const
 {
-    hpt->x_ = a11_ * hpt->x_ + a12_ * hpt->y_ + a13_ * hpt->z_ + a14_ * hpt->w_;
-    hpt->y_ = a21_ * hpt->x_ + a22_ * hpt->y_ + a23_ * hpt->z_ + a24_ * hpt->w_;
-    hpt->z_ = a31_ * hpt->x_ + a32_ * hpt->y_ + a33_ * hpt->z_ + a34_ * hpt->w_;
-    hpt->w_ = a41_ * hpt->x_ + a42_ * hpt->y_ + a43_ * hpt->z_ + a44_ * hpt->w_;
+    const real_t x = hpt->x_;
+    const real_t y = hpt->y_;
+    const real_t z = hpt->z_;
+    const real_t w = hpt->w_;
+
+    hpt->x_ = a11_ * x + a12_ * y + a13_ * z + a14_ * w;
+    hpt->y_ = a21_ * x + a22_ * y + a23_ * z + a24_ * w;
+    hpt->z_ = a31_ * x + a32_ * y + a33_ * z + a34_ * w;
+    hpt->w_ = a41_ * x + a42_ * y + a43_ * z + a44_ * w;
 
     return *this;
 }
@@ -461,49 +526,78 @@ v8::math::operator-(
 }
 
 template<typename real_t>
-v8::math::matrix_4X4<real_t>
-v8::math::operator*(
+inline
+void
+v8::math::internals::matrix4X4_multiply(
     const v8::math::matrix_4X4<real_t>& lhs,
-    const v8::math::matrix_4X4<real_t>& rhs
+    const v8::math::matrix_4X4<real_t>& rhs,
+    v8::math::matrix_4X4<real_t>* res
     )
 {
-    v8::math::matrix_4X4<real_t> res;
-    res.a11_ = lhs.a11_ * rhs.a11_ + lhs.a12_ * rhs.a21_ 
+    res->a11_ = lhs.a11_ * rhs.a11_ + lhs.a12_ * rhs.a21_ 
         + lhs.a13_ * rhs.a31_ + lhs.a14_ * rhs.a41_;
-    res.a12_ = lhs.a11_ * rhs.a12_ + lhs.a12_ * rhs.a22_ 
+    res->a12_ = lhs.a11_ * rhs.a12_ + lhs.a12_ * rhs.a22_ 
         + lhs.a13_ * rhs.a32_ + lhs.a14_ * rhs.a42_;
-    res.a13_ = lhs.a11_ * rhs.a13_ + lhs.a12_ * rhs.a23_ 
+    res->a13_ = lhs.a11_ * rhs.a13_ + lhs.a12_ * rhs.a23_ 
         + lhs.a13_ * rhs.a33_ + lhs.a14_ * rhs.a43_;
-    res.a14_ = lhs.a11_ * rhs.a14_ + lhs.a12_ * rhs.a24_ 
+    res->a14_ = lhs.a11_ * rhs.a14_ + lhs.a12_ * rhs.a24_ 
         + lhs.a13_ * rhs.a34_ + lhs.a14_ * rhs.a44_;
 
-    res.a21_ = lhs.a21_ * rhs.a11_ + lhs.a22_ * rhs.a21_ 
+    res->a21_ = lhs.a21_ * rhs.a11_ + lhs.a22_ * rhs.a21_ 
         + lhs.a23_ * rhs.a31_ + lhs.a24_ * rhs.a41_;
-    res.a22_ = lhs.a21_ * rhs.a12_ + lhs.a22_ * rhs.a22_ 
+    res->a22_ = lhs.a21_ * rhs.a12_ + lhs.a22_ * rhs.a22_ 
         + lhs.a23_ * rhs.a32_ + lhs.a24_ * rhs.a42_;
-    res.a23_ = lhs.a21_ * rhs.a13_ + lhs.a22_ * rhs.a23_ 
+    res->a23_ = lhs.a21_ * rhs.a13_ + lhs.a22_ * rhs.a23_ 
         + lhs.a23_ * rhs.a33_ + lhs.a24_ * rhs.a43_;
-    res.a24_ = lhs.a21_ * rhs.a14_ + lhs.a22_ * rhs.a24_ 
+    res->a24_ = lhs.a21_ * rhs.a14_ + lhs.a22_ * rhs.a24_ 
         + lhs.a23_ * rhs.a34_ + lhs.a24_ * rhs.a44_;
 
-    res.a31_ = lhs.a31_ * rhs.a11_ + lhs.a32_ * rhs.a21_ 
+    res->a31_ = lhs.a31_ * rhs.a11_ + lhs.a32_ * rhs.a21_ 
         + lhs.a33_ * rhs.a31_ + lhs.a34_ * rhs.a41_;
-    res.a32_ = lhs.a31_ * rhs.a12_ + lhs.a32_ * rhs.a22_ 
+    res->a32_ = lhs.a31_ * rhs.a12_ + lhs.a32_ * rhs.a22_ 
         + lhs.a33_ * rhs.a32_ + lhs.a34_ * rhs.a42_;
-    res.a33_ = lhs.a31_ * rhs.a13_ + lhs.a32_ * rhs.a23_ 
+    res->a33_ = lhs.a31_ * rhs.a13_ + lhs.a32_ * rhs.a23_ 
         + lhs.a33_ * rhs.a33_ + lhs.a34_ * rhs.a43_;
-    res.a34_ = lhs.a31_ * rhs.a14_ + lhs.a32_ * rhs.a24_ 
+    res->a34_ = lhs.a31_ * rhs.a14_ + lhs.a32_ * rhs.a24_ 
         + lhs.a33_ * rhs.a34_ + lhs.a34_ * rhs.a44_;
 
-    res.a41_ = lhs.a41_ * rhs.a11_ + lhs.a42_ * rhs.a21_ 
+    res->a41_ = lhs.a41_ * rhs.a11_ + lhs.a42_ * rhs.a21_ 
         + lhs.a43_ * rhs.a31_ + lhs.a44_ * rhs.a41_;
-    res.a42_ = lhs.a41_ * rhs.a12_ + lhs.a42_ * rhs.a22_ 
+    res->a42_ = lhs.a41_ * rhs.a12_ + lhs.a42_ * rhs.a22_ 
         + lhs.a43_ * rhs.a32_ + lhs.a44_ * rhs.a42_;
-    res.a43_ = lhs.a41_ * rhs.a13_ + lhs.a42_ * rhs.a23_ 
+    res->a43_ = lhs.a41_ * rhs.a13_ + lhs.a42_ * rhs.a23_ 
         + lhs.a43_ * rhs.a33_ + lhs.a44_ * rhs.a43_;
-    res.a44_ = lhs.a41_ * rhs.a14_ + lhs.a42_ * rhs.a24_ 
+    res->a44_ = lhs.a41_ * rhs.a14_ + lhs.a42_ * rhs.a24_ 
         + lhs.a43_ * rhs.a34_ + lhs.a44_ * rhs.a44_;
+}
 
+template<typename real_t>
+inline
+void
+v8::math::internals::matrix4X4_inverse(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    v8::math::matrix_4X4<real_t>* res
+    )
+{
+    mtx.get_adjoint(res);
+    //
+    // Expanding along the first row of mtx reuses the cofactors from the
+    // first column of the adjoint.
+    const real_t det = mtx.a11_ * res->a11_ + mtx.a12_ * res->a21_ 
+        + mtx.a13_ * res->a31_ + mtx.a14_ * res->a41_;
+    assert(!math::operands_eq(real_t(0), det));
+    *res /= det;
+}
+
+template<typename real_t>
+v8::math::matrix_4X4<real_t>
+v8::math::operator*(
+    const v8::math::matrix_4X4<real_t>& lhs,
+    const v8::math::matrix_4X4<real_t>& rhs
+    )
+{
+    v8::math::matrix_4X4<real_t> res;
+    internals::matrix4X4_multiply(lhs, rhs, &res);
     return res;
 }
 
@@ -0,0 +1,375 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include "v8/base/compiler_quirks.h"
+#include "v8/base/cpu_features.h"
+#include "v8/base/parallel_for.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector4.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \file    matrix4X4_batch.h
+ *
+ * \brief   Array versions of matrix_4X4::transform_affine_point(),
+ *          matrix_4X4::transform_affine_vector() and
+ *          matrix_4X4::transform_homogeneous_point().
+ *          Inputs can be arrays of vector3/vector4 objects (AoS), arrays of
+ *          elements separated by a fixed number of bytes (strided, like the
+ *          position member of a vertex) or separate arrays for the x, y, z
+ *          components (SoA). The output array may be the same as the input
+ *          array (in place transform), but the arrays must not partially
+ *          overlap.
+ *          For real_t = float, the kernels are selected at runtime, based on
+ *          the SIMD support of the processor (see base::host_simd_tier()).
+ *          The SSE kernels process 4 elements at a time, the AVX/AVX2 ones 8
+ *          at a time. The AVX2 kernels use FMA, so their results can differ
+ *          from the scalar ones in the last bits.
+ *          Every function takes an optional max_threads parameter. When it
+ *          is different than 1, large arrays are split into chunks that are
+ *          transformed in parallel (0 means use all the hardware threads).
+ */
+
+/**
+ * \brief   Minimum number of elements in a chunk, when splitting a batch
+ *          transform across threads.
+ */
+const size_t kBatchTransformGrainSize = 4096;
+
+namespace internals {
+
+/**
+ * \brief   Scalar kernels for the batch transform functions.
+ */
+template<typename real_t>
+struct batch_transform_scalar_kernels {
+    template<bool is_point>
+    static void affine_aos(
+        const matrix_4X4<real_t>& mtx,
+        const vector3<real_t>* input,
+        vector3<real_t>* output,
+        size_t count
+        );
+
+    template<bool is_point>
+    static void affine_strided(
+        const matrix_4X4<real_t>& mtx,
+        const unsigned char* input,
+        size_t input_stride,
+        unsigned char* output,
+        size_t output_stride,
+        size_t count
+        );
+
+    template<bool is_point>
+    static void affine_soa(
+        const matrix_4X4<real_t>& mtx,
+        const real_t* x_in,
+        const real_t* y_in,
+        const real_t* z_in,
+        real_t* x_out,
+        real_t* y_out,
+        real_t* z_out,
+        size_t count
+        );
+
+    static void homogeneous_aos(
+        const matrix_4X4<real_t>& mtx,
+        const vector4<real_t>* input,
+        vector4<real_t>* output,
+        size_t count
+        );
+};
+
+/**
+ * \brief   Kernels used by the batch transform functions. The float version
+ *          is specialized in matrix4X4_batch.inl, it uses the kernels from
+ *          batch_transform_kernels_for_host().
+ */
+template<typename real_t>
+struct batch_transform_kernels : public batch_transform_scalar_kernels<real_t> {};
+
+/**
+ * \brief   Table of batch transform kernels for float, for one SIMD tier.
+ */
+struct batch_transform_kernel_table {
+    typedef void (*affine_aos_fn)(
+        const matrix_4X4<float>& mtx,
+        const vector3<float>* input,
+        vector3<float>* output,
+        size_t count
+        );
+
+    typedef void (*affine_soa_fn)(
+        const matrix_4X4<float>& mtx,
+        const float* x_in,
+        const float* y_in,
+        const float* z_in,
+        float* x_out,
+        float* y_out,
+        float* z_out,
+        size_t count
+        );
+
+    typedef void (*homogeneous_aos_fn)(
+        const matrix_4X4<float>& mtx,
+        const vector4<float>* input,
+        vector4<float>* output,
+        size_t count
+        );
+
+    /// Tier of the kernels in this table.
+    base::simd_tier     tier;
+    affine_aos_fn       affine_points_aos;
+    affine_aos_fn       affine_vectors_aos;
+    affine_soa_fn       affine_points_soa;
+    affine_soa_fn       affine_vectors_soa;
+    homogeneous_aos_fn  homogeneous_aos;
+};
+
+/**
+ * \brief   Returns the kernels for the given tier. If the tier has no
+ *          dedicated kernels, the table for the closest lower tier is
+ *          returned (check the tier member).
+ * \remarks Defined in lib/math. Passing a tier higher than 
+ *          base::host_simd_tier() is not allowed.
+ */
+const batch_transform_kernel_table&
+batch_transform_kernels_for_tier(base::simd_tier tier);
+
+/**
+ * \brief   Returns the kernels for base::host_simd_tier(). The table is
+ *          selected on the first call.
+ */
+const batch_transform_kernel_table&
+batch_transform_kernels_for_host();
+
+} // namespace internals
+
+/**
+ * \brief   Transforms an array of affine points (w = 1), output[i] = mtx * input[i].
+ */
+template<typename real_t>
+void
+transform_affine_points(
+    const math::matrix_4X4<real_t>& mtx,
+    const math::vector3<real_t>* input,
+    math::vector3<real_t>* output,
+    size_t count,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Transforms an array of affine points (w = 1), in place.
+ */
+template<typename real_t>
+inline
+void
+transform_affine_points(
+    const math::matrix_4X4<real_t>& mtx,
+    math::vector3<real_t>* points,
+    size_t count,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Transforms an array of affine vectors (w = 0), 
+ *          output[i] = mtx * input[i].
+ */
+template<typename real_t>
+void
+transform_affine_vectors(
+    const math::matrix_4X4<real_t>& mtx,
+    const math::vector3<real_t>* input,
+    math::vector3<real_t>* output,
+    size_t count,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Transforms an array of affine vectors (w = 0), in place.
+ */
+template<typename real_t>
+inline
+void
+transform_affine_vectors(
+    const math::matrix_4X4<real_t>& mtx,
+    math::vector3<real_t>* vectors,
+    size_t count,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Transforms an array of homogeneous points, 
+ *          output[i] = mtx * input[i].
+ */
+template<typename real_t>
+void
+transform_homogeneous_points(
+    const math::matrix_4X4<real_t>& mtx,
+    const math::vector4<real_t>* input,
+    math::vector4<real_t>* output,
+    size_t count,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Transforms an array of homogeneous points, in place.
+ */
+template<typename real_t>
+inline
+void
+transform_homogeneous_points(
+    const math::matrix_4X4<real_t>& mtx,
+    math::vector4<real_t>* points,
+    size_t count,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Transforms affine points stored in an interleaved array. 
+ * \param   input           Address of the first point. Every point is made
+ *                          of 3 consecutive real_t values.
+ * \param   input_stride    Distance, in bytes, between two consecutive points.
+ * \param   output          Address of the first output point.
+ * \param   output_stride   Distance, in bytes, between two consecutive output
+ *                          points.
+ * \param   count           Number of points.
+ */
+template<typename real_t>
+void
+transform_affine_points_strided(
+    const math::matrix_4X4<real_t>& mtx,
+    const void* input,
+    size_t input_stride,
+    void* output,
+    size_t output_stride,
+    size_t count,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Transforms affine vectors stored in an interleaved array.
+ * \see     transform_affine_points_strided()
+ */
+template<typename real_t>
+void
+transform_affine_vectors_strided(
+    const math::matrix_4X4<real_t>& mtx,
+    const void* input,
+    size_t input_stride,
+    void* output,
+    size_t output_stride,
+    size_t count,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Transforms affine points stored as separate x, y, z arrays.
+ *          The output arrays may be the same as the input arrays.
+ */
+template<typename real_t>
+void
+transform_affine_points_soa(
+    const math::matrix_4X4<real_t>& mtx,
+    const real_t* x_in,
+    const real_t* y_in,
+    const real_t* z_in,
+    real_t* x_out,
+    real_t* y_out,
+    real_t* z_out,
+    size_t count,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Transforms affine vectors stored as separate x, y, z arrays.
+ *          The output arrays may be the same as the input arrays.
+ */
+template<typename real_t>
+void
+transform_affine_vectors_soa(
+    const math::matrix_4X4<real_t>& mtx,
+    const real_t* x_in,
+    const real_t* y_in,
+    const real_t* z_in,
+    real_t* x_out,
+    real_t* y_out,
+    real_t* z_out,
+    size_t count,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Inverts an array of matrices, output[i] = inverse(input[i]).
+ *          Uses matrix_4X4::get_inverse(), so the float version runs the
+ *          SSE kernel when V8_SIMD_ENABLED is defined.
+ * \remarks All the matrices must be invertible. output may be the same
+ *          array as input.
+ */
+template<typename real_t>
+void
+invert_matrices(
+    const math::matrix_4X4<real_t>* input,
+    math::matrix_4X4<real_t>* output,
+    size_t count,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Inverts an array of affine transformation matrices
+ *          (last row is (0, 0, 0, 1)), output[i] = inverse(input[i]).
+ * \see     matrix_4X4::invert_affine()
+ * \remarks output may be the same array as input.
+ */
+template<typename real_t>
+void
+invert_affine_matrices(
+    const math::matrix_4X4<real_t>* input,
+    math::matrix_4X4<real_t>* output,
+    size_t count,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Minimum number of matrices in a chunk, when splitting a batch
+ *          inversion across threads.
+ */
+const size_t kBatchInverseGrainSize = 1024;
+
+} // namespace math
+} // namespace v8
+
+#if defined(V8_SIMD_ENABLED)
+#include "matrix4X4_batch_sse.inl"
+#endif
+
+#include "matrix4X4_batch.inl"
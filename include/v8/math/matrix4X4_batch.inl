@@ -0,0 +1,401 @@
+template<typename real_t>
+template<bool is_point>
+void
+v8::math::internals::batch_transform_scalar_kernels<real_t>::affine_aos(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    const v8::math::vector3<real_t>* input,
+    v8::math::vector3<real_t>* output,
+    size_t count
+    )
+{
+    const real_t tx = is_point ? mtx.a14_ : real_t(0);
+    const real_t ty = is_point ? mtx.a24_ : real_t(0);
+    const real_t tz = is_point ? mtx.a34_ : real_t(0);
+
+    for (size_t i = 0; i < count; ++i) {
+        const real_t x = input[i].x_;
+        const real_t y = input[i].y_;
+        const real_t z = input[i].z_;
+
+        output[i].x_ = mtx.a11_ * x + mtx.a12_ * y + mtx.a13_ * z + tx;
+        output[i].y_ = mtx.a21_ * x + mtx.a22_ * y + mtx.a23_ * z + ty;
+        output[i].z_ = mtx.a31_ * x + mtx.a32_ * y + mtx.a33_ * z + tz;
+    }
+}
+
+template<typename real_t>
+template<bool is_point>
+void
+v8::math::internals::batch_transform_scalar_kernels<real_t>::affine_strided(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    const unsigned char* input,
+    size_t input_stride,
+    unsigned char* output,
+    size_t output_stride,
+    size_t count
+    )
+{
+    const real_t tx = is_point ? mtx.a14_ : real_t(0);
+    const real_t ty = is_point ? mtx.a24_ : real_t(0);
+    const real_t tz = is_point ? mtx.a34_ : real_t(0);
+
+    for (size_t i = 0; i < count; ++i) {
+        const real_t* src = reinterpret_cast<const real_t*>(
+            input + i * input_stride);
+        real_t* dst = reinterpret_cast<real_t*>(output + i * output_stride);
+
+        const real_t x = src[0];
+        const real_t y = src[1];
+        const real_t z = src[2];
+
+        dst[0] = mtx.a11_ * x + mtx.a12_ * y + mtx.a13_ * z + tx;
+        dst[1] = mtx.a21_ * x + mtx.a22_ * y + mtx.a23_ * z + ty;
+        dst[2] = mtx.a31_ * x + mtx.a32_ * y + mtx.a33_ * z + tz;
+    }
+}
+
+template<typename real_t>
+template<bool is_point>
+void
+v8::math::internals::batch_transform_scalar_kernels<real_t>::affine_soa(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    const real_t* x_in,
+    const real_t* y_in,
+    const real_t* z_in,
+    real_t* x_out,
+    real_t* y_out,
+    real_t* z_out,
+    size_t count
+    )
+{
+    const real_t tx = is_point ? mtx.a14_ : real_t(0);
+    const real_t ty = is_point ? mtx.a24_ : real_t(0);
+    const real_t tz = is_point ? mtx.a34_ : real_t(0);
+
+    for (size_t i = 0; i < count; ++i) {
+        const real_t x = x_in[i];
+        const real_t y = y_in[i];
+        const real_t z = z_in[i];
+
+        x_out[i] = mtx.a11_ * x + mtx.a12_ * y + mtx.a13_ * z + tx;
+        y_out[i] = mtx.a21_ * x + mtx.a22_ * y + mtx.a23_ * z + ty;
+        z_out[i] = mtx.a31_ * x + mtx.a32_ * y + mtx.a33_ * z + tz;
+    }
+}
+
+template<typename real_t>
+void
+v8::math::internals::batch_transform_scalar_kernels<real_t>::homogeneous_aos(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    const v8::math::vector4<real_t>* input,
+    v8::math::vector4<real_t>* output,
+    size_t count
+    )
+{
+    for (size_t i = 0; i < count; ++i) {
+        const real_t x = input[i].x_;
+        const real_t y = input[i].y_;
+        const real_t z = input[i].z_;
+        const real_t w = input[i].w_;
+
+        output[i].x_ = mtx.a11_ * x + mtx.a12_ * y + mtx.a13_ * z + mtx.a14_ * w;
+        output[i].y_ = mtx.a21_ * x + mtx.a22_ * y + mtx.a23_ * z + mtx.a24_ * w;
+        output[i].z_ = mtx.a31_ * x + mtx.a32_ * y + mtx.a33_ * z + mtx.a34_ * w;
+        output[i].w_ = mtx.a41_ * x + mtx.a42_ * y + mtx.a43_ * z + mtx.a44_ * w;
+    }
+}
+
+namespace v8 { namespace math { namespace internals {
+
+/**
+ * \brief   Routes the float batch transforms through the kernel table
+ *          selected for the host processor. The strided kernels are not 
+ *          dispatched, they are limited by the gather/scatter anyway.
+ */
+template<>
+struct batch_transform_kernels<float> {
+    template<bool is_point>
+    static void affine_aos(
+        const matrix_4X4<float>& mtx,
+        const vector3<float>* input,
+        vector3<float>* output,
+        size_t count
+        )
+    {
+        const batch_transform_kernel_table& table = 
+            batch_transform_kernels_for_host();
+        (is_point ? table.affine_points_aos : table.affine_vectors_aos)(
+            mtx, input, output, count);
+    }
+
+    template<bool is_point>
+    static void affine_strided(
+        const matrix_4X4<float>& mtx,
+        const unsigned char* input,
+        size_t input_stride,
+        unsigned char* output,
+        size_t output_stride,
+        size_t count
+        )
+    {
+#if defined(V8_SIMD_ENABLED)
+        typedef batch_transform_sse_kernels kernels_t;
+#else
+        typedef batch_transform_scalar_kernels<float> kernels_t;
+#endif
+        kernels_t::template affine_strided<is_point>(
+            mtx, input, input_stride, output, output_stride, count);
+    }
+
+    template<bool is_point>
+    static void affine_soa(
+        const matrix_4X4<float>& mtx,
+        const float* x_in,
+        const float* y_in,
+        const float* z_in,
+        float* x_out,
+        float* y_out,
+        float* z_out,
+        size_t count
+        )
+    {
+        const batch_transform_kernel_table& table = 
+            batch_transform_kernels_for_host();
+        (is_point ? table.affine_points_soa : table.affine_vectors_soa)(
+            mtx, x_in, y_in, z_in, x_out, y_out, z_out, count);
+    }
+
+    static void homogeneous_aos(
+        const matrix_4X4<float>& mtx,
+        const vector4<float>* input,
+        vector4<float>* output,
+        size_t count
+        )
+    {
+        batch_transform_kernels_for_host().homogeneous_aos(
+            mtx, input, output, count);
+    }
+};
+
+} // namespace internals
+} // namespace math
+} // namespace v8
+
+template<typename real_t>
+void
+v8::math::transform_affine_points(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    const v8::math::vector3<real_t>* input,
+    v8::math::vector3<real_t>* output,
+    size_t count,
+    unsigned int max_threads
+    )
+{
+    typedef internals::batch_transform_kernels<real_t> kernels_t;
+    base::parallel_for(count, kBatchTransformGrainSize, max_threads,
+                       [&mtx, input, output](size_t first, size_t last) {
+        kernels_t::template affine_aos<true>(
+            mtx, input + first, output + first, last - first);
+    });
+}
+
+template<typename real_t>
+inline
+void
+v8::math::transform_affine_points(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    v8::math::vector3<real_t>* points,
+    size_t count,
+    unsigned int max_threads
+    )
+{
+    transform_affine_points(mtx, points, points, count, max_threads);
+}
+
+template<typename real_t>
+void
+v8::math::transform_affine_vectors(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    const v8::math::vector3<real_t>* input,
+    v8::math::vector3<real_t>* output,
+    size_t count,
+    unsigned int max_threads
+    )
+{
+    typedef internals::batch_transform_kernels<real_t> kernels_t;
+    base::parallel_for(count, kBatchTransformGrainSize, max_threads,
+                       [&mtx, input, output](size_t first, size_t last) {
+        kernels_t::template affine_aos<false>(
+            mtx, input + first, output + first, last - first);
+    });
+}
+
+template<typename real_t>
+inline
+void
+v8::math::transform_affine_vectors(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    v8::math::vector3<real_t>* vectors,
+    size_t count,
+    unsigned int max_threads
+    )
+{
+    transform_affine_vectors(mtx, vectors, vectors, count, max_threads);
+}
+
+template<typename real_t>
+void
+v8::math::transform_homogeneous_points(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    const v8::math::vector4<real_t>* input,
+    v8::math::vector4<real_t>* output,
+    size_t count,
+    unsigned int max_threads
+    )
+{
+    typedef internals::batch_transform_kernels<real_t> kernels_t;
+    base::parallel_for(count, kBatchTransformGrainSize, max_threads,
+                       [&mtx, input, output](size_t first, size_t last) {
+        kernels_t::homogeneous_aos(
+            mtx, input + first, output + first, last - first);
+    });
+}
+
+template<typename real_t>
+inline
+void
+v8::math::transform_homogeneous_points(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    v8::math::vector4<real_t>* points,
+    size_t count,
+    unsigned int max_threads
+    )
+{
+    transform_homogeneous_points(mtx, points, points, count, max_threads);
+}
+
+template<typename real_t>
+void
+v8::math::transform_affine_points_strided(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    const void* input,
+    size_t input_stride,
+    void* output,
+    size_t output_stride,
+    size_t count,
+    unsigned int max_threads
+    )
+{
+    typedef internals::batch_transform_kernels<real_t> kernels_t;
+    const unsigned char* src = static_cast<const unsigned char*>(input);
+    unsigned char* dst = static_cast<unsigned char*>(output);
+
+    base::parallel_for(count, kBatchTransformGrainSize, max_threads,
+                       [&](size_t first, size_t last) {
+        kernels_t::template affine_strided<true>(
+            mtx, src + first * input_stride, input_stride,
+            dst + first * output_stride, output_stride, last - first);
+    });
+}
+
+template<typename real_t>
+void
+v8::math::transform_affine_vectors_strided(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    const void* input,
+    size_t input_stride,
+    void* output,
+    size_t output_stride,
+    size_t count,
+    unsigned int max_threads
+    )
+{
+    typedef internals::batch_transform_kernels<real_t> kernels_t;
+    const unsigned char* src = static_cast<const unsigned char*>(input);
+    unsigned char* dst = static_cast<unsigned char*>(output);
+
+    base::parallel_for(count, kBatchTransformGrainSize, max_threads,
+                       [&](size_t first, size_t last) {
+        kernels_t::template affine_strided<false>(
+            mtx, src + first * input_stride, input_stride,
+            dst + first * output_stride, output_stride, last - first);
+    });
+}
+
+template<typename real_t>
+void
+v8::math::transform_affine_points_soa(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    const real_t* x_in,
+    const real_t* y_in,
+    const real_t* z_in,
+    real_t* x_out,
+    real_t* y_out,
+    real_t* z_out,
+    size_t count,
+    unsigned int max_threads
+    )
+{
+    typedef internals::batch_transform_kernels<real_t> kernels_t;
+    base::parallel_for(count, kBatchTransformGrainSize, max_threads,
+                       [&](size_t first, size_t last) {
+        kernels_t::template affine_soa<true>(
+            mtx, x_in + first, y_in + first, z_in + first,
+            x_out + first, y_out + first, z_out + first, last - first);
+    });
+}
+
+template<typename real_t>
+void
+v8::math::transform_affine_vectors_soa(
+    const v8::math::matrix_4X4<real_t>& mtx,
+    const real_t* x_in,
+    const real_t* y_in,
+    const real_t* z_in,
+    real_t* x_out,
+    real_t* y_out,
+    real_t* z_out,
+    size_t count,
+    unsigned int max_threads
+    )
+{
+    typedef internals::batch_transform_kernels<real_t> kernels_t;
+    base::parallel_for(count, kBatchTransformGrainSize, max_threads,
+                       [&](size_t first, size_t last) {
+        kernels_t::template affine_soa<false>(
+            mtx, x_in + first, y_in + first, z_in + first,
+            x_out + first, y_out + first, z_out + first, last - first);
+    });
+}
+
+template<typename real_t>
+void
+v8::math::invert_matrices(
+    const v8::math::matrix_4X4<real_t>* input,
+    v8::math::matrix_4X4<real_t>* output,
+    size_t count,
+    unsigned int max_threads
+    )
+{
+    base::parallel_for(count, kBatchInverseGrainSize, max_threads,
+                       [input, output](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i)
+            input[i].get_inverse(output + i);
+    });
+}
+
+template<typename real_t>
+void
+v8::math::invert_affine_matrices(
+    const v8::math::matrix_4X4<real_t>* input,
+    v8::math::matrix_4X4<real_t>* output,
+    size_t count,
+    unsigned int max_threads
+    )
+{
+    base::parallel_for(count, kBatchInverseGrainSize, max_threads,
+                       [input, output](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i)
+            input[i].get_inverse_affine(output + i);
+    });
+}
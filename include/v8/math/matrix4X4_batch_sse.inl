@@ -0,0 +1,190 @@
+#include "v8/math/sse_utils.h"
+
+namespace v8 { namespace math { namespace internals {
+
+/**
+ * \brief   SSE kernels for the batch transform functions. The matrix elements
+ *          are broadcast into registers once per call, then the inputs are
+ *          processed in groups of 4, using the same operation order as the
+ *          generic kernels. The AVX versions are compiled separately, in
+ *          lib/math, and selected at runtime.
+ */
+struct batch_transform_sse_kernels {
+    /**
+     * \brief   Used for the elements left after the SIMD loops.
+     */
+    typedef batch_transform_scalar_kernels<float> scalar_kernels_t;
+
+    struct broadcast_matrix {
+        __m128 m[12];
+
+        template<bool is_point>
+        void load(const matrix_4X4<float>& mtx) {
+            const __m128 zero = _mm_setzero_ps();
+            m[0] = _mm_set1_ps(mtx.a11_);
+            m[1] = _mm_set1_ps(mtx.a12_);
+            m[2] = _mm_set1_ps(mtx.a13_);
+            m[3] = is_point ? _mm_set1_ps(mtx.a14_) : zero;
+            m[4] = _mm_set1_ps(mtx.a21_);
+            m[5] = _mm_set1_ps(mtx.a22_);
+            m[6] = _mm_set1_ps(mtx.a23_);
+            m[7] = is_point ? _mm_set1_ps(mtx.a24_) : zero;
+            m[8] = _mm_set1_ps(mtx.a31_);
+            m[9] = _mm_set1_ps(mtx.a32_);
+            m[10] = _mm_set1_ps(mtx.a33_);
+            m[11] = is_point ? _mm_set1_ps(mtx.a34_) : zero;
+        }
+
+        void transform(
+            __m128 x, __m128 y, __m128 z,
+            __m128* x_out, __m128* y_out, __m128* z_out
+            ) const {
+            *x_out = sse::linear_combination(m[0], x, m[1], y, m[2], z, m[3]);
+            *y_out = sse::linear_combination(m[4], x, m[5], y, m[6], z, m[7]);
+            *z_out = sse::linear_combination(m[8], x, m[9], y, m[10], z, m[11]);
+        }
+    };
+
+    template<bool is_point>
+    static void affine_aos(
+        const matrix_4X4<float>& mtx,
+        const vector3<float>* input,
+        vector3<float>* output,
+        size_t count
+        )
+    {
+        broadcast_matrix bm;
+        bm.template load<is_point>(mtx);
+
+        const size_t simd_count = count & ~size_t(3);
+        for (size_t i = 0; i < simd_count; i += 4) {
+            __m128 x, y, z;
+            sse::load_vector3x4(input[i].elements_, &x, &y, &z);
+            bm.transform(x, y, z, &x, &y, &z);
+            sse::store_vector3x4(output[i].elements_, x, y, z);
+        }
+
+        scalar_kernels_t::template affine_aos<is_point>(
+            mtx, input + simd_count, output + simd_count, count - simd_count);
+    }
+
+    template<bool is_point>
+    static void affine_strided(
+        const matrix_4X4<float>& mtx,
+        const unsigned char* input,
+        size_t input_stride,
+        unsigned char* output,
+        size_t output_stride,
+        size_t count
+        )
+    {
+        broadcast_matrix bm;
+        bm.template load<is_point>(mtx);
+
+        const size_t simd_count = count & ~size_t(3);
+        for (size_t i = 0; i < simd_count; i += 4) {
+            const float* p0 = reinterpret_cast<const float*>(
+                input + i * input_stride);
+            const float* p1 = reinterpret_cast<const float*>(
+                input + (i + 1) * input_stride);
+            const float* p2 = reinterpret_cast<const float*>(
+                input + (i + 2) * input_stride);
+            const float* p3 = reinterpret_cast<const float*>(
+                input + (i + 3) * input_stride);
+
+            __m128 x = _mm_setr_ps(p0[0], p1[0], p2[0], p3[0]);
+            __m128 y = _mm_setr_ps(p0[1], p1[1], p2[1], p3[1]);
+            __m128 z = _mm_setr_ps(p0[2], p1[2], p2[2], p3[2]);
+            bm.transform(x, y, z, &x, &y, &z);
+
+            union {
+                __m128 v[3];
+                float f[3][4];
+            } res;
+            res.v[0] = x;
+            res.v[1] = y;
+            res.v[2] = z;
+
+            for (size_t j = 0; j < 4; ++j) {
+                float* dst = reinterpret_cast<float*>(
+                    output + (i + j) * output_stride);
+                dst[0] = res.f[0][j];
+                dst[1] = res.f[1][j];
+                dst[2] = res.f[2][j];
+            }
+        }
+
+        scalar_kernels_t::template affine_strided<is_point>(
+            mtx, input + simd_count * input_stride, input_stride,
+            output + simd_count * output_stride, output_stride,
+            count - simd_count);
+    }
+
+    template<bool is_point>
+    static void affine_soa(
+        const matrix_4X4<float>& mtx,
+        const float* x_in,
+        const float* y_in,
+        const float* z_in,
+        float* x_out,
+        float* y_out,
+        float* z_out,
+        size_t count
+        )
+    {
+        broadcast_matrix bm;
+        bm.template load<is_point>(mtx);
+
+        const size_t simd_count = count & ~size_t(3);
+        size_t i = 0;
+        for (; i < simd_count; i += 4) {
+            __m128 x, y, z;
+            bm.transform(_mm_loadu_ps(x_in + i), _mm_loadu_ps(y_in + i),
+                         _mm_loadu_ps(z_in + i), &x, &y, &z);
+            _mm_storeu_ps(x_out + i, x);
+            _mm_storeu_ps(y_out + i, y);
+            _mm_storeu_ps(z_out + i, z);
+        }
+
+        scalar_kernels_t::template affine_soa<is_point>(
+            mtx, x_in + i, y_in + i, z_in + i, x_out + i, y_out + i, z_out + i,
+            count - i);
+    }
+
+    static void homogeneous_aos(
+        const matrix_4X4<float>& mtx,
+        const vector4<float>* input,
+        vector4<float>* output,
+        size_t count
+        )
+    {
+        //
+        // output = col1 * x + col2 * y + col3 * z + col4 * w
+        __m128 c1 = _mm_loadu_ps(mtx.elements_);
+        __m128 c2 = _mm_loadu_ps(mtx.elements_ + 4);
+        __m128 c3 = _mm_loadu_ps(mtx.elements_ + 8);
+        __m128 c4 = _mm_loadu_ps(mtx.elements_ + 12);
+        _MM_TRANSPOSE4_PS(c1, c2, c3, c4);
+
+        const size_t simd_count = count & ~size_t(3);
+        size_t i = 0;
+        for (; i < simd_count; i += 4) {
+            __m128 res[4];
+            for (size_t j = 0; j < 4; ++j) {
+                const __m128 v = _mm_loadu_ps(input[i + j].elements_);
+                res[j] = sse::linear_combination(
+                    c1, sse::splat<0>(v), c2, sse::splat<1>(v),
+                    c3, sse::splat<2>(v), _mm_mul_ps(c4, sse::splat<3>(v)));
+            }
+            for (size_t j = 0; j < 4; ++j)
+                _mm_storeu_ps(output[i + j].elements_, res[j]);
+        }
+
+        scalar_kernels_t::homogeneous_aos(
+            mtx, input + i, output + i, count - i);
+    }
+};
+
+} // namespace internals
+} // namespace math
+} // namespace v8
@@ -0,0 +1,249 @@
+#include <xmmintrin.h>
+
+#if defined(V8_AVX_AVAILABLE)
+#include <immintrin.h>
+#endif
+
+namespace v8 { namespace math { namespace internals {
+
+/**
+ * \brief   Computes res = lhs * rhs, for row major 4x4 float matrices.
+ *          Every row of the result is a linear combination of the rows of
+ *          rhs, weighted by the elements of the corresponding row of lhs :
+ *          res[i] = lhs[i][0] * rhs[0] + lhs[i][1] * rhs[1]
+ *                   + lhs[i][2] * rhs[2] + lhs[i][3] * rhs[3].
+ *          The multiplications and additions are done in the same order
+ *          as in the scalar version, so the results are identical.
+ * \remarks No alignment requirements for any of the pointers. res may
+ *          alias lhs or rhs.
+ */
+inline
+void
+matrix4X4F_multiply_sse(
+    const float* lhs,
+    const float* rhs,
+    float* res
+    )
+{
+    const __m128 rhs_r1 = _mm_loadu_ps(rhs);
+    const __m128 rhs_r2 = _mm_loadu_ps(rhs + 4);
+    const __m128 rhs_r3 = _mm_loadu_ps(rhs + 8);
+    const __m128 rhs_r4 = _mm_loadu_ps(rhs + 12);
+
+    __m128 rows[4];
+    for (int i = 0; i < 4; ++i) {
+        const __m128 lhs_row = _mm_loadu_ps(lhs + i * 4);
+
+        __m128 acc = _mm_mul_ps(
+            _mm_shuffle_ps(lhs_row, lhs_row, _MM_SHUFFLE(0, 0, 0, 0)), rhs_r1);
+        acc = _mm_add_ps(acc, _mm_mul_ps(
+            _mm_shuffle_ps(lhs_row, lhs_row, _MM_SHUFFLE(1, 1, 1, 1)), rhs_r2));
+        acc = _mm_add_ps(acc, _mm_mul_ps(
+            _mm_shuffle_ps(lhs_row, lhs_row, _MM_SHUFFLE(2, 2, 2, 2)), rhs_r3));
+        rows[i] = _mm_add_ps(acc, _mm_mul_ps(
+            _mm_shuffle_ps(lhs_row, lhs_row, _MM_SHUFFLE(3, 3, 3, 3)), rhs_r4));
+    }
+
+    _mm_storeu_ps(res, rows[0]);
+    _mm_storeu_ps(res + 4, rows[1]);
+    _mm_storeu_ps(res + 8, rows[2]);
+    _mm_storeu_ps(res + 12, rows[3]);
+}
+
+#if defined(V8_AVX_AVAILABLE)
+
+/**
+ * \brief   AVX version of matrix4X4F_multiply_sse(). Two rows of the
+ *          result are computed at once, the upper lane processing the
+ *          second row. The in lane shuffle broadcasts lhs[i][k] to the low
+ *          lane and lhs[i + 1][k] to the high lane, while the rows of rhs are
+ *          duplicated into both lanes.
+ */
+inline
+void
+matrix4X4F_multiply_avx(
+    const float* lhs,
+    const float* rhs,
+    float* res
+    )
+{
+    const __m256 rhs_r1 = _mm256_broadcast_ps(
+        reinterpret_cast<const __m128*>(rhs));
+    const __m256 rhs_r2 = _mm256_broadcast_ps(
+        reinterpret_cast<const __m128*>(rhs + 4));
+    const __m256 rhs_r3 = _mm256_broadcast_ps(
+        reinterpret_cast<const __m128*>(rhs + 8));
+    const __m256 rhs_r4 = _mm256_broadcast_ps(
+        reinterpret_cast<const __m128*>(rhs + 12));
+
+    const __m256 lhs_r12 = _mm256_loadu_ps(lhs);
+    const __m256 lhs_r34 = _mm256_loadu_ps(lhs + 8);
+
+    __m256 r12 = _mm256_mul_ps(
+        _mm256_shuffle_ps(lhs_r12, lhs_r12, _MM_SHUFFLE(0, 0, 0, 0)), rhs_r1);
+    __m256 r34 = _mm256_mul_ps(
+        _mm256_shuffle_ps(lhs_r34, lhs_r34, _MM_SHUFFLE(0, 0, 0, 0)), rhs_r1);
+
+    r12 = _mm256_add_ps(r12, _mm256_mul_ps(
+        _mm256_shuffle_ps(lhs_r12, lhs_r12, _MM_SHUFFLE(1, 1, 1, 1)), rhs_r2));
+    r34 = _mm256_add_ps(r34, _mm256_mul_ps(
+        _mm256_shuffle_ps(lhs_r34, lhs_r34, _MM_SHUFFLE(1, 1, 1, 1)), rhs_r2));
+
+    r12 = _mm256_add_ps(r12, _mm256_mul_ps(
+        _mm256_shuffle_ps(lhs_r12, lhs_r12, _MM_SHUFFLE(2, 2, 2, 2)), rhs_r3));
+    r34 = _mm256_add_ps(r34, _mm256_mul_ps(
+        _mm256_shuffle_ps(lhs_r34, lhs_r34, _MM_SHUFFLE(2, 2, 2, 2)), rhs_r3));
+
+    r12 = _mm256_add_ps(r12, _mm256_mul_ps(
+        _mm256_shuffle_ps(lhs_r12, lhs_r12, _MM_SHUFFLE(3, 3, 3, 3)), rhs_r4));
+    r34 = _mm256_add_ps(r34, _mm256_mul_ps(
+        _mm256_shuffle_ps(lhs_r34, lhs_r34, _MM_SHUFFLE(3, 3, 3, 3)), rhs_r4));
+
+    _mm256_storeu_ps(res, r12);
+    _mm256_storeu_ps(res + 8, r34);
+}
+
+#endif // V8_AVX_AVAILABLE
+
+/**
+ * \brief   Computes the inverse of a row major 4x4 float matrix, using
+ *          Cramer's rule. The matrix is loaded transposed, the cofactors are
+ *          computed 4 at a time from products of pairs of rows, then
+ *          they are scaled by 1 / det.
+ *          See "Streaming SIMD Extensions - Inverse of 4x4 Matrix",
+ *          Intel order number 245043.
+ * \remarks No alignment requirements. dst may alias src. The matrix must
+ *          be invertible.
+ */
+inline
+void
+matrix4X4F_inverse_sse(
+    const float* src,
+    float* dst
+    )
+{
+    __m128 minor0, minor1, minor2, minor3;
+    __m128 row0, row1, row2, row3;
+    __m128 det, tmp1;
+
+    //
+    // Transpose while loading :
+    // row0 = column 1, row1 = column 2 (low/high halves swapped),
+    // row2 = column 3, row3 = column 4 (low/high halves swapped).
+    const __m128 zero = _mm_setzero_ps();
+    tmp1 = _mm_loadh_pi(_mm_loadl_pi(zero, reinterpret_cast<const __m64*>(src)),
+                        reinterpret_cast<const __m64*>(src + 4));
+    row1 = _mm_loadh_pi(_mm_loadl_pi(zero, reinterpret_cast<const __m64*>(src + 8)),
+                        reinterpret_cast<const __m64*>(src + 12));
+    row0 = _mm_shuffle_ps(tmp1, row1, 0x88);
+    row1 = _mm_shuffle_ps(row1, tmp1, 0xDD);
+    tmp1 = _mm_loadh_pi(_mm_loadl_pi(zero, reinterpret_cast<const __m64*>(src + 2)),
+                        reinterpret_cast<const __m64*>(src + 6));
+    row3 = _mm_loadh_pi(_mm_loadl_pi(zero, reinterpret_cast<const __m64*>(src + 10)),
+                        reinterpret_cast<const __m64*>(src + 14));
+    row2 = _mm_shuffle_ps(tmp1, row3, 0x88);
+    row3 = _mm_shuffle_ps(row3, tmp1, 0xDD);
+
+    tmp1 = _mm_mul_ps(row2, row3);
+    tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+    minor0 = _mm_mul_ps(row1, tmp1);
+    minor1 = _mm_mul_ps(row0, tmp1);
+    tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+    minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp1), minor0);
+    minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor1);
+    minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+    tmp1 = _mm_mul_ps(row1, row2);
+    tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+    minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor0);
+    minor3 = _mm_mul_ps(row0, tmp1);
+    tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+    minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp1));
+    minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor3);
+    minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+    tmp1 = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+    tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+    row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+    minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor0);
+    minor2 = _mm_mul_ps(row0, tmp1);
+    tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+    minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp1));
+    minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor2);
+    minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+    tmp1 = _mm_mul_ps(row0, row1);
+    tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+    minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor2);
+    minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp1), minor3);
+    tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+    minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp1), minor2);
+    minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp1));
+
+    tmp1 = _mm_mul_ps(row0, row3);
+    tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+    minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp1));
+    minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor2);
+    tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+    minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor1);
+    minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp1));
+
+    tmp1 = _mm_mul_ps(row0, row2);
+    tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+    minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor1);
+    minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp1));
+    tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+    minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp1));
+    minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor3);
+
+    //
+    // det = dot(column 1, cofactors of column 1), broadcast to all elements.
+    det = _mm_mul_ps(row0, minor0);
+    det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+    det = _mm_add_ps(_mm_shuffle_ps(det, det, 0xB1), det);
+    assert(!math::operands_eq(0.0f, _mm_cvtss_f32(det)));
+
+    //
+    // Full precision division, the reciprocal estimate (even with a
+    // Newton-Raphson step) loses too much for near singular matrices.
+    det = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+    _mm_storeu_ps(dst, _mm_mul_ps(det, minor0));
+    _mm_storeu_ps(dst + 4, _mm_mul_ps(det, minor1));
+    _mm_storeu_ps(dst + 8, _mm_mul_ps(det, minor2));
+    _mm_storeu_ps(dst + 12, _mm_mul_ps(det, minor3));
+}
+
+} // namespace internals
+
+template<>
+inline
+matrix_4X4<float>
+operator*(
+    const matrix_4X4<float>& lhs,
+    const matrix_4X4<float>& rhs
+    )
+{
+    matrix_4X4<float> res;
+#if defined(V8_AVX_AVAILABLE)
+    internals::matrix4X4F_multiply_avx(lhs.elements_, rhs.elements_,
+                                       res.elements_);
+#else
+    internals::matrix4X4F_multiply_sse(lhs.elements_, rhs.elements_,
+                                       res.elements_);
+#endif
+    return res;
+}
+
+template<>
+inline
+void
+matrix_4X4<float>::get_inverse(
+    matrix_4X4<float>* mx
+    ) const
+{
+    internals::matrix4X4F_inverse_sse(elements_, mx->elements_);
+}
+
+} // namespace math
+} // namespace v8
@@ -0,0 +1,246 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "v8/base/compiler_quirks.h"
+#include "v8/math/aabb.h"
+#include "v8/math/aabb_soa.h"
+#include "v8/math/camera.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector4.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \brief   Size, in pixels, of the screen tiles rasterized by one task.
+ *          The width is a multiple of 4, the SIMD kernels write 4 pixels
+ *          at a time.
+ */
+const size_t kOcclusionTileWidth = 32;
+const size_t kOcclusionTileHeight = 16;
+
+/**
+ * \brief   Number of occluder triangles set up by a task, and number of
+ *          boxes tested by a task in occluded_aabbs().
+ */
+const size_t kOcclusionGrainSize = 1024;
+
+/**
+ * \class   occlusion_buffer
+ *
+ * \brief   Software occlusion culling. Occluder meshes are rasterized into
+ *          a low resolution depth buffer, from which a hierarchical-Z mip 
+ *          chain is built (every texel holds the farthest depth of the 
+ *          texels it covers). Bounding boxes of occludees are then tested
+ *          against the mip level where their screen rectangle covers at
+ *          most 2x2 texels.
+ *
+ *          Usage, every frame :
+ *          \code
+ *          buffer.begin_frame(cam);
+ *          buffer.add_occluder(world, vertices, vertex_count, indices, index_count);
+ *          ...
+ *          buffer.render();
+ *          buffer.occluded_aabbs(boxes, result);
+ *          \endcode
+ * \remarks Depth follows the camera's projection (0 at the near plane, 1 at
+ *          the far plane). Triangles are rasterized with both windings and
+ *          are clipped against the near plane. Rasterization runs in 
+ *          parallel over screen tiles; with V8_SIMD_ENABLED the kernels
+ *          process 4 pixels per iteration when rasterizing, and project
+ *          the 8 corners of a box as two groups of 4.
+ */
+class occlusion_buffer {
+public :
+    /**
+     * \brief   Creates a buffer of width x height pixels. The width must be
+     *          a multiple of 4.
+     * \param   max_threads Maximum number of threads used by render() and 
+     *                      occluded_aabbs(), 0 to use all hardware threads.
+     */
+    occlusion_buffer(size_t width, size_t height, unsigned int max_threads = 0);
+
+    /**
+     * \brief   Removes the occluders of the previous frame and takes the
+     *          projection * view matrix from the camera.
+     */
+    void begin_frame(const camera& cam);
+
+    /**
+     * \brief   Queues an indexed triangle list as an occluder. The vertices
+     *          and indices are not copied, they must stay valid until 
+     *          render() returns.
+     */
+    void add_occluder(
+        const matrix_4X4F& world,
+        const vector3F* vertices,
+        size_t vertex_count,
+        const uint32_t* indices,
+        size_t index_count
+        );
+
+    /**
+     * \brief   Rasterizes the queued occluders and builds the mip chain.
+     */
+    void render();
+
+    /**
+     * \brief   Returns true if the world space box is hidden by the occluders.
+     *          Boxes that cross the near plane or are outside the view are 
+     *          never reported as occluded (use the frustum to cull them).
+     */
+    bool is_occluded(const aabbF& box) const;
+
+    /**
+     * \brief   Tests a set of boxes, result[i] = is_occluded(boxes.get(i)).
+     */
+    void occluded_aabbs(const aabb_soaF& boxes, uint8_t* result) const;
+
+    size_t width() const {
+        return width_;
+    }
+
+    /**
+     * \brief   Projection * view matrix of the current frame.
+     */
+    const matrix_4X4F& projection_view() const {
+        return projection_view_;
+    }
+
+    size_t height() const {
+        return height_;
+    }
+
+    size_t mip_count() const {
+        return mips_.size();
+    }
+
+    size_t mip_width(size_t level) const {
+        assert(level < mips_.size());
+        return mips_[level].width;
+    }
+
+    size_t mip_height(size_t level) const {
+        assert(level < mips_.size());
+        return mips_[level].height;
+    }
+
+    /**
+     * \brief   Depth values of a mip level, row by row, top row first. 
+     *          Level 0 is the rasterized depth buffer.
+     */
+    const float* mip_data(size_t level) const {
+        assert(level < mips_.size());
+        return &mips_[level].depth[0];
+    }
+
+    /**
+     * \brief   Number of triangles rasterized by the last render() call,
+     *          after near plane clipping.
+     */
+    size_t triangle_count() const {
+        return triangle_count_;
+    }
+
+private :
+    struct occluder {
+        matrix_4X4F         world;
+        const vector3F*     vertices;
+        size_t              vertex_count;
+        const uint32_t*     indices;
+        size_t              index_count;
+    };
+
+    /**
+     * \brief   A triangle in screen space (pixels, depth), with its edge
+     *          equations and depth plane.
+     */
+    struct screen_triangle {
+        float   edge_a[3];
+        float   edge_b[3];
+        float   edge_c[3];
+        float   depth_a;
+        float   depth_b;
+        float   depth_c;
+        float   min_x;
+        float   min_y;
+        float   max_x;
+        float   max_y;
+    };
+
+    struct mip_level {
+        size_t              width;
+        size_t              height;
+        std::vector<float>  depth;
+    };
+
+    void setup_triangles(
+        size_t first, 
+        size_t last, 
+        std::vector<screen_triangle>* triangles
+        ) const;
+
+    void add_screen_triangle(
+        const vector4F& v0, 
+        const vector4F& v1, 
+        const vector4F& v2,
+        std::vector<screen_triangle>* triangles
+        ) const;
+
+    void rasterize_tile(size_t tile);
+
+    void build_mip_chain();
+
+    size_t                                      width_;
+    size_t                                      height_;
+    size_t                                      tiles_x_;
+    size_t                                      tiles_y_;
+    unsigned int                                max_threads_;
+    matrix_4X4F                                 projection_view_;
+    std::vector<occluder>                       occluders_;
+    /// Prefix sums of the triangle counts of the occluders.
+    std::vector<size_t>                         first_triangle_;
+    /// Clip space vertices of all the occluders.
+    std::vector<vector4F>                       clip_vertices_;
+    std::vector<size_t>                         first_vertex_;
+    std::vector<std::vector<screen_triangle> >  task_triangles_;
+    std::vector<std::vector<uint32_t> >         tile_bins_;
+    std::vector<const screen_triangle*>         triangle_ptrs_;
+    std::vector<mip_level>                      mips_;
+    size_t                                      triangle_count_;
+
+private :
+    NO_CC_ASSIGN(occlusion_buffer);
+};
+
+} // namespace math
+} // namespace v8
@@ -38,13 +38,12 @@ public :
   plane() {}
   
   plane(const vector3F& normal, float offset = 0.0f) 
-    : normal_(normal_), offset_(offset) {}
+    : normal_(normal), offset_(offset) {}
     
   plane(float A, float B, float C, float D) : normal_(A, B, C), offset_(D) {}
   
-  static plane from_point_and_normal(const vector3F& pt, const vector3F& normal)
-    : normal_(normal) {
-      offset_ = -(normal_.x_ * pt.x_ + normal_.y_ * pt.y_ + normal_.z_ * pt.z_);
+  static plane from_point_and_normal(const vector3F& pt, const vector3F& normal) {
+    return plane(normal, -(normal.x_ * pt.x_ + normal.y_ * pt.y_ + normal.z_ * pt.z_));
   }
   
   static plane from_point_and_parallel_directions(
@@ -53,6 +52,15 @@ public :
   {
     return plane::from_point_and_normal(pt, cross_product(dir1, dir2));    
   }
+
+  /**
+   * \brief  Returns dot(normal, pt) + offset. If the normal has unit length,
+   *         this is the signed distance from pt to the plane, positive on
+   *         the side the normal points to.
+   */
+  float signed_distance(const vector3F& pt) const {
+    return dot_product(normal_, pt) + offset_;
+  }
 };
 
 inline
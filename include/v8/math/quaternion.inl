@@ -204,7 +204,7 @@ v8::math::quaternion<real_t>::normalize() {
     if (math::operands_eq(real_t(0), len_sq))
         return make_zero();
 
-    const real_t scale_factor = real_t(1) / len_sq;
+    const real_t scale_factor = real_t(1) / std::sqrt(len_sq);
     w_ *= scale_factor;
     x_ *= scale_factor;
     y_ *= scale_factor;
@@ -285,7 +285,7 @@ v8::math::quaternion<real_t>::is_identity() const {
 }
 
 template<typename real_t>
-v8::math::quaternion<real_t>&
+const v8::math::quaternion<real_t>&
 v8::math::quaternion<real_t>::extract_rotation_matrix(
     v8::math::matrix_3X3<real_t>* mtx
     ) const {
@@ -326,7 +326,7 @@ v8::math::quaternion<real_t>::extract_rotation_matrix(
 }
 
 template<typename real_t>
-v8::math::quaternion<real_t>&
+const v8::math::quaternion<real_t>&
 v8::math::quaternion<real_t>::extract_axis_angle(
     v8::math::vector3<real_t>* axis, 
     real_t* angle
@@ -353,6 +353,78 @@ v8::math::dot_product(
     return lhs.x_ * rhs.x_ + lhs.y_ * rhs.y_ + lhs.z_ * rhs.z_ + lhs.w_ * rhs.w_;
 }
 
+template<typename real_t>
+v8::math::quaternion<real_t>
+v8::math::nlerp(
+    const v8::math::quaternion<real_t>& q0,
+    const v8::math::quaternion<real_t>& q1,
+    real_t t
+    ) {
+    //
+    // Flipping the sign of t selects the shortest arc, q1 and -q1 encode
+    // the same rotation.
+    const real_t t1 = dot_product(q0, q1) < real_t(0) ? -t : t;
+    const real_t t0 = real_t(1) - t;
+
+    quaternion<real_t> result(q0.w_ * t0 + q1.w_ * t1,
+                              q0.x_ * t0 + q1.x_ * t1,
+                              q0.y_ * t0 + q1.y_ * t1,
+                              q0.z_ * t0 + q1.z_ * t1);
+    return result.normalize();
+}
+
+template<typename real_t>
+v8::math::quaternion<real_t>
+v8::math::slerp(
+    const v8::math::quaternion<real_t>& q0,
+    const v8::math::quaternion<real_t>& q1,
+    real_t t
+    ) {
+    const real_t cos_theta = dot_product(q0, q1);
+    const real_t abs_cos_theta = std::abs(cos_theta);
+
+    if (abs_cos_theta > real_t(0.9995))
+        return nlerp(q0, q1, t);
+
+    const real_t theta = std::acos(abs_cos_theta);
+    const real_t inv_sin_theta = real_t(1) / std::sin(theta);
+    const real_t t0 = std::sin((real_t(1) - t) * theta) * inv_sin_theta;
+    const real_t t1 = std::sin(t * theta) * inv_sin_theta *
+        (cos_theta < real_t(0) ? real_t(-1) : real_t(1));
+
+    return quaternion<real_t>(q0.w_ * t0 + q1.w_ * t1,
+                              q0.x_ * t0 + q1.x_ * t1,
+                              q0.y_ * t0 + q1.y_ * t1,
+                              q0.z_ * t0 + q1.z_ * t1);
+}
+
+template<typename real_t>
+inline
+real_t
+v8::math::internals::slerp_fast_adjust_t(
+    real_t t,
+    real_t abs_cos_theta
+    ) {
+    const real_t d = abs_cos_theta;
+    const real_t a = real_t(1.0904) + d * (real_t(-3.2452) + 
+        d * (real_t(3.55645) - d * real_t(1.43519)));
+    const real_t b = real_t(0.848013) + d * (real_t(-1.06021) + 
+        d * real_t(0.215638));
+    const real_t k = a * (t - real_t(0.5)) * (t - real_t(0.5)) + b;
+    return t + t * (t - real_t(0.5)) * (t - real_t(1)) * k;
+}
+
+template<typename real_t>
+v8::math::quaternion<real_t>
+v8::math::slerp_fast(
+    const v8::math::quaternion<real_t>& q0,
+    const v8::math::quaternion<real_t>& q1,
+    real_t t
+    ) {
+    const real_t abs_cos_theta = std::abs(dot_product(q0, q1));
+    return nlerp(q0, q1, internals::slerp_fast_adjust_t(t, abs_cos_theta));
+}
+
 template<typename real_t>
 inline
 v8::math::quaternion<real_t>
@@ -0,0 +1,298 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include "v8/base/aligned_memory.h"
+#include "v8/base/compiler_quirks.h"
+#include "v8/base/parallel_for.h"
+#include "v8/math/quaternion.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \brief   Number of quaternions blended by a thread, when the array versions
+ *          of nlerp()/slerp()/slerp_fast() use more than one thread.
+ */
+const size_t kQuaternionBlendGrainSize = 2048;
+
+namespace internals {
+
+/**
+ * \brief   Scalar kernels for the quaternion_soa operations. The quaternions
+ *          are passed as arrays of 4 component pointers (w, x, y, z) and the
+ *          kernels process the elements in [first, last). The output can be
+ *          the same as one of the inputs.
+ */
+template<typename real_t>
+struct quaternion_soa_scalar_kernels {
+    static void nlerp(
+        const real_t* const* a, const real_t* const* b, real_t t,
+        real_t* const* out, size_t first, size_t last
+        );
+
+    static void slerp(
+        const real_t* const* a, const real_t* const* b, real_t t,
+        real_t* const* out, size_t first, size_t last
+        );
+
+    static void slerp_fast(
+        const real_t* const* a, const real_t* const* b, real_t t,
+        real_t* const* out, size_t first, size_t last
+        );
+
+    static void normalize(real_t* const* q, size_t first, size_t last);
+};
+
+/**
+ * \brief   Kernels used by quaternion_soa. The float version is specialized
+ *          in quaternion_soa_sse.inl.
+ */
+template<typename real_t>
+struct quaternion_soa_kernels : public quaternion_soa_scalar_kernels<real_t> {};
+
+} // namespace internals
+
+/**
+ * \class   quaternion_soa
+ *
+ * \brief   A stream of quaternions, stored as four separate arrays for the
+ *          w, x, y and z components (structure of arrays), with the same
+ *          alignment and padding rules as vector3_soa. Meant for the bone
+ *          rotations of skeletal animations, where whole poses are blended
+ *          with nlerp(), slerp() or slerp_fast().
+ * \remarks For real_t = float, when V8_SIMD_ENABLED is defined the operations
+ *          use SSE.
+ */
+template<typename real_t>
+class quaternion_soa {
+public :
+    enum {
+        kAlignment = 32,
+        kElementsPerBlock = kAlignment / sizeof(real_t)
+    };
+
+    typedef real_t                      element_type;
+    typedef quaternion<real_t>          quaternion_t;
+    typedef quaternion_soa<real_t>      quaternion_soa_t;
+
+    quaternion_soa() : size_(0), capacity_(0) {
+        components_[0] = components_[1] = components_[2] = components_[3] = 
+            nullptr;
+    }
+
+    /**
+     * \brief   Constructs a stream of count identity quaternions.
+     */
+    explicit quaternion_soa(size_t count);
+
+    /**
+     * \brief   Constructs a stream with a copy of count quaternions.
+     */
+    quaternion_soa(const quaternion_t* src, size_t count);
+
+    quaternion_soa(const quaternion_soa_t& other);
+
+    quaternion_soa_t& operator=(const quaternion_soa_t& other);
+
+    ~quaternion_soa() {
+        base::aligned_free(components_[0]);
+    }
+
+    void swap(quaternion_soa_t& other);
+
+    size_t size() const {
+        return size_;
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    bool empty() const {
+        return !size_;
+    }
+
+    /**
+     * \brief   Changes the number of elements. Existing elements are kept,
+     *          new elements are set to the identity quaternion.
+     */
+    void resize(size_t count);
+
+    /**
+     * \brief   Makes room for at least count elements, without changing size().
+     */
+    void reserve(size_t count);
+
+    void clear() {
+        size_ = 0;
+    }
+
+    /**
+     * \brief   Returns the array of component pointers, in w, x, y, z order.
+     */
+    real_t* const* components() {
+        return components_;
+    }
+
+    const real_t* const* components() const {
+        return components_;
+    }
+
+    real_t* w() {
+        return components_[0];
+    }
+
+    const real_t* w() const {
+        return components_[0];
+    }
+
+    real_t* x() {
+        return components_[1];
+    }
+
+    const real_t* x() const {
+        return components_[1];
+    }
+
+    real_t* y() {
+        return components_[2];
+    }
+
+    const real_t* y() const {
+        return components_[2];
+    }
+
+    real_t* z() {
+        return components_[3];
+    }
+
+    const real_t* z() const {
+        return components_[3];
+    }
+
+    quaternion_t get(size_t index) const {
+        assert(index < size_);
+        return quaternion_t(components_[0][index], components_[1][index],
+                            components_[2][index], components_[3][index]);
+    }
+
+    void set(size_t index, const quaternion_t& value) {
+        assert(index < size_);
+        components_[0][index] = value.w_;
+        components_[1][index] = value.x_;
+        components_[2][index] = value.y_;
+        components_[3][index] = value.z_;
+    }
+
+    /**
+     * \brief   Replaces the contents with a copy of count quaternions
+     *          (gather from AoS).
+     */
+    void assign(const quaternion_t* src, size_t count);
+
+    /**
+     * \brief   Copies the elements to an array of size() quaternions
+     *          (scatter to AoS).
+     */
+    void copy_to(quaternion_t* dst) const;
+
+    /**
+     * \brief   Makes all the elements unit length. None of them can be the 
+     *          null quaternion.
+     */
+    quaternion_soa_t& normalize();
+
+private :
+    void reallocate(size_t capacity);
+
+    real_t*     components_[4];
+    size_t      size_;
+    size_t      capacity_;
+};
+
+/**
+ * \brief   out[i] = nlerp(lhs[i], rhs[i], t). lhs and rhs must have the same
+ *          size, out is resized to match and can be lhs or rhs.
+ * \param   max_threads     Maximum number of threads to use, 0 means one per
+ *          hardware thread.
+ */
+template<typename real_t>
+void
+nlerp(
+    const math::quaternion_soa<real_t>& lhs,
+    const math::quaternion_soa<real_t>& rhs,
+    real_t t,
+    math::quaternion_soa<real_t>* out,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   out[i] = slerp(lhs[i], rhs[i], t). lhs and rhs must have the same
+ *          size, out is resized to match and can be lhs or rhs.
+ * \remarks The SIMD version still computes the interpolation weights with
+ *          scalar acos/sin calls, use slerp_fast() when speed matters more.
+ */
+template<typename real_t>
+void
+slerp(
+    const math::quaternion_soa<real_t>& lhs,
+    const math::quaternion_soa<real_t>& rhs,
+    real_t t,
+    math::quaternion_soa<real_t>* out,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   out[i] = slerp_fast(lhs[i], rhs[i], t). lhs and rhs must have the
+ *          same size, out is resized to match and can be lhs or rhs.
+ */
+template<typename real_t>
+void
+slerp_fast(
+    const math::quaternion_soa<real_t>& lhs,
+    const math::quaternion_soa<real_t>& rhs,
+    real_t t,
+    math::quaternion_soa<real_t>* out,
+    unsigned int max_threads = 1
+    );
+
+typedef quaternion_soa<float>     quaternion_soaF;
+
+typedef quaternion_soa<double>    quaternion_soaD;
+
+} // namespace math
+} // namespace v8
+
+#include "quaternion_soa.inl"
+
+#if defined(V8_SIMD_ENABLED)
+#include "quaternion_soa_sse.inl"
+#endif
@@ -0,0 +1,287 @@
+template<typename real_t>
+void
+v8::math::internals::quaternion_soa_scalar_kernels<real_t>::nlerp(
+    const real_t* const* a,
+    const real_t* const* b,
+    real_t t,
+    real_t* const* out,
+    size_t first,
+    size_t last
+    )
+{
+    for (size_t i = first; i < last; ++i) {
+        const quaternion<real_t> result = math::nlerp(
+            quaternion<real_t>(a[0][i], a[1][i], a[2][i], a[3][i]),
+            quaternion<real_t>(b[0][i], b[1][i], b[2][i], b[3][i]), t);
+        out[0][i] = result.w_;
+        out[1][i] = result.x_;
+        out[2][i] = result.y_;
+        out[3][i] = result.z_;
+    }
+}
+
+template<typename real_t>
+void
+v8::math::internals::quaternion_soa_scalar_kernels<real_t>::slerp(
+    const real_t* const* a,
+    const real_t* const* b,
+    real_t t,
+    real_t* const* out,
+    size_t first,
+    size_t last
+    )
+{
+    for (size_t i = first; i < last; ++i) {
+        const quaternion<real_t> result = math::slerp(
+            quaternion<real_t>(a[0][i], a[1][i], a[2][i], a[3][i]),
+            quaternion<real_t>(b[0][i], b[1][i], b[2][i], b[3][i]), t);
+        out[0][i] = result.w_;
+        out[1][i] = result.x_;
+        out[2][i] = result.y_;
+        out[3][i] = result.z_;
+    }
+}
+
+template<typename real_t>
+void
+v8::math::internals::quaternion_soa_scalar_kernels<real_t>::slerp_fast(
+    const real_t* const* a,
+    const real_t* const* b,
+    real_t t,
+    real_t* const* out,
+    size_t first,
+    size_t last
+    )
+{
+    for (size_t i = first; i < last; ++i) {
+        const quaternion<real_t> result = math::slerp_fast(
+            quaternion<real_t>(a[0][i], a[1][i], a[2][i], a[3][i]),
+            quaternion<real_t>(b[0][i], b[1][i], b[2][i], b[3][i]), t);
+        out[0][i] = result.w_;
+        out[1][i] = result.x_;
+        out[2][i] = result.y_;
+        out[3][i] = result.z_;
+    }
+}
+
+template<typename real_t>
+void
+v8::math::internals::quaternion_soa_scalar_kernels<real_t>::normalize(
+    real_t* const* q,
+    size_t first,
+    size_t last
+    )
+{
+    for (size_t i = first; i < last; ++i) {
+        const real_t len = std::sqrt(q[0][i] * q[0][i] + q[1][i] * q[1][i] +
+                                     q[2][i] * q[2][i] + q[3][i] * q[3][i]);
+        assert(!math::is_zero(len));
+        q[0][i] /= len;
+        q[1][i] /= len;
+        q[2][i] /= len;
+        q[3][i] /= len;
+    }
+}
+
+template<typename real_t>
+v8::math::quaternion_soa<real_t>::quaternion_soa(size_t count)
+    : size_(0), capacity_(0)
+{
+    components_[0] = components_[1] = components_[2] = components_[3] = nullptr;
+    resize(count);
+}
+
+template<typename real_t>
+v8::math::quaternion_soa<real_t>::quaternion_soa(
+    const quaternion_t* src,
+    size_t count
+    )
+    : size_(0), capacity_(0)
+{
+    components_[0] = components_[1] = components_[2] = components_[3] = nullptr;
+    assign(src, count);
+}
+
+template<typename real_t>
+v8::math::quaternion_soa<real_t>::quaternion_soa(const quaternion_soa_t& other)
+    : size_(0), capacity_(0)
+{
+    components_[0] = components_[1] = components_[2] = components_[3] = nullptr;
+    reallocate(other.size_);
+    for (size_t c = 0; c < 4; ++c)
+        std::memcpy(components_[c], other.components_[c],
+                    other.size_ * sizeof(real_t));
+    size_ = other.size_;
+}
+
+template<typename real_t>
+v8::math::quaternion_soa<real_t>&
+v8::math::quaternion_soa<real_t>::operator=(const quaternion_soa_t& other) {
+    if (this != &other) {
+        quaternion_soa_t tmp(other);
+        swap(tmp);
+    }
+    return *this;
+}
+
+template<typename real_t>
+void
+v8::math::quaternion_soa<real_t>::swap(quaternion_soa_t& other) {
+    using std::swap;
+    for (size_t c = 0; c < 4; ++c)
+        swap(components_[c], other.components_[c]);
+    swap(size_, other.size_);
+    swap(capacity_, other.capacity_);
+}
+
+template<typename real_t>
+void
+v8::math::quaternion_soa<real_t>::reallocate(size_t capacity) {
+    //
+    // One block for all 4 arrays, see vector3_soa::reallocate().
+    capacity = (capacity + kElementsPerBlock - 1) & ~size_t(kElementsPerBlock - 1);
+    if (!capacity)
+        capacity = kElementsPerBlock;
+
+    real_t* block = static_cast<real_t*>(
+        base::aligned_malloc(4 * capacity * sizeof(real_t), kAlignment));
+    assert(block);
+    std::memset(block, 0, 4 * capacity * sizeof(real_t));
+
+    const size_t kept = size_ < capacity ? size_ : capacity;
+    if (components_[0]) {
+        for (size_t c = 0; c < 4; ++c)
+            std::memcpy(block + c * capacity, components_[c],
+                        kept * sizeof(real_t));
+        base::aligned_free(components_[0]);
+    }
+
+    for (size_t c = 0; c < 4; ++c)
+        components_[c] = block + c * capacity;
+    capacity_ = capacity;
+}
+
+template<typename real_t>
+void
+v8::math::quaternion_soa<real_t>::reserve(size_t count) {
+    if (count > capacity_ || !components_[0])
+        reallocate(count);
+}
+
+template<typename real_t>
+void
+v8::math::quaternion_soa<real_t>::resize(size_t count) {
+    if (count > capacity_ || !components_[0])
+        reallocate(count);
+
+    for (size_t i = size_; i < count; ++i) {
+        components_[0][i] = real_t(1);
+        components_[1][i] = real_t(0);
+        components_[2][i] = real_t(0);
+        components_[3][i] = real_t(0);
+    }
+    size_ = count;
+}
+
+template<typename real_t>
+void
+v8::math::quaternion_soa<real_t>::assign(
+    const quaternion_t* src,
+    size_t count
+    )
+{
+    resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        components_[0][i] = src[i].w_;
+        components_[1][i] = src[i].x_;
+        components_[2][i] = src[i].y_;
+        components_[3][i] = src[i].z_;
+    }
+}
+
+template<typename real_t>
+void
+v8::math::quaternion_soa<real_t>::copy_to(quaternion_t* dst) const {
+    for (size_t i = 0; i < size_; ++i) {
+        dst[i].w_ = components_[0][i];
+        dst[i].x_ = components_[1][i];
+        dst[i].y_ = components_[2][i];
+        dst[i].z_ = components_[3][i];
+    }
+}
+
+template<typename real_t>
+v8::math::quaternion_soa<real_t>&
+v8::math::quaternion_soa<real_t>::normalize() {
+    internals::quaternion_soa_kernels<real_t>::normalize(components_, 0, size_);
+    return *this;
+}
+
+template<typename real_t>
+void
+v8::math::nlerp(
+    const v8::math::quaternion_soa<real_t>& lhs,
+    const v8::math::quaternion_soa<real_t>& rhs,
+    real_t t,
+    v8::math::quaternion_soa<real_t>* out,
+    unsigned int max_threads
+    )
+{
+    assert(lhs.size() == rhs.size());
+    out->resize(lhs.size());
+
+    const real_t* const* a = lhs.components();
+    const real_t* const* b = rhs.components();
+    real_t* const* dst = out->components();
+    base::parallel_for(lhs.size(), kQuaternionBlendGrainSize, max_threads,
+                       [a, b, t, dst](size_t first, size_t last) {
+        internals::quaternion_soa_kernels<real_t>::nlerp(
+            a, b, t, dst, first, last);
+    });
+}
+
+template<typename real_t>
+void
+v8::math::slerp(
+    const v8::math::quaternion_soa<real_t>& lhs,
+    const v8::math::quaternion_soa<real_t>& rhs,
+    real_t t,
+    v8::math::quaternion_soa<real_t>* out,
+    unsigned int max_threads
+    )
+{
+    assert(lhs.size() == rhs.size());
+    out->resize(lhs.size());
+
+    const real_t* const* a = lhs.components();
+    const real_t* const* b = rhs.components();
+    real_t* const* dst = out->components();
+    base::parallel_for(lhs.size(), kQuaternionBlendGrainSize, max_threads,
+                       [a, b, t, dst](size_t first, size_t last) {
+        internals::quaternion_soa_kernels<real_t>::slerp(
+            a, b, t, dst, first, last);
+    });
+}
+
+template<typename real_t>
+void
+v8::math::slerp_fast(
+    const v8::math::quaternion_soa<real_t>& lhs,
+    const v8::math::quaternion_soa<real_t>& rhs,
+    real_t t,
+    v8::math::quaternion_soa<real_t>* out,
+    unsigned int max_threads
+    )
+{
+    assert(lhs.size() == rhs.size());
+    out->resize(lhs.size());
+
+    const real_t* const* a = lhs.components();
+    const real_t* const* b = rhs.components();
+    real_t* const* dst = out->components();
+    base::parallel_for(lhs.size(), kQuaternionBlendGrainSize, max_threads,
+                       [a, b, t, dst](size_t first, size_t last) {
+        internals::quaternion_soa_kernels<real_t>::slerp_fast(
+            a, b, t, dst, first, last);
+    });
+}
@@ -0,0 +1,189 @@
+#include <xmmintrin.h>
+
+namespace v8 { namespace math { namespace internals {
+
+/**
+ * \brief   SSE kernels for quaternion_soa<float>. 4 quaternions are blended
+ *          per iteration, the remaining ones are handled by the scalar 
+ *          kernels.
+ */
+template<>
+struct quaternion_soa_kernels<float> {
+    typedef quaternion_soa_scalar_kernels<float> scalar_kernels_t;
+
+    struct quaternion4 {
+        __m128 c[4];
+
+        void load(const float* const* q, size_t i) {
+            c[0] = _mm_loadu_ps(q[0] + i);
+            c[1] = _mm_loadu_ps(q[1] + i);
+            c[2] = _mm_loadu_ps(q[2] + i);
+            c[3] = _mm_loadu_ps(q[3] + i);
+        }
+
+        void store(float* const* q, size_t i) const {
+            _mm_storeu_ps(q[0] + i, c[0]);
+            _mm_storeu_ps(q[1] + i, c[1]);
+            _mm_storeu_ps(q[2] + i, c[2]);
+            _mm_storeu_ps(q[3] + i, c[3]);
+        }
+
+        __m128 dot(const quaternion4& rhs) const {
+            return _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(c[0], rhs.c[0]), _mm_mul_ps(c[1], rhs.c[1])),
+                _mm_add_ps(_mm_mul_ps(c[2], rhs.c[2]), _mm_mul_ps(c[3], rhs.c[3])));
+        }
+
+        void normalize() {
+            const __m128 inv_len = _mm_div_ps(_mm_set1_ps(1.0f), 
+                                              _mm_sqrt_ps(dot(*this)));
+            c[0] = _mm_mul_ps(c[0], inv_len);
+            c[1] = _mm_mul_ps(c[1], inv_len);
+            c[2] = _mm_mul_ps(c[2], inv_len);
+            c[3] = _mm_mul_ps(c[3], inv_len);
+        }
+
+        /**
+         * \brief   *this = a * t0 + b * t1.
+         */
+        void blend(const quaternion4& a, __m128 t0, const quaternion4& b, __m128 t1) {
+            for (size_t j = 0; j < 4; ++j)
+                c[j] = _mm_add_ps(_mm_mul_ps(a.c[j], t0), _mm_mul_ps(b.c[j], t1));
+        }
+    };
+
+    static __m128 sign_mask() {
+        return _mm_set1_ps(-0.0f);
+    }
+
+    static void nlerp(
+        const float* const* a, const float* const* b, float t,
+        float* const* out, size_t first, size_t last
+        )
+    {
+        const __m128 tv = _mm_set1_ps(t);
+        const __m128 t0 = _mm_set1_ps(1.0f - t);
+        const size_t simd_last = first + ((last - first) & ~size_t(3));
+
+        for (size_t i = first; i < simd_last; i += 4) {
+            quaternion4 qa, qb, res;
+            qa.load(a, i);
+            qb.load(b, i);
+
+            //
+            // t1 = -t for the lanes where dot(a, b) < 0 (shortest arc).
+            const __m128 sign = _mm_and_ps(qa.dot(qb), sign_mask());
+            res.blend(qa, t0, qb, _mm_xor_ps(tv, sign));
+            res.normalize();
+            res.store(out, i);
+        }
+
+        scalar_kernels_t::nlerp(a, b, t, out, simd_last, last);
+    }
+
+    static void slerp(
+        const float* const* a, const float* const* b, float t,
+        float* const* out, size_t first, size_t last
+        )
+    {
+        const size_t simd_last = first + ((last - first) & ~size_t(3));
+
+        for (size_t i = first; i < simd_last; i += 4) {
+            quaternion4 qa, qb, res;
+            qa.load(a, i);
+            qb.load(b, i);
+
+            //
+            // The weights need acos/sin, so they are computed one lane at a 
+            // time. The blend and the normalization are done on all 4 lanes.
+            // The normalization only matters for the lanes that fall back to
+            // nlerp, for the others it just removes the rounding errors.
+            union {
+                __m128 v;
+                float f[4];
+            } cos_theta, w0, w1;
+
+            cos_theta.v = qa.dot(qb);
+            for (size_t j = 0; j < 4; ++j) {
+                const float abs_cos = std::abs(cos_theta.f[j]);
+                const float sign = cos_theta.f[j] < 0.0f ? -1.0f : 1.0f;
+                if (abs_cos > 0.9995f) {
+                    w0.f[j] = 1.0f - t;
+                    w1.f[j] = t * sign;
+                } else {
+                    const float theta = std::acos(abs_cos);
+                    const float inv_sin_theta = 1.0f / std::sin(theta);
+                    w0.f[j] = std::sin((1.0f - t) * theta) * inv_sin_theta;
+                    w1.f[j] = std::sin(t * theta) * inv_sin_theta * sign;
+                }
+            }
+
+            res.blend(qa, w0.v, qb, w1.v);
+            res.normalize();
+            res.store(out, i);
+        }
+
+        scalar_kernels_t::slerp(a, b, t, out, simd_last, last);
+    }
+
+    static void slerp_fast(
+        const float* const* a, const float* const* b, float t,
+        float* const* out, size_t first, size_t last
+        )
+    {
+        //
+        // Same polynomial as internals::slerp_fast_adjust_t(), 
+        // evaluated for 4 lanes.
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 tv = _mm_set1_ps(t);
+        const __m128 t_half = _mm_sub_ps(tv, half);
+        const __m128 t_half_sq = _mm_mul_ps(t_half, t_half);
+        const __m128 t_poly = _mm_mul_ps(_mm_mul_ps(tv, t_half), 
+                                         _mm_sub_ps(tv, one));
+        const size_t simd_last = first + ((last - first) & ~size_t(3));
+
+        for (size_t i = first; i < simd_last; i += 4) {
+            quaternion4 qa, qb, res;
+            qa.load(a, i);
+            qb.load(b, i);
+
+            const __m128 cos_theta = qa.dot(qb);
+            const __m128 sign = _mm_and_ps(cos_theta, sign_mask());
+            const __m128 d = _mm_andnot_ps(sign_mask(), cos_theta);
+
+            const __m128 ka = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(d,
+                _mm_add_ps(_mm_set1_ps(-3.2452f), _mm_mul_ps(d,
+                    _mm_sub_ps(_mm_set1_ps(3.55645f), 
+                               _mm_mul_ps(d, _mm_set1_ps(1.43519f)))))));
+            const __m128 kb = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(d,
+                _mm_add_ps(_mm_set1_ps(-1.06021f), 
+                           _mm_mul_ps(d, _mm_set1_ps(0.215638f)))));
+            const __m128 k = _mm_add_ps(_mm_mul_ps(ka, t_half_sq), kb);
+            const __m128 adj_t = _mm_add_ps(tv, _mm_mul_ps(t_poly, k));
+
+            res.blend(qa, _mm_sub_ps(one, adj_t), qb, _mm_xor_ps(adj_t, sign));
+            res.normalize();
+            res.store(out, i);
+        }
+
+        scalar_kernels_t::slerp_fast(a, b, t, out, simd_last, last);
+    }
+
+    static void normalize(float* const* q, size_t first, size_t last) {
+        const size_t simd_last = first + ((last - first) & ~size_t(3));
+
+        for (size_t i = first; i < simd_last; i += 4) {
+            quaternion4 qv;
+            qv.load(q, i);
+            qv.normalize();
+            qv.store(q, i);
+        }
+
+        scalar_kernels_t::normalize(q, simd_last, last);
+    }
+};
+
+} // namespace internals
+} // namespace math
+} // namespace v8
@@ -0,0 +1,163 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "v8/base/compiler_quirks.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/transform.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \brief   Parent index of the root nodes.
+ */
+const uint32_t kInvalidNode = 0xFFFFFFFF;
+
+/**
+ * \class   scene_hierarchy
+ *
+ * \brief   A transform hierarchy (scene graph) stored in flat arrays. A 
+ *          node's parent is always stored before it, so a front to back
+ *          sweep sees every parent's world matrix before its children. 
+ *          Every node has a local transform and a world matrix,
+ *          world = parent_world * local.
+ *
+ *          Changing a local transform marks the node dirty. update() only
+ *          recomputes the world matrices of the subtrees under the dirty
+ *          nodes, so a mostly static scene updates in time proportional to
+ *          what moved, not to the size of the hierarchy.
+ * \remarks World matrices are valid after update(). 
+ */
+class scene_hierarchy {
+public :
+    scene_hierarchy();
+
+    void reserve(size_t node_count);
+
+    void clear();
+
+    /**
+     * \brief   Adds a node and returns its index. The node starts dirty.
+     * \param   parent  Index of an existing node, or kInvalidNode for a 
+     *                  root node.
+     */
+    uint32_t add_node(uint32_t parent, const transformF& local);
+
+    size_t node_count() const {
+        return parents_.size();
+    }
+
+    uint32_t parent(uint32_t node) const {
+        assert(node < node_count());
+        return parents_[node];
+    }
+
+    /**
+     * \brief   First child of a node, kInvalidNode if it has none.
+     */
+    uint32_t first_child(uint32_t node) const {
+        assert(node < node_count());
+        return first_child_[node];
+    }
+
+    /**
+     * \brief   Next child of the node's parent, kInvalidNode for the last 
+     *          child.
+     */
+    uint32_t next_sibling(uint32_t node) const {
+        assert(node < node_count());
+        return next_sibling_[node];
+    }
+
+    const transformF& local_transform(uint32_t node) const {
+        assert(node < node_count());
+        return locals_[node];
+    }
+
+    /**
+     * \brief   Sets the local transform and marks the node dirty.
+     */
+    void set_local_transform(uint32_t node, const transformF& local);
+
+    /**
+     * \brief   World matrix, as of the last update().
+     */
+    const matrix_4X4F& world_matrix(uint32_t node) const {
+        assert(node < node_count());
+        return worlds_[node];
+    }
+
+    bool is_dirty(uint32_t node) const {
+        assert(node < node_count());
+        return dirty_[node] != 0;
+    }
+
+    /**
+     * \brief   Recomputes the world matrices of the dirty subtrees.
+     */
+    void update();
+
+    /**
+     * \brief   Recomputes every world matrix, with one sweep over the 
+     *          arrays. Faster than update() when most of the nodes moved.
+     */
+    void update_all();
+
+    /**
+     * \brief   Number of world matrices computed by the last update() or
+     *          update_all() call.
+     */
+    size_t last_update_count() const {
+        return last_update_count_;
+    }
+
+private :
+    void update_subtree(uint32_t root);
+
+    std::vector<uint32_t>       parents_;
+    std::vector<uint32_t>       first_child_;
+    std::vector<uint32_t>       last_child_;
+    std::vector<uint32_t>       next_sibling_;
+    std::vector<transformF>     locals_;
+    std::vector<matrix_4X4F>    worlds_;
+    std::vector<uint8_t>        dirty_;
+    /// Nodes marked dirty since the last update, in marking order.
+    std::vector<uint32_t>       dirty_roots_;
+    /// Scratch stack for the subtree walks.
+    std::vector<uint32_t>       stack_;
+    size_t                      last_update_count_;
+
+private :
+    NO_CC_ASSIGN(scene_hierarchy);
+};
+
+} // namespace math
+} // namespace v8
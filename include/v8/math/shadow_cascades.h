@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstddef>
+#include "v8/math/camera.h"
+#include "v8/math/light.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/vector3.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \brief   Maximum number of cascades compute_shadow_cascades() can build.
+ */
+const size_t kMaxShadowCascades = 8;
+
+/**
+ * \brief   Parameters for compute_shadow_cascades().
+ */
+struct shadow_cascade_params {
+    /// Number of cascades, 1 to kMaxShadowCascades.
+    size_t          cascade_count;
+    
+    /**
+     * Blends between uniform (0) and logarithmic (1) split distances,
+     * the "practical split scheme". Values around 0.5 - 0.8 are typical.
+     * Ignored for an orthographic camera, whose splits are uniform.
+     */
+    float           split_lambda;
+
+    /// Size of the (square) shadow map for a cascade, in texels.
+    unsigned int    shadow_map_size;
+
+    /**
+     * Extra depth added in front of each cascade, towards the light, so 
+     * that casters outside the view frustum still land in the shadow map.
+     */
+    float           caster_depth_extension;
+
+    shadow_cascade_params() 
+        :   cascade_count(4), split_lambda(0.75f), shadow_map_size(2048),
+            caster_depth_extension(0.0f) {}
+};
+
+/**
+ * \brief   A slice of the view frustum, with the matrices to render its 
+ *          shadow map.
+ */
+struct shadow_cascade {
+    /// Distance along the view direction where the slice starts.
+    float           split_near;
+
+    /// Distance along the view direction where the slice ends.
+    float           split_far;
+
+    /**
+     * World space corners of the slice : the 4 near corners, then the 4
+     * far corners, in the order (rmin, umin), (rmax, umin), (rmax, umax), 
+     * (rmin, umax).
+     */
+    vector3F        corners[8];
+
+    /// World space bounding sphere of the slice.
+    vector3F        sphere_center;
+    float           sphere_radius;
+
+    /// World to light space, a rotation only (same for all cascades).
+    matrix_4X4F     light_view;
+
+    /// Orthographic projection around the bounding sphere.
+    matrix_4X4F     light_projection;
+
+    /// light_projection * light_view.
+    matrix_4X4F     light_view_projection;
+};
+
+/**
+ * \brief   Splits the view frustum of a camera into cascades and computes
+ *          the shadow map matrices of a directional light for each one.
+ *          The split distances and the world space corners are computed
+ *          once for all the cascades (neighbouring cascades share a plane
+ *          of corners). Each projection is built around the bounding 
+ *          sphere of its slice, with the window center snapped to whole
+ *          shadow map texels. The sphere's size depends only on the
+ *          frustrum parameters, so rotating or moving the camera never 
+ *          changes the texel size, and the snapping keeps the shadow 
+ *          edges from shimmering when the camera moves.
+ * \param   cam         The camera. Both perspective and orthographic
+ *                      projections are supported; an orthographic
+ *                      camera gets uniform splits and may have its near
+ *                      plane at 0.
+ * \param   dir_light   A directional light.
+ * \param   params      Cascade count, split distribution, shadow map size.
+ * \param   cascades    Receives params.cascade_count cascades.
+ */
+void
+compute_shadow_cascades(
+    const camera& cam,
+    const light& dir_light,
+    const shadow_cascade_params& params,
+    shadow_cascade* cascades
+    );
+
+} // namespace math
+} // namespace v8
@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "v8/base/compiler_quirks.h"
+
+#if defined(V8_SIMD_ENABLED)
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+namespace v8 { namespace math { namespace sse {
+
+/**
+ * \brief   Returns a vector with all four elements set to the specified
+ *          element of v.
+ */
+template<int element>
+inline __m128 splat(__m128 v) {
+    return _mm_shuffle_ps(
+        v, v, _MM_SHUFFLE(element, element, element, element));
+}
+
+/**
+ * \brief   Loads four consecutive vector3F objects (12 floats) and
+ *          transposes them into x, y, z registers, 
+ *          x = (x0, x1, x2, x3), y = (y0, y1, y2, y3), z = (z0, z1, z2, z3).
+ */
+inline
+void
+load_vector3x4(
+    const float* src,
+    __m128* x,
+    __m128* y,
+    __m128* z
+    )
+{
+    //
+    // a = (x0, y0, z0, x1), b = (y1, z1, x2, y2), c = (z2, x3, y3, z3)
+    const __m128 a = _mm_loadu_ps(src);
+    const __m128 b = _mm_loadu_ps(src + 4);
+    const __m128 c = _mm_loadu_ps(src + 8);
+
+    const __m128 b2c1 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+    *x = _mm_shuffle_ps(a, b2c1, _MM_SHUFFLE(2, 0, 3, 0));
+
+    const __m128 a1b0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+    const __m128 b3c2 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+    *y = _mm_shuffle_ps(a1b0, b3c2, _MM_SHUFFLE(2, 0, 2, 0));
+
+    const __m128 a2b1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+    *z = _mm_shuffle_ps(a2b1, c, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+/**
+ * \brief   Inverse of load_vector3x4(), stores x, y, z as four consecutive
+ *          vector3F objects.
+ */
+inline
+void
+store_vector3x4(
+    float* dst,
+    __m128 x,
+    __m128 y,
+    __m128 z
+    )
+{
+    const __m128 x0y0 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 z0x1 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0));
+    const __m128 y1z1 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 x2y2 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 z2x3 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2));
+    const __m128 y3z3 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3));
+
+    _mm_storeu_ps(dst, _mm_shuffle_ps(x0y0, z0x1, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(dst + 4, _mm_shuffle_ps(y1z1, x2y2, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(dst + 8, _mm_shuffle_ps(z2x3, y3z3, _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+/**
+ * \brief   Computes a * x + b * y + c * z + d, for every element.
+ */
+inline
+__m128
+linear_combination(
+    __m128 a, __m128 x,
+    __m128 b, __m128 y,
+    __m128 c, __m128 z,
+    __m128 d
+    )
+{
+    return _mm_add_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(b, y)),
+                   _mm_mul_ps(c, z)),
+        d);
+}
+
+} // namespace sse
+} // namespace math
+} // namespace v8
+
+#endif // V8_SIMD_ENABLED
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include "v8/math/matrix3X3.h"
 #include "v8/math/matrix4X4.h"
 #include "v8/math/vector3.h"
@@ -90,10 +91,35 @@ public :
 
     const math::matrix_4X4<real_t>& get_transform_matrix() const;
 
+    /**
+     * \brief   Writes the transform matrix to mtx, without using or filling
+     *          the cached matrix.
+     */
+    void get_transform_matrix(math::matrix_4X4<real_t>* mtx) const;
+
     void compute_inverse(math::matrix_4X4<real_t>* inv) const;
 
     transform<real_t>& invert();
 
+    /**
+     * \brief   Applies the transform to a point, with the 3X3 matrix, the
+     *          scale and the translation (no 4X4 matrix is built).
+     */
+    inline math::vector3<real_t> transform_point(
+        const math::vector3<real_t>& pt
+        ) const;
+
+    /**
+     * \brief   Applies the matrix and scale components to a vector.
+     */
+    inline math::vector3<real_t> transform_vector(
+        const math::vector3<real_t>& vec
+        ) const;
+
+    /**
+     * \brief   Appends rhs to this transform : the result applies this 
+     *          transform first, then rhs (as a matrix, rhs * this).
+     */
     transform<real_t>& operator*=(const math::transform<real_t>& rhs);
 };
 
@@ -102,6 +128,34 @@ inline
 math::transform<real_t>
 operator*(const math::transform<real_t>&, const math::transform<real_t>&);
 
+/**
+ * \brief   Composes parent/child arrays in one pass : worlds[i] applies 
+ *          locals[i], then parents[i] (worlds[i] = locals[i] * parents[i], 
+ *          the 4X4 matrix is parent * local). worlds can alias locals or
+ *          parents.
+ */
+template<typename real_t>
+void
+compose_transforms(
+    const math::transform<real_t>* parents,
+    const math::transform<real_t>* locals,
+    size_t count,
+    math::transform<real_t>* worlds
+    );
+
+/**
+ * \brief   world = parent * local.get_transform_matrix(), computed from the
+ *          components of local. parent must be an affine matrix (last row
+ *          0, 0, 0, 1); world must not alias parent.
+ */
+template<typename real_t>
+void
+compose_affine(
+    const math::matrix_4X4<real_t>& parent,
+    const math::transform<real_t>& local,
+    math::matrix_4X4<real_t>* world
+    );
+
 typedef transform<float>    transformF;
 typedef transform<double>   transformD;
 
@@ -178,6 +178,28 @@ v8::math::transform<real_t>::get_transform_matrix() const {
     return transform_matrix_;
 }
 
+template<typename real_t>
+void v8::math::transform<real_t>::get_transform_matrix(
+    v8::math::matrix_4X4<real_t>* mtx
+    ) const {
+    if (is_identity_) {
+        mtx->make_identity();
+        return;
+    }
+
+    const v8::math::matrix_3X3<real_t>& m = matrix_component_;
+    const real_t s = is_scale_ ? scale_factor_component_ : real_t(1);
+    const v8::math::vector3<real_t>& t = translation_component_;
+    mtx->a11_ = m.a11_ * s; mtx->a12_ = m.a12_ * s; mtx->a13_ = m.a13_ * s;
+    mtx->a21_ = m.a21_ * s; mtx->a22_ = m.a22_ * s; mtx->a23_ = m.a23_ * s;
+    mtx->a31_ = m.a31_ * s; mtx->a32_ = m.a32_ * s; mtx->a33_ = m.a33_ * s;
+    mtx->a14_ = t.x_;
+    mtx->a24_ = t.y_;
+    mtx->a34_ = t.z_;
+    mtx->a41_ = mtx->a42_ = mtx->a43_ = real_t(0);
+    mtx->a44_ = real_t(1);
+}
+
 template<typename real_t>
 void v8::math::transform<real_t>::compute_inverse(v8::math::matrix_4X4<real_t>* inv) const {
     if (is_identity_) {
@@ -221,9 +243,43 @@ v8::math::transform<real_t>& v8::math::transform<real_t>::invert() {
         scale_factor_component_ = real_t(1) / scale_factor_component_;
         translation_component_ *= scale_factor_component_;
     }
+    cache_valid_ = false;
     return *this;
 }
 
+template<typename real_t>
+inline
+v8::math::vector3<real_t>
+v8::math::transform<real_t>::transform_vector(
+    const v8::math::vector3<real_t>& vec
+    ) const {
+    if (is_identity_)
+        return vec;
+
+    const v8::math::matrix_3X3<real_t>& m = matrix_component_;
+    v8::math::vector3<real_t> result(
+        m.a11_ * vec.x_ + m.a12_ * vec.y_ + m.a13_ * vec.z_,
+        m.a21_ * vec.x_ + m.a22_ * vec.y_ + m.a23_ * vec.z_,
+        m.a31_ * vec.x_ + m.a32_ * vec.y_ + m.a33_ * vec.z_);
+    if (is_scale_)
+        result *= scale_factor_component_;
+    return result;
+}
+
+template<typename real_t>
+inline
+v8::math::vector3<real_t>
+v8::math::transform<real_t>::transform_point(
+    const v8::math::vector3<real_t>& pt
+    ) const {
+    if (is_identity_)
+        return pt;
+
+    v8::math::vector3<real_t> result(transform_vector(pt));
+    result += translation_component_;
+    return result;
+}
+
 template<typename real_t>
 v8::math::transform<real_t>&
 v8::math::transform<real_t>::operator*=(const v8::math::transform<real_t>& rhs) {
@@ -235,18 +291,22 @@ v8::math::transform<real_t>::operator*=(const v8::math::transform<real_t>& rhs)
         return *this;
     }
 
+    //
+    // p' = s2 * M2 * (s1 * M1 * p + t1) + t2, the scales are uniform so
+    // they commute with the matrices.
     cache_valid_ = false;
-    matrix_component_ = rhs.get_matrix_component() * matrix_component_;
+    translation_component_ = rhs.transform_point(translation_component_);
+    matrix_component_ = rhs.matrix_component_ * matrix_component_;
     is_rotation_reflection_ = is_rotation_reflection_ 
-                              || rhs.is_rotation_or_reflection();
+                              && rhs.is_rotation_reflection_;
 
-    if (rhs.is_scaling()) {
+    if (rhs.is_scale_) {
+        scale_factor_component_ = is_scale_ 
+            ? scale_factor_component_ * rhs.scale_factor_component_
+            : rhs.scale_factor_component_;
         is_scale_ = true;
-        scale_factor_component_ *= rhs.get_scale_component();
     }
 
-    translation_component_ = rhs.matrix_component_ * translation_component_;
-    translation_component_ += rhs.translation_component_;
     return *this;
 }
 
@@ -260,4 +320,61 @@ v8::math::operator*(
     transform<real_t> result(lhs);
     result *= rhs;
     return result;
-}
\ No newline at end of file
+}
+
+template<typename real_t>
+void
+v8::math::compose_transforms(
+    const v8::math::transform<real_t>* parents,
+    const v8::math::transform<real_t>* locals,
+    size_t count,
+    v8::math::transform<real_t>* worlds
+    ) {
+    for (size_t i = 0; i < count; ++i) {
+        //
+        // Compose into a copy, worlds[i] can be parents[i] or locals[i].
+        transform<real_t> world(locals[i]);
+        world *= parents[i];
+        worlds[i] = world;
+    }
+}
+
+template<typename real_t>
+void
+v8::math::compose_affine(
+    const v8::math::matrix_4X4<real_t>& parent,
+    const v8::math::transform<real_t>& local,
+    v8::math::matrix_4X4<real_t>* world
+    ) {
+    assert(world != &parent);
+
+    if (local.is_identity()) {
+        *world = parent;
+        return;
+    }
+
+    //
+    // Upper 3X3 : P * (s * M), last column : P * t + parent translation.
+    const v8::math::matrix_3X3<real_t>& m = local.get_matrix_component();
+    const v8::math::vector3<real_t>& t = local.get_translation_component();
+    const real_t s = local.is_scaling() ? local.get_scale_component() 
+                                        : real_t(1);
+    const v8::math::matrix_4X4<real_t>& p = parent;
+
+    for (int r = 0; r < 3; ++r) {
+        const real_t p1 = p.elements_[4 * r];
+        const real_t p2 = p.elements_[4 * r + 1];
+        const real_t p3 = p.elements_[4 * r + 2];
+        const real_t p1s = p1 * s;
+        const real_t p2s = p2 * s;
+        const real_t p3s = p3 * s;
+        real_t* w = world->elements_ + 4 * r;
+        w[0] = p1s * m.a11_ + p2s * m.a21_ + p3s * m.a31_;
+        w[1] = p1s * m.a12_ + p2s * m.a22_ + p3s * m.a32_;
+        w[2] = p1s * m.a13_ + p2s * m.a23_ + p3s * m.a33_;
+        w[3] = p1 * t.x_ + p2 * t.y_ + p3 * t.z_ + p.elements_[4 * r + 3];
+    }
+
+    world->a41_ = world->a42_ = world->a43_ = real_t(0);
+    world->a44_ = real_t(1);
+}
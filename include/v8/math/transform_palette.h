@@ -0,0 +1,233 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include "v8/base/compiler_quirks.h"
+#include "v8/base/parallel_for.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/quaternion.h"
+#include "v8/math/quaternion_soa.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \file    transform_palette.h
+ *
+ * \brief   Builds matrix palettes (one matrix per bone) from rotation,
+ *          translation and scale arrays, M[i] = T[i] * R[i] * S[i], the
+ *          input of a skinning shader. The matrices are written directly,
+ *          without going through quaternion::extract_rotation_matrix() and
+ *          matrix_3X3 objects.
+ *          The 3X4 palettes hold the first 3 rows of each matrix (12 
+ *          elements, row major, the last column is the translation), which
+ *          is enough for affine transforms and uses 25% less memory.
+ *          The rotations must be non null quaternions, they do not have to
+ *          be unit length. The scales can be null, meaning a scale of 1.
+ *          For real_t = float, when V8_SIMD_ENABLED is defined the palettes
+ *          are built 4 bones at a time with SSE.
+ */
+
+/**
+ * \brief   Minimum number of bones in a chunk, when splitting the build of
+ *          a palette across threads.
+ */
+const size_t kTransformPaletteGrainSize = 1024;
+
+namespace internals {
+
+/**
+ * \brief   Scalar kernels for the palette functions. Bone i is written at
+ *          palette + i * rows * 4, the kernels process the bones in 
+ *          [first, last). The SoA versions take arrays of component pointers
+ *          (w, x, y, z for rotations, x, y, z for translations and scales).
+ */
+template<typename real_t>
+struct transform_palette_scalar_kernels {
+    template<size_t rows>
+    static void compose_aos(
+        const quaternion<real_t>* rotations,
+        const vector3<real_t>* translations,
+        const vector3<real_t>* scales,
+        real_t* palette,
+        size_t first,
+        size_t last
+        );
+
+    template<size_t rows>
+    static void compose_soa(
+        const real_t* const* rotations,
+        const real_t* const* translations,
+        const real_t* const* scales,
+        real_t* palette,
+        size_t first,
+        size_t last
+        );
+
+    /**
+     * \brief   Writes the rows of T * R * S at dst.
+     */
+    template<size_t rows>
+    static void compose(
+        real_t w, real_t x, real_t y, real_t z,
+        real_t tx, real_t ty, real_t tz,
+        real_t sx, real_t sy, real_t sz,
+        real_t* dst
+        );
+};
+
+/**
+ * \brief   Kernels used by the palette functions. The float version is 
+ *          specialized in transform_palette_sse.inl.
+ */
+template<typename real_t>
+struct transform_palette_kernels 
+    : public transform_palette_scalar_kernels<real_t> {};
+
+} // namespace internals
+
+/**
+ * \brief   Builds a palette of count 3X4 matrices.
+ * \param   rotations       Array of count rotations.
+ * \param   translations    Array of count translations.
+ * \param   scales          Array of count scale factors, can be null.
+ * \param   count           Number of bones.
+ * \param   palette         Receives 12 * count elements.
+ * \param   max_threads     Maximum number of threads to use, 0 means one per
+ *          hardware thread.
+ */
+template<typename real_t>
+void
+make_transform_palette_3X4(
+    const math::quaternion<real_t>* rotations,
+    const math::vector3<real_t>* translations,
+    const math::vector3<real_t>* scales,
+    size_t count,
+    real_t* palette,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Builds a palette of count matrix_4X4 objects. The last row of
+ *          every matrix is (0, 0, 0, 1).
+ */
+template<typename real_t>
+void
+make_transform_palette_4X4(
+    const math::quaternion<real_t>* rotations,
+    const math::vector3<real_t>* translations,
+    const math::vector3<real_t>* scales,
+    size_t count,
+    math::matrix_4X4<real_t>* palette,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Builds a palette of rotations.size() 3X4 matrices, from SoA
+ *          streams (the output of the quaternion_soa blending functions).
+ *          All the streams must have the same size, scales can be null.
+ */
+template<typename real_t>
+void
+make_transform_palette_3X4(
+    const math::quaternion_soa<real_t>& rotations,
+    const math::vector3_soa<real_t>& translations,
+    const math::vector3_soa<real_t>* scales,
+    real_t* palette,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Builds a palette of rotations.size() matrix_4X4 objects, from SoA
+ *          streams. All the streams must have the same size, scales can be
+ *          null.
+ */
+template<typename real_t>
+void
+make_transform_palette_4X4(
+    const math::quaternion_soa<real_t>& rotations,
+    const math::vector3_soa<real_t>& translations,
+    const math::vector3_soa<real_t>* scales,
+    math::matrix_4X4<real_t>* palette,
+    unsigned int max_threads = 1
+    );
+
+/**
+ * \brief   Overloads for bones without scaling.
+ */
+template<typename real_t>
+inline
+void
+make_transform_palette_3X4(
+    const math::quaternion<real_t>* rotations,
+    const math::vector3<real_t>* translations,
+    size_t count,
+    real_t* palette,
+    unsigned int max_threads = 1
+    );
+
+template<typename real_t>
+inline
+void
+make_transform_palette_4X4(
+    const math::quaternion<real_t>* rotations,
+    const math::vector3<real_t>* translations,
+    size_t count,
+    math::matrix_4X4<real_t>* palette,
+    unsigned int max_threads = 1
+    );
+
+template<typename real_t>
+inline
+void
+make_transform_palette_3X4(
+    const math::quaternion_soa<real_t>& rotations,
+    const math::vector3_soa<real_t>& translations,
+    real_t* palette,
+    unsigned int max_threads = 1
+    );
+
+template<typename real_t>
+inline
+void
+make_transform_palette_4X4(
+    const math::quaternion_soa<real_t>& rotations,
+    const math::vector3_soa<real_t>& translations,
+    math::matrix_4X4<real_t>* palette,
+    unsigned int max_threads = 1
+    );
+
+} // namespace math
+} // namespace v8
+
+#include "transform_palette.inl"
+
+#if defined(V8_SIMD_ENABLED)
+#include "transform_palette_sse.inl"
+#endif
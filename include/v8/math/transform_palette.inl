@@ -0,0 +1,265 @@
+template<typename real_t>
+template<size_t rows>
+inline
+void
+v8::math::internals::transform_palette_scalar_kernels<real_t>::compose(
+    real_t w, real_t x, real_t y, real_t z,
+    real_t tx, real_t ty, real_t tz,
+    real_t sx, real_t sy, real_t sz,
+    real_t* dst
+    )
+{
+    //
+    // Same terms as quaternion::extract_rotation_matrix(), the columns are 
+    // then multiplied with the scale factors.
+    const real_t s = real_t(2) / (w * w + x * x + y * y + z * z);
+
+    const real_t xs = s * x;
+    const real_t ys = s * y;
+    const real_t zs = s * z;
+
+    const real_t wx = w * xs;
+    const real_t wy = w * ys;
+    const real_t wz = w * zs;
+
+    const real_t xx = x * xs;
+    const real_t xy = x * ys;
+    const real_t xz = x * zs;
+
+    const real_t yy = y * ys;
+    const real_t yz = y * zs;
+
+    const real_t zz = z * zs;
+
+    dst[0] = (real_t(1) - (yy + zz)) * sx;
+    dst[1] = (xy - wz) * sy;
+    dst[2] = (xz + wy) * sz;
+    dst[3] = tx;
+
+    dst[4] = (xy + wz) * sx;
+    dst[5] = (real_t(1) - (xx + zz)) * sy;
+    dst[6] = (yz - wx) * sz;
+    dst[7] = ty;
+
+    dst[8] = (xz - wy) * sx;
+    dst[9] = (yz + wx) * sy;
+    dst[10] = (real_t(1) - (xx + yy)) * sz;
+    dst[11] = tz;
+
+    if (rows == 4) {
+        dst[12] = real_t(0);
+        dst[13] = real_t(0);
+        dst[14] = real_t(0);
+        dst[15] = real_t(1);
+    }
+}
+
+template<typename real_t>
+template<size_t rows>
+void
+v8::math::internals::transform_palette_scalar_kernels<real_t>::compose_aos(
+    const v8::math::quaternion<real_t>* rotations,
+    const v8::math::vector3<real_t>* translations,
+    const v8::math::vector3<real_t>* scales,
+    real_t* palette,
+    size_t first,
+    size_t last
+    )
+{
+    for (size_t i = first; i < last; ++i) {
+        const quaternion<real_t>& q = rotations[i];
+        const vector3<real_t>& t = translations[i];
+        compose<rows>(q.w_, q.x_, q.y_, q.z_, t.x_, t.y_, t.z_,
+                      scales ? scales[i].x_ : real_t(1),
+                      scales ? scales[i].y_ : real_t(1),
+                      scales ? scales[i].z_ : real_t(1),
+                      palette + i * rows * 4);
+    }
+}
+
+template<typename real_t>
+template<size_t rows>
+void
+v8::math::internals::transform_palette_scalar_kernels<real_t>::compose_soa(
+    const real_t* const* rotations,
+    const real_t* const* translations,
+    const real_t* const* scales,
+    real_t* palette,
+    size_t first,
+    size_t last
+    )
+{
+    for (size_t i = first; i < last; ++i) {
+        compose<rows>(
+            rotations[0][i], rotations[1][i], rotations[2][i], rotations[3][i],
+            translations[0][i], translations[1][i], translations[2][i],
+            scales ? scales[0][i] : real_t(1),
+            scales ? scales[1][i] : real_t(1),
+            scales ? scales[2][i] : real_t(1),
+            palette + i * rows * 4);
+    }
+}
+
+template<typename real_t>
+void
+v8::math::make_transform_palette_3X4(
+    const v8::math::quaternion<real_t>* rotations,
+    const v8::math::vector3<real_t>* translations,
+    const v8::math::vector3<real_t>* scales,
+    size_t count,
+    real_t* palette,
+    unsigned int max_threads
+    )
+{
+    base::parallel_for(count, kTransformPaletteGrainSize, max_threads,
+                       [=](size_t first, size_t last) {
+        internals::transform_palette_kernels<real_t>::template compose_aos<3>(
+            rotations, translations, scales, palette, first, last);
+    });
+}
+
+template<typename real_t>
+void
+v8::math::make_transform_palette_4X4(
+    const v8::math::quaternion<real_t>* rotations,
+    const v8::math::vector3<real_t>* translations,
+    const v8::math::vector3<real_t>* scales,
+    size_t count,
+    v8::math::matrix_4X4<real_t>* palette,
+    unsigned int max_threads
+    )
+{
+    real_t* dst = palette->elements_;
+    base::parallel_for(count, kTransformPaletteGrainSize, max_threads,
+                       [=](size_t first, size_t last) {
+        internals::transform_palette_kernels<real_t>::template compose_aos<4>(
+            rotations, translations, scales, dst, first, last);
+    });
+}
+
+namespace v8 { namespace math { namespace internals {
+
+template<size_t rows, typename real_t>
+void
+make_transform_palette_soa(
+    const quaternion_soa<real_t>& rotations,
+    const vector3_soa<real_t>& translations,
+    const vector3_soa<real_t>* scales,
+    real_t* palette,
+    unsigned int max_threads
+    )
+{
+    assert(rotations.size() == translations.size());
+    assert(!scales || scales->size() == rotations.size());
+
+    const real_t* const* r = rotations.components();
+    const real_t* const t[3] = { 
+        translations.x(), translations.y(), translations.z() 
+    };
+    const real_t* const s_arrays[3] = { 
+        scales ? scales->x() : nullptr, 
+        scales ? scales->y() : nullptr, 
+        scales ? scales->z() : nullptr 
+    };
+    const real_t* const* s = scales ? s_arrays : nullptr;
+
+    base::parallel_for(rotations.size(), kTransformPaletteGrainSize, 
+                       max_threads, [&](size_t first, size_t last) {
+        transform_palette_kernels<real_t>::template compose_soa<rows>(
+            r, t, s, palette, first, last);
+    });
+}
+
+} // namespace internals
+} // namespace math
+} // namespace v8
+
+template<typename real_t>
+void
+v8::math::make_transform_palette_3X4(
+    const v8::math::quaternion_soa<real_t>& rotations,
+    const v8::math::vector3_soa<real_t>& translations,
+    const v8::math::vector3_soa<real_t>* scales,
+    real_t* palette,
+    unsigned int max_threads
+    )
+{
+    internals::make_transform_palette_soa<3>(
+        rotations, translations, scales, palette, max_threads);
+}
+
+template<typename real_t>
+void
+v8::math::make_transform_palette_4X4(
+    const v8::math::quaternion_soa<real_t>& rotations,
+    const v8::math::vector3_soa<real_t>& translations,
+    const v8::math::vector3_soa<real_t>* scales,
+    v8::math::matrix_4X4<real_t>* palette,
+    unsigned int max_threads
+    )
+{
+    internals::make_transform_palette_soa<4>(
+        rotations, translations, scales, palette->elements_, max_threads);
+}
+
+template<typename real_t>
+inline
+void
+v8::math::make_transform_palette_3X4(
+    const v8::math::quaternion<real_t>* rotations,
+    const v8::math::vector3<real_t>* translations,
+    size_t count,
+    real_t* palette,
+    unsigned int max_threads
+    )
+{
+    const vector3<real_t>* no_scales = nullptr;
+    make_transform_palette_3X4(rotations, translations, no_scales, count, 
+                               palette, max_threads);
+}
+
+template<typename real_t>
+inline
+void
+v8::math::make_transform_palette_4X4(
+    const v8::math::quaternion<real_t>* rotations,
+    const v8::math::vector3<real_t>* translations,
+    size_t count,
+    v8::math::matrix_4X4<real_t>* palette,
+    unsigned int max_threads
+    )
+{
+    const vector3<real_t>* no_scales = nullptr;
+    make_transform_palette_4X4(rotations, translations, no_scales, count, 
+                               palette, max_threads);
+}
+
+template<typename real_t>
+inline
+void
+v8::math::make_transform_palette_3X4(
+    const v8::math::quaternion_soa<real_t>& rotations,
+    const v8::math::vector3_soa<real_t>& translations,
+    real_t* palette,
+    unsigned int max_threads
+    )
+{
+    const vector3_soa<real_t>* no_scales = nullptr;
+    internals::make_transform_palette_soa<3>(
+        rotations, translations, no_scales, palette, max_threads);
+}
+
+template<typename real_t>
+inline
+void
+v8::math::make_transform_palette_4X4(
+    const v8::math::quaternion_soa<real_t>& rotations,
+    const v8::math::vector3_soa<real_t>& translations,
+    v8::math::matrix_4X4<real_t>* palette,
+    unsigned int max_threads
+    )
+{
+    const vector3_soa<real_t>* no_scales = nullptr;
+    internals::make_transform_palette_soa<4>(
+        rotations, translations, no_scales, palette->elements_, max_threads);
+}
@@ -0,0 +1,146 @@
+#include "v8/math/sse_utils.h"
+
+namespace v8 { namespace math { namespace internals {
+
+/**
+ * \brief   SSE kernels for the float palettes. The rotations, translations
+ *          and scales of 4 bones are loaded in SoA form (AoS inputs are 
+ *          transposed), the matrix elements are computed for the 4 bones at
+ *          once and each group of rows is transposed back before the store.
+ */
+template<>
+struct transform_palette_kernels<float> {
+    typedef transform_palette_scalar_kernels<float> scalar_kernels_t;
+
+    template<size_t rows>
+    static void compose4(
+        __m128 w, __m128 x, __m128 y, __m128 z,
+        __m128 tx, __m128 ty, __m128 tz,
+        __m128 sx, __m128 sy, __m128 sz,
+        float* dst
+        )
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 len_sq = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(w, w), _mm_mul_ps(x, x)),
+            _mm_add_ps(_mm_mul_ps(y, y), _mm_mul_ps(z, z)));
+        const __m128 s = _mm_div_ps(_mm_set1_ps(2.0f), len_sq);
+
+        const __m128 xs = _mm_mul_ps(s, x);
+        const __m128 ys = _mm_mul_ps(s, y);
+        const __m128 zs = _mm_mul_ps(s, z);
+
+        const __m128 wx = _mm_mul_ps(w, xs);
+        const __m128 wy = _mm_mul_ps(w, ys);
+        const __m128 wz = _mm_mul_ps(w, zs);
+
+        const __m128 xx = _mm_mul_ps(x, xs);
+        const __m128 xy = _mm_mul_ps(x, ys);
+        const __m128 xz = _mm_mul_ps(x, zs);
+
+        const __m128 yy = _mm_mul_ps(y, ys);
+        const __m128 yz = _mm_mul_ps(y, zs);
+
+        const __m128 zz = _mm_mul_ps(z, zs);
+
+        //
+        // r[row][column] holds that element for the 4 bones, the transpose
+        // turns it into one matrix row per register.
+        __m128 r[3][4];
+        r[0][0] = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx);
+        r[0][1] = _mm_mul_ps(_mm_sub_ps(xy, wz), sy);
+        r[0][2] = _mm_mul_ps(_mm_add_ps(xz, wy), sz);
+        r[0][3] = tx;
+
+        r[1][0] = _mm_mul_ps(_mm_add_ps(xy, wz), sx);
+        r[1][1] = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy);
+        r[1][2] = _mm_mul_ps(_mm_sub_ps(yz, wx), sz);
+        r[1][3] = ty;
+
+        r[2][0] = _mm_mul_ps(_mm_sub_ps(xz, wy), sx);
+        r[2][1] = _mm_mul_ps(_mm_add_ps(yz, wx), sy);
+        r[2][2] = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz);
+        r[2][3] = tz;
+
+        const __m128 last_row = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+        for (size_t row = 0; row < 3; ++row) {
+            _MM_TRANSPOSE4_PS(r[row][0], r[row][1], r[row][2], r[row][3]);
+            for (size_t bone = 0; bone < 4; ++bone)
+                _mm_storeu_ps(dst + bone * rows * 4 + row * 4, r[row][bone]);
+        }
+
+        if (rows == 4) {
+            for (size_t bone = 0; bone < 4; ++bone)
+                _mm_storeu_ps(dst + bone * rows * 4 + 12, last_row);
+        }
+    }
+
+    template<size_t rows>
+    static void compose_aos(
+        const quaternion<float>* rotations,
+        const vector3<float>* translations,
+        const vector3<float>* scales,
+        float* palette,
+        size_t first,
+        size_t last
+        )
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const size_t simd_last = first + ((last - first) & ~size_t(3));
+
+        for (size_t i = first; i < simd_last; i += 4) {
+            __m128 w = _mm_loadu_ps(rotations[i].elements_);
+            __m128 x = _mm_loadu_ps(rotations[i + 1].elements_);
+            __m128 y = _mm_loadu_ps(rotations[i + 2].elements_);
+            __m128 z = _mm_loadu_ps(rotations[i + 3].elements_);
+            _MM_TRANSPOSE4_PS(w, x, y, z);
+
+            __m128 tx, ty, tz;
+            sse::load_vector3x4(translations[i].elements_, &tx, &ty, &tz);
+
+            __m128 sx = one, sy = one, sz = one;
+            if (scales)
+                sse::load_vector3x4(scales[i].elements_, &sx, &sy, &sz);
+
+            compose4<rows>(w, x, y, z, tx, ty, tz, sx, sy, sz, 
+                           palette + i * rows * 4);
+        }
+
+        scalar_kernels_t::template compose_aos<rows>(
+            rotations, translations, scales, palette, simd_last, last);
+    }
+
+    template<size_t rows>
+    static void compose_soa(
+        const float* const* rotations,
+        const float* const* translations,
+        const float* const* scales,
+        float* palette,
+        size_t first,
+        size_t last
+        )
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const size_t simd_last = first + ((last - first) & ~size_t(3));
+
+        for (size_t i = first; i < simd_last; i += 4) {
+            compose4<rows>(
+                _mm_loadu_ps(rotations[0] + i), _mm_loadu_ps(rotations[1] + i),
+                _mm_loadu_ps(rotations[2] + i), _mm_loadu_ps(rotations[3] + i),
+                _mm_loadu_ps(translations[0] + i), 
+                _mm_loadu_ps(translations[1] + i),
+                _mm_loadu_ps(translations[2] + i),
+                scales ? _mm_loadu_ps(scales[0] + i) : one,
+                scales ? _mm_loadu_ps(scales[1] + i) : one,
+                scales ? _mm_loadu_ps(scales[2] + i) : one,
+                palette + i * rows * 4);
+        }
+
+        scalar_kernels_t::template compose_soa<rows>(
+            rotations, translations, scales, palette, simd_last, last);
+    }
+};
+
+} // namespace internals
+} // namespace math
+} // namespace v8
@@ -174,6 +174,21 @@ public:
         }
         return *this;
     }
+
+    /**
+     * \brief   Normalizes the vector, computing 1 / ||v|| with the specified
+     *          precision (see precision_policy).
+     */
+    template<precision_policy policy>
+    vector2<real_t>& normalize() {
+        const real_t len_sq = sum_components_squared();
+        if (len_sq <= constants::kEpsilon * constants::kEpsilon) {
+            x_ = y_ = real_t(0);
+        } else {
+            *this *= math::inv_sqrt<policy>(len_sq);
+        }
+        return *this;
+    }
 };
 
 template<typename real_t>
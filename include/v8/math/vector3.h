@@ -171,6 +171,14 @@ public:
      * \brief   Normalizes the vector (v = v / ||v||);
      */
     inline vector3<real_t>& normalize();
+
+    /**
+     * \brief   Normalizes the vector, computing 1 / ||v|| with the specified
+     *          precision (see precision_policy). 
+     *          Usage : v.normalize<precision_fast>().
+     */
+    template<precision_policy policy>
+    inline vector3<real_t>& normalize();
 };
 
 /**
@@ -0,0 +1,325 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include "v8/base/aligned_memory.h"
+#include "v8/base/compiler_quirks.h"
+#include "v8/math/vector3.h"
+
+namespace v8 { namespace math {
+
+namespace internals {
+
+/**
+ * \brief   Scalar kernels for the vector3_soa operations. They work on 
+ *          separate x, y, z arrays of count elements. The output arrays can
+ *          be the same as the input arrays.
+ */
+template<typename real_t>
+struct vector3_soa_scalar_kernels {
+    static void add(const real_t* a, const real_t* b, real_t* out, size_t count);
+
+    static void subtract(const real_t* a, const real_t* b, real_t* out, size_t count);
+
+    static void scale(const real_t* a, real_t k, real_t* out, size_t count);
+
+    static void lerp(
+        const real_t* a, const real_t* b, real_t t, real_t* out, size_t count
+        );
+
+    static void dot(
+        const real_t* ax, const real_t* ay, const real_t* az,
+        const real_t* bx, const real_t* by, const real_t* bz,
+        real_t* out, size_t count
+        );
+
+    static void cross(
+        const real_t* ax, const real_t* ay, const real_t* az,
+        const real_t* bx, const real_t* by, const real_t* bz,
+        real_t* out_x, real_t* out_y, real_t* out_z, size_t count
+        );
+
+    static void magnitude(
+        const real_t* x, const real_t* y, const real_t* z,
+        real_t* out, size_t count
+        );
+
+    template<precision_policy policy>
+    static void normalize(real_t* x, real_t* y, real_t* z, size_t count);
+
+    static void min_max(
+        const real_t* a, size_t count, real_t* min_val, real_t* max_val
+        );
+};
+
+/**
+ * \brief   Kernels used by vector3_soa. The float version is specialized in
+ *          vector3_soa_sse.inl.
+ */
+template<typename real_t>
+struct vector3_soa_kernels : public vector3_soa_scalar_kernels<real_t> {};
+
+} // namespace internals
+
+/**
+ * \class   vector3_soa
+ *
+ * \brief   A stream of vector3 objects, stored as three separate arrays
+ *          for the x, y and z components (structure of arrays). Each array
+ *          starts on a kAlignment byte boundary and has room for a multiple of
+ *          kAlignment / sizeof(real_t) elements, so SIMD code can process
+ *          the components 4 (SSE) or 8 (AVX) at a time.
+ *          Use it for large sets of vectors that get the same operation
+ *          applied to all the elements (particles, physics bodies, etc).
+ *          Converting to and from arrays of vector3 (assign() and copy_to())
+ *          has to copy the data, since the layouts are different.
+ * \remarks For real_t = float, when V8_SIMD_ENABLED is defined the operations
+ *          use SSE.
+ */
+template<typename real_t>
+class vector3_soa {
+public :
+    enum {
+        kAlignment = 32,
+        kElementsPerBlock = kAlignment / sizeof(real_t)
+    };
+
+    typedef real_t                      element_type;
+    typedef vector3<real_t>             vector3_t;
+    typedef vector3_soa<real_t>         vector3_soa_t;
+
+    vector3_soa() : x_(nullptr), y_(nullptr), z_(nullptr), size_(0), capacity_(0) {}
+
+    /**
+     * \brief   Constructs a stream of count elements, all set to (0, 0, 0).
+     */
+    explicit vector3_soa(size_t count);
+
+    /**
+     * \brief   Constructs a stream with a copy of count vector3 objects.
+     */
+    vector3_soa(const vector3_t* src, size_t count);
+
+    vector3_soa(const vector3_soa_t& other);
+
+    vector3_soa_t& operator=(const vector3_soa_t& other);
+
+    ~vector3_soa() {
+        base::aligned_free(x_);
+    }
+
+    void swap(vector3_soa_t& other);
+
+    size_t size() const {
+        return size_;
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    bool empty() const {
+        return !size_;
+    }
+
+    /**
+     * \brief   Changes the number of elements. Existing elements are kept,
+     *          new elements are set to (0, 0, 0).
+     */
+    void resize(size_t count);
+
+    /**
+     * \brief   Makes room for at least count elements, without changing size().
+     */
+    void reserve(size_t count);
+
+    void clear() {
+        size_ = 0;
+    }
+
+    real_t* x() {
+        return x_;
+    }
+
+    const real_t* x() const {
+        return x_;
+    }
+
+    real_t* y() {
+        return y_;
+    }
+
+    const real_t* y() const {
+        return y_;
+    }
+
+    real_t* z() {
+        return z_;
+    }
+
+    const real_t* z() const {
+        return z_;
+    }
+
+    vector3_t get(size_t index) const {
+        assert(index < size_);
+        return vector3_t(x_[index], y_[index], z_[index]);
+    }
+
+    void set(size_t index, const vector3_t& value) {
+        assert(index < size_);
+        x_[index] = value.x_;
+        y_[index] = value.y_;
+        z_[index] = value.z_;
+    }
+
+    /**
+     * \brief   Replaces the contents with a copy of count vector3 objects
+     *          (gather from AoS).
+     */
+    void assign(const vector3_t* src, size_t count);
+
+    /**
+     * \brief   Copies the elements to an array of size() vector3 objects
+     *          (scatter to AoS).
+     */
+    void copy_to(vector3_t* dst) const;
+
+    /**
+     * \brief   Element wise addition. rhs must have the same size.
+     */
+    vector3_soa_t& operator+=(const vector3_soa_t& rhs);
+
+    /**
+     * \brief   Element wise subtraction. rhs must have the same size.
+     */
+    vector3_soa_t& operator-=(const vector3_soa_t& rhs);
+
+    /**
+     * \brief   Multiplies all the elements with a scalar.
+     */
+    vector3_soa_t& operator*=(real_t k);
+
+    /**
+     * \brief   Normalizes all the elements. None of them can be the null vector.
+     */
+    vector3_soa_t& normalize();
+
+    /**
+     * \brief   Normalizes all the elements, computing 1 / ||v|| with the
+     *          specified precision (see precision_policy).
+     */
+    template<precision_policy policy>
+    vector3_soa_t& normalize();
+
+private :
+    void reallocate(size_t capacity);
+
+    real_t*     x_;
+    real_t*     y_;
+    real_t*     z_;
+    size_t      size_;
+    size_t      capacity_;
+};
+
+/**
+ * \brief   out[i] = lhs[i] + t * (rhs[i] - lhs[i]). lhs and rhs must have
+ *          the same size, out is resized to match. out can be lhs or rhs.
+ */
+template<typename real_t>
+void
+lerp(
+    const math::vector3_soa<real_t>& lhs,
+    const math::vector3_soa<real_t>& rhs,
+    real_t t,
+    math::vector3_soa<real_t>* out
+    );
+
+/**
+ * \brief   out[i] = dot_product(lhs[i], rhs[i]). out must have room for 
+ *          lhs.size() elements.
+ */
+template<typename real_t>
+void
+dot_product(
+    const math::vector3_soa<real_t>& lhs,
+    const math::vector3_soa<real_t>& rhs,
+    real_t* out
+    );
+
+/**
+ * \brief   out[i] = cross_product(lhs[i], rhs[i]). out is resized to match,
+ *          and can be lhs or rhs.
+ */
+template<typename real_t>
+void
+cross_product(
+    const math::vector3_soa<real_t>& lhs,
+    const math::vector3_soa<real_t>& rhs,
+    math::vector3_soa<real_t>* out
+    );
+
+/**
+ * \brief   out[i] = vec[i].magnitude(). out must have room for vec.size()
+ *          elements.
+ */
+template<typename real_t>
+void
+magnitude(
+    const math::vector3_soa<real_t>& vec,
+    real_t* out
+    );
+
+/**
+ * \brief   Computes the component wise minimum and maximum of all the
+ *          elements (the corners of the bounding box). vec cannot be empty.
+ */
+template<typename real_t>
+void
+min_max(
+    const math::vector3_soa<real_t>& vec,
+    math::vector3<real_t>* min_val,
+    math::vector3<real_t>* max_val
+    );
+
+typedef vector3_soa<float>     vector3_soaF;
+
+typedef vector3_soa<double>    vector3_soaD;
+
+} // namespace math
+} // namespace v8
+
+#include "vector3_soa.inl"
+
+#if defined(V8_SIMD_ENABLED)
+#include "vector3_soa_sse.inl"
+#endif
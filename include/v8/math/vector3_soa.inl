@@ -0,0 +1,377 @@
+template<typename real_t>
+void
+v8::math::internals::vector3_soa_scalar_kernels<real_t>::add(
+    const real_t* a,
+    const real_t* b,
+    real_t* out,
+    size_t count
+    )
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = a[i] + b[i];
+}
+
+template<typename real_t>
+void
+v8::math::internals::vector3_soa_scalar_kernels<real_t>::subtract(
+    const real_t* a,
+    const real_t* b,
+    real_t* out,
+    size_t count
+    )
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = a[i] - b[i];
+}
+
+template<typename real_t>
+void
+v8::math::internals::vector3_soa_scalar_kernels<real_t>::scale(
+    const real_t* a,
+    real_t k,
+    real_t* out,
+    size_t count
+    )
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = a[i] * k;
+}
+
+template<typename real_t>
+void
+v8::math::internals::vector3_soa_scalar_kernels<real_t>::lerp(
+    const real_t* a,
+    const real_t* b,
+    real_t t,
+    real_t* out,
+    size_t count
+    )
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = a[i] + t * (b[i] - a[i]);
+}
+
+template<typename real_t>
+void
+v8::math::internals::vector3_soa_scalar_kernels<real_t>::dot(
+    const real_t* ax, const real_t* ay, const real_t* az,
+    const real_t* bx, const real_t* by, const real_t* bz,
+    real_t* out,
+    size_t count
+    )
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+}
+
+template<typename real_t>
+void
+v8::math::internals::vector3_soa_scalar_kernels<real_t>::cross(
+    const real_t* ax, const real_t* ay, const real_t* az,
+    const real_t* bx, const real_t* by, const real_t* bz,
+    real_t* out_x, real_t* out_y, real_t* out_z,
+    size_t count
+    )
+{
+    for (size_t i = 0; i < count; ++i) {
+        const real_t x = ay[i] * bz[i] - az[i] * by[i];
+        const real_t y = az[i] * bx[i] - ax[i] * bz[i];
+        const real_t z = ax[i] * by[i] - ay[i] * bx[i];
+        out_x[i] = x;
+        out_y[i] = y;
+        out_z[i] = z;
+    }
+}
+
+template<typename real_t>
+void
+v8::math::internals::vector3_soa_scalar_kernels<real_t>::magnitude(
+    const real_t* x, const real_t* y, const real_t* z,
+    real_t* out,
+    size_t count
+    )
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+}
+
+template<typename real_t>
+template<v8::math::precision_policy policy>
+void
+v8::math::internals::vector3_soa_scalar_kernels<real_t>::normalize(
+    real_t* x,
+    real_t* y,
+    real_t* z,
+    size_t count
+    )
+{
+    for (size_t i = 0; i < count; ++i) {
+        const real_t len_sq = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+        assert(!math::is_zero(len_sq));
+        const real_t inv_len = math::inv_sqrt<policy>(len_sq);
+        x[i] *= inv_len;
+        y[i] *= inv_len;
+        z[i] *= inv_len;
+    }
+}
+
+template<typename real_t>
+void
+v8::math::internals::vector3_soa_scalar_kernels<real_t>::min_max(
+    const real_t* a,
+    size_t count,
+    real_t* min_val,
+    real_t* max_val
+    )
+{
+    assert(count);
+    real_t mn = a[0];
+    real_t mx = a[0];
+    for (size_t i = 1; i < count; ++i) {
+        mn = a[i] < mn ? a[i] : mn;
+        mx = a[i] > mx ? a[i] : mx;
+    }
+    *min_val = mn;
+    *max_val = mx;
+}
+
+template<typename real_t>
+v8::math::vector3_soa<real_t>::vector3_soa(size_t count)
+    : x_(nullptr), y_(nullptr), z_(nullptr), size_(0), capacity_(0)
+{
+    resize(count);
+}
+
+template<typename real_t>
+v8::math::vector3_soa<real_t>::vector3_soa(
+    const vector3_t* src,
+    size_t count
+    )
+    : x_(nullptr), y_(nullptr), z_(nullptr), size_(0), capacity_(0)
+{
+    assign(src, count);
+}
+
+template<typename real_t>
+v8::math::vector3_soa<real_t>::vector3_soa(const vector3_soa_t& other)
+    : x_(nullptr), y_(nullptr), z_(nullptr), size_(0), capacity_(0)
+{
+    reallocate(other.size_);
+    std::memcpy(x_, other.x_, other.size_ * sizeof(real_t));
+    std::memcpy(y_, other.y_, other.size_ * sizeof(real_t));
+    std::memcpy(z_, other.z_, other.size_ * sizeof(real_t));
+    size_ = other.size_;
+}
+
+template<typename real_t>
+v8::math::vector3_soa<real_t>&
+v8::math::vector3_soa<real_t>::operator=(const vector3_soa_t& other) {
+    if (this != &other) {
+        vector3_soa_t tmp(other);
+        swap(tmp);
+    }
+    return *this;
+}
+
+template<typename real_t>
+void
+v8::math::vector3_soa<real_t>::swap(vector3_soa_t& other) {
+    using std::swap;
+    swap(x_, other.x_);
+    swap(y_, other.y_);
+    swap(z_, other.z_);
+    swap(size_, other.size_);
+    swap(capacity_, other.capacity_);
+}
+
+template<typename real_t>
+void
+v8::math::vector3_soa<real_t>::reallocate(size_t capacity) {
+    //
+    // One block for all 3 arrays. The capacity is rounded up to a multiple
+    // of kElementsPerBlock, so y_ and z_ are aligned too.
+    capacity = (capacity + kElementsPerBlock - 1) & ~size_t(kElementsPerBlock - 1);
+    if (!capacity)
+        capacity = kElementsPerBlock;
+
+    real_t* block = static_cast<real_t*>(
+        base::aligned_malloc(3 * capacity * sizeof(real_t), kAlignment));
+    assert(block);
+    std::memset(block, 0, 3 * capacity * sizeof(real_t));
+
+    const size_t kept = size_ < capacity ? size_ : capacity;
+    if (x_) {
+        std::memcpy(block, x_, kept * sizeof(real_t));
+        std::memcpy(block + capacity, y_, kept * sizeof(real_t));
+        std::memcpy(block + 2 * capacity, z_, kept * sizeof(real_t));
+        base::aligned_free(x_);
+    }
+
+    x_ = block;
+    y_ = block + capacity;
+    z_ = block + 2 * capacity;
+    capacity_ = capacity;
+}
+
+template<typename real_t>
+void
+v8::math::vector3_soa<real_t>::reserve(size_t count) {
+    if (count > capacity_ || !x_)
+        reallocate(count);
+}
+
+template<typename real_t>
+void
+v8::math::vector3_soa<real_t>::resize(size_t count) {
+    if (count > capacity_ || !x_) {
+        reallocate(count);
+    } else if (count > size_) {
+        std::memset(x_ + size_, 0, (count - size_) * sizeof(real_t));
+        std::memset(y_ + size_, 0, (count - size_) * sizeof(real_t));
+        std::memset(z_ + size_, 0, (count - size_) * sizeof(real_t));
+    }
+    size_ = count;
+}
+
+template<typename real_t>
+void
+v8::math::vector3_soa<real_t>::assign(
+    const vector3_t* src,
+    size_t count
+    )
+{
+    resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        x_[i] = src[i].x_;
+        y_[i] = src[i].y_;
+        z_[i] = src[i].z_;
+    }
+}
+
+template<typename real_t>
+void
+v8::math::vector3_soa<real_t>::copy_to(vector3_t* dst) const {
+    for (size_t i = 0; i < size_; ++i) {
+        dst[i].x_ = x_[i];
+        dst[i].y_ = y_[i];
+        dst[i].z_ = z_[i];
+    }
+}
+
+template<typename real_t>
+v8::math::vector3_soa<real_t>&
+v8::math::vector3_soa<real_t>::operator+=(const vector3_soa_t& rhs) {
+    assert(size_ == rhs.size_);
+    typedef internals::vector3_soa_kernels<real_t> kernels_t;
+    kernels_t::add(x_, rhs.x_, x_, size_);
+    kernels_t::add(y_, rhs.y_, y_, size_);
+    kernels_t::add(z_, rhs.z_, z_, size_);
+    return *this;
+}
+
+template<typename real_t>
+v8::math::vector3_soa<real_t>&
+v8::math::vector3_soa<real_t>::operator-=(const vector3_soa_t& rhs) {
+    assert(size_ == rhs.size_);
+    typedef internals::vector3_soa_kernels<real_t> kernels_t;
+    kernels_t::subtract(x_, rhs.x_, x_, size_);
+    kernels_t::subtract(y_, rhs.y_, y_, size_);
+    kernels_t::subtract(z_, rhs.z_, z_, size_);
+    return *this;
+}
+
+template<typename real_t>
+v8::math::vector3_soa<real_t>&
+v8::math::vector3_soa<real_t>::operator*=(real_t k) {
+    typedef internals::vector3_soa_kernels<real_t> kernels_t;
+    kernels_t::scale(x_, k, x_, size_);
+    kernels_t::scale(y_, k, y_, size_);
+    kernels_t::scale(z_, k, z_, size_);
+    return *this;
+}
+
+template<typename real_t>
+v8::math::vector3_soa<real_t>&
+v8::math::vector3_soa<real_t>::normalize() {
+    return normalize<precision_exact>();
+}
+
+template<typename real_t>
+template<v8::math::precision_policy policy>
+v8::math::vector3_soa<real_t>&
+v8::math::vector3_soa<real_t>::normalize() {
+    internals::vector3_soa_kernels<real_t>::template normalize<policy>(
+        x_, y_, z_, size_);
+    return *this;
+}
+
+template<typename real_t>
+void
+v8::math::lerp(
+    const v8::math::vector3_soa<real_t>& lhs,
+    const v8::math::vector3_soa<real_t>& rhs,
+    real_t t,
+    v8::math::vector3_soa<real_t>* out
+    )
+{
+    assert(lhs.size() == rhs.size());
+    typedef internals::vector3_soa_kernels<real_t> kernels_t;
+    const size_t count = lhs.size();
+    out->resize(count);
+    kernels_t::lerp(lhs.x(), rhs.x(), t, out->x(), count);
+    kernels_t::lerp(lhs.y(), rhs.y(), t, out->y(), count);
+    kernels_t::lerp(lhs.z(), rhs.z(), t, out->z(), count);
+}
+
+template<typename real_t>
+void
+v8::math::dot_product(
+    const v8::math::vector3_soa<real_t>& lhs,
+    const v8::math::vector3_soa<real_t>& rhs,
+    real_t* out
+    )
+{
+    assert(lhs.size() == rhs.size());
+    internals::vector3_soa_kernels<real_t>::dot(
+        lhs.x(), lhs.y(), lhs.z(), rhs.x(), rhs.y(), rhs.z(), out, lhs.size());
+}
+
+template<typename real_t>
+void
+v8::math::cross_product(
+    const v8::math::vector3_soa<real_t>& lhs,
+    const v8::math::vector3_soa<real_t>& rhs,
+    v8::math::vector3_soa<real_t>* out
+    )
+{
+    assert(lhs.size() == rhs.size());
+    out->resize(lhs.size());
+    internals::vector3_soa_kernels<real_t>::cross(
+        lhs.x(), lhs.y(), lhs.z(), rhs.x(), rhs.y(), rhs.z(),
+        out->x(), out->y(), out->z(), lhs.size());
+}
+
+template<typename real_t>
+void
+v8::math::magnitude(
+    const v8::math::vector3_soa<real_t>& vec,
+    real_t* out
+    )
+{
+    internals::vector3_soa_kernels<real_t>::magnitude(
+        vec.x(), vec.y(), vec.z(), out, vec.size());
+}
+
+template<typename real_t>
+void
+v8::math::min_max(
+    const v8::math::vector3_soa<real_t>& vec,
+    v8::math::vector3<real_t>* min_val,
+    v8::math::vector3<real_t>* max_val
+    )
+{
+    typedef internals::vector3_soa_kernels<real_t> kernels_t;
+    kernels_t::min_max(vec.x(), vec.size(), &min_val->x_, &max_val->x_);
+    kernels_t::min_max(vec.y(), vec.size(), &min_val->y_, &max_val->y_);
+    kernels_t::min_max(vec.z(), vec.size(), &min_val->z_, &max_val->z_);
+}
@@ -0,0 +1,190 @@
+#include <xmmintrin.h>
+
+namespace v8 { namespace math { namespace internals {
+
+/**
+ * \brief   SSE kernels for vector3_soa<float>. Every loop processes 4
+ *          elements per iteration, the remaining elements are handled by
+ *          the scalar kernels. Unaligned loads/stores are used, since some
+ *          of the outputs are user supplied arrays; on the vector3_soa
+ *          arrays, which are aligned, they are as fast as the aligned ones.
+ */
+template<>
+struct vector3_soa_kernels<float> {
+    typedef vector3_soa_scalar_kernels<float> scalar_kernels_t;
+
+    static void add(const float* a, const float* b, float* out, size_t count) {
+        const size_t simd_count = count & ~size_t(3);
+        for (size_t i = 0; i < simd_count; i += 4)
+            _mm_storeu_ps(out + i,
+                          _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+
+        scalar_kernels_t::add(a + simd_count, b + simd_count,
+                              out + simd_count, count - simd_count);
+    }
+
+    static void subtract(const float* a, const float* b, float* out, size_t count) {
+        const size_t simd_count = count & ~size_t(3);
+        for (size_t i = 0; i < simd_count; i += 4)
+            _mm_storeu_ps(out + i,
+                          _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+
+        scalar_kernels_t::subtract(a + simd_count, b + simd_count,
+                                   out + simd_count, count - simd_count);
+    }
+
+    static void scale(const float* a, float k, float* out, size_t count) {
+        const __m128 kv = _mm_set1_ps(k);
+        const size_t simd_count = count & ~size_t(3);
+        for (size_t i = 0; i < simd_count; i += 4)
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), kv));
+
+        scalar_kernels_t::scale(a + simd_count, k, out + simd_count,
+                                count - simd_count);
+    }
+
+    static void lerp(
+        const float* a, const float* b, float t, float* out, size_t count
+        )
+    {
+        const __m128 tv = _mm_set1_ps(t);
+        const size_t simd_count = count & ~size_t(3);
+        for (size_t i = 0; i < simd_count; i += 4) {
+            const __m128 av = _mm_loadu_ps(a + i);
+            const __m128 bv = _mm_loadu_ps(b + i);
+            _mm_storeu_ps(out + i,
+                          _mm_add_ps(av, _mm_mul_ps(tv, _mm_sub_ps(bv, av))));
+        }
+
+        scalar_kernels_t::lerp(a + simd_count, b + simd_count, t,
+                               out + simd_count, count - simd_count);
+    }
+
+    static void dot(
+        const float* ax, const float* ay, const float* az,
+        const float* bx, const float* by, const float* bz,
+        float* out, size_t count
+        )
+    {
+        const size_t simd_count = count & ~size_t(3);
+        for (size_t i = 0; i < simd_count; i += 4) {
+            const __m128 xx = _mm_mul_ps(_mm_loadu_ps(ax + i), _mm_loadu_ps(bx + i));
+            const __m128 yy = _mm_mul_ps(_mm_loadu_ps(ay + i), _mm_loadu_ps(by + i));
+            const __m128 zz = _mm_mul_ps(_mm_loadu_ps(az + i), _mm_loadu_ps(bz + i));
+            _mm_storeu_ps(out + i, _mm_add_ps(_mm_add_ps(xx, yy), zz));
+        }
+
+        const size_t n = simd_count;
+        scalar_kernels_t::dot(ax + n, ay + n, az + n, bx + n, by + n, bz + n,
+                              out + n, count - n);
+    }
+
+    static void cross(
+        const float* ax, const float* ay, const float* az,
+        const float* bx, const float* by, const float* bz,
+        float* out_x, float* out_y, float* out_z, size_t count
+        )
+    {
+        const size_t simd_count = count & ~size_t(3);
+        for (size_t i = 0; i < simd_count; i += 4) {
+            const __m128 a_x = _mm_loadu_ps(ax + i);
+            const __m128 a_y = _mm_loadu_ps(ay + i);
+            const __m128 a_z = _mm_loadu_ps(az + i);
+            const __m128 b_x = _mm_loadu_ps(bx + i);
+            const __m128 b_y = _mm_loadu_ps(by + i);
+            const __m128 b_z = _mm_loadu_ps(bz + i);
+
+            _mm_storeu_ps(out_x + i, _mm_sub_ps(_mm_mul_ps(a_y, b_z),
+                                                _mm_mul_ps(a_z, b_y)));
+            _mm_storeu_ps(out_y + i, _mm_sub_ps(_mm_mul_ps(a_z, b_x),
+                                                _mm_mul_ps(a_x, b_z)));
+            _mm_storeu_ps(out_z + i, _mm_sub_ps(_mm_mul_ps(a_x, b_y),
+                                                _mm_mul_ps(a_y, b_x)));
+        }
+
+        const size_t n = simd_count;
+        scalar_kernels_t::cross(ax + n, ay + n, az + n, bx + n, by + n, bz + n,
+                                out_x + n, out_y + n, out_z + n, count - n);
+    }
+
+    static void magnitude(
+        const float* x, const float* y, const float* z,
+        float* out, size_t count
+        )
+    {
+        const size_t simd_count = count & ~size_t(3);
+        for (size_t i = 0; i < simd_count; i += 4) {
+            const __m128 xv = _mm_loadu_ps(x + i);
+            const __m128 yv = _mm_loadu_ps(y + i);
+            const __m128 zv = _mm_loadu_ps(z + i);
+            const __m128 len_sq = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(xv, xv), _mm_mul_ps(yv, yv)),
+                _mm_mul_ps(zv, zv));
+            _mm_storeu_ps(out + i, _mm_sqrt_ps(len_sq));
+        }
+
+        const size_t n = simd_count;
+        scalar_kernels_t::magnitude(x + n, y + n, z + n, out + n, count - n);
+    }
+
+    template<precision_policy policy>
+    static void normalize(float* x, float* y, float* z, size_t count) {
+        const size_t simd_count = count & ~size_t(3);
+        for (size_t i = 0; i < simd_count; i += 4) {
+            const __m128 xv = _mm_loadu_ps(x + i);
+            const __m128 yv = _mm_loadu_ps(y + i);
+            const __m128 zv = _mm_loadu_ps(z + i);
+            const __m128 inv_len = sse::inv_sqrt<policy>(_mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(xv, xv), _mm_mul_ps(yv, yv)),
+                _mm_mul_ps(zv, zv)));
+            _mm_storeu_ps(x + i, _mm_mul_ps(xv, inv_len));
+            _mm_storeu_ps(y + i, _mm_mul_ps(yv, inv_len));
+            _mm_storeu_ps(z + i, _mm_mul_ps(zv, inv_len));
+        }
+
+        const size_t n = simd_count;
+        scalar_kernels_t::template normalize<policy>(
+            x + n, y + n, z + n, count - n);
+    }
+
+    static void min_max(
+        const float* a, size_t count, float* min_val, float* max_val
+        )
+    {
+        assert(count);
+        if (count < 4) {
+            scalar_kernels_t::min_max(a, count, min_val, max_val);
+            return;
+        }
+
+        __m128 mn = _mm_loadu_ps(a);
+        __m128 mx = mn;
+        const size_t simd_count = count & ~size_t(3);
+        for (size_t i = 4; i < simd_count; i += 4) {
+            const __m128 v = _mm_loadu_ps(a + i);
+            mn = _mm_min_ps(mn, v);
+            mx = _mm_max_ps(mx, v);
+        }
+
+        //
+        // Reduce the 4 lanes, then fold in the remaining elements.
+        mn = _mm_min_ps(mn, _mm_shuffle_ps(mn, mn, _MM_SHUFFLE(1, 0, 3, 2)));
+        mn = _mm_min_ps(mn, _mm_shuffle_ps(mn, mn, _MM_SHUFFLE(2, 3, 0, 1)));
+        mx = _mm_max_ps(mx, _mm_shuffle_ps(mx, mx, _MM_SHUFFLE(1, 0, 3, 2)));
+        mx = _mm_max_ps(mx, _mm_shuffle_ps(mx, mx, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        float result_min = _mm_cvtss_f32(mn);
+        float result_max = _mm_cvtss_f32(mx);
+        for (size_t i = simd_count; i < count; ++i) {
+            result_min = a[i] < result_min ? a[i] : result_min;
+            result_max = a[i] > result_max ? a[i] : result_max;
+        }
+
+        *min_val = result_min;
+        *max_val = result_max;
+    }
+};
+
+} // namespace internals
+} // namespace math
+} // namespace v8
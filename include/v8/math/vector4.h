@@ -266,6 +266,17 @@ public :
     inline
     vector4<real_t>& 
     normalize();
+
+    /**
+     * \brief   Normalizes the vector, computing 1 / ||v|| with the specified
+     *          precision (see precision_policy).
+     *
+     * \remarks Only valid if the object represents a vector.
+     */
+    template<precision_policy policy>
+    inline
+    vector4<real_t>& 
+    normalize();
 };
 
 template<typename real_t>
@@ -122,6 +122,20 @@ v8::math::vector4<real_t>::normalize() {
     return *this;
 }
 
+template<typename real_t>
+template<v8::math::precision_policy policy>
+inline
+v8::math::vector4<real_t>&
+v8::math::vector4<real_t>::normalize() {
+    const real_t len_sq = sum_components_squared();
+    if (len_sq <= constants::kEpsilon * constants::kEpsilon) {
+        x_ = y_ = z_ = real_t(0);
+    } else {
+        *this *= math::inv_sqrt<policy>(len_sq);
+    }
+    return *this;
+}
+
 template<typename real_t>
 inline
 bool
@@ -0,0 +1,443 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include "v8/math/math_utils.h"
+#include "v8/math/vector2.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector4.h"
+
+namespace v8 { namespace math { namespace expr {
+
+/**
+ * \file    vector_expression.h
+ *
+ * \brief   Opt-in expression templates for vector2, vector3 and vector4
+ *          arithmetic. Wrapping one operand with lazy() turns the whole
+ *          expression into a tree of small objects, which is evaluated in a
+ *          single pass when assigned to a vector, with no temporary vectors.
+ *          Since every component is computed by a single expression, the 
+ *          compiler can also contract the multiply/add pairs into FMA 
+ *          instructions (when allowed, /fp:contract or -ffp-contract=fast).
+ * \code
+ *  using v8::math::expr::lazy;
+ *  vector3F r = lazy(a) * s + lazy(b) * t - c;
+ * \endcode
+ *          Supported : +, - between vectors/expressions, unary -, * and / 
+ *          with a scalar, += and -= with an expression. The existing vector
+ *          operators are not affected.
+ * \remarks The expression keeps references to its operands, so it must be
+ *          evaluated in the statement that builds it (do not store it in an
+ *          auto variable).
+ *          Only the x, y, z components of a vector4 are computed and w is
+ *          set to 0, as the vector4 subtraction does. This differs from the
+ *          vector4 scalar * and / operators and from += and -=, which keep
+ *          the w of their vector operand, so lazy() can change the result
+ *          when w is not 0.
+ */
+
+/**
+ * \brief   Number of components used by the expressions, for each vector
+ *          type.
+ */
+template<typename vector_t>
+struct vector_traits;
+
+template<typename real_t>
+struct vector_traits<vector2<real_t> > {
+    enum { dimension = 2 };
+
+    static void finish(vector2<real_t>*) {}
+};
+
+template<typename real_t>
+struct vector_traits<vector3<real_t> > {
+    enum { dimension = 3 };
+
+    static void finish(vector3<real_t>*) {}
+};
+
+template<typename real_t>
+struct vector_traits<vector4<real_t> > {
+    enum { dimension = 3 };
+
+    static void finish(vector4<real_t>* result) {
+        result->w_ = real_t(0);
+    }
+};
+
+/**
+ * \brief   Evaluates components [0, count) of an expression, unrolled at 
+ *          compile time, so every component is computed with constant 
+ *          indices.
+ */
+template<size_t count>
+struct unrolled {
+    template<typename real_t, typename expr_t>
+    static void assign(real_t* dst, const expr_t& e) {
+        unrolled<count - 1>::assign(dst, e);
+        dst[count - 1] = e[count - 1];
+    }
+
+    template<typename real_t, typename expr_t>
+    static void add(real_t* dst, const expr_t& e) {
+        unrolled<count - 1>::add(dst, e);
+        dst[count - 1] += e[count - 1];
+    }
+
+    template<typename real_t, typename expr_t>
+    static void subtract(real_t* dst, const expr_t& e) {
+        unrolled<count - 1>::subtract(dst, e);
+        dst[count - 1] -= e[count - 1];
+    }
+};
+
+template<>
+struct unrolled<0> {
+    template<typename real_t, typename expr_t>
+    static void assign(real_t*, const expr_t&) {}
+
+    template<typename real_t, typename expr_t>
+    static void add(real_t*, const expr_t&) {}
+
+    template<typename real_t, typename expr_t>
+    static void subtract(real_t*, const expr_t&) {}
+};
+
+/**
+ * \brief   Base of all the expression nodes (CRTP). Converts to vector_t, 
+ *          by evaluating the expression once per component.
+ */
+template<typename derived_t, typename vector_t>
+struct expression {
+    typedef vector_t                                vector_type;
+    typedef typename vector_t::element_type         element_type;
+
+    const derived_t& self() const {
+        return static_cast<const derived_t&>(*this);
+    }
+
+    void evaluate(vector_t* result) const {
+        unrolled<vector_traits<vector_t>::dimension>::assign(
+            result->elements_, self());
+        vector_traits<vector_t>::finish(result);
+    }
+
+    vector_t evaluate() const {
+        vector_t result;
+        evaluate(&result);
+        return result;
+    }
+
+    operator vector_t() const {
+        return evaluate();
+    }
+};
+
+/**
+ * \brief   Leaf node, references a vector.
+ */
+template<typename vector_t>
+struct vector_ref : public expression<vector_ref<vector_t>, vector_t> {
+    typedef typename vector_t::element_type element_type;
+
+    explicit vector_ref(const vector_t& vec) : vec_(vec) {}
+
+    element_type operator[](size_t i) const {
+        return vec_.elements_[i];
+    }
+
+    const vector_t& vec_;
+};
+
+struct add_op {
+    template<typename real_t>
+    static real_t apply(real_t lhs, real_t rhs) {
+        return lhs + rhs;
+    }
+};
+
+struct subtract_op {
+    template<typename real_t>
+    static real_t apply(real_t lhs, real_t rhs) {
+        return lhs - rhs;
+    }
+};
+
+/**
+ * \brief   lhs op rhs, component wise.
+ */
+template<typename lhs_t, typename rhs_t, typename op_t, typename vector_t>
+struct binary_expression 
+    : public expression<binary_expression<lhs_t, rhs_t, op_t, vector_t>, vector_t> {
+    typedef typename vector_t::element_type element_type;
+
+    binary_expression(const lhs_t& lhs, const rhs_t& rhs) 
+        : lhs_(lhs), rhs_(rhs) {}
+
+    element_type operator[](size_t i) const {
+        return op_t::apply(lhs_[i], rhs_[i]);
+    }
+
+    lhs_t   lhs_;
+    rhs_t   rhs_;
+};
+
+/**
+ * \brief   expr * k, component wise.
+ */
+template<typename expr_t, typename vector_t>
+struct scaled_expression 
+    : public expression<scaled_expression<expr_t, vector_t>, vector_t> {
+    typedef typename vector_t::element_type element_type;
+
+    scaled_expression(const expr_t& e, element_type k) : expr_(e), k_(k) {}
+
+    element_type operator[](size_t i) const {
+        return expr_[i] * k_;
+    }
+
+    expr_t          expr_;
+    element_type    k_;
+};
+
+/**
+ * \brief   expr / k, component wise. Uses the same helpers as the vector
+ *          operator/=, so floating point vectors are multiplied by 1 / k and
+ *          integer vectors are divided by k.
+ */
+template<typename expr_t, typename vector_t>
+struct divided_expression 
+    : public expression<divided_expression<expr_t, vector_t>, vector_t> {
+    typedef typename vector_t::element_type element_type;
+
+    typedef internals::divide_helper<
+        element_type, 
+        vector_t::is_floating_point
+    >                                       div_helper_t;
+
+    divided_expression(const expr_t& e, element_type k) 
+        : expr_(e), 
+          k_(internals::transform_dividend_for_division<
+                element_type, 
+                vector_t::is_floating_point
+             >::transform(k)) {}
+
+    element_type operator[](size_t i) const {
+        return div_helper_t::divide(expr_[i], k_);
+    }
+
+    expr_t          expr_;
+    element_type    k_;
+};
+
+/**
+ * \brief   -expr, component wise.
+ */
+template<typename expr_t, typename vector_t>
+struct negated_expression 
+    : public expression<negated_expression<expr_t, vector_t>, vector_t> {
+    typedef typename vector_t::element_type element_type;
+
+    explicit negated_expression(const expr_t& e) : expr_(e) {}
+
+    element_type operator[](size_t i) const {
+        return -expr_[i];
+    }
+
+    expr_t  expr_;
+};
+
+/**
+ * \brief   Starts an expression.
+ */
+template<typename real_t>
+inline vector_ref<vector2<real_t> > lazy(const vector2<real_t>& vec) {
+    return vector_ref<vector2<real_t> >(vec);
+}
+
+template<typename real_t>
+inline vector_ref<vector3<real_t> > lazy(const vector3<real_t>& vec) {
+    return vector_ref<vector3<real_t> >(vec);
+}
+
+template<typename real_t>
+inline vector_ref<vector4<real_t> > lazy(const vector4<real_t>& vec) {
+    return vector_ref<vector4<real_t> >(vec);
+}
+
+template<typename lhs_t, typename rhs_t, typename vector_t>
+inline
+binary_expression<lhs_t, rhs_t, add_op, vector_t>
+operator+(
+    const expression<lhs_t, vector_t>& lhs, 
+    const expression<rhs_t, vector_t>& rhs
+    ) 
+{
+    return binary_expression<lhs_t, rhs_t, add_op, vector_t>(
+        lhs.self(), rhs.self());
+}
+
+template<typename lhs_t, typename vector_t>
+inline
+binary_expression<lhs_t, vector_ref<vector_t>, add_op, vector_t>
+operator+(
+    const expression<lhs_t, vector_t>& lhs, 
+    const vector_t& rhs
+    ) 
+{
+    return binary_expression<lhs_t, vector_ref<vector_t>, add_op, vector_t>(
+        lhs.self(), vector_ref<vector_t>(rhs));
+}
+
+template<typename rhs_t, typename vector_t>
+inline
+binary_expression<vector_ref<vector_t>, rhs_t, add_op, vector_t>
+operator+(
+    const vector_t& lhs,
+    const expression<rhs_t, vector_t>& rhs
+    ) 
+{
+    return binary_expression<vector_ref<vector_t>, rhs_t, add_op, vector_t>(
+        vector_ref<vector_t>(lhs), rhs.self());
+}
+
+template<typename lhs_t, typename rhs_t, typename vector_t>
+inline
+binary_expression<lhs_t, rhs_t, subtract_op, vector_t>
+operator-(
+    const expression<lhs_t, vector_t>& lhs, 
+    const expression<rhs_t, vector_t>& rhs
+    ) 
+{
+    return binary_expression<lhs_t, rhs_t, subtract_op, vector_t>(
+        lhs.self(), rhs.self());
+}
+
+template<typename lhs_t, typename vector_t>
+inline
+binary_expression<lhs_t, vector_ref<vector_t>, subtract_op, vector_t>
+operator-(
+    const expression<lhs_t, vector_t>& lhs, 
+    const vector_t& rhs
+    ) 
+{
+    return binary_expression<lhs_t, vector_ref<vector_t>, subtract_op, vector_t>(
+        lhs.self(), vector_ref<vector_t>(rhs));
+}
+
+template<typename rhs_t, typename vector_t>
+inline
+binary_expression<vector_ref<vector_t>, rhs_t, subtract_op, vector_t>
+operator-(
+    const vector_t& lhs,
+    const expression<rhs_t, vector_t>& rhs
+    ) 
+{
+    return binary_expression<vector_ref<vector_t>, rhs_t, subtract_op, vector_t>(
+        vector_ref<vector_t>(lhs), rhs.self());
+}
+
+template<typename expr_t, typename vector_t>
+inline
+negated_expression<expr_t, vector_t>
+operator-(
+    const expression<expr_t, vector_t>& e
+    )
+{
+    return negated_expression<expr_t, vector_t>(e.self());
+}
+
+template<typename expr_t, typename vector_t>
+inline
+scaled_expression<expr_t, vector_t>
+operator*(
+    const expression<expr_t, vector_t>& e,
+    typename vector_t::element_type k
+    )
+{
+    return scaled_expression<expr_t, vector_t>(e.self(), k);
+}
+
+template<typename expr_t, typename vector_t>
+inline
+scaled_expression<expr_t, vector_t>
+operator*(
+    typename vector_t::element_type k,
+    const expression<expr_t, vector_t>& e
+    )
+{
+    return scaled_expression<expr_t, vector_t>(e.self(), k);
+}
+
+template<typename expr_t, typename vector_t>
+inline
+divided_expression<expr_t, vector_t>
+operator/(
+    const expression<expr_t, vector_t>& e,
+    typename vector_t::element_type k
+    )
+{
+    return divided_expression<expr_t, vector_t>(e.self(), k);
+}
+
+/**
+ * \brief   vec += expr, in a single pass.
+ */
+template<typename expr_t, typename vector_t>
+inline
+vector_t&
+operator+=(
+    vector_t& lhs,
+    const expression<expr_t, vector_t>& rhs
+    )
+{
+    unrolled<vector_traits<vector_t>::dimension>::add(
+        lhs.elements_, rhs.self());
+    return lhs;
+}
+
+/**
+ * \brief   vec -= expr, in a single pass.
+ */
+template<typename expr_t, typename vector_t>
+inline
+vector_t&
+operator-=(
+    vector_t& lhs,
+    const expression<expr_t, vector_t>& rhs
+    )
+{
+    unrolled<vector_traits<vector_t>::dimension>::subtract(
+        lhs.elements_, rhs.self());
+    return lhs;
+}
+
+} // namespace expr
+} // namespace math
+} // namespace v8
@@ -0,0 +1,158 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "v8/base/compiler_quirks.h"
+#include "v8/math/camera.h"
+#include "v8/math/frustum.h"
+#include "v8/math/vector3_soa.h"
+
+namespace v8 { namespace math {
+
+/**
+ * \brief   Number of instances in a culling task. It is a multiple of 16,
+ *          so the index ranges written by different tasks never share a
+ *          cache line.
+ */
+const size_t kVisibilityCullChunkSize = 4096;
+
+/**
+ * \class   visibility_culler
+ *
+ * \brief   Culls a set of instances, given by their bounding spheres, 
+ *          against several views in one call, and keeps the list of 
+ *          visible instance indices for each view.
+ *          The work is split into (view, chunk of kVisibilityCullChunkSize
+ *          instances) tasks, that the threads of base::thread_pool::shared()
+ *          take one at a time. Every task writes its visible indices to
+ *          its own slice of the view's index buffer, so no locks are 
+ *          needed; a second pass packs the slices, per view, into a 
+ *          contiguous list. The buffers are kept between calls, so culling
+ *          the same number of views and instances does not allocate.
+ * \remarks An instance is visible if its sphere is inside or intersects
+ *          the frustum. The visible indices are sorted in increasing order.
+ */
+class visibility_culler {
+public :
+    /**
+     * \param   max_threads     Maximum number of threads used by cull(),
+     *                          0 for all the hardware threads.
+     */
+    explicit visibility_culler(unsigned int max_threads = 0)
+        : view_count_(0), max_threads_(max_threads) {}
+
+    ~visibility_culler();
+
+    unsigned int get_max_threads() const {
+        return max_threads_;
+    }
+
+    void set_max_threads(unsigned int max_threads) {
+        max_threads_ = max_threads;
+    }
+
+    /**
+     * \brief   Culls the instances against view_count frustums. radius must
+     *          have centers.size() elements, none of them negative.
+     */
+    void cull(
+        const frustum* views,
+        size_t view_count,
+        const vector3_soaF& centers,
+        const float* radius
+        );
+
+    /**
+     * \brief   Culls the instances against the view volumes of 
+     *          camera_count cameras.
+     */
+    void cull(
+        const camera* cameras,
+        size_t camera_count,
+        const vector3_soaF& centers,
+        const float* radius
+        );
+
+    /**
+     * \brief   Number of views from the last call to cull().
+     */
+    size_t view_count() const {
+        return view_count_;
+    }
+
+    size_t visible_count(size_t view) const {
+        assert(view < view_count_);
+        return views_[view].visible_count;
+    }
+
+    /**
+     * \brief   The indices of the instances visible in a view, 
+     *          visible_count(view) elements. The pointer is valid until the
+     *          next call to cull().
+     */
+    const uint32_t* visible_indices(size_t view) const {
+        assert(view < view_count_);
+        return views_[view].indices;
+    }
+
+private :
+    NO_CC_ASSIGN(visibility_culler);
+
+    struct view_data {
+        uint32_t*   indices;
+        size_t      capacity;
+        size_t      visible_count;
+    };
+
+    /**
+     * \brief   Makes room for view_count views of instance_count indices.
+     */
+    void reserve(size_t view_count, size_t instance_count);
+
+    /**
+     * \brief   Number of visible instances found by a task. Padded to a
+     *          cache line, since the counts are written by different 
+     *          threads at the same time.
+     */
+    struct chunk_count {
+        uint32_t    value;
+        uint8_t     padding[60];
+    };
+
+    std::vector<view_data>      views_;
+    std::vector<frustum>        frustums_;
+    /// One per task (view major).
+    std::vector<chunk_count>    chunk_counts_;
+    size_t                      view_count_;
+    unsigned int                max_threads_;
+};
+
+} // namespace math
+} // namespace v8
@@ -0,0 +1,186 @@
+#include "pch_hdr.h"
+#include <cctype>
+#include "v8/base/compiler_quirks.h"
+#include "v8/base/count_of.h"
+#include "v8/base/cpu_features.h"
+
+#if defined(MSVC_BUILD_SYSTEM)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+namespace {
+
+/**
+ * \brief   Executes cpuid for the given leaf/subleaf.
+ *          regs receives eax, ebx, ecx, edx.
+ */
+void
+query_cpuid(
+    unsigned int leaf,
+    unsigned int subleaf,
+    unsigned int regs[4]
+    )
+{
+#if defined(MSVC_BUILD_SYSTEM)
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i)
+        regs[i] = static_cast<unsigned int>(info[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/**
+ * \brief   Returns the low 32 bits of the XCR0 register, that tells which
+ *          register sets the operating system saves on context switches.
+ */
+unsigned int
+query_xcr0() {
+#if defined(MSVC_BUILD_SYSTEM)
+    return static_cast<unsigned int>(_xgetbv(0));
+#else
+    unsigned int eax;
+    unsigned int edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return eax;
+#endif
+}
+
+unsigned int
+detect_cpu_features() {
+    using v8::base::cpu_feature;
+
+    unsigned int regs[4];
+    query_cpuid(0, 0, regs);
+    const unsigned int max_leaf = regs[0];
+    if (max_leaf < 1)
+        return 0;
+
+    unsigned int features = 0;
+    query_cpuid(1, 0, regs);
+    const unsigned int ecx1 = regs[2];
+    const unsigned int edx1 = regs[3];
+
+    if (edx1 & (1u << 26))
+        features |= cpu_feature::sse2;
+    if (ecx1 & (1u << 0))
+        features |= cpu_feature::sse3;
+    if (ecx1 & (1u << 9))
+        features |= cpu_feature::ssse3;
+    if (ecx1 & (1u << 19))
+        features |= cpu_feature::sse41;
+    if (ecx1 & (1u << 20))
+        features |= cpu_feature::sse42;
+
+    //
+    // The AVX family also needs OS support for saving the ymm/zmm registers.
+    const bool has_osxsave = (ecx1 & (1u << 27)) != 0;
+    const unsigned int xcr0 = has_osxsave ? query_xcr0() : 0;
+    const bool os_saves_ymm = (xcr0 & 0x06) == 0x06;
+    const bool os_saves_zmm = (xcr0 & 0xE6) == 0xE6;
+
+    if (!os_saves_ymm)
+        return features;
+
+    if (ecx1 & (1u << 28))
+        features |= cpu_feature::avx;
+    if (ecx1 & (1u << 12))
+        features |= cpu_feature::fma;
+
+    if (max_leaf >= 7) {
+        query_cpuid(7, 0, regs);
+        const unsigned int ebx7 = regs[1];
+        if (ebx7 & (1u << 5))
+            features |= cpu_feature::avx2;
+        if (os_saves_zmm && (ebx7 & (1u << 16)))
+            features |= cpu_feature::avx512f;
+    }
+
+    return features;
+}
+
+v8::base::simd_tier
+tier_from_features(unsigned int features) {
+    using namespace v8::base;
+
+    if (features & cpu_feature::avx512f)
+        return simd_tier_avx512;
+
+    const unsigned int kAvx2Mask = cpu_feature::avx2 | cpu_feature::fma;
+    if ((features & kAvx2Mask) == kAvx2Mask)
+        return simd_tier_avx2;
+    if (features & cpu_feature::avx)
+        return simd_tier_avx;
+    if (features & cpu_feature::sse41)
+        return simd_tier_sse41;
+    if (features & cpu_feature::sse2)
+        return simd_tier_sse2;
+    return simd_tier_scalar;
+}
+
+const char* const kTierNames[] = {
+    "scalar", "sse2", "sse41", "avx", "avx2", "avx512"
+};
+
+bool
+names_equal_nocase(const char* lhs, const char* rhs) {
+    for (; *lhs && *rhs; ++lhs, ++rhs) {
+        if (std::tolower(static_cast<unsigned char>(*lhs)) 
+            != std::tolower(static_cast<unsigned char>(*rhs)))
+            return false;
+    }
+    return *lhs == *rhs;
+}
+
+v8::base::simd_tier
+detect_host_simd_tier() {
+    using namespace v8::base;
+
+    simd_tier tier = tier_from_features(cpu_features());
+
+    const char* override_name = std::getenv("V8_SIMD_TIER");
+    simd_tier override_tier;
+    if (override_name && simd_tier_from_name(override_name, &override_tier)
+        && override_tier < tier)
+        tier = override_tier;
+
+    return tier;
+}
+
+} // anonymous namespace
+
+unsigned int
+v8::base::cpu_features() {
+    static const unsigned int features = detect_cpu_features();
+    return features;
+}
+
+v8::base::simd_tier
+v8::base::host_simd_tier() {
+    static const simd_tier tier = detect_host_simd_tier();
+    return tier;
+}
+
+const char*
+v8::base::simd_tier_name(simd_tier tier) {
+    assert(tier >= simd_tier_scalar && tier < simd_tier_count);
+    return kTierNames[tier];
+}
+
+bool
+v8::base::simd_tier_from_name(
+    const char* name,
+    simd_tier* tier
+    )
+{
+    for (size_t i = 0; i < count_of_array(kTierNames); ++i) {
+        if (names_equal_nocase(name, kTierNames[i])) {
+            *tier = static_cast<simd_tier>(i);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,152 @@
+#include "pch_hdr.h"
+#include "v8/base/thread_pool.h"
+
+namespace {
+
+/**
+ * \brief   Number of times a thread polls a barrier before it starts to
+ *          yield its time slice. Levels of a hierarchy or phases of a job
+ *          are usually short, so a short spin avoids going to sleep.
+ */
+const unsigned int kBarrierSpinCount = 4096;
+
+} // anonymous namespace
+
+void v8::base::parallel_region::barrier() {
+    if (thread_count_ > 1)
+        pool_->region_barrier(thread_count_);
+}
+
+v8::base::thread_pool::thread_pool(unsigned int thread_count)
+    : job_(nullptr),
+      job_context_(nullptr),
+      job_threads_(0),
+      pending_(0),
+      generation_(0),
+      stop_(false),
+      busy_(false),
+      barrier_arrived_(0),
+      barrier_generation_(0)
+{
+    const unsigned int worker_count = effective_thread_count(thread_count) - 1;
+    workers_.reserve(worker_count);
+    for (unsigned int i = 0; i < worker_count; ++i)
+        workers_.push_back(std::thread(&thread_pool::worker_loop, this, i + 1));
+}
+
+v8::base::thread_pool::~thread_pool() {
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        stop_ = true;
+    }
+    work_ready_.notify_all();
+
+    for (size_t i = 0; i < workers_.size(); ++i)
+        workers_[i].join();
+}
+
+v8::base::thread_pool& v8::base::thread_pool::shared() {
+    static thread_pool pool;
+    return pool;
+}
+
+void v8::base::thread_pool::dispatch(
+    unsigned int max_threads,
+    job_fn_t job,
+    void* context
+    ) {
+    unsigned int thread_count = this->thread_count();
+    if (max_threads && max_threads < thread_count)
+        thread_count = max_threads;
+
+    bool idle = false;
+    if (thread_count <= 1
+        || !busy_.compare_exchange_strong(idle, true,
+                                          std::memory_order_acquire)) {
+        //
+        // Busy, or a job submitted from inside a job : run it here.
+        parallel_region region(this, 0, 1);
+        job(context, region);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        job_ = job;
+        job_context_ = context;
+        job_threads_ = thread_count;
+        pending_ = thread_count - 1;
+        barrier_arrived_.store(0, std::memory_order_relaxed);
+        ++generation_;
+    }
+    work_ready_.notify_all();
+
+    parallel_region region(this, 0, thread_count);
+    job(context, region);
+
+    {
+        std::unique_lock<std::mutex> lock(lock_);
+        while (pending_)
+            work_done_.wait(lock);
+    }
+    busy_.store(false, std::memory_order_release);
+}
+
+void v8::base::thread_pool::worker_loop(unsigned int thread_index) {
+    unsigned int seen_generation = 0;
+
+    for (;;) {
+        job_fn_t job;
+        void* context;
+        unsigned int thread_count;
+        {
+            std::unique_lock<std::mutex> lock(lock_);
+            while (!stop_ && generation_ == seen_generation)
+                work_ready_.wait(lock);
+
+            if (stop_)
+                return;
+
+            seen_generation = generation_;
+            job = job_;
+            context = job_context_;
+            thread_count = job_threads_;
+        }
+
+        //
+        // Workers that are not needed for this job go back to sleep. A
+        // worker that is needed cannot miss a job, since the next one is
+        // not submitted until this one is done.
+        if (thread_index >= thread_count)
+            continue;
+
+        parallel_region region(this, thread_index, thread_count);
+        job(context, region);
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(lock_);
+            last = --pending_ == 0;
+        }
+        if (last)
+            work_done_.notify_one();
+    }
+}
+
+void v8::base::thread_pool::region_barrier(unsigned int thread_count) {
+    const unsigned int generation =
+        barrier_generation_.load(std::memory_order_acquire);
+
+    if (barrier_arrived_.fetch_add(1, std::memory_order_acq_rel) + 1
+        == thread_count) {
+        barrier_arrived_.store(0, std::memory_order_relaxed);
+        barrier_generation_.fetch_add(1, std::memory_order_release);
+        return;
+    }
+
+    unsigned int spins = 0;
+    while (barrier_generation_.load(std::memory_order_acquire) == generation) {
+        if (++spins > kBarrierSpinCount)
+            std::this_thread::yield();
+    }
+}
@@ -0,0 +1,484 @@
+#include "pch_hdr.h"
+#include "v8/base/parallel_for.h"
+#include "v8/math/animation_clip.h"
+
+#if defined(V8_SIMD_ENABLED)
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+/**
+ * \brief   The three smallest components of a unit quaternion (after making
+ *          the largest one positive) are in [-kRotationRange, kRotationRange].
+ */
+const float kRotationRange = 0.707106781f;
+const float kRotationStep = 2.0f * kRotationRange / 65535.0f;
+
+/**
+ * \brief   Longest segment, in frames, between two kept keys. Bounds the
+ *          cost of the key reduction to kMaxKeySpan error evaluations per
+ *          frame and track.
+ */
+const size_t kMaxKeySpan = 256;
+
+uint16_t
+quantize_unit(float value) {
+    const float q = std::floor(value * 65535.0f + 0.5f);
+    return static_cast<uint16_t>(std::min(std::max(q, 0.0f), 65535.0f));
+}
+
+/**
+ * \brief   Smallest three encoding, key[0..2] are the quantized components
+ *          other than the largest one (in w, x, y, z order), key[3] is the
+ *          index of the largest one.
+ */
+void
+encode_rotation(const v8::math::quaternionF& rotation, uint16_t* key) {
+    const float* q = rotation.elements_;
+    size_t largest = 0;
+    for (size_t j = 1; j < 4; ++j) {
+        if (std::fabs(q[j]) > std::fabs(q[largest]))
+            largest = j;
+    }
+
+    const float sign = q[largest] < 0.0f ? -1.0f : 1.0f;
+    size_t stored = 0;
+    for (size_t j = 0; j < 4; ++j) {
+        if (j != largest) {
+            key[stored++] = quantize_unit(
+                (sign * q[j] + kRotationRange) / (2.0f * kRotationRange));
+        }
+    }
+    key[3] = static_cast<uint16_t>(largest);
+}
+
+v8::math::quaternionF
+decode_rotation(const uint16_t* key) {
+    const float a = key[0] * kRotationStep - kRotationRange;
+    const float b = key[1] * kRotationStep - kRotationRange;
+    const float c = key[2] * kRotationStep - kRotationRange;
+    const float largest = std::sqrt(
+        std::max(1.0f - a * a - b * b - c * c, 0.0f));
+
+    const float stored[3] = { a, b, c };
+    const size_t index = key[3];
+    float q[4];
+    for (size_t j = 0; j < 4; ++j) {
+        if (j == index)
+            q[j] = largest;
+        else
+            q[j] = stored[j < index ? j : j - 1];
+    }
+    return v8::math::quaternionF(q[0], q[1], q[2], q[3]);
+}
+
+/**
+ * \brief   Angle between two rotations, ignoring the sign of the 
+ *          quaternions. Computed from the chord length, acos() of the dot
+ *          product is too coarse in single precision for small angles.
+ */
+float
+rotation_error(const v8::math::quaternionF& a, const v8::math::quaternionF& b) {
+    const float sign = dot_product(a, b) < 0.0f ? -1.0f : 1.0f;
+    float chord_sq = 0.0f;
+    for (size_t j = 0; j < 4; ++j) {
+        const float d = a.elements_[j] - sign * b.elements_[j];
+        chord_sq += d * d;
+    }
+    return 4.0f * std::asin(std::min(0.5f * std::sqrt(chord_sq), 1.0f));
+}
+
+/**
+ * \brief   Pointers to the key data of a clip and to the outputs of a 
+ *          sampler.
+ */
+struct sampling_streams {
+    const uint16_t*     rotation_keys;
+    const uint16_t*     translation_keys;
+    const float*        min_x;
+    const float*        min_y;
+    const float*        min_z;
+    const float*        scale_x;
+    const float*        scale_y;
+    const float*        scale_z;
+    float*              w;
+    float*              x;
+    float*              y;
+    float*              z;
+    float*              tx;
+    float*              ty;
+    float*              tz;
+};
+
+struct sampling_scalar_kernels {
+    static void sample_track(
+        const sampling_streams& s,
+        size_t track,
+        uint32_t key0,
+        uint32_t key1,
+        float alpha
+        )
+    {
+        const v8::math::quaternionF q(v8::math::nlerp(
+            decode_rotation(s.rotation_keys + 4 * key0),
+            decode_rotation(s.rotation_keys + 4 * key1), alpha));
+        s.w[track] = q.w_;
+        s.x[track] = q.x_;
+        s.y[track] = q.y_;
+        s.z[track] = q.z_;
+
+        const uint16_t* t0 = s.translation_keys + 4 * key0;
+        const uint16_t* t1 = s.translation_keys + 4 * key1;
+        const float u = 1.0f - alpha;
+        s.tx[track] = s.min_x[track] + s.scale_x[track] * (u * t0[0] + alpha * t1[0]);
+        s.ty[track] = s.min_y[track] + s.scale_y[track] * (u * t0[1] + alpha * t1[1]);
+        s.tz[track] = s.min_z[track] + s.scale_z[track] * (u * t0[2] + alpha * t1[2]);
+    }
+};
+
+/**
+ * \brief   Finds the keys around frame for a track, key0 <= frame <= key1,
+ *          and the interpolation factor between them. Playing forward moves
+ *          the cursor by a few keys at most, going back restarts the search 
+ *          from the first key of the track.
+ */
+inline void
+locate_keys(
+    const uint16_t* frames,
+    uint32_t first,
+    uint32_t last,
+    float frame,
+    uint32_t* cursor,
+    uint32_t* key0,
+    uint32_t* key1,
+    float* alpha
+    )
+{
+    uint32_t k = *cursor;
+    if (frames[k] > frame)
+        k = first;
+    while (k < last && frames[k + 1] <= frame)
+        ++k;
+    *cursor = k;
+
+    *key0 = k;
+    if (k == last) {
+        *key1 = k;
+        *alpha = 0.0f;
+    } else {
+        *key1 = k + 1;
+        *alpha = (frame - frames[k]) / static_cast<float>(frames[k + 1] - frames[k]);
+    }
+}
+
+#if defined(V8_SIMD_ENABLED)
+
+/**
+ * \brief   SSE decoding and interpolation of 4 tracks. The keys (4 uint16
+ *          each) are widened to floats and transposed, so every register
+ *          holds one component for the 4 tracks.
+ */
+struct sampling_sse_kernels {
+    static void load_keys4(
+        const uint16_t* keys,
+        const uint32_t* indices,
+        __m128* a,
+        __m128* b,
+        __m128* c,
+        __m128* d
+        )
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128 k[4];
+        for (size_t lane = 0; lane < 4; ++lane) {
+            const __m128i bits = _mm_loadl_epi64(
+                reinterpret_cast<const __m128i*>(keys + 4 * indices[lane]));
+            k[lane] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(bits, zero));
+        }
+        _MM_TRANSPOSE4_PS(k[0], k[1], k[2], k[3]);
+        *a = k[0];
+        *b = k[1];
+        *c = k[2];
+        *d = k[3];
+    }
+
+    static __m128 select(__m128 mask, __m128 if_true, __m128 if_false) {
+        return _mm_or_ps(_mm_and_ps(mask, if_true), 
+                         _mm_andnot_ps(mask, if_false));
+    }
+
+    static void decode_rotations4(
+        const uint16_t* keys,
+        const uint32_t* indices,
+        __m128* q
+        )
+    {
+        __m128 a, b, c, index;
+        load_keys4(keys, indices, &a, &b, &c, &index);
+
+        const __m128 step = _mm_set1_ps(kRotationStep);
+        const __m128 range = _mm_set1_ps(kRotationRange);
+        a = _mm_sub_ps(_mm_mul_ps(a, step), range);
+        b = _mm_sub_ps(_mm_mul_ps(b, step), range);
+        c = _mm_sub_ps(_mm_mul_ps(c, step), range);
+
+        const __m128 sum_sq = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(a, a), _mm_mul_ps(b, b)), _mm_mul_ps(c, c));
+        const __m128 largest = _mm_sqrt_ps(
+            _mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.0f), sum_sq), _mm_setzero_ps()));
+
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 two = _mm_set1_ps(2.0f);
+        const __m128 three = _mm_set1_ps(3.0f);
+        q[0] = select(_mm_cmpeq_ps(index, _mm_setzero_ps()), largest, a);
+        q[1] = select(_mm_cmpeq_ps(index, one), largest, 
+                      select(_mm_cmpgt_ps(index, one), b, a));
+        q[2] = select(_mm_cmpeq_ps(index, two), largest, 
+                      select(_mm_cmpgt_ps(index, two), c, b));
+        q[3] = select(_mm_cmpeq_ps(index, three), largest, c);
+    }
+
+    static void sample_tracks4(
+        const sampling_streams& s,
+        size_t track,
+        const uint32_t* keys0,
+        const uint32_t* keys1,
+        const float* alphas
+        )
+    {
+        const __m128 alpha = _mm_loadu_ps(alphas);
+        const __m128 one_minus_alpha = _mm_sub_ps(_mm_set1_ps(1.0f), alpha);
+
+        //
+        // nlerp, the sign of alpha is flipped to take the shortest arc.
+        __m128 q0[4], q1[4];
+        decode_rotations4(s.rotation_keys, keys0, q0);
+        decode_rotations4(s.rotation_keys, keys1, q1);
+        const __m128 dot = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(q0[0], q1[0]), _mm_mul_ps(q0[1], q1[1])),
+            _mm_add_ps(_mm_mul_ps(q0[2], q1[2]), _mm_mul_ps(q0[3], q1[3])));
+        const __m128 t1 = _mm_xor_ps(alpha, _mm_and_ps(
+            _mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f)));
+
+        __m128 q[4];
+        for (size_t j = 0; j < 4; ++j) {
+            q[j] = _mm_add_ps(_mm_mul_ps(q0[j], one_minus_alpha), 
+                              _mm_mul_ps(q1[j], t1));
+        }
+        const __m128 len_sq = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(q[0], q[0]), _mm_mul_ps(q[1], q[1])),
+            _mm_add_ps(_mm_mul_ps(q[2], q[2]), _mm_mul_ps(q[3], q[3])));
+        const __m128 inv_len = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(len_sq));
+        _mm_storeu_ps(s.w + track, _mm_mul_ps(q[0], inv_len));
+        _mm_storeu_ps(s.x + track, _mm_mul_ps(q[1], inv_len));
+        _mm_storeu_ps(s.y + track, _mm_mul_ps(q[2], inv_len));
+        _mm_storeu_ps(s.z + track, _mm_mul_ps(q[3], inv_len));
+
+        __m128 x0, y0, z0, x1, y1, z1, unused;
+        load_keys4(s.translation_keys, keys0, &x0, &y0, &z0, &unused);
+        load_keys4(s.translation_keys, keys1, &x1, &y1, &z1, &unused);
+        const __m128 x = _mm_add_ps(_mm_mul_ps(x0, one_minus_alpha), _mm_mul_ps(x1, alpha));
+        const __m128 y = _mm_add_ps(_mm_mul_ps(y0, one_minus_alpha), _mm_mul_ps(y1, alpha));
+        const __m128 z = _mm_add_ps(_mm_mul_ps(z0, one_minus_alpha), _mm_mul_ps(z1, alpha));
+        _mm_storeu_ps(s.tx + track, _mm_add_ps(_mm_loadu_ps(s.min_x + track), 
+            _mm_mul_ps(_mm_loadu_ps(s.scale_x + track), x)));
+        _mm_storeu_ps(s.ty + track, _mm_add_ps(_mm_loadu_ps(s.min_y + track), 
+            _mm_mul_ps(_mm_loadu_ps(s.scale_y + track), y)));
+        _mm_storeu_ps(s.tz + track, _mm_add_ps(_mm_loadu_ps(s.min_z + track), 
+            _mm_mul_ps(_mm_loadu_ps(s.scale_z + track), z)));
+    }
+};
+
+#endif
+
+} // anonymous namespace
+
+v8::math::animation_clip::animation_clip()
+    :   frame_count_(0),
+        sample_rate_(30.0f),
+        track_first_key_(1, 0) {}
+
+void v8::math::animation_clip::build(
+    const v8::math::quaternionF* rotations,
+    const v8::math::vector3F* translations,
+    size_t track_count,
+    size_t frame_count,
+    float sample_rate,
+    float rotation_tolerance,
+    float translation_tolerance
+    ) {
+    assert(frame_count <= 65536);
+    assert(sample_rate > 0.0f);
+
+    frame_count_ = frame_count;
+    sample_rate_ = sample_rate;
+    track_first_key_.assign(1, 0);
+    key_frames_.clear();
+    rotation_keys_.clear();
+    translation_keys_.clear();
+    translation_min_.resize(track_count);
+    translation_scale_.resize(track_count);
+
+    std::vector<uint16_t> kept;
+    for (size_t track = 0; track < track_count; ++track) {
+        const quaternionF* r = rotations + track;
+        const vector3F* t = translations + track;
+        const size_t stride = track_count;
+
+        //
+        // Greedy key reduction : extend the segment that starts at the last
+        // kept key until a frame in between can not be interpolated, or 
+        // the segment is kMaxKeySpan frames long.
+        kept.clear();
+        if (frame_count)
+            kept.push_back(0);
+
+        size_t start = 0;
+        for (size_t end = 2; end < frame_count; ++end) {
+            bool fits = end - start <= kMaxKeySpan;
+            for (size_t f = start + 1; f < end && fits; ++f) {
+                const float alpha = 
+                    static_cast<float>(f - start) / static_cast<float>(end - start);
+                const quaternionF q(nlerp(r[start * stride], r[end * stride], alpha));
+                const vector3F p(t[start * stride] 
+                    + (t[end * stride] - t[start * stride]) * alpha);
+                fits = rotation_error(q, r[f * stride]) <= rotation_tolerance
+                    && (p - t[f * stride]).magnitude() <= translation_tolerance;
+            }
+
+            if (!fits) {
+                start = end - 1;
+                kept.push_back(static_cast<uint16_t>(start));
+            }
+        }
+        if (frame_count > 1)
+            kept.push_back(static_cast<uint16_t>(frame_count - 1));
+
+        //
+        // Translation range of the track.
+        vector3F t_min(0.0f, 0.0f, 0.0f);
+        vector3F t_max(0.0f, 0.0f, 0.0f);
+        for (size_t k = 0; k < kept.size(); ++k) {
+            const vector3F& p = t[kept[k] * stride];
+            if (!k) {
+                t_min = t_max = p;
+                continue;
+            }
+            t_min.x_ = std::min(t_min.x_, p.x_);
+            t_min.y_ = std::min(t_min.y_, p.y_);
+            t_min.z_ = std::min(t_min.z_, p.z_);
+            t_max.x_ = std::max(t_max.x_, p.x_);
+            t_max.y_ = std::max(t_max.y_, p.y_);
+            t_max.z_ = std::max(t_max.z_, p.z_);
+        }
+        const vector3F extent(t_max - t_min);
+        translation_min_.set(track, t_min);
+        translation_scale_.set(track, extent / 65535.0f);
+
+        for (size_t k = 0; k < kept.size(); ++k) {
+            key_frames_.push_back(kept[k]);
+
+            uint16_t key[4];
+            encode_rotation(r[kept[k] * stride], key);
+            rotation_keys_.insert(rotation_keys_.end(), key, key + 4);
+
+            const vector3F& p = t[kept[k] * stride];
+            key[0] = extent.x_ > 0.0f ? quantize_unit((p.x_ - t_min.x_) / extent.x_) : 0;
+            key[1] = extent.y_ > 0.0f ? quantize_unit((p.y_ - t_min.y_) / extent.y_) : 0;
+            key[2] = extent.z_ > 0.0f ? quantize_unit((p.z_ - t_min.z_) / extent.z_) : 0;
+            key[3] = 0;
+            translation_keys_.insert(translation_keys_.end(), key, key + 4);
+        }
+
+        track_first_key_.push_back(static_cast<uint32_t>(key_frames_.size()));
+    }
+}
+
+size_t v8::math::animation_clip::size_in_bytes() const {
+    return track_first_key_.size() * sizeof(uint32_t)
+        + key_frames_.size() * sizeof(uint16_t)
+        + rotation_keys_.size() * sizeof(uint16_t)
+        + translation_keys_.size() * sizeof(uint16_t)
+        + 6 * track_count() * sizeof(float);
+}
+
+void v8::math::animation_sampler::set_clip(const v8::math::animation_clip* clip) {
+    clip_ = clip;
+    const size_t track_count = clip ? clip->track_count() : 0;
+    cursors_.resize(track_count);
+    for (size_t track = 0; track < track_count; ++track)
+        cursors_[track] = clip->track_first_key_[track];
+    rotations_.resize(track_count);
+    translations_.resize(track_count);
+}
+
+void v8::math::animation_sampler::sample(float time) {
+    assert(clip_ != nullptr);
+    const size_t track_count = clip_->track_count();
+    if (!track_count || !clip_->frame_count())
+        return;
+
+    const float last_frame = static_cast<float>(clip_->frame_count() - 1);
+    const float frame = std::min(std::max(time * clip_->sample_rate(), 0.0f), 
+                                 last_frame);
+
+    const uint16_t* frames = &clip_->key_frames_[0];
+    const uint32_t* first_keys = &clip_->track_first_key_[0];
+    uint32_t* cursors = &cursors_[0];
+
+    sampling_streams s;
+    s.rotation_keys = &clip_->rotation_keys_[0];
+    s.translation_keys = &clip_->translation_keys_[0];
+    s.min_x = clip_->translation_min_.x();
+    s.min_y = clip_->translation_min_.y();
+    s.min_z = clip_->translation_min_.z();
+    s.scale_x = clip_->translation_scale_.x();
+    s.scale_y = clip_->translation_scale_.y();
+    s.scale_z = clip_->translation_scale_.z();
+    s.w = rotations_.w();
+    s.x = rotations_.x();
+    s.y = rotations_.y();
+    s.z = rotations_.z();
+    s.tx = translations_.x();
+    s.ty = translations_.y();
+    s.tz = translations_.z();
+
+    size_t track = 0;
+
+#if defined(V8_SIMD_ENABLED)
+    const size_t simd_last = track_count & ~size_t(3);
+    for (; track < simd_last; track += 4) {
+        uint32_t keys0[4], keys1[4];
+        float alphas[4];
+        for (size_t lane = 0; lane < 4; ++lane) {
+            const size_t t = track + lane;
+            locate_keys(frames, first_keys[t], first_keys[t + 1] - 1, frame,
+                        cursors + t, &keys0[lane], &keys1[lane], &alphas[lane]);
+        }
+        sampling_sse_kernels::sample_tracks4(s, track, keys0, keys1, alphas);
+    }
+#endif
+
+    for (; track < track_count; ++track) {
+        uint32_t key0, key1;
+        float alpha;
+        locate_keys(frames, first_keys[track], first_keys[track + 1] - 1, 
+                    frame, cursors + track, &key0, &key1, &alpha);
+        sampling_scalar_kernels::sample_track(s, track, key0, key1, alpha);
+    }
+}
+
+void v8::math::sample_animations(
+    v8::math::animation_sampler* samplers,
+    const float* times,
+    size_t count,
+    unsigned int max_threads
+    ) {
+    base::parallel_for(count, kAnimationSamplingGrainSize, max_threads,
+                       [samplers, times](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i)
+            samplers[i].sample(times[i]);
+    });
+}
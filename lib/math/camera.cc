@@ -8,10 +8,16 @@ v8::math::camera::camera()
         view_dir_(vector3F::unit_z),
         view_matrix_(matrix_4X4F::identity),
         projection_matrix_(matrix_4X4F::identity),
-        projection_view_matrix_(matrix_4X4F::identity) {
+        projection_view_matrix_(matrix_4X4F::identity),
+        inverse_view_matrix_(matrix_4X4F::identity),
+        inverse_projection_view_matrix_(matrix_4X4F::identity),
+        projection_type_(Projection_Perspective),
+        dirty_flags_(0),
+        rebuilds_avoided_(0),
+        custom_projection_(false) {
 }
 
-void v8::math::camera::update_view_matrix() {
+void v8::math::camera::update_view_matrix() const {
     view_matrix_.a11_ = view_side_.x_;
     view_matrix_.a12_ = view_side_.y_;
     view_matrix_.a13_ = view_side_.z_;
@@ -28,6 +34,7 @@ void v8::math::camera::update_view_matrix() {
     view_matrix_.a34_ = -v8::math::dot_product(view_dir_, view_pos_);
 
     view_matrix_.set_row(4, v8::math::vector4F(0.0f, 0.0f, 0.0f, 1.0f));
+    dirty_flags_ &= ~Dirty_View;
 }
 
 v8::math::camera&
@@ -55,8 +62,7 @@ v8::math::camera::set_axes(
     view_up_ = up_vector;
     view_dir_ = dir_vector;
     
-    update_view_matrix();
-    update_projection_view_transform();
+    handle_view_frame_change();
     return *this;
 }
 
@@ -83,10 +89,12 @@ void v8::math::camera::set_projection_matrix(
     projection_matrix_.set_column(3, third_col);
     projection_matrix_.set_column(4, fourth_col);
     
-    update_projection_view_transform();
+    custom_projection_ = true;
+    dirty_flags_ &= ~Dirty_Projection;
+    invalidate(Dirty_Projection_View | Dirty_Inverse_Projection_View);
 }
 
-void v8::math::camera::handle_frustrum_param_change() {
+void v8::math::camera::update_projection_matrix() const {
     const float dmin = frustrum_params_[Frustrum_DMin];
     const float dmax = frustrum_params_[Frustrum_DMax];
     const float umin = frustrum_params_[Frustrum_UMin];
@@ -136,13 +144,15 @@ void v8::math::camera::handle_frustrum_param_change() {
         projection_matrix_(1, 3) = 0.0f;
         projection_matrix_(2, 3) = 0.0f;
         projection_matrix_(3, 3) = inv_depth;
-        projection_matrix_(3, 4) = 0.0f;
+        projection_matrix_(4, 3) = 0.0f;
 
         projection_matrix_(1, 4) = -(rmax + rmin) * inv_width;
         projection_matrix_(2, 4) = -(umax + umin) * inv_height;
         projection_matrix_(3, 4) = -dmin * inv_depth;
         projection_matrix_(4, 4) = 1.0f;
     }
+
+    dirty_flags_ &= ~Dirty_Projection;
 }
 
 void v8::math::camera::set_frustrum(
@@ -0,0 +1,255 @@
+#include "pch_hdr.h"
+#include "v8/base/parallel_for.h"
+#include "v8/math/dual_quaternion_skinning.h"
+#include "skinning_streams.h"
+
+#if defined(V8_SIMD_ENABLED)
+#include <xmmintrin.h>
+#include "v8/math/sse_utils.h"
+#endif
+
+namespace {
+
+/**
+ * \brief   Inputs and outputs of a skinning job, as raw pointers.
+ */
+struct dq_skinning_streams : v8::math::internals::skinning_vertex_streams {
+    const v8::math::dual_quaternionF*   palette;
+    const uint16_t*                     indices;
+    const float*                        weights;
+};
+
+const size_t kInfluences = v8::math::kDualQuaternionSkinningInfluences;
+
+struct dq_skinning_scalar_kernels {
+    static void skin(
+        const dq_skinning_streams& s,
+        size_t first,
+        size_t last
+        )
+    {
+        using v8::math::quaternionF;
+
+        for (size_t i = first; i < last; ++i) {
+            const uint16_t* bones = s.indices + kInfluences * i;
+            const float* weights = s.weights + kInfluences * i;
+            const quaternionF& pivot = s.palette[bones[0]].real_;
+
+            float b[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+            for (size_t k = 0; k < kInfluences; ++k) {
+                const v8::math::dual_quaternionF& dq = s.palette[bones[k]];
+                const float w = dot_product(pivot, dq.real_) < 0.0f 
+                    ? -weights[k] : weights[k];
+                for (size_t j = 0; j < 4; ++j) {
+                    b[j] += w * dq.real_.elements_[j];
+                    b[4 + j] += w * dq.dual_.elements_[j];
+                }
+            }
+
+            const float inv_len = 1.0f / std::sqrt(
+                b[0] * b[0] + b[1] * b[1] + b[2] * b[2] + b[3] * b[3]);
+            for (size_t j = 0; j < 8; ++j)
+                b[j] *= inv_len;
+
+            //
+            // Rotation (rw, rv), translation 2 (rw dv - dw rv + rv x dv).
+            const float rw = b[0], rx = b[1], ry = b[2], rz = b[3];
+            const float dw = b[4], dx = b[5], dy = b[6], dz = b[7];
+            const float tx = 2.0f * (rw * dx - dw * rx + ry * dz - rz * dy);
+            const float ty = 2.0f * (rw * dy - dw * ry + rz * dx - rx * dz);
+            const float tz = 2.0f * (rw * dz - dw * rz + rx * dy - ry * dx);
+
+            float x = s.px[i], y = s.py[i], z = s.pz[i];
+            float cx = ry * z - rz * y + rw * x;
+            float cy = rz * x - rx * z + rw * y;
+            float cz = rx * y - ry * x + rw * z;
+            s.out_px[i] = x + 2.0f * (ry * cz - rz * cy) + tx;
+            s.out_py[i] = y + 2.0f * (rz * cx - rx * cz) + ty;
+            s.out_pz[i] = z + 2.0f * (rx * cy - ry * cx) + tz;
+
+            if (!s.nx)
+                continue;
+
+            x = s.nx[i], y = s.ny[i], z = s.nz[i];
+            cx = ry * z - rz * y + rw * x;
+            cy = rz * x - rx * z + rw * y;
+            cz = rx * y - ry * x + rw * z;
+            s.out_nx[i] = x + 2.0f * (ry * cz - rz * cy);
+            s.out_ny[i] = y + 2.0f * (rz * cx - rx * cz);
+            s.out_nz[i] = z + 2.0f * (rx * cy - ry * cx);
+        }
+    }
+};
+
+#if defined(V8_SIMD_ENABLED)
+
+/**
+ * \brief   SSE version, 4 vertices at a time. The bone dual quaternions
+ *          of an influence are gathered for the 4 vertices and transposed,
+ *          so the blend and the transforms work on (w, x, y, z) registers
+ *          that hold one vertex per lane.
+ */
+struct dq_skinning_sse_kernels {
+    /**
+     * \brief   v + 2 r x (r x v + rw v), for 4 vectors.
+     */
+    static void rotate4(
+        __m128 rw, __m128 rx, __m128 ry, __m128 rz,
+        __m128 x, __m128 y, __m128 z,
+        __m128* out_x, __m128* out_y, __m128* out_z
+        )
+    {
+        const __m128 two = _mm_set1_ps(2.0f);
+        const __m128 cx = _mm_add_ps(
+            _mm_sub_ps(_mm_mul_ps(ry, z), _mm_mul_ps(rz, y)), _mm_mul_ps(rw, x));
+        const __m128 cy = _mm_add_ps(
+            _mm_sub_ps(_mm_mul_ps(rz, x), _mm_mul_ps(rx, z)), _mm_mul_ps(rw, y));
+        const __m128 cz = _mm_add_ps(
+            _mm_sub_ps(_mm_mul_ps(rx, y), _mm_mul_ps(ry, x)), _mm_mul_ps(rw, z));
+
+        *out_x = _mm_add_ps(x, _mm_mul_ps(two, 
+            _mm_sub_ps(_mm_mul_ps(ry, cz), _mm_mul_ps(rz, cy))));
+        *out_y = _mm_add_ps(y, _mm_mul_ps(two, 
+            _mm_sub_ps(_mm_mul_ps(rz, cx), _mm_mul_ps(rx, cz))));
+        *out_z = _mm_add_ps(z, _mm_mul_ps(two, 
+            _mm_sub_ps(_mm_mul_ps(rx, cy), _mm_mul_ps(ry, cx))));
+    }
+
+    static void skin(
+        const dq_skinning_streams& s,
+        size_t first,
+        size_t last
+        )
+    {
+        const __m128 sign_bit = _mm_set1_ps(-0.0f);
+        const __m128 two = _mm_set1_ps(2.0f);
+        const size_t simd_last = first + ((last - first) & ~size_t(3));
+
+        for (size_t i = first; i < simd_last; i += 4) {
+            const uint16_t* bones = s.indices + kInfluences * i;
+
+            //
+            // weights[k] = influence k of the 4 vertices.
+            __m128 weights[4] = {
+                _mm_loadu_ps(s.weights + kInfluences * i),
+                _mm_loadu_ps(s.weights + kInfluences * i + 4),
+                _mm_loadu_ps(s.weights + kInfluences * i + 8),
+                _mm_loadu_ps(s.weights + kInfluences * i + 12)
+            };
+            _MM_TRANSPOSE4_PS(weights[0], weights[1], weights[2], weights[3]);
+
+            __m128 b[8];
+            __m128 pivot[4];
+            for (size_t k = 0; k < kInfluences; ++k) {
+                const v8::math::dual_quaternionF& q0 = s.palette[bones[k]];
+                const v8::math::dual_quaternionF& q1 = 
+                    s.palette[bones[kInfluences + k]];
+                const v8::math::dual_quaternionF& q2 = 
+                    s.palette[bones[2 * kInfluences + k]];
+                const v8::math::dual_quaternionF& q3 = 
+                    s.palette[bones[3 * kInfluences + k]];
+
+                __m128 rw = _mm_loadu_ps(q0.real_.elements_);
+                __m128 rx = _mm_loadu_ps(q1.real_.elements_);
+                __m128 ry = _mm_loadu_ps(q2.real_.elements_);
+                __m128 rz = _mm_loadu_ps(q3.real_.elements_);
+                _MM_TRANSPOSE4_PS(rw, rx, ry, rz);
+                __m128 dw = _mm_loadu_ps(q0.dual_.elements_);
+                __m128 dx = _mm_loadu_ps(q1.dual_.elements_);
+                __m128 dy = _mm_loadu_ps(q2.dual_.elements_);
+                __m128 dz = _mm_loadu_ps(q3.dual_.elements_);
+                _MM_TRANSPOSE4_PS(dw, dx, dy, dz);
+
+                __m128 w = weights[k];
+                if (k == 0) {
+                    pivot[0] = rw;
+                    pivot[1] = rx;
+                    pivot[2] = ry;
+                    pivot[3] = rz;
+                } else {
+                    const __m128 dot = _mm_add_ps(
+                        _mm_add_ps(_mm_mul_ps(pivot[0], rw), _mm_mul_ps(pivot[1], rx)),
+                        _mm_add_ps(_mm_mul_ps(pivot[2], ry), _mm_mul_ps(pivot[3], rz)));
+                    w = _mm_xor_ps(w, _mm_and_ps(
+                        _mm_cmplt_ps(dot, _mm_setzero_ps()), sign_bit));
+                }
+
+                const __m128 parts[8] = { rw, rx, ry, rz, dw, dx, dy, dz };
+                for (size_t j = 0; j < 8; ++j) {
+                    b[j] = k == 0 ? _mm_mul_ps(w, parts[j]) 
+                                  : _mm_add_ps(b[j], _mm_mul_ps(w, parts[j]));
+                }
+            }
+
+            const __m128 len_sq = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(b[0], b[0]), _mm_mul_ps(b[1], b[1])),
+                _mm_add_ps(_mm_mul_ps(b[2], b[2]), _mm_mul_ps(b[3], b[3])));
+            const __m128 inv_len = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(len_sq));
+            for (size_t j = 0; j < 8; ++j)
+                b[j] = _mm_mul_ps(b[j], inv_len);
+
+            const __m128 rw = b[0], rx = b[1], ry = b[2], rz = b[3];
+            const __m128 dw = b[4], dx = b[5], dy = b[6], dz = b[7];
+            const __m128 tx = _mm_mul_ps(two, _mm_add_ps(
+                _mm_sub_ps(_mm_mul_ps(rw, dx), _mm_mul_ps(dw, rx)),
+                _mm_sub_ps(_mm_mul_ps(ry, dz), _mm_mul_ps(rz, dy))));
+            const __m128 ty = _mm_mul_ps(two, _mm_add_ps(
+                _mm_sub_ps(_mm_mul_ps(rw, dy), _mm_mul_ps(dw, ry)),
+                _mm_sub_ps(_mm_mul_ps(rz, dx), _mm_mul_ps(rx, dz))));
+            const __m128 tz = _mm_mul_ps(two, _mm_add_ps(
+                _mm_sub_ps(_mm_mul_ps(rw, dz), _mm_mul_ps(dw, rz)),
+                _mm_sub_ps(_mm_mul_ps(rx, dy), _mm_mul_ps(ry, dx))));
+
+            __m128 x, y, z;
+            rotate4(rw, rx, ry, rz, _mm_loadu_ps(s.px + i), _mm_loadu_ps(s.py + i),
+                    _mm_loadu_ps(s.pz + i), &x, &y, &z);
+            _mm_storeu_ps(s.out_px + i, _mm_add_ps(x, tx));
+            _mm_storeu_ps(s.out_py + i, _mm_add_ps(y, ty));
+            _mm_storeu_ps(s.out_pz + i, _mm_add_ps(z, tz));
+
+            if (s.nx) {
+                rotate4(rw, rx, ry, rz, _mm_loadu_ps(s.nx + i), 
+                        _mm_loadu_ps(s.ny + i), _mm_loadu_ps(s.nz + i), 
+                        &x, &y, &z);
+                _mm_storeu_ps(s.out_nx + i, x);
+                _mm_storeu_ps(s.out_ny + i, y);
+                _mm_storeu_ps(s.out_nz + i, z);
+            }
+        }
+
+        dq_skinning_scalar_kernels::skin(s, simd_last, last);
+    }
+};
+
+typedef dq_skinning_sse_kernels dq_skinning_kernels;
+
+#else
+
+typedef dq_skinning_scalar_kernels dq_skinning_kernels;
+
+#endif
+
+} // anonymous namespace
+
+void v8::math::skin_dual_quaternion(
+    const v8::math::dual_quaternionF* palette,
+    const uint16_t* bone_indices,
+    const float* bone_weights,
+    const v8::math::vector3_soaF& positions,
+    const v8::math::vector3_soaF* normals,
+    v8::math::vector3_soaF* skinned_positions,
+    v8::math::vector3_soaF* skinned_normals,
+    unsigned int max_threads
+    ) {
+    dq_skinning_streams s;
+    const size_t count = internals::init_skinning_streams(
+        positions, normals, skinned_positions, skinned_normals, &s);
+    s.palette = palette;
+    s.indices = bone_indices;
+    s.weights = bone_weights;
+
+    base::parallel_for(count, kDualQuaternionSkinningGrainSize, max_threads,
+                       [s](size_t first, size_t last) {
+        dq_skinning_kernels::skin(s, first, last);
+    });
+}
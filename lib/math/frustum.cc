@@ -0,0 +1,195 @@
+#include "pch_hdr.h"
+#include "v8/base/parallel_for.h"
+#include "v8/math/frustum.h"
+
+#if defined(V8_SIMD_ENABLED)
+#include <xmmintrin.h>
+#endif
+
+namespace {
+
+/**
+ * \brief   Scalar version of the sphere test. Processes the spheres in
+ *          [first, last).
+ */
+struct frustum_cull_scalar_kernels {
+    static void classify_spheres(
+        const v8::math::frustum& f,
+        const float* x,
+        const float* y,
+        const float* z,
+        const float* radius,
+        uint8_t* result,
+        size_t first,
+        size_t last
+        )
+    {
+        const float* nx = f.normals_x();
+        const float* ny = f.normals_y();
+        const float* nz = f.normals_z();
+        const float* d = f.offsets();
+
+        for (size_t i = first; i < last; ++i) {
+            uint8_t classification = v8::math::cull_inside;
+            for (int p = 0; p < v8::math::frustum::Plane_Count; ++p) {
+                const float dist = nx[p] * x[i] + ny[p] * y[i] + nz[p] * z[i] + d[p];
+                if (dist < -radius[i]) {
+                    classification = v8::math::cull_outside;
+                    break;
+                }
+                if (dist < radius[i])
+                    classification = v8::math::cull_intersect;
+            }
+            result[i] = classification;
+        }
+    }
+};
+
+#if defined(V8_SIMD_ENABLED)
+
+/**
+ * \brief   SSE version of the sphere test. The plane coefficients are
+ *          broadcast once, then 4 spheres are tested against all the planes
+ *          per iteration. A sphere is outside if it is behind a plane by
+ *          more than its radius, and crosses a plane if it is behind it
+ *          by less than its radius; since outside implies crossing (r >= 0),
+ *          the classification is crossing_bit + outside_bit.
+ */
+struct frustum_cull_sse_kernels {
+    static void classify_spheres(
+        const v8::math::frustum& f,
+        const float* x,
+        const float* y,
+        const float* z,
+        const float* radius,
+        uint8_t* result,
+        size_t first,
+        size_t last
+        )
+    {
+        using v8::math::frustum;
+
+        __m128 nx[frustum::Plane_Count];
+        __m128 ny[frustum::Plane_Count];
+        __m128 nz[frustum::Plane_Count];
+        __m128 d[frustum::Plane_Count];
+        for (int p = 0; p < frustum::Plane_Count; ++p) {
+            nx[p] = _mm_set1_ps(f.normals_x()[p]);
+            ny[p] = _mm_set1_ps(f.normals_y()[p]);
+            nz[p] = _mm_set1_ps(f.normals_z()[p]);
+            d[p] = _mm_set1_ps(f.offsets()[p]);
+        }
+
+        const __m128 sign_mask = _mm_set1_ps(-0.0f);
+        const size_t simd_last = first + ((last - first) & ~size_t(3));
+        for (size_t i = first; i < simd_last; i += 4) {
+            const __m128 cx = _mm_loadu_ps(x + i);
+            const __m128 cy = _mm_loadu_ps(y + i);
+            const __m128 cz = _mm_loadu_ps(z + i);
+            const __m128 r = _mm_loadu_ps(radius + i);
+            const __m128 neg_r = _mm_xor_ps(r, sign_mask);
+
+            __m128 outside = _mm_setzero_ps();
+            __m128 crossing = _mm_setzero_ps();
+            for (int p = 0; p < frustum::Plane_Count; ++p) {
+                const __m128 dist = _mm_add_ps(
+                    _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], cx),
+                                          _mm_mul_ps(ny[p], cy)),
+                               _mm_mul_ps(nz[p], cz)),
+                    d[p]);
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, neg_r));
+                crossing = _mm_or_ps(crossing, _mm_cmplt_ps(dist, r));
+            }
+
+            const int outside_bits = _mm_movemask_ps(outside);
+            const int crossing_bits = _mm_movemask_ps(crossing);
+            for (size_t j = 0; j < 4; ++j) {
+                result[i + j] = static_cast<uint8_t>(
+                    ((crossing_bits >> j) & 1) + ((outside_bits >> j) & 1));
+            }
+        }
+
+        frustum_cull_scalar_kernels::classify_spheres(
+            f, x, y, z, radius, result, simd_last, last);
+    }
+};
+
+typedef frustum_cull_sse_kernels frustum_cull_kernels;
+
+#else
+
+typedef frustum_cull_scalar_kernels frustum_cull_kernels;
+
+#endif
+
+} // anonymous namespace
+
+void v8::math::frustum::extract_planes(
+    const v8::math::matrix_4X4F& projection_view
+    ) {
+    const matrix_4X4F& m = projection_view;
+    const float coefficients[Plane_Count][4] = {
+        { m.a41_ + m.a11_, m.a42_ + m.a12_, m.a43_ + m.a13_, m.a44_ + m.a14_ },
+        { m.a41_ - m.a11_, m.a42_ - m.a12_, m.a43_ - m.a13_, m.a44_ - m.a14_ },
+        { m.a41_ + m.a21_, m.a42_ + m.a22_, m.a43_ + m.a23_, m.a44_ + m.a24_ },
+        { m.a41_ - m.a21_, m.a42_ - m.a22_, m.a43_ - m.a23_, m.a44_ - m.a24_ },
+        { m.a31_, m.a32_, m.a33_, m.a34_ },
+        { m.a41_ - m.a31_, m.a42_ - m.a32_, m.a43_ - m.a33_, m.a44_ - m.a34_ }
+    };
+
+    for (int i = 0; i < Plane_Count; ++i) {
+        const float* c = coefficients[i];
+        const float inv_len = 1.0f / std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+
+        nx_[i] = c[0] * inv_len;
+        ny_[i] = c[1] * inv_len;
+        nz_[i] = c[2] * inv_len;
+        d_[i] = c[3] * inv_len;
+        planes_[i] = plane(nx_[i], ny_[i], nz_[i], d_[i]);
+    }
+}
+
+v8::math::cull_result v8::math::frustum::classify_sphere(
+    const v8::math::vector3F& center,
+    float radius
+    ) const {
+    cull_result classification = cull_inside;
+    for (int i = 0; i < Plane_Count; ++i) {
+        const float dist = planes_[i].signed_distance(center);
+        if (dist < -radius)
+            return cull_outside;
+        if (dist < radius)
+            classification = cull_intersect;
+    }
+    return classification;
+}
+
+void v8::math::classify_spheres(
+    const v8::math::frustum& view_frustum,
+    const float* center_x,
+    const float* center_y,
+    const float* center_z,
+    const float* radius,
+    size_t count,
+    uint8_t* result,
+    unsigned int max_threads
+    ) {
+    base::parallel_for(count, kFrustumCullGrainSize, max_threads,
+                       [&view_frustum, center_x, center_y, center_z, radius, result]
+                       (size_t first, size_t last) {
+        frustum_cull_kernels::classify_spheres(
+            view_frustum, center_x, center_y, center_z, radius, result,
+            first, last);
+    });
+}
+
+void v8::math::classify_spheres(
+    const v8::math::frustum& view_frustum,
+    const v8::math::vector3_soaF& centers,
+    const float* radius,
+    uint8_t* result,
+    unsigned int max_threads
+    ) {
+    classify_spheres(view_frustum, centers.x(), centers.y(), centers.z(),
+                     radius, centers.size(), result, max_threads);
+}
@@ -0,0 +1,223 @@
+#include "pch_hdr.h"
+#include "v8/base/thread_pool.h"
+#include "v8/math/level_hierarchy.h"
+#include "v8/math/transform_palette.h"
+
+#if defined(V8_SIMD_ENABLED)
+#include <xmmintrin.h>
+#include "v8/math/sse_utils.h"
+#endif
+
+namespace {
+
+/**
+ * \brief   Scalar version of the world matrix composition. For the nodes
+ *          in [first, last), replaces the local 3X4 matrix with 
+ *          parent_world * local. The parents must have been processed.
+ */
+struct level_compose_scalar_kernels {
+    static void compose(
+        float* worlds,
+        const uint32_t* parents,
+        size_t first,
+        size_t last
+        )
+    {
+        for (size_t i = first; i < last; ++i) {
+            const float* p = worlds + 12 * parents[i];
+            float* m = worlds + 12 * i;
+            float local[12];
+            std::memcpy(local, m, sizeof(local));
+
+            for (size_t r = 0; r < 3; ++r) {
+                const float* pr = p + 4 * r;
+                for (size_t c = 0; c < 4; ++c) {
+                    m[4 * r + c] = pr[0] * local[c] + pr[1] * local[4 + c] 
+                        + pr[2] * local[8 + c] + (c == 3 ? pr[3] : 0.0f);
+                }
+            }
+        }
+    }
+};
+
+#if defined(V8_SIMD_ENABLED)
+
+/**
+ * \brief   SSE version, one matrix row per register. Row r of the result
+ *          is p(r, 0) * L0 + p(r, 1) * L1 + p(r, 2) * L2 + (0, 0, 0, p(r, 3)),
+ *          the same operations as the scalar version.
+ */
+struct level_compose_sse_kernels {
+    static void compose(
+        float* worlds,
+        const uint32_t* parents,
+        size_t first,
+        size_t last
+        )
+    {
+        using namespace v8::math;
+
+        const __m128 w_mask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+        for (size_t i = first; i < last; ++i) {
+            const float* p = worlds + 12 * parents[i];
+            float* m = worlds + 12 * i;
+
+            const __m128 l0 = _mm_loadu_ps(m);
+            const __m128 l1 = _mm_loadu_ps(m + 4);
+            const __m128 l2 = _mm_loadu_ps(m + 8);
+            __m128 rows[3];
+            for (size_t r = 0; r < 3; ++r) {
+                const __m128 pr = _mm_loadu_ps(p + 4 * r);
+                rows[r] = sse::linear_combination(
+                    sse::splat<0>(pr), l0, sse::splat<1>(pr), l1,
+                    sse::splat<2>(pr), l2, _mm_and_ps(pr, w_mask));
+            }
+
+            _mm_storeu_ps(m, rows[0]);
+            _mm_storeu_ps(m + 4, rows[1]);
+            _mm_storeu_ps(m + 8, rows[2]);
+        }
+    }
+};
+
+typedef level_compose_sse_kernels level_compose_kernels;
+
+#else
+
+typedef level_compose_scalar_kernels level_compose_kernels;
+
+#endif
+
+} // anonymous namespace
+
+v8::math::level_hierarchy::level_hierarchy(unsigned int max_threads)
+    :   max_threads_(max_threads),
+        level_first_(1, 0) {}
+
+void v8::math::level_hierarchy::build(const uint32_t* parents, size_t count) {
+    //
+    // Depth of every node. The parents can follow their children, so the
+    // chains are walked up to a node of known depth, then assigned back.
+    const uint32_t unknown = kInvalidNode;
+    std::vector<uint32_t> depth(count, unknown);
+    std::vector<uint32_t> chain;
+    uint32_t max_depth = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t node = static_cast<uint32_t>(i);
+        while (depth[node] == unknown && parents[node] != kInvalidNode) {
+            assert(parents[node] < count);
+            assert(chain.size() < count && "Cycle in the hierarchy!");
+            chain.push_back(node);
+            node = parents[node];
+        }
+
+        if (depth[node] == unknown)
+            depth[node] = 0;
+
+        uint32_t d = depth[node];
+        while (!chain.empty()) {
+            depth[chain.back()] = ++d;
+            chain.pop_back();
+        }
+        max_depth = std::max(max_depth, d);
+    }
+
+    //
+    // Counting sort by depth, stable, so the nodes of a level keep their
+    // relative order.
+    level_first_.assign(count ? max_depth + 2 : 1, 0);
+    for (size_t i = 0; i < count; ++i)
+        ++level_first_[depth[i] + 1];
+    for (size_t l = 1; l < level_first_.size(); ++l)
+        level_first_[l] += level_first_[l - 1];
+
+    std::vector<size_t> cursor(level_first_.begin(), level_first_.end() - 1);
+    node_at_.resize(count);
+    sorted_index_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const size_t pos = cursor[depth[i]]++;
+        node_at_[pos] = static_cast<uint32_t>(i);
+        sorted_index_[i] = static_cast<uint32_t>(pos);
+    }
+
+    sorted_parents_.resize(count);
+    for (size_t pos = 0; pos < count; ++pos) {
+        const uint32_t parent = parents[node_at_[pos]];
+        sorted_parents_[pos] = 
+            parent == kInvalidNode ? kInvalidNode : sorted_index_[parent];
+    }
+
+    rotations_.resize(count);
+    translations_.resize(count);
+    scales_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        rotations_.set(i, quaternionF::identity);
+        scales_.set(i, vector3F(1.0f, 1.0f, 1.0f));
+    }
+    worlds_.assign(12 * count, 0.0f);
+}
+
+void v8::math::level_hierarchy::set_local_transform(
+    uint32_t node,
+    const v8::math::quaternionF& rotation,
+    const v8::math::vector3F& translation,
+    const v8::math::vector3F& scale
+    ) {
+    const uint32_t pos = sorted_index(node);
+    rotations_.set(pos, rotation);
+    translations_.set(pos, translation);
+    scales_.set(pos, scale);
+}
+
+void v8::math::level_hierarchy::update() {
+    if (!node_count())
+        return;
+
+    make_transform_palette_3X4(rotations_, translations_, &scales_, 
+                               &worlds_[0], max_threads_);
+
+    //
+    // The roots (level 0) keep their local matrices. The other levels are
+    // composed in a single job on the shared pool : every thread takes a
+    // contiguous range of chunks of the level, then waits for the others
+    // at a barrier before moving to the next level.
+    float* worlds = &worlds_[0];
+    const uint32_t* parents = &sorted_parents_[0];
+    const size_t* level_first = &level_first_[0];
+    const size_t levels = level_count();
+    base::thread_pool::shared().run(max_threads_, 
+                                    [=](base::parallel_region& region) {
+        const size_t thread = region.thread_index();
+        const size_t threads = region.thread_count();
+
+        for (size_t level = 1; level < levels; ++level) {
+            const size_t first = level_first[level];
+            const size_t last = level_first[level + 1];
+            const size_t chunks = 
+                (last - first + kLevelHierarchyGrainSize - 1) 
+                / kLevelHierarchyGrainSize;
+            const size_t chunk_first = chunks * thread / threads;
+            const size_t chunk_last = chunks * (thread + 1) / threads;
+            if (chunk_first < chunk_last) {
+                level_compose_kernels::compose(
+                    worlds, parents, 
+                    first + chunk_first * kLevelHierarchyGrainSize,
+                    std::min(first + chunk_last * kLevelHierarchyGrainSize, last));
+            }
+
+            if (level + 1 < levels)
+                region.barrier();
+        }
+    });
+}
+
+v8::math::matrix_4X4F 
+v8::math::level_hierarchy::world_matrix(uint32_t node) const {
+    const float* m = &worlds_[12 * sorted_index(node)];
+    matrix_4X4F result;
+    std::memcpy(result.elements_, m, 12 * sizeof(float));
+    result.a41_ = result.a42_ = result.a43_ = 0.0f;
+    result.a44_ = 1.0f;
+    return result;
+}
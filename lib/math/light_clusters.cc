@@ -0,0 +1,240 @@
+#include "pch_hdr.h"
+#include "v8/base/parallel_for.h"
+#include "v8/math/light_clusters.h"
+#include "v8/math/matrix4X4_batch.h"
+
+v8::math::light_clusters::light_clusters(
+    size_t grid_x,
+    size_t grid_y,
+    size_t grid_z,
+    unsigned int max_threads
+    )
+    :   grid_x_(grid_x), 
+        grid_y_(grid_y), 
+        grid_z_(grid_z), 
+        max_threads_(max_threads),
+        log_depth_ratio_(0.0f),
+        offsets_(grid_x * grid_y * grid_z + 1, 0) 
+{
+    assert(grid_x && grid_y && grid_z);
+    std::memset(frustrum_, 0, sizeof(frustrum_));
+}
+
+size_t v8::math::light_clusters::depth_slice(float view_depth) const {
+    const float dmin = frustrum_[camera::Frustrum_DMin];
+    if (view_depth <= dmin)
+        return 0;
+
+    const size_t slice = static_cast<size_t>(
+        std::log(view_depth / dmin) / log_depth_ratio_ 
+        * static_cast<float>(grid_z_));
+    return std::min(slice, grid_z_ - 1);
+}
+
+void v8::math::light_clusters::update_cluster_bounds(
+    const v8::math::camera& cam
+    ) {
+    if (!std::memcmp(frustrum_, cam.get_frustrum(), sizeof(frustrum_)))
+        return;
+
+    std::memcpy(frustrum_, cam.get_frustrum(), sizeof(frustrum_));
+    const float dmin = frustrum_[camera::Frustrum_DMin];
+    const float dmax = frustrum_[camera::Frustrum_DMax];
+    const float rmin = frustrum_[camera::Frustrum_RMin];
+    const float rmax = frustrum_[camera::Frustrum_RMax];
+    const float umin = frustrum_[camera::Frustrum_UMin];
+    const float umax = frustrum_[camera::Frustrum_UMax];
+    log_depth_ratio_ = std::log(dmax / dmin);
+
+    tile_x_.resize(grid_x_ + 1);
+    for (size_t i = 0; i <= grid_x_; ++i)
+        tile_x_[i] = rmin + (rmax - rmin) * i / static_cast<float>(grid_x_);
+    tile_x_[grid_x_] = rmax;
+
+    tile_y_.resize(grid_y_ + 1);
+    for (size_t i = 0; i <= grid_y_; ++i)
+        tile_y_[i] = umin + (umax - umin) * i / static_cast<float>(grid_y_);
+    tile_y_[grid_y_] = umax;
+
+    slice_z_.resize(grid_z_ + 1);
+    for (size_t i = 0; i <= grid_z_; ++i)
+        slice_z_[i] = dmin * std::pow(dmax / dmin, i / static_cast<float>(grid_z_));
+    slice_z_[0] = dmin;
+    slice_z_[grid_z_] = dmax;
+
+    //
+    // The tiles are defined on the near plane, a cluster's side faces are
+    // on the planes through the eye and the tile edges.
+    cluster_bounds_.resize(cluster_count());
+    for (size_t z = 0; z < grid_z_; ++z) {
+        const float near_scale = slice_z_[z] / dmin;
+        const float far_scale = slice_z_[z + 1] / dmin;
+
+        for (size_t y = 0; y < grid_y_; ++y) {
+            for (size_t x = 0; x < grid_x_; ++x) {
+                const vector3F min_pt(
+                    std::min(tile_x_[x] * near_scale, tile_x_[x] * far_scale),
+                    std::min(tile_y_[y] * near_scale, tile_y_[y] * far_scale),
+                    slice_z_[z]);
+                const vector3F max_pt(
+                    std::max(tile_x_[x + 1] * near_scale, tile_x_[x + 1] * far_scale),
+                    std::max(tile_y_[y + 1] * near_scale, tile_y_[y + 1] * far_scale),
+                    slice_z_[z + 1]);
+                cluster_bounds_.set(cluster_index(x, y, z), aabbF(min_pt, max_pt));
+            }
+        }
+    }
+}
+
+void v8::math::light_clusters::bin_lights(
+    size_t first,
+    size_t last,
+    std::vector<light_cluster_pair>* pairs
+    ) const {
+    typedef internals::aabb_soa_kernels<float> kernels_t;
+
+    const float dmin = frustrum_[camera::Frustrum_DMin];
+    const float dmax = frustrum_[camera::Frustrum_DMax];
+    const float tile_width = tile_x_[1] - tile_x_[0];
+    const float tile_height = tile_y_[1] - tile_y_[0];
+    const float* bounds[6] = {
+        cluster_bounds_.mins().x(), cluster_bounds_.mins().y(), 
+        cluster_bounds_.mins().z(), cluster_bounds_.maxs().x(), 
+        cluster_bounds_.maxs().y(), cluster_bounds_.maxs().z()
+    };
+    std::vector<uint8_t> hits(grid_x_);
+
+    for (size_t l = first; l < last; ++l) {
+        const vector3F center(light_positions_.get(l));
+        const float radius = light_ranges_[l];
+        const float z_lo = std::max(center.z_ - radius, dmin);
+        const float z_hi = std::min(center.z_ + radius, dmax);
+        if (z_lo > z_hi)
+            continue;
+
+        //
+        // The tile and slice ranges only prune the clusters that get the
+        // exact test, so they are widened by one to absorb the rounding
+        // differences between the log/floor math and the cluster bounds.
+        const size_t slice_first = depth_slice(z_lo) - (depth_slice(z_lo) > 0);
+        const size_t slice_last = std::min(depth_slice(z_hi) + 1, grid_z_ - 1);
+        for (size_t z = slice_first; z <= slice_last; ++z) {
+            //
+            // Tile range of the cluster bounds the sphere's box can touch.
+            // A cluster's x extent is [min(x0 * s_near, x0 * s_far),
+            // max(x1 * s_near, x1 * s_far)], which is monotonic in the tile
+            // edges, so it inverts to the sphere's extent projected on the
+            // near plane from both ends of the slice.
+            const float k_near = dmin / slice_z_[z];
+            const float k_far = dmin / slice_z_[z + 1];
+            const float x0 = center.x_ - radius;
+            const float x1 = center.x_ + radius;
+            const float y0 = center.y_ - radius;
+            const float y1 = center.y_ + radius;
+            const float px_min = std::min(x0 * k_near, x0 * k_far);
+            const float px_max = std::max(x1 * k_near, x1 * k_far);
+            const float py_min = std::min(y0 * k_near, y0 * k_far);
+            const float py_max = std::max(y1 * k_near, y1 * k_far);
+
+            const float fx0 = std::floor((px_min - tile_x_[0]) / tile_width) - 1.0f;
+            const float fx1 = std::floor((px_max - tile_x_[0]) / tile_width) + 1.0f;
+            const float fy0 = std::floor((py_min - tile_y_[0]) / tile_height) - 1.0f;
+            const float fy1 = std::floor((py_max - tile_y_[0]) / tile_height) + 1.0f;
+            if (fx1 < 0.0f || fy1 < 0.0f || fx0 >= grid_x_ || fy0 >= grid_y_)
+                continue;
+
+            const size_t tx0 = static_cast<size_t>(std::max(fx0, 0.0f));
+            const size_t tx1 = std::min(static_cast<size_t>(fx1), grid_x_ - 1);
+            const size_t ty0 = static_cast<size_t>(std::max(fy0, 0.0f));
+            const size_t ty1 = std::min(static_cast<size_t>(fy1), grid_y_ - 1);
+
+            for (size_t y = ty0; y <= ty1; ++y) {
+                const size_t row = cluster_index(0, y, z);
+                const float* row_bounds[6] = {
+                    bounds[0] + row, bounds[1] + row, bounds[2] + row,
+                    bounds[3] + row, bounds[4] + row, bounds[5] + row
+                };
+                kernels_t::sphere_overlap(center, radius, row_bounds, &hits[0],
+                                          tx0, tx1 + 1);
+
+                for (size_t x = tx0; x <= tx1; ++x) {
+                    if (hits[x]) {
+                        const light_cluster_pair p = { 
+                            static_cast<uint32_t>(row + x), light_ids_[l] 
+                        };
+                        pairs->push_back(p);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void v8::math::light_clusters::assign(
+    const v8::math::camera& cam,
+    const v8::math::light* lights,
+    size_t light_count
+    ) {
+    assert(cam.get_projection_type() == camera::Projection_Perspective);
+    update_cluster_bounds(cam);
+
+    //
+    // Pack the point and spot lights, then move them to view space.
+    light_positions_.resize(light_count);
+    light_ranges_.resize(light_count);
+    light_ids_.resize(light_count);
+    size_t packed = 0;
+    for (size_t i = 0; i < light_count; ++i) {
+        if (lights[i].get_type() == light::light_type_directional)
+            continue;
+
+        light_positions_.set(packed, lights[i].get_position());
+        light_ranges_[packed] = lights[i].get_max_range();
+        light_ids_[packed] = static_cast<uint32_t>(i);
+        ++packed;
+    }
+    light_positions_.resize(packed);
+
+    transform_affine_points_soa(
+        cam.get_view_transform(), 
+        light_positions_.x(), light_positions_.y(), light_positions_.z(),
+        light_positions_.x(), light_positions_.y(), light_positions_.z(),
+        packed, max_threads_);
+
+    //
+    // Bin the lights, every task has its own list of pairs.
+    const size_t task_count = 
+        (packed + kLightClusterGrainSize - 1) / kLightClusterGrainSize;
+    if (task_pairs_.size() < task_count)
+        task_pairs_.resize(task_count);
+    for (size_t i = 0; i < task_count; ++i)
+        task_pairs_[i].clear();
+
+    base::parallel_for(packed, kLightClusterGrainSize, max_threads_,
+                       [this](size_t first, size_t last) {
+        bin_lights(first, last, &task_pairs_[first / kLightClusterGrainSize]);
+    });
+
+    //
+    // Counting sort of the pairs, by cluster. The tasks are visited in
+    // order, so the light indices in each list stay sorted.
+    std::fill(offsets_.begin(), offsets_.end(), 0);
+    size_t pair_count = 0;
+    for (size_t t = 0; t < task_count; ++t) {
+        const std::vector<light_cluster_pair>& pairs = task_pairs_[t];
+        for (size_t i = 0; i < pairs.size(); ++i)
+            ++offsets_[pairs[i].cluster + 1];
+        pair_count += pairs.size();
+    }
+
+    for (size_t c = 0; c < cluster_count(); ++c)
+        offsets_[c + 1] += offsets_[c];
+
+    indices_.resize(pair_count);
+    std::vector<uint32_t> cursor(offsets_.begin(), offsets_.end() - 1);
+    for (size_t t = 0; t < task_count; ++t) {
+        const std::vector<light_cluster_pair>& pairs = task_pairs_[t];
+        for (size_t i = 0; i < pairs.size(); ++i)
+            indices_[cursor[pairs[i].cluster]++] = pairs[i].light;
+    }
+}
@@ -0,0 +1,351 @@
+#include "pch_hdr.h"
+#include "v8/base/parallel_for.h"
+#include "v8/math/light_set.h"
+#include "v8/math/math_constants.h"
+
+#if defined(V8_SIMD_ENABLED)
+#include <xmmintrin.h>
+#endif
+
+namespace {
+
+/**
+ * \brief   The values produced by the light kernels.
+ */
+enum light_term {
+    term_range,
+    term_attenuation,
+    term_spot,
+    term_intensity
+};
+
+/**
+ * \brief   Columns of a light_set, as raw pointers.
+ */
+struct light_columns {
+    const float* x;
+    const float* y;
+    const float* z;
+    const float* dir_x;
+    const float* dir_y;
+    const float* dir_z;
+    const float* att_constant;
+    const float* att_linear;
+    const float* att_quadratic;
+    const float* max_range;
+    const float* spot_power;
+    const float* spot_cos;
+
+    explicit light_columns(const v8::math::light_set& lights)
+        :   x(lights.positions().x()),
+            y(lights.positions().y()),
+            z(lights.positions().z()),
+            dir_x(lights.directions().x()),
+            dir_y(lights.directions().y()),
+            dir_z(lights.directions().z()),
+            att_constant(lights.attenuation().x()),
+            att_linear(lights.attenuation().y()),
+            att_quadratic(lights.attenuation().z()),
+            max_range(lights.max_range()),
+            spot_power(lights.spot_power()),
+            spot_cos(lights.spot_cone_cos()) {}
+};
+
+inline float spot_factor(float cos_alpha, float cone_cos, float power) {
+    if (cos_alpha < cone_cos)
+        return 0.0f;
+
+    return power == 0.0f ? 1.0f : std::pow(std::max(cos_alpha, 0.0f), power);
+}
+
+/**
+ * \brief   Scalar version, evaluates the lights in [first, last) for one
+ *          point.
+ */
+struct light_scalar_kernels {
+    template<light_term term, typename output_t>
+    static void evaluate(
+        const light_columns& lc,
+        float px,
+        float py,
+        float pz,
+        output_t* out,
+        size_t first,
+        size_t last
+        )
+    {
+        for (size_t i = first; i < last; ++i) {
+            const float dx = px - lc.x[i];
+            const float dy = py - lc.y[i];
+            const float dz = pz - lc.z[i];
+            const float dist_sq = dx * dx + dy * dy + dz * dz;
+
+            const bool in_range = dist_sq <= lc.max_range[i] * lc.max_range[i];
+            if (term == term_range) {
+                out[i] = static_cast<output_t>(in_range);
+                continue;
+            }
+
+            if (term == term_intensity && !in_range) {
+                out[i] = 0.0f;
+                continue;
+            }
+
+            const float dist = std::sqrt(dist_sq);
+            float attenuation = 1.0f;
+            if (term == term_attenuation || term == term_intensity) {
+                attenuation = 1.0f / (lc.att_constant[i] + lc.att_linear[i] * dist 
+                                      + lc.att_quadratic[i] * dist_sq);
+            }
+
+            float spot = 1.0f;
+            if (term == term_spot || term == term_intensity) {
+                const float inv_dist = dist > 0.0f ? 1.0f / dist : 0.0f;
+                const float cos_alpha = 
+                    (dx * lc.dir_x[i] + dy * lc.dir_y[i] + dz * lc.dir_z[i]) 
+                    * inv_dist;
+                spot = spot_factor(cos_alpha, lc.spot_cos[i], lc.spot_power[i]);
+            }
+
+            out[i] = static_cast<output_t>(attenuation * spot);
+        }
+    }
+};
+
+#if defined(V8_SIMD_ENABLED)
+
+/**
+ * \brief   SSE version, 4 lights per iteration, same operation order as
+ *          the scalar kernel. There is no vector pow(), so the spot factor
+ *          for the lanes that are inside the cone, with a non zero spot
+ *          power, is computed with std::pow(); lanes out of range are
+ *          skipped when computing the intensity.
+ */
+struct light_sse_kernels {
+    template<light_term term, typename output_t>
+    static void evaluate(
+        const light_columns& lc,
+        float px,
+        float py,
+        float pz,
+        output_t* out,
+        size_t first,
+        size_t last
+        )
+    {
+        const __m128 pxv = _mm_set1_ps(px);
+        const __m128 pyv = _mm_set1_ps(py);
+        const __m128 pzv = _mm_set1_ps(pz);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        const size_t simd_last = first + ((last - first) & ~size_t(3));
+        for (size_t i = first; i < simd_last; i += 4) {
+            const __m128 dx = _mm_sub_ps(pxv, _mm_loadu_ps(lc.x + i));
+            const __m128 dy = _mm_sub_ps(pyv, _mm_loadu_ps(lc.y + i));
+            const __m128 dz = _mm_sub_ps(pzv, _mm_loadu_ps(lc.z + i));
+            const __m128 dist_sq = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                _mm_mul_ps(dz, dz));
+            const __m128 range = _mm_loadu_ps(lc.max_range + i);
+            const __m128 in_range = _mm_cmple_ps(dist_sq, _mm_mul_ps(range, range));
+
+            if (term == term_range) {
+                const int mask = _mm_movemask_ps(in_range);
+                for (size_t j = 0; j < 4; ++j)
+                    out[i + j] = static_cast<output_t>((mask >> j) & 1);
+                continue;
+            }
+
+            const __m128 dist = _mm_sqrt_ps(dist_sq);
+            __m128 attenuation = one;
+            if (term == term_attenuation || term == term_intensity) {
+                attenuation = _mm_div_ps(one, _mm_add_ps(
+                    _mm_add_ps(_mm_loadu_ps(lc.att_constant + i),
+                               _mm_mul_ps(_mm_loadu_ps(lc.att_linear + i), dist)),
+                    _mm_mul_ps(_mm_loadu_ps(lc.att_quadratic + i), dist_sq)));
+            }
+
+            __m128 spot = one;
+            if (term == term_spot || term == term_intensity) {
+                const __m128 inv_dist = _mm_and_ps(_mm_cmpgt_ps(dist, zero),
+                                                   _mm_div_ps(one, dist));
+                const __m128 cos_alpha = _mm_mul_ps(
+                    _mm_add_ps(_mm_add_ps(
+                        _mm_mul_ps(dx, _mm_loadu_ps(lc.dir_x + i)),
+                        _mm_mul_ps(dy, _mm_loadu_ps(lc.dir_y + i))),
+                        _mm_mul_ps(dz, _mm_loadu_ps(lc.dir_z + i))),
+                    inv_dist);
+                const __m128 power = _mm_loadu_ps(lc.spot_power + i);
+                const __m128 in_cone = _mm_cmpge_ps(
+                    cos_alpha, _mm_loadu_ps(lc.spot_cos + i));
+                int pow_lanes = _mm_movemask_ps(
+                    _mm_andnot_ps(_mm_cmpeq_ps(power, zero), in_cone));
+                if (term == term_intensity)
+                    pow_lanes &= _mm_movemask_ps(in_range);
+
+                spot = _mm_and_ps(in_cone, one);
+                if (pow_lanes) {
+                    union {
+                        __m128 v;
+                        float f[4];
+                    } c, p, s;
+                    c.v = _mm_max_ps(cos_alpha, zero);
+                    p.v = power;
+                    s.v = spot;
+                    for (size_t j = 0; j < 4; ++j) {
+                        if ((pow_lanes >> j) & 1)
+                            s.f[j] = std::pow(c.f[j], p.f[j]);
+                    }
+                    spot = s.v;
+                }
+            }
+
+            union {
+                __m128 v;
+                float f[4];
+            } res;
+            res.v = _mm_mul_ps(attenuation, spot);
+            if (term == term_intensity)
+                res.v = _mm_and_ps(res.v, in_range);
+
+            for (size_t j = 0; j < 4; ++j)
+                out[i + j] = static_cast<output_t>(res.f[j]);
+        }
+
+        light_scalar_kernels::evaluate<term>(lc, px, py, pz, out, simd_last, last);
+    }
+};
+
+typedef light_sse_kernels light_kernels;
+
+#else
+
+typedef light_scalar_kernels light_kernels;
+
+#endif
+
+template<light_term term, typename output_t>
+void evaluate_term(
+    const v8::math::light_set& lights,
+    const v8::math::vector3_soaF& points,
+    output_t* result,
+    unsigned int max_threads
+    ) {
+    const size_t light_count = lights.light_count();
+    if (!light_count)
+        return;
+
+    const light_columns lc(lights);
+    const float* px = points.x();
+    const float* py = points.y();
+    const float* pz = points.z();
+
+    v8::base::parallel_for(points.size(), v8::math::kLightSetGrainSize, 
+                           max_threads,
+                           [&lc, px, py, pz, result, light_count]
+                           (size_t first, size_t last) {
+        for (size_t p = first; p < last; ++p) {
+            light_kernels::evaluate<term>(lc, px[p], py[p], pz[p],
+                                          result + p * light_count, 
+                                          0, light_count);
+        }
+    });
+}
+
+} // anonymous namespace
+
+v8::math::light_set::light_set(
+    const v8::math::light* lights,
+    size_t count
+    ) {
+    reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (lights[i].get_type() != light::light_type_directional)
+            add(lights[i]);
+    }
+}
+
+size_t v8::math::light_set::add(const v8::math::light& source) {
+    assert(source.get_type() != light::light_type_directional);
+
+    const size_t index = light_count();
+    if (index == positions_.capacity())
+        reserve(2 * index);
+
+    positions_.resize(index + 1);
+    directions_.resize(index + 1);
+    attenuation_.resize(index + 1);
+    positions_.set(index, source.get_position());
+    attenuation_.set(index, source.get_attenuation_factors());
+    max_range_.push_back(source.get_max_range());
+
+    if (source.get_type() == light::light_type_spot) {
+        vector3F direction(source.get_direction());
+        directions_.set(index, direction.normalize());
+        spot_power_.push_back(source.get_spot_power());
+        spot_cone_theta_.push_back(source.get_spot_cone_angle());
+    } else {
+        directions_.set(index, vector3F::zero);
+        spot_power_.push_back(0.0f);
+        spot_cone_theta_.push_back(constants::kPi);
+    }
+    spot_cone_cos_.push_back(std::cos(spot_cone_theta_.back()));
+    return index;
+}
+
+void v8::math::light_set::reserve(size_t count) {
+    positions_.reserve(count);
+    directions_.reserve(count);
+    attenuation_.reserve(count);
+    max_range_.reserve(count);
+    spot_power_.reserve(count);
+    spot_cone_theta_.reserve(count);
+    spot_cone_cos_.reserve(count);
+}
+
+void v8::math::light_set::clear() {
+    positions_.clear();
+    directions_.clear();
+    attenuation_.clear();
+    max_range_.clear();
+    spot_power_.clear();
+    spot_cone_theta_.clear();
+    spot_cone_cos_.clear();
+}
+
+void v8::math::light_range_cull(
+    const v8::math::light_set& lights,
+    const v8::math::vector3_soaF& points,
+    uint8_t* in_range,
+    unsigned int max_threads
+    ) {
+    evaluate_term<term_range>(lights, points, in_range, max_threads);
+}
+
+void v8::math::light_distance_attenuation(
+    const v8::math::light_set& lights,
+    const v8::math::vector3_soaF& points,
+    float* attenuation,
+    unsigned int max_threads
+    ) {
+    evaluate_term<term_attenuation>(lights, points, attenuation, max_threads);
+}
+
+void v8::math::light_spot_falloff(
+    const v8::math::light_set& lights,
+    const v8::math::vector3_soaF& points,
+    float* falloff,
+    unsigned int max_threads
+    ) {
+    evaluate_term<term_spot>(lights, points, falloff, max_threads);
+}
+
+void v8::math::evaluate_lights(
+    const v8::math::light_set& lights,
+    const v8::math::vector3_soaF& points,
+    float* intensity,
+    unsigned int max_threads
+    ) {
+    evaluate_term<term_intensity>(lights, points, intensity, max_threads);
+}
@@ -0,0 +1,237 @@
+#include "pch_hdr.h"
+#include "v8/base/parallel_for.h"
+#include "v8/math/linear_blend_skinning.h"
+#include "skinning_streams.h"
+
+#if defined(V8_SIMD_ENABLED)
+#include <xmmintrin.h>
+#include "v8/math/sse_utils.h"
+#endif
+
+namespace {
+
+/**
+ * \brief   Inputs and outputs of a skinning job, as raw pointers. Bone b
+ *          uses the 12 floats at palette + b * palette_stride.
+ */
+struct lbs_streams : v8::math::internals::skinning_vertex_streams {
+    const float*        palette;
+    size_t              palette_stride;
+    const uint16_t*     indices;
+    const float*        weights;
+};
+
+struct lbs_scalar_kernels {
+    template<size_t influences>
+    static void skin(
+        const lbs_streams& s,
+        size_t first,
+        size_t last
+        )
+    {
+        for (size_t i = first; i < last; ++i) {
+            const uint16_t* bones = s.indices + influences * i;
+            const float* weights = s.weights + influences * i;
+
+            float m[12];
+            const float* bone = s.palette + bones[0] * s.palette_stride;
+            for (size_t j = 0; j < 12; ++j)
+                m[j] = weights[0] * bone[j];
+            for (size_t k = 1; k < influences; ++k) {
+                bone = s.palette + bones[k] * s.palette_stride;
+                for (size_t j = 0; j < 12; ++j)
+                    m[j] += weights[k] * bone[j];
+            }
+
+            float x = s.px[i], y = s.py[i], z = s.pz[i];
+            s.out_px[i] = m[0] * x + m[1] * y + m[2] * z + m[3];
+            s.out_py[i] = m[4] * x + m[5] * y + m[6] * z + m[7];
+            s.out_pz[i] = m[8] * x + m[9] * y + m[10] * z + m[11];
+
+            if (!s.nx)
+                continue;
+
+            x = s.nx[i], y = s.ny[i], z = s.nz[i];
+            s.out_nx[i] = m[0] * x + m[1] * y + m[2] * z;
+            s.out_ny[i] = m[4] * x + m[5] * y + m[6] * z;
+            s.out_nz[i] = m[8] * x + m[9] * y + m[10] * z;
+        }
+    }
+};
+
+#if defined(V8_SIMD_ENABLED)
+
+/**
+ * \brief   SSE version. The matrices of 4 vertices are blended one row per
+ *          register, then each row is transposed so that the transforms
+ *          work on one vertex per lane.
+ */
+struct lbs_sse_kernels {
+    template<size_t influences>
+    static void blend_rows(
+        const lbs_streams& s,
+        size_t vertex,
+        __m128* rows
+        )
+    {
+        const uint16_t* bones = s.indices + influences * vertex;
+        const float* weights = s.weights + influences * vertex;
+
+        const float* bone = s.palette + bones[0] * s.palette_stride;
+        __m128 w = _mm_set1_ps(weights[0]);
+        rows[0] = _mm_mul_ps(w, _mm_loadu_ps(bone));
+        rows[1] = _mm_mul_ps(w, _mm_loadu_ps(bone + 4));
+        rows[2] = _mm_mul_ps(w, _mm_loadu_ps(bone + 8));
+        for (size_t k = 1; k < influences; ++k) {
+            bone = s.palette + bones[k] * s.palette_stride;
+            w = _mm_set1_ps(weights[k]);
+            rows[0] = _mm_add_ps(rows[0], _mm_mul_ps(w, _mm_loadu_ps(bone)));
+            rows[1] = _mm_add_ps(rows[1], _mm_mul_ps(w, _mm_loadu_ps(bone + 4)));
+            rows[2] = _mm_add_ps(rows[2], _mm_mul_ps(w, _mm_loadu_ps(bone + 8)));
+        }
+    }
+
+    template<size_t influences>
+    static void skin(
+        const lbs_streams& s,
+        size_t first,
+        size_t last
+        )
+    {
+        using namespace v8::math;
+
+        const size_t simd_last = first + ((last - first) & ~size_t(3));
+
+        for (size_t i = first; i < simd_last; i += 4) {
+            //
+            // m[row][vertex], after the transpose m[row][column].
+            __m128 m[3][4];
+            __m128 rows[3];
+            for (size_t v = 0; v < 4; ++v) {
+                blend_rows<influences>(s, i + v, rows);
+                m[0][v] = rows[0];
+                m[1][v] = rows[1];
+                m[2][v] = rows[2];
+            }
+            for (size_t r = 0; r < 3; ++r)
+                _MM_TRANSPOSE4_PS(m[r][0], m[r][1], m[r][2], m[r][3]);
+
+            const __m128 x = _mm_loadu_ps(s.px + i);
+            const __m128 y = _mm_loadu_ps(s.py + i);
+            const __m128 z = _mm_loadu_ps(s.pz + i);
+            _mm_storeu_ps(s.out_px + i, sse::linear_combination(
+                m[0][0], x, m[0][1], y, m[0][2], z, m[0][3]));
+            _mm_storeu_ps(s.out_py + i, sse::linear_combination(
+                m[1][0], x, m[1][1], y, m[1][2], z, m[1][3]));
+            _mm_storeu_ps(s.out_pz + i, sse::linear_combination(
+                m[2][0], x, m[2][1], y, m[2][2], z, m[2][3]));
+
+            if (s.nx) {
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 nx = _mm_loadu_ps(s.nx + i);
+                const __m128 ny = _mm_loadu_ps(s.ny + i);
+                const __m128 nz = _mm_loadu_ps(s.nz + i);
+                _mm_storeu_ps(s.out_nx + i, sse::linear_combination(
+                    m[0][0], nx, m[0][1], ny, m[0][2], nz, zero));
+                _mm_storeu_ps(s.out_ny + i, sse::linear_combination(
+                    m[1][0], nx, m[1][1], ny, m[1][2], nz, zero));
+                _mm_storeu_ps(s.out_nz + i, sse::linear_combination(
+                    m[2][0], nx, m[2][1], ny, m[2][2], nz, zero));
+            }
+        }
+
+        lbs_scalar_kernels::skin<influences>(s, simd_last, last);
+    }
+};
+
+typedef lbs_sse_kernels lbs_kernels;
+
+#else
+
+typedef lbs_scalar_kernels lbs_kernels;
+
+#endif
+
+template<size_t influences>
+void
+run_skinning(const lbs_streams& s, size_t count, unsigned int max_threads) {
+    v8::base::parallel_for(count, v8::math::kLinearBlendSkinningGrainSize,
+                           max_threads, [s](size_t first, size_t last) {
+        lbs_kernels::skin<influences>(s, first, last);
+    });
+}
+
+void
+skin_linear_blend_impl(
+    const float* palette,
+    size_t palette_stride,
+    const uint16_t* bone_indices,
+    const float* bone_weights,
+    v8::math::skinning_influences influences,
+    const v8::math::vector3_soaF& positions,
+    const v8::math::vector3_soaF* normals,
+    v8::math::vector3_soaF* skinned_positions,
+    v8::math::vector3_soaF* skinned_normals,
+    unsigned int max_threads
+    )
+{
+    lbs_streams s;
+    const size_t count = v8::math::internals::init_skinning_streams(
+        positions, normals, skinned_positions, skinned_normals, &s);
+    s.palette = palette;
+    s.palette_stride = palette_stride;
+    s.indices = bone_indices;
+    s.weights = bone_weights;
+
+    switch (influences) {
+    case v8::math::skinning_influences_1 :
+        run_skinning<1>(s, count, max_threads);
+        break;
+
+    case v8::math::skinning_influences_2 :
+        run_skinning<2>(s, count, max_threads);
+        break;
+
+    case v8::math::skinning_influences_4 :
+        run_skinning<4>(s, count, max_threads);
+        break;
+
+    case v8::math::skinning_influences_8 :
+        run_skinning<8>(s, count, max_threads);
+        break;
+    }
+}
+
+} // anonymous namespace
+
+void v8::math::skin_linear_blend(
+    const float* palette_3X4,
+    const uint16_t* bone_indices,
+    const float* bone_weights,
+    v8::math::skinning_influences influences,
+    const v8::math::vector3_soaF& positions,
+    const v8::math::vector3_soaF* normals,
+    v8::math::vector3_soaF* skinned_positions,
+    v8::math::vector3_soaF* skinned_normals,
+    unsigned int max_threads
+    ) {
+    skin_linear_blend_impl(palette_3X4, 12, bone_indices, bone_weights,
+                           influences, positions, normals, skinned_positions,
+                           skinned_normals, max_threads);
+}
+
+void v8::math::skin_linear_blend(
+    const v8::math::matrix_4X4F* palette,
+    const uint16_t* bone_indices,
+    const float* bone_weights,
+    v8::math::skinning_influences influences,
+    const v8::math::vector3_soaF& positions,
+    const v8::math::vector3_soaF* normals,
+    v8::math::vector3_soaF* skinned_positions,
+    v8::math::vector3_soaF* skinned_normals,
+    unsigned int max_threads
+    ) {
+    skin_linear_blend_impl(palette->elements_, 16, bone_indices, bone_weights,
+                           influences, positions, normals, skinned_positions,
+                           skinned_normals, max_threads);
+}
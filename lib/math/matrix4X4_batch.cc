@@ -0,0 +1,191 @@
+#include "pch_hdr.h"
+#include "v8/base/cpu_features.h"
+#include "v8/math/matrix4X4_batch.h"
+#include "matrix4X4_batch_avx.h"
+
+namespace {
+
+using v8::math::matrix_4X4;
+using v8::math::vector3;
+using v8::math::vector4;
+using v8::math::internals::batch_transform_kernel_table;
+
+/**
+ * \brief   Adapts a kernels struct (batch_transform_scalar_kernels<float>
+ *          or batch_transform_sse_kernels) to the table signatures.
+ */
+template<typename kernels_t>
+struct kernel_table_adapter {
+    template<bool is_point>
+    static void affine_aos(
+        const matrix_4X4<float>& mtx,
+        const vector3<float>* input,
+        vector3<float>* output,
+        size_t count
+        )
+    {
+        kernels_t::template affine_aos<is_point>(mtx, input, output, count);
+    }
+
+    template<bool is_point>
+    static void affine_soa(
+        const matrix_4X4<float>& mtx,
+        const float* x_in,
+        const float* y_in,
+        const float* z_in,
+        float* x_out,
+        float* y_out,
+        float* z_out,
+        size_t count
+        )
+    {
+        kernels_t::template affine_soa<is_point>(
+            mtx, x_in, y_in, z_in, x_out, y_out, z_out, count);
+    }
+
+    static void homogeneous_aos(
+        const matrix_4X4<float>& mtx,
+        const vector4<float>* input,
+        vector4<float>* output,
+        size_t count
+        )
+    {
+        kernels_t::homogeneous_aos(mtx, input, output, count);
+    }
+};
+
+#if defined(V8_SIMD_ENABLED)
+
+#define V8_DEFINE_AVX_KERNEL_ADAPTER(suffix)                                \
+    struct avx_kernel_adapter_##suffix {                                    \
+        static void points_aos(const matrix_4X4<float>& mtx,                \
+                               const vector3<float>* input,                 \
+                               vector3<float>* output, size_t count) {      \
+            v8::math::internals::batch_transform_points_aos_##suffix(       \
+                mtx.elements_, input->elements_, output->elements_, count); \
+        }                                                                   \
+        static void vectors_aos(const matrix_4X4<float>& mtx,               \
+                                const vector3<float>* input,                \
+                                vector3<float>* output, size_t count) {     \
+            v8::math::internals::batch_transform_vectors_aos_##suffix(      \
+                mtx.elements_, input->elements_, output->elements_, count); \
+        }                                                                   \
+        static void points_soa(const matrix_4X4<float>& mtx,                \
+                               const float* x_in, const float* y_in,        \
+                               const float* z_in, float* x_out,             \
+                               float* y_out, float* z_out, size_t count) {  \
+            v8::math::internals::batch_transform_points_soa_##suffix(       \
+                mtx.elements_, x_in, y_in, z_in, x_out, y_out, z_out,       \
+                count);                                                     \
+        }                                                                   \
+        static void vectors_soa(const matrix_4X4<float>& mtx,               \
+                                const float* x_in, const float* y_in,       \
+                                const float* z_in, float* x_out,            \
+                                float* y_out, float* z_out, size_t count) { \
+            v8::math::internals::batch_transform_vectors_soa_##suffix(      \
+                mtx.elements_, x_in, y_in, z_in, x_out, y_out, z_out,       \
+                count);                                                     \
+        }                                                                   \
+        static void homogeneous_aos(const matrix_4X4<float>& mtx,           \
+                                    const vector4<float>* input,            \
+                                    vector4<float>* output, size_t count) { \
+            v8::math::internals::batch_transform_homogeneous_aos_##suffix(  \
+                mtx.elements_, input->elements_, output->elements_, count); \
+        }                                                                   \
+    }
+
+V8_DEFINE_AVX_KERNEL_ADAPTER(avx);
+
+V8_DEFINE_AVX_KERNEL_ADAPTER(avx2);
+
+#undef V8_DEFINE_AVX_KERNEL_ADAPTER
+
+#endif // V8_SIMD_ENABLED
+
+//
+// The tables are constant initialized, so they can be used by the static
+// initializers of other translation units.
+typedef kernel_table_adapter<
+    v8::math::internals::batch_transform_scalar_kernels<float>
+> scalar_adapter_t;
+
+const batch_transform_kernel_table kScalarKernels = {
+    v8::base::simd_tier_scalar,
+    &scalar_adapter_t::affine_aos<true>,
+    &scalar_adapter_t::affine_aos<false>,
+    &scalar_adapter_t::affine_soa<true>,
+    &scalar_adapter_t::affine_soa<false>,
+    &scalar_adapter_t::homogeneous_aos
+};
+
+#if defined(V8_SIMD_ENABLED)
+
+typedef kernel_table_adapter<
+    v8::math::internals::batch_transform_sse_kernels
+> sse_adapter_t;
+
+const batch_transform_kernel_table kSSEKernels = {
+    v8::base::simd_tier_sse2,
+    &sse_adapter_t::affine_aos<true>,
+    &sse_adapter_t::affine_aos<false>,
+    &sse_adapter_t::affine_soa<true>,
+    &sse_adapter_t::affine_soa<false>,
+    &sse_adapter_t::homogeneous_aos
+};
+
+const batch_transform_kernel_table kAVXKernels = {
+    v8::base::simd_tier_avx,
+    &avx_kernel_adapter_avx::points_aos,
+    &avx_kernel_adapter_avx::vectors_aos,
+    &avx_kernel_adapter_avx::points_soa,
+    &avx_kernel_adapter_avx::vectors_soa,
+    &avx_kernel_adapter_avx::homogeneous_aos
+};
+
+const batch_transform_kernel_table kAVX2Kernels = {
+    v8::base::simd_tier_avx2,
+    &avx_kernel_adapter_avx2::points_aos,
+    &avx_kernel_adapter_avx2::vectors_aos,
+    &avx_kernel_adapter_avx2::points_soa,
+    &avx_kernel_adapter_avx2::vectors_soa,
+    &avx_kernel_adapter_avx2::homogeneous_aos
+};
+
+#endif // V8_SIMD_ENABLED
+
+} // anonymous namespace
+
+const v8::math::internals::batch_transform_kernel_table&
+v8::math::internals::batch_transform_kernels_for_tier(
+    v8::base::simd_tier tier
+    )
+{
+    assert(tier <= base::host_simd_tier());
+
+#if defined(V8_SIMD_ENABLED)
+    switch (tier) {
+    case base::simd_tier_avx512 :
+    case base::simd_tier_avx2 :
+        return kAVX2Kernels;
+
+    case base::simd_tier_avx :
+        return kAVXKernels;
+
+    case base::simd_tier_sse41 :
+    case base::simd_tier_sse2 :
+        return kSSEKernels;
+
+    default :
+        break;
+    }
+#endif
+
+    return kScalarKernels;
+}
+
+const v8::math::internals::batch_transform_kernel_table&
+v8::math::internals::batch_transform_kernels_for_host() {
+    static const batch_transform_kernel_table& table = 
+        batch_transform_kernels_for_tier(base::host_simd_tier());
+    return table;
+}
@@ -0,0 +1,11 @@
+//
+// Compiled with AVX code generation (/arch:AVX, -mavx). Does not use the
+// precompiled header, and must not include any of the library headers,
+// see matrix4X4_batch_avx.h.
+#include <immintrin.h>
+#include "matrix4X4_batch_avx.h"
+
+#define V8_AVX_KERNEL_SUFFIX    avx
+#define V8_AVX_MADD(a, b, c)    _mm256_add_ps(_mm256_mul_ps((a), (b)), (c))
+
+#include "matrix4X4_batch_avx_kernels.inl"
@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+
+//
+// Batch transform kernels that are compiled with AVX (matrix4X4_batch_avx.cc)
+// and AVX2 + FMA (matrix4X4_batch_avx2.cc) code generation enabled. They
+// work on raw float arrays, so that the translation units compiled with
+// those flags do not instantiate any of the inline functions/templates that
+// the rest of the library uses (the linker could pick the AVX version of
+// an inline function and use it on a processor without AVX).
+// mtx points to the 16 elements of a row major matrix_4X4<float>.
+
+namespace v8 { namespace math { namespace internals {
+
+#define V8_DECLARE_BATCH_TRANSFORM_KERNELS(suffix)                          \
+    void batch_transform_points_aos_##suffix(                               \
+        const float* mtx, const float* input, float* output, size_t count); \
+    void batch_transform_vectors_aos_##suffix(                              \
+        const float* mtx, const float* input, float* output, size_t count); \
+    void batch_transform_points_soa_##suffix(                               \
+        const float* mtx, const float* x_in, const float* y_in,             \
+        const float* z_in, float* x_out, float* y_out, float* z_out,        \
+        size_t count);                                                      \
+    void batch_transform_vectors_soa_##suffix(                              \
+        const float* mtx, const float* x_in, const float* y_in,             \
+        const float* z_in, float* x_out, float* y_out, float* z_out,        \
+        size_t count);                                                      \
+    void batch_transform_homogeneous_aos_##suffix(                          \
+        const float* mtx, const float* input, float* output, size_t count)
+
+V8_DECLARE_BATCH_TRANSFORM_KERNELS(avx);
+
+V8_DECLARE_BATCH_TRANSFORM_KERNELS(avx2);
+
+#undef V8_DECLARE_BATCH_TRANSFORM_KERNELS
+
+} // namespace internals
+} // namespace math
+} // namespace v8
@@ -0,0 +1,283 @@
+//
+// Body of the AVX batch transform kernels, shared by matrix4X4_batch_avx.cc
+// and matrix4X4_batch_avx2.cc. Before including this file define :
+// V8_AVX_KERNEL_SUFFIX - suffix of the exported function names (avx, avx2)
+// V8_AVX_MADD(a, b, c) - computes a * b + c on __m256 values.
+
+#define V8_AVX_KERNEL_NAME_IMPL(name, suffix)   name##_##suffix
+#define V8_AVX_KERNEL_NAME_EXPAND(name, suffix) V8_AVX_KERNEL_NAME_IMPL(name, suffix)
+#define V8_AVX_KERNEL_NAME(name)                \
+    V8_AVX_KERNEL_NAME_EXPAND(name, V8_AVX_KERNEL_SUFFIX)
+
+namespace {
+
+/**
+ * \brief   The 12 elements of the upper 3x4 part of the matrix, broadcast
+ *          to all the lanes. The translation is zero for vectors.
+ */
+struct broadcast_matrix {
+    __m256 m[12];
+
+    broadcast_matrix(const float* mtx, bool is_point) {
+        for (int row = 0; row < 3; ++row) {
+            m[row * 4] = _mm256_set1_ps(mtx[row * 4]);
+            m[row * 4 + 1] = _mm256_set1_ps(mtx[row * 4 + 1]);
+            m[row * 4 + 2] = _mm256_set1_ps(mtx[row * 4 + 2]);
+            m[row * 4 + 3] = is_point ? _mm256_set1_ps(mtx[row * 4 + 3])
+                                      : _mm256_setzero_ps();
+        }
+    }
+
+    void transform(
+        __m256 x, __m256 y, __m256 z,
+        __m256* x_out, __m256* y_out, __m256* z_out
+        ) const
+    {
+        //
+        // Same evaluation order as the scalar kernels, 
+        // ((m1 * x + m2 * y) + m3 * z) + m4, so that without FMA the results
+        // are identical.
+        *x_out = _mm256_add_ps(V8_AVX_MADD(m[2], z, V8_AVX_MADD(
+            m[1], y, _mm256_mul_ps(m[0], x))), m[3]);
+        *y_out = _mm256_add_ps(V8_AVX_MADD(m[6], z, V8_AVX_MADD(
+            m[5], y, _mm256_mul_ps(m[4], x))), m[7]);
+        *z_out = _mm256_add_ps(V8_AVX_MADD(m[10], z, V8_AVX_MADD(
+            m[9], y, _mm256_mul_ps(m[8], x))), m[11]);
+    }
+};
+
+inline
+__m256
+load_halves(
+    const float* lo,
+    const float* hi
+    )
+{
+    return _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm_loadu_ps(lo)), _mm_loadu_ps(hi), 1);
+}
+
+inline
+void
+store_halves(
+    float* lo,
+    float* hi,
+    __m256 v
+    )
+{
+    _mm_storeu_ps(lo, _mm256_castps256_ps128(v));
+    _mm_storeu_ps(hi, _mm256_extractf128_ps(v, 1));
+}
+
+void
+affine_scalar(
+    const float* mtx,
+    bool is_point,
+    const float* input,
+    float* output,
+    size_t count
+    )
+{
+    const float w = is_point ? 1.0f : 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        const float x = input[i * 3];
+        const float y = input[i * 3 + 1];
+        const float z = input[i * 3 + 2];
+        output[i * 3] = mtx[0] * x + mtx[1] * y + mtx[2] * z + mtx[3] * w;
+        output[i * 3 + 1] = mtx[4] * x + mtx[5] * y + mtx[6] * z + mtx[7] * w;
+        output[i * 3 + 2] = mtx[8] * x + mtx[9] * y + mtx[10] * z + mtx[11] * w;
+    }
+}
+
+/**
+ * \brief   Processes 8 points per iteration. The low 128 bit lanes hold
+ *          points 0 - 3, the high lanes points 4 - 7, and the same
+ *          (in lane) shuffles as sse::load_vector3x4() are used to 
+ *          transpose them to x, y, z.
+ */
+void
+affine_aos(
+    const float* mtx,
+    bool is_point,
+    const float* input,
+    float* output,
+    size_t count
+    )
+{
+    const broadcast_matrix bm(mtx, is_point);
+
+    const size_t simd_count = count & ~size_t(7);
+    for (size_t i = 0; i < simd_count; i += 8) {
+        const float* src = input + i * 3;
+        const __m256 a = load_halves(src, src + 12);
+        const __m256 b = load_halves(src + 4, src + 16);
+        const __m256 c = load_halves(src + 8, src + 20);
+
+        const __m256 b2c1 = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+        const __m256 x = _mm256_shuffle_ps(a, b2c1, _MM_SHUFFLE(2, 0, 3, 0));
+        const __m256 a1b0 = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+        const __m256 b3c2 = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+        const __m256 y = _mm256_shuffle_ps(a1b0, b3c2, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 a2b1 = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+        const __m256 z = _mm256_shuffle_ps(a2b1, c, _MM_SHUFFLE(3, 0, 2, 0));
+
+        __m256 rx, ry, rz;
+        bm.transform(x, y, z, &rx, &ry, &rz);
+
+        const __m256 x0y0 = _mm256_shuffle_ps(rx, ry, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m256 z0x1 = _mm256_shuffle_ps(rz, rx, _MM_SHUFFLE(1, 1, 0, 0));
+        const __m256 y1z1 = _mm256_shuffle_ps(ry, rz, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m256 x2y2 = _mm256_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m256 z2x3 = _mm256_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 3, 2, 2));
+        const __m256 y3z3 = _mm256_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 3, 3, 3));
+
+        float* dst = output + i * 3;
+        store_halves(dst, dst + 12,
+                     _mm256_shuffle_ps(x0y0, z0x1, _MM_SHUFFLE(2, 0, 2, 0)));
+        store_halves(dst + 4, dst + 16,
+                     _mm256_shuffle_ps(y1z1, x2y2, _MM_SHUFFLE(2, 0, 2, 0)));
+        store_halves(dst + 8, dst + 20,
+                     _mm256_shuffle_ps(z2x3, y3z3, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+
+    affine_scalar(mtx, is_point, input + simd_count * 3, 
+                  output + simd_count * 3, count - simd_count);
+}
+
+void
+affine_soa(
+    const float* mtx,
+    bool is_point,
+    const float* x_in,
+    const float* y_in,
+    const float* z_in,
+    float* x_out,
+    float* y_out,
+    float* z_out,
+    size_t count
+    )
+{
+    const broadcast_matrix bm(mtx, is_point);
+
+    const size_t simd_count = count & ~size_t(7);
+    for (size_t i = 0; i < simd_count; i += 8) {
+        __m256 rx, ry, rz;
+        bm.transform(_mm256_loadu_ps(x_in + i), _mm256_loadu_ps(y_in + i),
+                     _mm256_loadu_ps(z_in + i), &rx, &ry, &rz);
+        _mm256_storeu_ps(x_out + i, rx);
+        _mm256_storeu_ps(y_out + i, ry);
+        _mm256_storeu_ps(z_out + i, rz);
+    }
+
+    const float w = is_point ? 1.0f : 0.0f;
+    for (size_t i = simd_count; i < count; ++i) {
+        const float x = x_in[i];
+        const float y = y_in[i];
+        const float z = z_in[i];
+        x_out[i] = mtx[0] * x + mtx[1] * y + mtx[2] * z + mtx[3] * w;
+        y_out[i] = mtx[4] * x + mtx[5] * y + mtx[6] * z + mtx[7] * w;
+        z_out[i] = mtx[8] * x + mtx[9] * y + mtx[10] * z + mtx[11] * w;
+    }
+}
+
+} // anonymous namespace
+
+void
+v8::math::internals::V8_AVX_KERNEL_NAME(batch_transform_points_aos)(
+    const float* mtx,
+    const float* input,
+    float* output,
+    size_t count
+    )
+{
+    affine_aos(mtx, true, input, output, count);
+}
+
+void
+v8::math::internals::V8_AVX_KERNEL_NAME(batch_transform_vectors_aos)(
+    const float* mtx,
+    const float* input,
+    float* output,
+    size_t count
+    )
+{
+    affine_aos(mtx, false, input, output, count);
+}
+
+void
+v8::math::internals::V8_AVX_KERNEL_NAME(batch_transform_points_soa)(
+    const float* mtx,
+    const float* x_in,
+    const float* y_in,
+    const float* z_in,
+    float* x_out,
+    float* y_out,
+    float* z_out,
+    size_t count
+    )
+{
+    affine_soa(mtx, true, x_in, y_in, z_in, x_out, y_out, z_out, count);
+}
+
+void
+v8::math::internals::V8_AVX_KERNEL_NAME(batch_transform_vectors_soa)(
+    const float* mtx,
+    const float* x_in,
+    const float* y_in,
+    const float* z_in,
+    float* x_out,
+    float* y_out,
+    float* z_out,
+    size_t count
+    )
+{
+    affine_soa(mtx, false, x_in, y_in, z_in, x_out, y_out, z_out, count);
+}
+
+void
+v8::math::internals::V8_AVX_KERNEL_NAME(batch_transform_homogeneous_aos)(
+    const float* mtx,
+    const float* input,
+    float* output,
+    size_t count
+    )
+{
+    //
+    // Two points per iteration, one in each 128 bit lane. 
+    // output = col1 * x + col2 * y + col3 * z + col4 * w, with the columns
+    // of the matrix duplicated in both lanes.
+    __m256 col[4];
+    for (int i = 0; i < 4; ++i)
+        col[i] = _mm256_setr_ps(mtx[i], mtx[4 + i], mtx[8 + i], mtx[12 + i],
+                                mtx[i], mtx[4 + i], mtx[8 + i], mtx[12 + i]);
+
+    const size_t simd_count = count & ~size_t(1);
+    for (size_t i = 0; i < simd_count; i += 2) {
+        const __m256 v = _mm256_loadu_ps(input + i * 4);
+        const __m256 res = V8_AVX_MADD(
+            col[3], _mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3)),
+            V8_AVX_MADD(
+                col[2], _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)),
+                V8_AVX_MADD(
+                    col[1], _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)),
+                    _mm256_mul_ps(col[0], 
+                                  _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0))))));
+        _mm256_storeu_ps(output + i * 4, res);
+    }
+
+    if (simd_count != count) {
+        const float* src = input + simd_count * 4;
+        float* dst = output + simd_count * 4;
+        const float x = src[0];
+        const float y = src[1];
+        const float z = src[2];
+        const float w = src[3];
+        for (int row = 0; row < 4; ++row)
+            dst[row] = mtx[row * 4] * x + mtx[row * 4 + 1] * y 
+                + mtx[row * 4 + 2] * z + mtx[row * 4 + 3] * w;
+    }
+}
+
+#undef V8_AVX_KERNEL_NAME
+#undef V8_AVX_KERNEL_NAME_EXPAND
+#undef V8_AVX_KERNEL_NAME_IMPL
@@ -0,0 +1,627 @@
+#include "pch_hdr.h"
+#include <cfloat>
+#include "v8/base/parallel_for.h"
+#include "v8/math/matrix4X4_batch.h"
+#include "v8/math/occlusion_buffer.h"
+
+#if defined(V8_SIMD_ENABLED)
+#include <xmmintrin.h>
+#include "v8/math/sse_utils.h"
+#endif
+
+namespace {
+
+/**
+ * \brief   Screen space rectangle and nearest depth of a projected box.
+ */
+struct box_footprint {
+    float   min_x;
+    float   min_y;
+    float   max_x;
+    float   max_y;
+    float   min_z;
+};
+
+/**
+ * \brief   Tests a projected box against the mip chain. The box is occluded
+ *          if its nearest depth is behind the farthest occluder depth of 
+ *          every texel it touches.
+ */
+bool footprint_occluded(
+    const v8::math::occlusion_buffer& buffer,
+    const box_footprint& fp
+    ) {
+    const float width = static_cast<float>(buffer.width());
+    const float height = static_cast<float>(buffer.height());
+    if (fp.max_x < 0.0f || fp.max_y < 0.0f || fp.min_x >= width || fp.min_y >= height)
+        return false;
+
+    size_t x0 = static_cast<size_t>(std::max(fp.min_x, 0.0f));
+    size_t y0 = static_cast<size_t>(std::max(fp.min_y, 0.0f));
+    size_t x1 = std::min(static_cast<size_t>(std::min(fp.max_x, width)), 
+                         buffer.width() - 1);
+    size_t y1 = std::min(static_cast<size_t>(std::min(fp.max_y, height)), 
+                         buffer.height() - 1);
+
+    //
+    // Go down the chain until the rectangle covers at most 2x2 texels.
+    size_t level = 0;
+    while ((x1 - x0 > 1 || y1 - y0 > 1) && level + 1 < buffer.mip_count()) {
+        x0 >>= 1;
+        y0 >>= 1;
+        x1 >>= 1;
+        y1 >>= 1;
+        ++level;
+    }
+
+    const float* depth = buffer.mip_data(level);
+    const size_t pitch = buffer.mip_width(level);
+    float max_depth = 0.0f;
+    for (size_t y = y0; y <= y1; ++y) {
+        for (size_t x = x0; x <= x1; ++x)
+            max_depth = std::max(max_depth, depth[y * pitch + x]);
+    }
+
+    return fp.min_z > max_depth;
+}
+
+/**
+ * \brief   Scalar kernels, rasterization of one triangle row and box
+ *          projection.
+ */
+struct occlusion_scalar_kernels {
+    /**
+     * \brief   Rasterizes the pixels [x0, x1) of row y. The edge and depth
+     *          values are A * px + (B * py + C), for the pixel centers.
+     */
+    static void rasterize_row(
+        const float* edge_a,
+        const float* edge_row,
+        float depth_a,
+        float depth_row,
+        size_t x0,
+        size_t x1,
+        float* depth
+        )
+    {
+        for (size_t x = x0; x < x1; ++x) {
+            const float px = static_cast<float>(x) + 0.5f;
+            const float e0 = edge_a[0] * px + edge_row[0];
+            const float e1 = edge_a[1] * px + edge_row[1];
+            const float e2 = edge_a[2] * px + edge_row[2];
+            if (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f)
+                depth[x] = std::min(depth[x], depth_a * px + depth_row);
+        }
+    }
+
+    /**
+     * \brief   Projects the 8 corners of a box, returns false if the box 
+     *          crosses the near plane.
+     */
+    static bool project_box(
+        const v8::math::matrix_4X4F& pv,
+        float half_width,
+        float half_height,
+        const float* box_min,
+        const float* box_max,
+        box_footprint* fp
+        )
+    {
+        fp->min_x = fp->min_y = fp->min_z = FLT_MAX;
+        fp->max_x = fp->max_y = -FLT_MAX;
+
+        for (int i = 0; i < 8; ++i) {
+            const float x = (i & 1) ? box_max[0] : box_min[0];
+            const float y = (i & 2) ? box_max[1] : box_min[1];
+            const float z = (i & 4) ? box_max[2] : box_min[2];
+
+            const float cx = pv.a11_ * x + pv.a12_ * y + pv.a13_ * z + pv.a14_;
+            const float cy = pv.a21_ * x + pv.a22_ * y + pv.a23_ * z + pv.a24_;
+            const float cz = pv.a31_ * x + pv.a32_ * y + pv.a33_ * z + pv.a34_;
+            const float cw = pv.a41_ * x + pv.a42_ * y + pv.a43_ * z + pv.a44_;
+            if (cz < 0.0f || !(cw > 0.0f))
+                return false;
+
+            const float inv_w = 1.0f / cw;
+            const float sx = (cx * inv_w + 1.0f) * half_width;
+            const float sy = (1.0f - cy * inv_w) * half_height;
+            const float sz = cz * inv_w;
+            fp->min_x = std::min(fp->min_x, sx);
+            fp->max_x = std::max(fp->max_x, sx);
+            fp->min_y = std::min(fp->min_y, sy);
+            fp->max_y = std::max(fp->max_y, sy);
+            fp->min_z = std::min(fp->min_z, sz);
+        }
+        return true;
+    }
+};
+
+#if defined(V8_SIMD_ENABLED)
+
+/**
+ * \brief   SSE kernels. Rows are rasterized 4 pixels at a time (the tile
+ *          bounds are multiples of 4), box corners are projected 4 at a 
+ *          time, the x/y corners are in the lanes and the two z values
+ *          in separate registers.
+ */
+struct occlusion_sse_kernels {
+    static void rasterize_row(
+        const float* edge_a,
+        const float* edge_row,
+        float depth_a,
+        float depth_row,
+        size_t x0,
+        size_t x1,
+        float* depth
+        )
+    {
+        assert(!(x0 & 3) && !(x1 & 3));
+
+        const __m128 a0 = _mm_set1_ps(edge_a[0]);
+        const __m128 a1 = _mm_set1_ps(edge_a[1]);
+        const __m128 a2 = _mm_set1_ps(edge_a[2]);
+        const __m128 r0 = _mm_set1_ps(edge_row[0]);
+        const __m128 r1 = _mm_set1_ps(edge_row[1]);
+        const __m128 r2 = _mm_set1_ps(edge_row[2]);
+        const __m128 za = _mm_set1_ps(depth_a);
+        const __m128 zr = _mm_set1_ps(depth_row);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 centers = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+
+        for (size_t x = x0; x < x1; x += 4) {
+            const __m128 px = _mm_add_ps(
+                _mm_set1_ps(static_cast<float>(x)), centers);
+            const __m128 inside = _mm_and_ps(
+                _mm_and_ps(
+                    _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, px), r0), zero),
+                    _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, px), r1), zero)),
+                _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, px), r2), zero));
+            if (!_mm_movemask_ps(inside))
+                continue;
+
+            const __m128 old_depth = _mm_loadu_ps(depth + x);
+            const __m128 new_depth = _mm_min_ps(
+                old_depth, _mm_add_ps(_mm_mul_ps(za, px), zr));
+            _mm_storeu_ps(depth + x, 
+                          _mm_or_ps(_mm_and_ps(inside, new_depth),
+                                    _mm_andnot_ps(inside, old_depth)));
+        }
+    }
+
+    static bool project_box(
+        const v8::math::matrix_4X4F& pv,
+        float half_width,
+        float half_height,
+        const float* box_min,
+        const float* box_max,
+        box_footprint* fp
+        )
+    {
+        using namespace v8::math;
+
+        const __m128 x = _mm_setr_ps(box_min[0], box_max[0], box_min[0], box_max[0]);
+        const __m128 y = _mm_setr_ps(box_min[1], box_min[1], box_max[1], box_max[1]);
+        const __m128 z[2] = { _mm_set1_ps(box_min[2]), _mm_set1_ps(box_max[2]) };
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 hw = _mm_set1_ps(half_width);
+        const __m128 hh = _mm_set1_ps(half_height);
+
+        __m128 sx[2], sy[2], sz[2];
+        int rejected = 0;
+        for (int i = 0; i < 2; ++i) {
+            const __m128 cx = sse::linear_combination(
+                _mm_set1_ps(pv.a11_), x, _mm_set1_ps(pv.a12_), y,
+                _mm_set1_ps(pv.a13_), z[i], _mm_set1_ps(pv.a14_));
+            const __m128 cy = sse::linear_combination(
+                _mm_set1_ps(pv.a21_), x, _mm_set1_ps(pv.a22_), y,
+                _mm_set1_ps(pv.a23_), z[i], _mm_set1_ps(pv.a24_));
+            const __m128 cz = sse::linear_combination(
+                _mm_set1_ps(pv.a31_), x, _mm_set1_ps(pv.a32_), y,
+                _mm_set1_ps(pv.a33_), z[i], _mm_set1_ps(pv.a34_));
+            const __m128 cw = sse::linear_combination(
+                _mm_set1_ps(pv.a41_), x, _mm_set1_ps(pv.a42_), y,
+                _mm_set1_ps(pv.a43_), z[i], _mm_set1_ps(pv.a44_));
+
+            rejected |= _mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(cz, zero),
+                                                  _mm_cmpngt_ps(cw, zero)));
+
+            const __m128 inv_w = _mm_div_ps(one, cw);
+            sx[i] = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(cx, inv_w), one), hw);
+            sy[i] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(cy, inv_w)), hh);
+            sz[i] = _mm_mul_ps(cz, inv_w);
+        }
+
+        if (rejected)
+            return false;
+
+        fp->min_x = horizontal_min(_mm_min_ps(sx[0], sx[1]));
+        fp->max_x = horizontal_max(_mm_max_ps(sx[0], sx[1]));
+        fp->min_y = horizontal_min(_mm_min_ps(sy[0], sy[1]));
+        fp->max_y = horizontal_max(_mm_max_ps(sy[0], sy[1]));
+        fp->min_z = horizontal_min(_mm_min_ps(sz[0], sz[1]));
+        return true;
+    }
+
+    static float horizontal_min(__m128 v) {
+        v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+        v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtss_f32(v);
+    }
+
+    static float horizontal_max(__m128 v) {
+        v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+        v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtss_f32(v);
+    }
+};
+
+typedef occlusion_sse_kernels occlusion_kernels;
+
+#else
+
+typedef occlusion_scalar_kernels occlusion_kernels;
+
+#endif
+
+/**
+ * \brief   Intersection of the segment [a, b] with the near plane (z = 0).
+ */
+inline v8::math::vector4F clip_near(
+    const v8::math::vector4F& a, 
+    const v8::math::vector4F& b
+    ) {
+    const float t = a.z_ / (a.z_ - b.z_);
+    return v8::math::vector4F(a.x_ + t * (b.x_ - a.x_), a.y_ + t * (b.y_ - a.y_),
+                              0.0f, a.w_ + t * (b.w_ - a.w_));
+}
+
+} // anonymous namespace
+
+v8::math::occlusion_buffer::occlusion_buffer(
+    size_t width,
+    size_t height,
+    unsigned int max_threads
+    )
+    :   width_(width),
+        height_(height),
+        tiles_x_((width + kOcclusionTileWidth - 1) / kOcclusionTileWidth),
+        tiles_y_((height + kOcclusionTileHeight - 1) / kOcclusionTileHeight),
+        max_threads_(max_threads),
+        projection_view_(matrix_4X4F::identity),
+        tile_bins_(tiles_x_ * tiles_y_),
+        triangle_count_(0)
+{
+    assert(width && height);
+    assert(!(width & 3) && "Width must be a multiple of 4!");
+
+    size_t w = width;
+    size_t h = height;
+    for (;;) {
+        mip_level level;
+        level.width = w;
+        level.height = h;
+        level.depth.assign(w * h, 1.0f);
+        mips_.push_back(level);
+
+        if (w == 1 && h == 1)
+            break;
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+    }
+}
+
+void v8::math::occlusion_buffer::begin_frame(const v8::math::camera& cam) {
+    projection_view_ = cam.get_projection_wiew_transform();
+    occluders_.clear();
+}
+
+void v8::math::occlusion_buffer::add_occluder(
+    const v8::math::matrix_4X4F& world,
+    const v8::math::vector3F* vertices,
+    size_t vertex_count,
+    const uint32_t* indices,
+    size_t index_count
+    ) {
+    assert(!(index_count % 3));
+    const occluder o = { world, vertices, vertex_count, indices, index_count };
+    occluders_.push_back(o);
+}
+
+void v8::math::occlusion_buffer::add_screen_triangle(
+    const v8::math::vector4F& v0,
+    const v8::math::vector4F& v1,
+    const v8::math::vector4F& v2,
+    std::vector<screen_triangle>* triangles
+    ) const {
+    const float half_width = 0.5f * static_cast<float>(width_);
+    const float half_height = 0.5f * static_cast<float>(height_);
+    const vector4F* clip[3] = { &v0, &v1, &v2 };
+    float x[3], y[3], z[3];
+    for (int i = 0; i < 3; ++i) {
+        const float inv_w = 1.0f / clip[i]->w_;
+        x[i] = (clip[i]->x_ * inv_w + 1.0f) * half_width;
+        y[i] = (1.0f - clip[i]->y_ * inv_w) * half_height;
+        z[i] = clip[i]->z_ * inv_w;
+    }
+
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (std::fabs(area) < 1.0e-8f)
+        return;
+
+    //
+    // Both windings are drawn, make the edge functions positive inside.
+    if (area < 0.0f) {
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+        std::swap(z[1], z[2]);
+        area = -area;
+    }
+
+    screen_triangle tri;
+    tri.min_x = std::min(x[0], std::min(x[1], x[2]));
+    tri.max_x = std::max(x[0], std::max(x[1], x[2]));
+    tri.min_y = std::min(y[0], std::min(y[1], y[2]));
+    tri.max_y = std::max(y[0], std::max(y[1], y[2]));
+    if (tri.max_x < 0.0f || tri.max_y < 0.0f || 
+        tri.min_x > 2.0f * half_width || tri.min_y > 2.0f * half_height)
+        return;
+
+    //
+    // Edge k is opposite to vertex k, e_k(x, y) = a * x + b * y + c is
+    // area * barycentric_k(x, y).
+    for (int k = 0; k < 3; ++k) {
+        const int i = (k + 1) % 3;
+        const int j = (k + 2) % 3;
+        tri.edge_a[k] = y[i] - y[j];
+        tri.edge_b[k] = x[j] - x[i];
+        tri.edge_c[k] = x[i] * y[j] - x[j] * y[i];
+    }
+
+    //
+    // Depth plane, relative to vertex 0 (the sum of the edge coefficients
+    // is 0, this avoids the cancellation of the large terms).
+    const float inv_area = 1.0f / area;
+    const float dz1 = z[1] - z[0];
+    const float dz2 = z[2] - z[0];
+    tri.depth_a = (tri.edge_a[1] * dz1 + tri.edge_a[2] * dz2) * inv_area;
+    tri.depth_b = (tri.edge_b[1] * dz1 + tri.edge_b[2] * dz2) * inv_area;
+    tri.depth_c = z[0] - tri.depth_a * x[0] - tri.depth_b * y[0];
+    triangles->push_back(tri);
+}
+
+void v8::math::occlusion_buffer::setup_triangles(
+    size_t first,
+    size_t last,
+    std::vector<screen_triangle>* triangles
+    ) const {
+    size_t occ = std::upper_bound(first_triangle_.begin(), first_triangle_.end(), 
+                                  first) - first_triangle_.begin() - 1;
+
+    for (size_t t = first; t < last; ++t) {
+        while (t >= first_triangle_[occ + 1])
+            ++occ;
+
+        const occluder& o = occluders_[occ];
+        const vector4F* verts = &clip_vertices_[first_vertex_[occ]];
+        const uint32_t* idx = o.indices + 3 * (t - first_triangle_[occ]);
+        assert(idx[0] < o.vertex_count && idx[1] < o.vertex_count 
+               && idx[2] < o.vertex_count);
+
+        const vector4F* v[3] = { &verts[idx[0]], &verts[idx[1]], &verts[idx[2]] };
+        const int inside = (v[0]->z_ >= 0.0f) + (v[1]->z_ >= 0.0f) 
+            + (v[2]->z_ >= 0.0f);
+        if (inside == 3) {
+            add_screen_triangle(*v[0], *v[1], *v[2], triangles);
+            continue;
+        }
+        if (!inside)
+            continue;
+
+        //
+        // Clip against the near plane, one or two vertices are in front 
+        // of it. Rotate the vertices so v[0] is the odd one out, this keeps
+        // the winding.
+        while ((v[0]->z_ >= 0.0f) == (v[1]->z_ >= 0.0f) || 
+               (v[0]->z_ >= 0.0f) == (v[2]->z_ >= 0.0f)) {
+            const vector4F* tmp = v[0];
+            v[0] = v[1];
+            v[1] = v[2];
+            v[2] = tmp;
+        }
+
+        const vector4F a(clip_near(*v[0], *v[1]));
+        const vector4F b(clip_near(*v[0], *v[2]));
+        if (inside == 1) {
+            add_screen_triangle(*v[0], a, b, triangles);
+        } else {
+            add_screen_triangle(a, *v[1], *v[2], triangles);
+            add_screen_triangle(a, *v[2], b, triangles);
+        }
+    }
+}
+
+void v8::math::occlusion_buffer::rasterize_tile(size_t tile) {
+    const size_t tile_x = (tile % tiles_x_) * kOcclusionTileWidth;
+    const size_t tile_y = (tile / tiles_x_) * kOcclusionTileHeight;
+    const float tile_x0 = static_cast<float>(tile_x);
+    const float tile_y0 = static_cast<float>(tile_y);
+    const float tile_x1 = static_cast<float>(
+        std::min(tile_x + kOcclusionTileWidth, width_));
+    const float tile_y1 = static_cast<float>(
+        std::min(tile_y + kOcclusionTileHeight, height_));
+
+    float* depth = &mips_[0].depth[0];
+    for (size_t y = tile_y; y < static_cast<size_t>(tile_y1); ++y)
+        std::fill(depth + y * width_ + tile_x, 
+                  depth + y * width_ + static_cast<size_t>(tile_x1), 1.0f);
+
+    const std::vector<uint32_t>& bin = tile_bins_[tile];
+    for (size_t i = 0; i < bin.size(); ++i) {
+        const screen_triangle& tri = *triangle_ptrs_[bin[i]];
+
+        //
+        // Pixels whose centers are inside the triangle's bounds. The 
+        // columns are aligned to 4 for the SIMD kernel, the edge functions
+        // reject the extra pixels.
+        const float fx0 = std::max(std::ceil(tri.min_x - 0.5f), tile_x0);
+        const float fx1 = std::min(std::floor(tri.max_x - 0.5f) + 1.0f, tile_x1);
+        const float fy0 = std::max(std::ceil(tri.min_y - 0.5f), tile_y0);
+        const float fy1 = std::min(std::floor(tri.max_y - 0.5f) + 1.0f, tile_y1);
+        if (fx0 >= fx1 || fy0 >= fy1)
+            continue;
+
+        const size_t x0 = static_cast<size_t>(fx0) & ~size_t(3);
+        const size_t x1 = (static_cast<size_t>(fx1) + 3) & ~size_t(3);
+        const size_t y0 = static_cast<size_t>(fy0);
+        const size_t y1 = static_cast<size_t>(fy1);
+
+        for (size_t y = y0; y < y1; ++y) {
+            const float py = static_cast<float>(y) + 0.5f;
+            const float edge_row[3] = {
+                tri.edge_b[0] * py + tri.edge_c[0],
+                tri.edge_b[1] * py + tri.edge_c[1],
+                tri.edge_b[2] * py + tri.edge_c[2]
+            };
+            occlusion_kernels::rasterize_row(
+                tri.edge_a, edge_row, tri.depth_a, tri.depth_b * py + tri.depth_c,
+                x0, x1, depth + y * width_);
+        }
+    }
+}
+
+void v8::math::occlusion_buffer::build_mip_chain() {
+    for (size_t level = 1; level < mips_.size(); ++level) {
+        const mip_level& src = mips_[level - 1];
+        mip_level& dst = mips_[level];
+
+        for (size_t y = 0; y < dst.height; ++y) {
+            const float* row0 = &src.depth[std::min(2 * y, src.height - 1) * src.width];
+            const float* row1 = &src.depth[std::min(2 * y + 1, src.height - 1) * src.width];
+            float* out = &dst.depth[y * dst.width];
+
+            for (size_t x = 0; x < dst.width; ++x) {
+                const size_t x0 = std::min(2 * x, src.width - 1);
+                const size_t x1 = std::min(2 * x + 1, src.width - 1);
+                out[x] = std::max(std::max(row0[x0], row0[x1]), 
+                                  std::max(row1[x0], row1[x1]));
+            }
+        }
+    }
+}
+
+void v8::math::occlusion_buffer::render() {
+    //
+    // Clip space vertices, with the batch transform.
+    first_vertex_.resize(occluders_.size() + 1);
+    first_triangle_.resize(occluders_.size() + 1);
+    first_vertex_[0] = first_triangle_[0] = 0;
+    for (size_t i = 0; i < occluders_.size(); ++i) {
+        first_vertex_[i + 1] = first_vertex_[i] + occluders_[i].vertex_count;
+        first_triangle_[i + 1] = first_triangle_[i] + occluders_[i].index_count / 3;
+    }
+
+    clip_vertices_.resize(first_vertex_.back());
+    base::parallel_for(occluders_.size(), 1, max_threads_, 
+                       [this](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            const occluder& o = occluders_[i];
+            vector4F* out = &clip_vertices_[0] + first_vertex_[i];
+            for (size_t v = 0; v < o.vertex_count; ++v)
+                out[v] = vector4F(o.vertices[v].x_, o.vertices[v].y_, 
+                                  o.vertices[v].z_, 1.0f);
+
+            transform_homogeneous_points(projection_view_ * o.world, out, 
+                                         o.vertex_count);
+        }
+    });
+
+    //
+    // Triangle setup, every task has its own list.
+    const size_t triangle_count = first_triangle_.back();
+    const size_t task_count = 
+        (triangle_count + kOcclusionGrainSize - 1) / kOcclusionGrainSize;
+    if (task_triangles_.size() < task_count)
+        task_triangles_.resize(task_count);
+    for (size_t i = 0; i < task_count; ++i)
+        task_triangles_[i].clear();
+
+    base::parallel_for(triangle_count, kOcclusionGrainSize, max_threads_,
+                       [this](size_t first, size_t last) {
+        setup_triangles(first, last, &task_triangles_[first / kOcclusionGrainSize]);
+    });
+
+    //
+    // Bin the triangles to the tiles their bounds touch.
+    for (size_t i = 0; i < tile_bins_.size(); ++i)
+        tile_bins_[i].clear();
+    triangle_ptrs_.clear();
+
+    const float max_tile_x = static_cast<float>(tiles_x_ - 1);
+    const float max_tile_y = static_cast<float>(tiles_y_ - 1);
+    for (size_t t = 0; t < task_count; ++t) {
+        const std::vector<screen_triangle>& tris = task_triangles_[t];
+        for (size_t i = 0; i < tris.size(); ++i) {
+            const uint32_t index = static_cast<uint32_t>(triangle_ptrs_.size());
+            triangle_ptrs_.push_back(&tris[i]);
+
+            const size_t tx0 = static_cast<size_t>(std::min(
+                std::max(tris[i].min_x, 0.0f) / kOcclusionTileWidth, max_tile_x));
+            const size_t tx1 = static_cast<size_t>(std::min(
+                std::max(tris[i].max_x, 0.0f) / kOcclusionTileWidth, max_tile_x));
+            const size_t ty0 = static_cast<size_t>(std::min(
+                std::max(tris[i].min_y, 0.0f) / kOcclusionTileHeight, max_tile_y));
+            const size_t ty1 = static_cast<size_t>(std::min(
+                std::max(tris[i].max_y, 0.0f) / kOcclusionTileHeight, max_tile_y));
+
+            for (size_t ty = ty0; ty <= ty1; ++ty) {
+                for (size_t tx = tx0; tx <= tx1; ++tx)
+                    tile_bins_[ty * tiles_x_ + tx].push_back(index);
+            }
+        }
+    }
+    triangle_count_ = triangle_ptrs_.size();
+
+    base::parallel_for(tile_bins_.size(), 1, max_threads_,
+                       [this](size_t first, size_t last) {
+        for (size_t tile = first; tile < last; ++tile)
+            rasterize_tile(tile);
+    });
+
+    build_mip_chain();
+}
+
+bool v8::math::occlusion_buffer::is_occluded(const v8::math::aabbF& box) const {
+    box_footprint fp;
+    return occlusion_kernels::project_box(
+        projection_view_, 0.5f * static_cast<float>(width_), 
+        0.5f * static_cast<float>(height_), box.min_.elements_, 
+        box.max_.elements_, &fp) 
+        && footprint_occluded(*this, fp);
+}
+
+void v8::math::occlusion_buffer::occluded_aabbs(
+    const v8::math::aabb_soaF& boxes,
+    uint8_t* result
+    ) const {
+    const float* min_x = boxes.mins().x();
+    const float* min_y = boxes.mins().y();
+    const float* min_z = boxes.mins().z();
+    const float* max_x = boxes.maxs().x();
+    const float* max_y = boxes.maxs().y();
+    const float* max_z = boxes.maxs().z();
+    const float half_width = 0.5f * static_cast<float>(width_);
+    const float half_height = 0.5f * static_cast<float>(height_);
+
+    base::parallel_for(boxes.size(), kOcclusionGrainSize, max_threads_,
+                       [=](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            const float box_min[3] = { min_x[i], min_y[i], min_z[i] };
+            const float box_max[3] = { max_x[i], max_y[i], max_z[i] };
+            box_footprint fp;
+            result[i] = occlusion_kernels::project_box(
+                projection_view_, half_width, half_height, box_min, box_max, &fp) 
+                && footprint_occluded(*this, fp);
+        }
+    });
+}
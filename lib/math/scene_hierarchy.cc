@@ -0,0 +1,131 @@
+#include "pch_hdr.h"
+#include "v8/math/scene_hierarchy.h"
+
+v8::math::scene_hierarchy::scene_hierarchy()
+    :   last_update_count_(0) {}
+
+void v8::math::scene_hierarchy::reserve(size_t node_count) {
+    parents_.reserve(node_count);
+    first_child_.reserve(node_count);
+    last_child_.reserve(node_count);
+    next_sibling_.reserve(node_count);
+    locals_.reserve(node_count);
+    worlds_.reserve(node_count);
+    dirty_.reserve(node_count);
+}
+
+void v8::math::scene_hierarchy::clear() {
+    parents_.clear();
+    first_child_.clear();
+    last_child_.clear();
+    next_sibling_.clear();
+    locals_.clear();
+    worlds_.clear();
+    dirty_.clear();
+    dirty_roots_.clear();
+    last_update_count_ = 0;
+}
+
+uint32_t v8::math::scene_hierarchy::add_node(
+    uint32_t parent,
+    const v8::math::transformF& local
+    ) {
+    assert(parent == kInvalidNode || parent < node_count());
+
+    const uint32_t node = static_cast<uint32_t>(node_count());
+    parents_.push_back(parent);
+    first_child_.push_back(kInvalidNode);
+    last_child_.push_back(kInvalidNode);
+    next_sibling_.push_back(kInvalidNode);
+    locals_.push_back(local);
+    worlds_.push_back(matrix_4X4F::identity);
+    dirty_.push_back(1);
+    dirty_roots_.push_back(node);
+
+    if (parent != kInvalidNode) {
+        if (last_child_[parent] == kInvalidNode)
+            first_child_[parent] = node;
+        else
+            next_sibling_[last_child_[parent]] = node;
+        last_child_[parent] = node;
+    }
+    return node;
+}
+
+void v8::math::scene_hierarchy::set_local_transform(
+    uint32_t node,
+    const v8::math::transformF& local
+    ) {
+    assert(node < node_count());
+    locals_[node] = local;
+    if (!dirty_[node]) {
+        dirty_[node] = 1;
+        dirty_roots_.push_back(node);
+    }
+}
+
+void v8::math::scene_hierarchy::update_subtree(uint32_t root) {
+    stack_.clear();
+    stack_.push_back(root);
+
+    while (!stack_.empty()) {
+        const uint32_t node = stack_.back();
+        stack_.pop_back();
+
+        const uint32_t parent = parents_[node];
+        if (parent == kInvalidNode)
+            worlds_[node] = locals_[node].get_transform_matrix();
+        else
+            worlds_[node] = worlds_[parent] * locals_[node].get_transform_matrix();
+        dirty_[node] = 0;
+        ++last_update_count_;
+
+        for (uint32_t child = first_child_[node]; child != kInvalidNode; 
+             child = next_sibling_[child]) {
+            stack_.push_back(child);
+        }
+    }
+}
+
+void v8::math::scene_hierarchy::update() {
+    last_update_count_ = 0;
+
+    for (size_t i = 0; i < dirty_roots_.size(); ++i) {
+        const uint32_t node = dirty_roots_[i];
+
+        //
+        // Already updated, as part of the subtree of another dirty node.
+        if (!dirty_[node])
+            continue;
+
+        //
+        // A dirty ancestor will update this subtree.
+        bool ancestor_dirty = false;
+        for (uint32_t p = parents_[node]; p != kInvalidNode; p = parents_[p]) {
+            if (dirty_[p]) {
+                ancestor_dirty = true;
+                break;
+            }
+        }
+
+        if (!ancestor_dirty)
+            update_subtree(node);
+    }
+
+    dirty_roots_.clear();
+}
+
+void v8::math::scene_hierarchy::update_all() {
+    const size_t count = node_count();
+    for (size_t node = 0; node < count; ++node) {
+        const uint32_t parent = parents_[node];
+        if (parent == kInvalidNode)
+            worlds_[node] = locals_[node].get_transform_matrix();
+        else
+            worlds_[node] = worlds_[parent] * locals_[node].get_transform_matrix();
+        dirty_[node] = 0;
+    }
+
+    dirty_roots_.clear();
+    last_update_count_ = count;
+}
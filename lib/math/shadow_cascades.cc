@@ -0,0 +1,237 @@
+#include "pch_hdr.h"
+#include "v8/math/shadow_cascades.h"
+
+namespace {
+
+using v8::math::vector3F;
+
+/**
+ * \brief   View space rectangle of the frustum at a given depth.
+ */
+struct depth_slice {
+    float   depth;
+    float   rmin;
+    float   rmax;
+    float   umin;
+    float   umax;
+};
+
+depth_slice
+make_depth_slice(
+    const v8::math::camera& cam,
+    float depth
+    )
+{
+    //
+    // The projection window is defined on the near plane, for a perspective
+    // projection it grows linearly with the depth.
+    const float scale = 
+        cam.get_projection_type() == v8::math::camera::Projection_Perspective 
+        ? depth / cam.get_dmin() : 1.0f;
+
+    const depth_slice slice = {
+        depth, 
+        cam.get_rmin() * scale, cam.get_rmax() * scale,
+        cam.get_umin() * scale, cam.get_umax() * scale
+    };
+    return slice;
+}
+
+/**
+ * \brief   Converts a view space point to world space.
+ */
+vector3F
+view_to_world(
+    const v8::math::camera& cam,
+    float x, 
+    float y,
+    float z
+    )
+{
+    const vector3F& o = cam.get_origin();
+    const vector3F& r = cam.get_right_vector();
+    const vector3F& u = cam.get_up_vector();
+    const vector3F& d = cam.get_direction_vector();
+    return vector3F(o.x_ + r.x_ * x + u.x_ * y + d.x_ * z,
+                    o.y_ + r.y_ * x + u.y_ * y + d.y_ * z,
+                    o.z_ + r.z_ * x + u.z_ * y + d.z_ * z);
+}
+
+void
+slice_corners(
+    const v8::math::camera& cam,
+    const depth_slice& slice,
+    vector3F* corners
+    )
+{
+    corners[0] = view_to_world(cam, slice.rmin, slice.umin, slice.depth);
+    corners[1] = view_to_world(cam, slice.rmax, slice.umin, slice.depth);
+    corners[2] = view_to_world(cam, slice.rmax, slice.umax, slice.depth);
+    corners[3] = view_to_world(cam, slice.rmin, slice.umax, slice.depth);
+}
+
+/**
+ * \brief   Bounding sphere of the part of the frustum between two slices, 
+ *          in view space. The center lies on the line through the centers
+ *          of the two rectangles, at the point that is (about) as far from
+ *          the near corners as from the far ones. Only the frustrum 
+ *          parameters are used, so the result does not change when the
+ *          camera moves or rotates.
+ */
+void
+slice_bounding_sphere(
+    const depth_slice& near_slice,
+    const depth_slice& far_slice,
+    float* center_x,
+    float* center_y,
+    float* center_z,
+    float* radius
+    )
+{
+    const float n = near_slice.depth;
+    const float f = far_slice.depth;
+    const float near_cx = (near_slice.rmin + near_slice.rmax) * 0.5f;
+    const float near_cy = (near_slice.umin + near_slice.umax) * 0.5f;
+    const float far_cx = (far_slice.rmin + far_slice.rmax) * 0.5f;
+    const float far_cy = (far_slice.umin + far_slice.umax) * 0.5f;
+
+    //
+    // Squared distance from a rectangle's corners to its center.
+    const float near_hw = (near_slice.rmax - near_slice.rmin) * 0.5f;
+    const float near_hh = (near_slice.umax - near_slice.umin) * 0.5f;
+    const float far_hw = (far_slice.rmax - far_slice.rmin) * 0.5f;
+    const float far_hh = (far_slice.umax - far_slice.umin) * 0.5f;
+    const float near_sq = near_hw * near_hw + near_hh * near_hh;
+    const float far_sq = far_hw * far_hw + far_hh * far_hh;
+
+    float cz = (f * f - n * n + far_sq - near_sq) / (2.0f * (f - n));
+    cz = std::min(std::max(cz, n), f);
+    const float t = (cz - n) / (f - n);
+    const float cx = near_cx + t * (far_cx - near_cx);
+    const float cy = near_cy + t * (far_cy - near_cy);
+
+    //
+    // The center is only approximate for off center frustrums, so take the
+    // farthest of the 8 corners.
+    const depth_slice* slices[2] = { &near_slice, &far_slice };
+    float radius_sq = 0.0f;
+    for (size_t i = 0; i < 2; ++i) {
+        const float xs[2] = { slices[i]->rmin - cx, slices[i]->rmax - cx };
+        const float ys[2] = { slices[i]->umin - cy, slices[i]->umax - cy };
+        const float dz = slices[i]->depth - cz;
+        for (size_t j = 0; j < 2; ++j)
+            for (size_t k = 0; k < 2; ++k)
+                radius_sq = std::max(
+                    radius_sq, xs[j] * xs[j] + ys[k] * ys[k] + dz * dz);
+    }
+
+    *center_x = cx;
+    *center_y = cy;
+    *center_z = cz;
+    *radius = std::sqrt(radius_sq);
+}
+
+} // anonymous namespace
+
+void
+v8::math::compute_shadow_cascades(
+    const v8::math::camera& cam,
+    const v8::math::light& dir_light,
+    const v8::math::shadow_cascade_params& params,
+    v8::math::shadow_cascade* cascades
+    ) 
+{
+    assert(dir_light.get_type() == light::light_type_directional);
+    assert(params.cascade_count && params.cascade_count <= kMaxShadowCascades);
+    assert(params.shadow_map_size > 1);
+
+    const size_t count = params.cascade_count;
+    const float dmin = cam.get_dmin();
+    const float dmax = cam.get_dmax();
+
+    //
+    // Split distances (practical split scheme) and the corners at each 
+    // split, shared by the two cascades on either side. An orthographic
+    // projection has the same texel density at every depth, so its splits
+    // are uniform; the logarithmic split is also undefined for dmin <= 0.
+    const float lambda = 
+        (cam.get_projection_type() == camera::Projection_Perspective
+         && dmin > 0.0f) ? params.split_lambda : 0.0f;
+
+    depth_slice slices[kMaxShadowCascades + 1];
+    vector3F corners[kMaxShadowCascades + 1][4];
+    for (size_t i = 0; i <= count; ++i) {
+        const float k = static_cast<float>(i) / static_cast<float>(count);
+        const float uniform_split = dmin + (dmax - dmin) * k;
+        const float log_split = 
+            lambda > 0.0f ? dmin * std::pow(dmax / dmin, k) : uniform_split;
+        const float depth = i == 0 ? dmin : (i == count ? dmax :
+            lambda * log_split + (1.0f - lambda) * uniform_split);
+
+        slices[i] = make_depth_slice(cam, depth);
+        slice_corners(cam, slices[i], corners[i]);
+    }
+
+    //
+    // Light space basis. It depends only on the light's direction, so it
+    // is the same for all the cascades and does not change with the camera.
+    const vector3F light_dir = vector3F(dir_light.get_direction()).normalize();
+    const vector3F world_up = 
+        std::fabs(light_dir.y_) < 0.99f ? vector3F::unit_y : vector3F::unit_x;
+    const vector3F light_right = cross_product(world_up, light_dir).normalize();
+    const vector3F light_up = cross_product(light_dir, light_right);
+
+    matrix_4X4F light_view(matrix_4X4F::identity);
+    light_view.a11_ = light_right.x_;
+    light_view.a12_ = light_right.y_;
+    light_view.a13_ = light_right.z_;
+    light_view.a21_ = light_up.x_;
+    light_view.a22_ = light_up.y_;
+    light_view.a23_ = light_up.z_;
+    light_view.a31_ = light_dir.x_;
+    light_view.a32_ = light_dir.y_;
+    light_view.a33_ = light_dir.z_;
+
+    for (size_t i = 0; i < count; ++i) {
+        shadow_cascade& cascade = cascades[i];
+        cascade.split_near = slices[i].depth;
+        cascade.split_far = slices[i + 1].depth;
+        for (size_t j = 0; j < 4; ++j) {
+            cascade.corners[j] = corners[i][j];
+            cascade.corners[j + 4] = corners[i + 1][j];
+        }
+
+        float cx, cy, cz, radius;
+        slice_bounding_sphere(slices[i], slices[i + 1], &cx, &cy, &cz, &radius);
+        cascade.sphere_center = view_to_world(cam, cx, cy, cz);
+        cascade.sphere_radius = radius;
+
+        //
+        // The window is sized so that snapping its center to the texel grid
+        // (moving it by at most half a texel) still covers the sphere :
+        // half_size = radius + texel / 2, with 2 * half_size = map_size * texel.
+        const float texel = 2.0f * radius / static_cast<float>(params.shadow_map_size - 1);
+        const float half_size = radius + 0.5f * texel;
+        const float lx = std::floor(
+            dot_product(light_right, cascade.sphere_center) / texel + 0.5f) * texel;
+        const float ly = std::floor(
+            dot_product(light_up, cascade.sphere_center) / texel + 0.5f) * texel;
+        const float lz = dot_product(light_dir, cascade.sphere_center);
+
+        const float near_z = lz - radius - params.caster_depth_extension;
+        const float far_z = lz + radius;
+        const float inv_depth = 1.0f / (far_z - near_z);
+
+        matrix_4X4F& proj = cascade.light_projection;
+        proj = matrix_4X4F::identity;
+        proj.a11_ = 1.0f / half_size;
+        proj.a14_ = -lx / half_size;
+        proj.a22_ = 1.0f / half_size;
+        proj.a24_ = -ly / half_size;
+        proj.a33_ = inv_depth;
+        proj.a34_ = -near_z * inv_depth;
+
+        cascade.light_view = light_view;
+        cascade.light_view_projection = proj * light_view;
+    }
+}
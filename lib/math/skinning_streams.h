@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2011, 2012, Adrian Hodos
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the author nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR THE CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include "v8/math/vector3_soa.h"
+
+//
+// Vertex inputs and outputs shared by the skinning kernels
+// (linear_blend_skinning.cc and dual_quaternion_skinning.cc).
+
+namespace v8 { namespace math { namespace internals {
+
+/**
+ * \brief   Positions and normals of a skinning job, as raw pointers. The 
+ *          normal pointers are null when there are no normals.
+ */
+struct skinning_vertex_streams {
+    const float*    px;
+    const float*    py;
+    const float*    pz;
+    const float*    nx;
+    const float*    ny;
+    const float*    nz;
+    float*          out_px;
+    float*          out_py;
+    float*          out_pz;
+    float*          out_nx;
+    float*          out_ny;
+    float*          out_nz;
+};
+
+/**
+ * \brief   Checks the arguments of a skinning function, resizes the outputs 
+ *          to match the inputs and fills the pointers of s. Returns the 
+ *          number of vertices.
+ */
+inline
+size_t
+init_skinning_streams(
+    const v8::math::vector3_soaF& positions,
+    const v8::math::vector3_soaF* normals,
+    v8::math::vector3_soaF* skinned_positions,
+    v8::math::vector3_soaF* skinned_normals,
+    skinning_vertex_streams* s
+    )
+{
+    assert(skinned_positions != &positions);
+    assert(!normals || (skinned_normals && skinned_normals != normals));
+    assert(!normals || normals->size() == positions.size());
+
+    const size_t count = positions.size();
+    skinned_positions->resize(count);
+    if (normals)
+        skinned_normals->resize(count);
+
+    s->px = positions.x();
+    s->py = positions.y();
+    s->pz = positions.z();
+    s->nx = normals ? normals->x() : nullptr;
+    s->ny = normals ? normals->y() : nullptr;
+    s->nz = normals ? normals->z() : nullptr;
+    s->out_px = skinned_positions->x();
+    s->out_py = skinned_positions->y();
+    s->out_pz = skinned_positions->z();
+    s->out_nx = normals ? skinned_normals->x() : nullptr;
+    s->out_ny = normals ? skinned_normals->y() : nullptr;
+    s->out_nz = normals ? skinned_normals->z() : nullptr;
+    return count;
+}
+
+} // namespace internals
+} // namespace math
+} // namespace v8
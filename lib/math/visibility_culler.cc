@@ -0,0 +1,135 @@
+#include "pch_hdr.h"
+#include "v8/base/aligned_memory.h"
+#include <atomic>
+#include "v8/base/thread_pool.h"
+#include "v8/math/visibility_culler.h"
+
+namespace {
+
+/**
+ * \brief   Alignment of the index buffers. Task slices start at multiples
+ *          of kVisibilityCullChunkSize indices, so they start on cache
+ *          line boundaries too.
+ */
+const size_t kIndexBufferAlignment = 64;
+
+} // anonymous namespace
+
+v8::math::visibility_culler::~visibility_culler() {
+    for (size_t i = 0; i < views_.size(); ++i)
+        base::aligned_free(views_[i].indices);
+}
+
+void v8::math::visibility_culler::reserve(
+    size_t view_count,
+    size_t instance_count
+    ) {
+    if (views_.size() < view_count) {
+        const view_data empty_view = { nullptr, 0, 0 };
+        views_.resize(view_count, empty_view);
+    }
+
+    for (size_t i = 0; i < view_count; ++i) {
+        view_data& view = views_[i];
+        view.visible_count = 0;
+        if (view.capacity >= instance_count)
+            continue;
+
+        base::aligned_free(view.indices);
+        view.indices = static_cast<uint32_t*>(base::aligned_malloc(
+            instance_count * sizeof(uint32_t), kIndexBufferAlignment));
+        view.capacity = instance_count;
+    }
+
+    view_count_ = view_count;
+}
+
+void v8::math::visibility_culler::cull(
+    const v8::math::frustum* views,
+    size_t view_count,
+    const v8::math::vector3_soaF& centers,
+    const float* radius
+    ) {
+    const size_t instance_count = centers.size();
+    reserve(view_count, instance_count);
+    if (!view_count || !instance_count)
+        return;
+
+    const size_t chunks_per_view = 
+        (instance_count + kVisibilityCullChunkSize - 1) / kVisibilityCullChunkSize;
+    const size_t task_count = view_count * chunks_per_view;
+    chunk_counts_.resize(task_count);
+
+    const float* x = centers.x();
+    const float* y = centers.y();
+    const float* z = centers.z();
+    view_data* view_results = &views_[0];
+    chunk_count* chunk_counts = &chunk_counts_[0];
+    std::atomic<size_t> next_task(0);
+
+    //
+    // Both passes run in a single job on the shared pool, with a barrier
+    // between them.
+    base::thread_pool::shared().run(max_threads_, 
+                                    [&](base::parallel_region& region) {
+        //
+        // First pass : every task classifies a chunk of instances against 
+        // one view, and writes the visible indices at the start of the 
+        // chunk's slice in the index buffer. The tasks are handed out one
+        // at a time, so threads that get cheap chunks take more of them.
+        uint8_t classes[kVisibilityCullChunkSize];
+        for (;;) {
+            const size_t task = next_task.fetch_add(1, std::memory_order_relaxed);
+            if (task >= task_count)
+                break;
+
+            const size_t view = task / chunks_per_view;
+            const size_t first = (task % chunks_per_view) * kVisibilityCullChunkSize;
+            const size_t count = 
+                std::min(kVisibilityCullChunkSize, instance_count - first);
+
+            classify_spheres(views[view], x + first, y + first, z + first,
+                             radius + first, count, classes);
+
+            uint32_t* out = view_results[view].indices + first;
+            uint32_t visible = 0;
+            for (size_t i = 0; i < count; ++i) {
+                out[visible] = static_cast<uint32_t>(first + i);
+                visible += classes[i] != cull_outside;
+            }
+            chunk_counts[task].value = visible;
+        }
+
+        region.barrier();
+
+        //
+        // Second pass : pack the slices of each view. A slice never moves 
+        // past its own start, so this can be done in place, in order.
+        for (size_t view = region.thread_index(); view < view_count; 
+             view += region.thread_count()) {
+            uint32_t* indices = view_results[view].indices;
+            const chunk_count* counts = chunk_counts + view * chunks_per_view;
+            size_t visible = counts[0].value;
+            for (size_t chunk = 1; chunk < chunks_per_view; ++chunk) {
+                std::memmove(indices + visible, 
+                             indices + chunk * kVisibilityCullChunkSize,
+                             counts[chunk].value * sizeof(uint32_t));
+                visible += counts[chunk].value;
+            }
+            view_results[view].visible_count = visible;
+        }
+    });
+}
+
+void v8::math::visibility_culler::cull(
+    const v8::math::camera* cameras,
+    size_t camera_count,
+    const v8::math::vector3_soaF& centers,
+    const float* radius
+    ) {
+    frustums_.resize(camera_count);
+    for (size_t i = 0; i < camera_count; ++i)
+        frustums_[i] = cameras[i].get_frustum();
+
+    cull(camera_count ? &frustums_[0] : nullptr, camera_count, centers, radius);
+}
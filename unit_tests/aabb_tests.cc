@@ -0,0 +1,175 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/aabb.h"
+#include "v8/math/aabb_soa.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+#include "test_helpers.h"
+
+using v8::math::aabbF;
+using v8::math::aabb_soaF;
+using v8::math::matrix_4X4F;
+using v8::math::vector3F;
+using test_helpers::random_boxes;
+
+namespace {
+
+//
+// Rotation around an arbitrary axis, a non uniform scale and a 
+// translation, so every element of the 3x3 part is non zero.
+const matrix_4X4F kTestMatrix(
+    0.8f, -1.2f, 0.3f, 5.0f,
+    0.6f, 1.6f, -0.2f, -3.0f,
+    -0.1f, 0.4f, 2.0f, 7.5f,
+    0.0f, 0.0f, 0.0f, 1.0f);
+
+} // anonymous namespace
+
+TEST(aabb_tests, basic_operations) {
+    aabbF box(aabbF::empty());
+    EXPECT_TRUE(box.is_empty());
+
+    box.add_point(vector3F(1.0f, -2.0f, 3.0f));
+    EXPECT_FALSE(box.is_empty());
+    EXPECT_EQ(box.min_, box.max_);
+
+    box.add_point(vector3F(-1.0f, 4.0f, 5.0f));
+    EXPECT_EQ(vector3F(-1.0f, -2.0f, 3.0f), box.min_);
+    EXPECT_EQ(vector3F(1.0f, 4.0f, 5.0f), box.max_);
+    EXPECT_EQ(vector3F(0.0f, 1.0f, 4.0f), box.center());
+    EXPECT_EQ(vector3F(1.0f, 3.0f, 1.0f), box.extents());
+    EXPECT_EQ(vector3F(2.0f, 6.0f, 2.0f), box.size());
+
+    EXPECT_TRUE(point_in_aabb(vector3F(0.0f, 0.0f, 4.0f), box));
+    EXPECT_TRUE(point_in_aabb(vector3F(1.0f, 4.0f, 5.0f), box));
+    EXPECT_FALSE(point_in_aabb(vector3F(0.0f, 0.0f, 5.5f), box));
+
+    const aabbF other(vector3F(0.5f, 3.0f, -10.0f), vector3F(8.0f, 9.0f, 3.0f));
+    EXPECT_TRUE(aabb_overlap(box, other));
+    EXPECT_TRUE(aabb_overlap(other, box));
+
+    const aabbF u = merge(box, other);
+    EXPECT_EQ(vector3F(-1.0f, -2.0f, -10.0f), u.min_);
+    EXPECT_EQ(vector3F(8.0f, 9.0f, 5.0f), u.max_);
+
+    const aabbF i = intersection(box, other);
+    EXPECT_FALSE(i.is_empty());
+    EXPECT_EQ(vector3F(0.5f, 3.0f, 3.0f), i.min_);
+    EXPECT_EQ(vector3F(1.0f, 4.0f, 3.0f), i.max_);
+
+    const aabbF far_away(vector3F(10.0f, 10.0f, 10.0f), 
+                         vector3F(11.0f, 11.0f, 11.0f));
+    EXPECT_FALSE(aabb_overlap(box, far_away));
+    EXPECT_TRUE(intersection(box, far_away).is_empty());
+
+    //
+    // Corner (11, 11, 11) is sqrt(3) away from (12, 12, 12).
+    EXPECT_TRUE(aabb_sphere_overlap(far_away, vector3F(12.0f, 12.0f, 12.0f), 1.8f));
+    EXPECT_FALSE(aabb_sphere_overlap(far_away, vector3F(12.0f, 12.0f, 12.0f), 1.7f));
+    EXPECT_TRUE(aabb_sphere_overlap(far_away, vector3F(10.5f, 10.5f, 10.5f), 0.1f));
+}
+
+TEST(aabb_tests, transform_contains_corners) {
+    const matrix_4X4F mtx(kTestMatrix);
+    const std::vector<aabbF> boxes(random_boxes(100, 3));
+
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        const aabbF& box = boxes[i];
+        const aabbF result = transform_aabb(mtx, box);
+
+        //
+        // Arvo's method gives the exact bounds of the transformed corners.
+        aabbF expected(aabbF::empty());
+        for (int corner = 0; corner < 8; ++corner) {
+            vector3F pt(corner & 1 ? box.max_.x_ : box.min_.x_,
+                        corner & 2 ? box.max_.y_ : box.min_.y_,
+                        corner & 4 ? box.max_.z_ : box.min_.z_);
+            mtx.transform_affine_point(&pt);
+            expected.add_point(pt);
+        }
+
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_NEAR(expected.min_.elements_[j], result.min_.elements_[j], 
+                        1.0e-4f);
+            EXPECT_NEAR(expected.max_.elements_[j], result.max_.elements_[j],
+                        1.0e-4f);
+        }
+    }
+}
+
+TEST(aabb_soa_tests, storage) {
+    const std::vector<aabbF> boxes(random_boxes(13, 5));
+    aabb_soaF soa(&boxes[0], boxes.size());
+    ASSERT_EQ(boxes.size(), soa.size());
+
+    std::vector<aabbF> copy(boxes.size());
+    soa.copy_to(&copy[0]);
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        EXPECT_EQ(boxes[i], soa.get(i));
+        EXPECT_EQ(boxes[i], copy[i]);
+    }
+
+    aabbF expected(aabbF::empty());
+    for (size_t i = 0; i < boxes.size(); ++i)
+        expected.add_aabb(boxes[i]);
+    EXPECT_EQ(expected, merge(soa));
+
+    soa.resize(20);
+    EXPECT_EQ(aabbF(vector3F(0.0f, 0.0f, 0.0f), vector3F(0.0f, 0.0f, 0.0f)),
+              soa.get(19));
+    EXPECT_EQ(boxes[12], soa.get(12));
+}
+
+TEST(aabb_soa_tests, batch_functions_match_single) {
+    //
+    // Odd count, so the SIMD tail is used too.
+    const size_t count = 10003;
+    const std::vector<aabbF> boxes(random_boxes(count, 11));
+    const aabb_soaF soa(&boxes[0], count);
+    const matrix_4X4F mtx(kTestMatrix);
+    const aabbF query(vector3F(-20.0f, -15.0f, -30.0f), 
+                      vector3F(10.0f, 25.0f, 5.0f));
+
+    std::mt19937 gen(13);
+    std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+    v8::math::vector3_soaF points(count);
+    for (size_t i = 0; i < count; ++i)
+        points.set(i, vector3F(pos(gen), pos(gen), pos(gen)));
+
+    for (unsigned int threads = 1; threads <= 4; threads += 3) {
+        aabb_soaF transformed;
+        transform_aabbs(mtx, soa, &transformed, threads);
+        ASSERT_EQ(count, transformed.size());
+
+        std::vector<uint8_t> inside(count, 0xFF);
+        points_in_aabb(points, query, &inside[0], threads);
+
+        std::vector<uint8_t> overlaps(count, 0xFF);
+        aabb_overlap(query, soa, &overlaps[0], threads);
+
+        const vector3F sphere_center(5.0f, -3.0f, 8.0f);
+        std::vector<uint8_t> sphere_hits(count, 0xFF);
+        aabb_sphere_overlap(soa, sphere_center, 12.0f, &sphere_hits[0], threads);
+
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(transform_aabb(mtx, boxes[i]), transformed.get(i)) 
+                << "box " << i;
+            ASSERT_EQ(point_in_aabb(points.get(i), query), inside[i] != 0)
+                << "point " << i;
+            ASSERT_EQ(aabb_overlap(query, boxes[i]), overlaps[i] != 0) 
+                << "box " << i;
+            ASSERT_EQ(aabb_sphere_overlap(boxes[i], sphere_center, 12.0f), 
+                      sphere_hits[i] != 0) << "box " << i;
+        }
+    }
+
+    //
+    // In place.
+    aabb_soaF in_place(soa);
+    transform_aabbs(mtx, in_place, &in_place);
+    for (size_t i = 0; i < count; ++i)
+        ASSERT_EQ(transform_aabb(mtx, boxes[i]), in_place.get(i));
+}
@@ -0,0 +1,168 @@
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/animation_clip.h"
+#include "v8/math/quaternion.h"
+#include "v8/math/vector3.h"
+
+using v8::math::animation_clip;
+using v8::math::animation_sampler;
+using v8::math::quaternionF;
+using v8::math::vector3F;
+
+namespace {
+
+const size_t kTrackCount = 11;
+const size_t kFrameCount = 121;
+const float kSampleRate = 30.0f;
+const float kRotationTolerance = 1.0e-3f;
+const float kTranslationTolerance = 1.0e-3f;
+
+/**
+ * \brief   Frame major poses, the last track does not move, and the clip
+ *          built from them.
+ */
+struct test_clip {
+    test_clip()
+        : rotations(kTrackCount * kFrameCount),
+          translations(kTrackCount * kFrameCount)
+    {
+        for (size_t frame = 0; frame < kFrameCount; ++frame) {
+            for (size_t track = 0; track < kTrackCount; ++track) {
+                const bool is_static = track == kTrackCount - 1;
+                const float t = is_static ? 0.0f : frame / kSampleRate;
+                const float phase = static_cast<float>(track);
+                const vector3F axis(std::cos(phase), std::sin(phase), 
+                                    0.5f + 0.1f * phase);
+                rotations[frame * kTrackCount + track] = 
+                    quaternionF(2.5f * std::sin(1.3f * t + phase), axis);
+                translations[frame * kTrackCount + track] = vector3F(
+                    std::cos(t + phase), 0.5f * std::sin(2.0f * t), 
+                    phase + 0.25f * t);
+            }
+        }
+
+        clip.build(&rotations[0], &translations[0], kTrackCount, kFrameCount, 
+                   kSampleRate, kRotationTolerance, kTranslationTolerance);
+    }
+
+    std::vector<quaternionF>    rotations;
+    std::vector<vector3F>       translations;
+    animation_clip              clip;
+};
+
+float
+rotation_error(const quaternionF& a, const quaternionF& b) {
+    const float sign = dot_product(a, b) < 0.0f ? -1.0f : 1.0f;
+    float chord_sq = 0.0f;
+    for (size_t j = 0; j < 4; ++j) {
+        const float d = a.elements_[j] - sign * b.elements_[j];
+        chord_sq += d * d;
+    }
+    return 4.0f * std::asin(std::min(0.5f * std::sqrt(chord_sq), 1.0f));
+}
+
+} // anonymous namespace
+
+TEST(animation_clip_tests, reduces_keys) {
+    const test_clip test;
+    const animation_clip& clip = test.clip;
+
+    EXPECT_EQ(kTrackCount, clip.track_count());
+    EXPECT_EQ(kFrameCount, clip.frame_count());
+    EXPECT_NEAR(4.0f, clip.duration(), 1.0e-5f);
+    EXPECT_EQ(2u, clip.key_count(kTrackCount - 1));
+    EXPECT_LT(clip.total_key_count(), kTrackCount * kFrameCount);
+    EXPECT_LT(clip.size_in_bytes(), 
+              kTrackCount * kFrameCount * (sizeof(quaternionF) + sizeof(vector3F)));
+}
+
+TEST(animation_clip_tests, sampling_is_within_tolerance) {
+    const test_clip test;
+    const animation_clip& clip = test.clip;
+
+    //
+    // Tolerance of the key reduction plus the 16 bit quantization error.
+    animation_sampler sampler(&clip);
+    for (size_t frame = 0; frame < kFrameCount; ++frame) {
+        sampler.sample(frame / kSampleRate);
+        for (size_t track = 0; track < kTrackCount; ++track) {
+            const quaternionF q(sampler.rotations().get(track));
+            const vector3F p(sampler.translations().get(track));
+            EXPECT_NEAR(1.0f, q.magnitude(), 1.0e-5f);
+            const size_t key = frame * kTrackCount + track;
+            EXPECT_LE(rotation_error(test.rotations[key], q),
+                      kRotationTolerance + 2.0e-4f);
+            EXPECT_LE((test.translations[key] - p).magnitude(),
+                      kTranslationTolerance + 1.0e-4f);
+        }
+    }
+}
+
+TEST(animation_clip_tests, sampling_backwards_and_clamped) {
+    const test_clip test;
+    const animation_clip& clip = test.clip;
+
+    animation_sampler forward(&clip);
+    animation_sampler backward(&clip);
+    backward.sample(clip.duration());
+
+    const float times[] = { 3.9f, 2.21f, 0.4f, 1.7f, 0.05f };
+    for (size_t i = 0; i < sizeof(times) / sizeof(times[0]); ++i) {
+        forward.set_clip(&clip);
+        forward.sample(times[i]);
+        backward.sample(times[i]);
+        for (size_t track = 0; track < kTrackCount; ++track) {
+            const quaternionF a(forward.rotations().get(track));
+            const quaternionF b(backward.rotations().get(track));
+            EXPECT_NEAR(0.0f, rotation_error(a, b), 1.0e-5f);
+            EXPECT_NEAR(0.0f, (forward.translations().get(track) 
+                               - backward.translations().get(track)).magnitude(), 
+                        1.0e-5f);
+        }
+    }
+
+    forward.sample(-1.0f);
+    backward.sample(0.0f);
+    forward.sample(100.0f);
+    backward.sample(clip.duration());
+    for (size_t track = 0; track < kTrackCount; ++track) {
+        EXPECT_NEAR(0.0f, (forward.translations().get(track) 
+                           - backward.translations().get(track)).magnitude(), 
+                    1.0e-5f);
+    }
+}
+
+TEST(animation_clip_tests, sample_animations_matches_sampler) {
+    const test_clip test;
+    const animation_clip& clip = test.clip;
+
+    const size_t kSamplerCount = 37;
+    std::vector<float> times(kSamplerCount);
+    for (size_t i = 0; i < kSamplerCount; ++i)
+        times[i] = 0.11f * i;
+
+    const unsigned int thread_counts[] = { 1, 3 };
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); ++t) {
+        std::vector<animation_sampler> samplers(kSamplerCount);
+        for (size_t i = 0; i < kSamplerCount; ++i)
+            samplers[i].set_clip(&clip);
+        v8::math::sample_animations(&samplers[0], &times[0], kSamplerCount, 
+                                    thread_counts[t]);
+
+        animation_sampler reference(&clip);
+        for (size_t i = 0; i < kSamplerCount; ++i) {
+            reference.sample(times[i]);
+            for (size_t track = 0; track < kTrackCount; ++track) {
+                const quaternionF a(reference.rotations().get(track));
+                const quaternionF b(samplers[i].rotations().get(track));
+                EXPECT_EQ(a.w_, b.w_);
+                EXPECT_EQ(a.x_, b.x_);
+                EXPECT_EQ(a.y_, b.y_);
+                EXPECT_EQ(a.z_, b.z_);
+                EXPECT_EQ(reference.translations().get(track).x_, 
+                          samplers[i].translations().get(track).x_);
+            }
+        }
+    }
+}
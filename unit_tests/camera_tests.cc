@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "v8/math/camera.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/vector3.h"
+#include "test_helpers.h"
+
+using v8::math::camera;
+using v8::math::matrix_4X4F;
+using v8::math::vector3F;
+using test_helpers::expect_matrix_near;
+
+TEST(camera_tests, lazy_matrices) {
+    camera cam;
+    cam.look_at(vector3F(1.0f, 2.0f, 3.0f), vector3F(0.0f, 1.0f, 0.0f),
+                vector3F(10.0f, -2.0f, 30.0f));
+
+    //
+    // Changing the frustrum after the view frame must update P * V too.
+    cam.set_symmetric_frustrum(75.0f, 1.5f, 0.5f, 500.0f);
+
+    const matrix_4X4F& view = cam.get_view_transform();
+    EXPECT_FLOAT_EQ(cam.get_right_vector().x_, view.a11_);
+    EXPECT_FLOAT_EQ(cam.get_up_vector().y_, view.a22_);
+    EXPECT_FLOAT_EQ(cam.get_direction_vector().z_, view.a33_);
+    EXPECT_FLOAT_EQ(
+        -v8::math::dot_product(cam.get_direction_vector(), cam.get_origin()),
+        view.a34_);
+
+    const matrix_4X4F& proj = cam.get_projection_transform();
+    EXPECT_FLOAT_EQ(500.0f / 499.5f, proj.a33_);
+    EXPECT_FLOAT_EQ(1.0f, proj.a43_);
+
+    expect_matrix_near(proj * view, cam.get_projection_wiew_transform(), 1.0e-6f);
+
+    expect_matrix_near(matrix_4X4F::identity, 
+                       cam.get_inverse_view_transform() * view, 1.0e-5f);
+    expect_matrix_near(matrix_4X4F::identity,
+                       cam.get_inverse_projection_view_transform() 
+                       * cam.get_projection_wiew_transform(), 1.0e-4f);
+
+    //
+    // The cached inverses follow later changes.
+    cam.set_origin(vector3F(-4.0f, 0.0f, 8.0f));
+    expect_matrix_near(matrix_4X4F::identity,
+                       cam.get_inverse_view_transform() 
+                       * cam.get_view_transform(), 1.0e-5f);
+    EXPECT_FLOAT_EQ(-4.0f, cam.get_inverse_view_transform().a14_);
+}
+
+TEST(camera_tests, projection_matrix_overrides_frustrum) {
+    camera cam;
+    cam.set_symmetric_frustrum(90.0f, 1.0f, 1.0f, 100.0f);
+
+    const matrix_4X4F custom(2.0f, 3.0f, 4.0f, 1.0f);
+    cam.set_projection_matrix(custom);
+    expect_matrix_near(custom, cam.get_projection_transform(), 0.0f);
+    expect_matrix_near(custom * cam.get_view_transform(),
+                       cam.get_projection_wiew_transform(), 0.0f);
+
+    //
+    // Changing the type of a custom projection keeps the matrix.
+    cam.set_projection_type(camera::Projection_Orthographic);
+    EXPECT_EQ(camera::Projection_Orthographic, cam.get_projection_type());
+    expect_matrix_near(custom, cam.get_projection_transform(), 0.0f);
+
+    cam.set_frustrum(1.0f, 10.0f, -1.0f, 1.0f, -2.0f, 2.0f, 
+                     camera::Projection_Orthographic);
+    const matrix_4X4F& ortho = cam.get_projection_transform();
+    EXPECT_FLOAT_EQ(0.5f, ortho.a11_);
+    EXPECT_FLOAT_EQ(1.0f, ortho.a22_);
+    EXPECT_FLOAT_EQ(1.0f / 9.0f, ortho.a33_);
+    EXPECT_FLOAT_EQ(0.0f, ortho.a43_);
+    EXPECT_FLOAT_EQ(1.0f, ortho.a44_);
+}
+
+TEST(camera_tests, rebuilds_avoided) {
+    camera cam;
+    EXPECT_EQ(0u, cam.get_rebuilds_avoided());
+
+    //
+    // The first change marks V and P * V out of date, every following 
+    // change before they are used saves rebuilding both.
+    cam.set_origin(vector3F(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(0u, cam.get_rebuilds_avoided());
+    cam.set_origin(vector3F(2.0f, 0.0f, 0.0f));
+    cam.set_origin(vector3F(3.0f, 0.0f, 0.0f));
+    EXPECT_EQ(4u, cam.get_rebuilds_avoided());
+
+    //
+    // P is out of date now too, P * V still is.
+    cam.set_symmetric_frustrum(90.0f, 1.0f, 1.0f, 100.0f);
+    EXPECT_EQ(5u, cam.get_rebuilds_avoided());
+
+    cam.get_projection_wiew_transform();
+    cam.set_origin(vector3F(4.0f, 0.0f, 0.0f));
+    EXPECT_EQ(5u, cam.get_rebuilds_avoided());
+    EXPECT_FLOAT_EQ(-4.0f, cam.get_view_transform().a14_);
+}
@@ -1,5 +1,8 @@
+#include <cstdint>
+#include <limits>
 #include <gtest/gtest.h>
 #include "v8/math/color.h"
+#include "v8/math/color_pack.h"
 
 TEST(gfx_color_tests, conversion_from_rgba) {
     v8::math::color color(v8::math::color::from_u32_rgba(0xFF2D57FFU));
@@ -32,4 +35,107 @@ TEST(gfx_color_tests, conversion_to_uint32_rgba) {
     v8::math::color color(1.0f, 0.5f, 0.25f, 1.0f);
 
     EXPECT_EQ(0xFF8040FF, color.to_uint32_rgba());
-}
\ No newline at end of file
+}
+
+namespace {
+
+const uint32_t kPackedColors[] = {
+    0xFF2D57FFU, 0x00000000U, 0xFFFFFFFFU, 0x01020304U, 0x80FF7F00U,
+    0x12345678U, 0x9ABCDEF0U, 0x7F7F7F7FU, 0xC0FFEE11U, 0x0BADF00DU,
+    0xDEADBEEFU
+};
+
+const size_t kPackedColorCount = sizeof(kPackedColors) / sizeof(kPackedColors[0]);
+
+} // anonymous namespace
+
+TEST(gfx_color_tests, bulk_unpack) {
+    using namespace v8::math;
+
+    color colors[kPackedColorCount];
+    unpack_colors<color_format_rgba>(kPackedColors, colors, kPackedColorCount);
+    for (size_t i = 0; i < kPackedColorCount; ++i) {
+        const color expected(color::from_u32_rgba(kPackedColors[i]));
+        EXPECT_NEAR(expected.r_, colors[i].r_, 1.0e-6f);
+        EXPECT_NEAR(expected.g_, colors[i].g_, 1.0e-6f);
+        EXPECT_NEAR(expected.b_, colors[i].b_, 1.0e-6f);
+        EXPECT_NEAR(expected.a_, colors[i].a_, 1.0e-6f);
+    }
+
+    unpack_colors<color_format_bgra>(kPackedColors, colors, kPackedColorCount);
+    for (size_t i = 0; i < kPackedColorCount; ++i) {
+        const color expected(color::from_u32_bgra(kPackedColors[i]));
+        EXPECT_NEAR(expected.r_, colors[i].r_, 1.0e-6f);
+        EXPECT_NEAR(expected.b_, colors[i].b_, 1.0e-6f);
+    }
+
+    unpack_colors<color_format_argb>(kPackedColors, colors, kPackedColorCount);
+    for (size_t i = 0; i < kPackedColorCount; ++i) {
+        const color expected(color::from_u32_argb(kPackedColors[i]));
+        EXPECT_NEAR(expected.r_, colors[i].r_, 1.0e-6f);
+        EXPECT_NEAR(expected.a_, colors[i].a_, 1.0e-6f);
+    }
+}
+
+TEST(gfx_color_tests, bulk_round_trip) {
+    using namespace v8::math;
+
+    color colors[kPackedColorCount];
+    uint32_t packed[kPackedColorCount];
+
+    unpack_colors<color_format_abgr>(kPackedColors, colors, kPackedColorCount);
+    pack_colors<color_format_abgr>(colors, packed, kPackedColorCount);
+    for (size_t i = 0; i < kPackedColorCount; ++i)
+        EXPECT_EQ(kPackedColors[i], packed[i]);
+
+    //
+    // Swizzle : read as rgba, write as abgr reverses the bytes.
+    unpack_colors<color_format_rgba>(kPackedColors, colors, kPackedColorCount);
+    pack_colors<color_format_abgr>(colors, packed, kPackedColorCount);
+    for (size_t i = 0; i < kPackedColorCount; ++i) {
+        const uint32_t c = kPackedColors[i];
+        EXPECT_EQ((c >> 24) | ((c >> 8) & 0xFF00U) | ((c << 8) & 0xFF0000U) | 
+                  (c << 24), packed[i]);
+    }
+}
+
+TEST(gfx_color_tests, bulk_pack_clamp_and_round) {
+    using namespace v8::math;
+
+    const color colors[] = {
+        color(1.0f, 0.5f, 0.25f, 1.0f), color(-1.0f, 2.0f, 0.0f, 1.0f),
+        color(0.1f, 0.2f, 0.3f, 0.4f), color(1.0f / 255.0f, 0.999f, 0.001f, 0.5f),
+        color(0.7f, 0.6f, 0.5f, 0.4f)
+    };
+    const uint32_t expected[] = {
+        0xFF8040FFU, 0x00FF00FFU, 0x1A334D66U, 0x01FF0080U, 0xB3998066U
+    };
+
+    uint32_t packed[5];
+    pack_colors<color_format_rgba>(colors, packed, 5);
+    for (size_t i = 0; i < 5; ++i)
+        EXPECT_EQ(expected[i], packed[i]);
+}
+
+TEST(gfx_color_tests, bulk_pack_nan) {
+    using namespace v8::math;
+
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const color colors[] = {
+        color(nan, 0.5f, 1.0f, nan), color(0.25f, nan, nan, 1.0f),
+        color(nan, nan, nan, nan), color(1.0f, 0.0f, 0.5f, nan)
+    };
+    const uint32_t expected[] = {
+        0x0080FF00U, 0x400000FFU, 0x00000000U, 0xFF008000U
+    };
+
+    uint32_t packed[4];
+    pack_colors<color_format_rgba>(colors, packed, 4);
+    uint32_t packed_scalar[4];
+    internals::color_pack_scalar_kernels<color_format_rgba>::pack(
+        colors, packed_scalar, 4);
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(expected[i], packed[i]);
+        EXPECT_EQ(expected[i], packed_scalar[i]);
+    }
+}
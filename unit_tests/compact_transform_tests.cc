@@ -0,0 +1,74 @@
+#include <cmath>
+#include <random>
+#include <gtest/gtest.h>
+#include "v8/math/compact_transform.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/quaternion.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector4.h"
+#include "test_helpers.h"
+
+using v8::math::compact_transformF;
+using v8::math::matrix_4X4F;
+using v8::math::quaternionF;
+using v8::math::vector3F;
+using test_helpers::expect_matrix_near;
+using test_helpers::expect_near;
+using test_helpers::random_rotation;
+
+TEST(compact_transform_tests, size) {
+    EXPECT_EQ(32u, sizeof(compact_transformF));
+}
+
+TEST(compact_transform_tests, identity) {
+    const vector3F p(1.0f, -2.0f, 3.0f);
+    expect_near(p, compact_transformF::identity.transform_point(p));
+    EXPECT_TRUE(compact_transformF::identity.get_matrix() 
+                == matrix_4X4F::identity);
+}
+
+TEST(compact_transform_tests, matches_matrix) {
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> unit(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+    for (int i = 0; i < 100; ++i) {
+        const compact_transformF tfm(
+            random_rotation(&gen), vector3F(unit(gen), unit(gen), unit(gen)),
+            scale(gen));
+        const matrix_4X4F mtx(tfm.get_matrix());
+        const vector3F p(unit(gen), unit(gen), unit(gen));
+
+        vector3F expected_p(p);
+        mtx.transform_affine_point(&expected_p);
+        expect_near(expected_p, tfm.transform_point(p));
+
+        vector3F expected_v(p);
+        mtx.transform_affine_vector(&expected_v);
+        expect_near(expected_v, tfm.transform_vector(p));
+    }
+}
+
+TEST(compact_transform_tests, compose_and_invert) {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> unit(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+    for (int i = 0; i < 100; ++i) {
+        const compact_transformF parent(
+            random_rotation(&gen), vector3F(unit(gen), unit(gen), unit(gen)),
+            scale(gen));
+        const compact_transformF local(
+            random_rotation(&gen), vector3F(unit(gen), unit(gen), unit(gen)),
+            scale(gen));
+        const vector3F p(unit(gen), unit(gen), unit(gen));
+
+        const compact_transformF world(parent * local);
+        expect_near(parent.transform_point(local.transform_point(p)),
+                    world.transform_point(p));
+
+        expect_matrix_near(parent.get_matrix() * local.get_matrix(), 
+                           world.get_matrix());
+
+        expect_near(p, v8::math::inverse_of(world).transform_point(
+            world.transform_point(p)));
+    }
+}
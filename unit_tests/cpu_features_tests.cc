@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include "v8/base/cpu_features.h"
+
+using namespace v8::base;
+
+TEST(cpu_features_tests, tier_names) {
+    for (int t = simd_tier_scalar; t < simd_tier_count; ++t) {
+        simd_tier tier;
+        EXPECT_TRUE(simd_tier_from_name(
+            simd_tier_name(static_cast<simd_tier>(t)), &tier));
+        EXPECT_EQ(t, tier);
+    }
+
+    simd_tier tier;
+    EXPECT_TRUE(simd_tier_from_name("AVX2", &tier));
+    EXPECT_EQ(simd_tier_avx2, tier);
+    EXPECT_FALSE(simd_tier_from_name("avx3", &tier));
+    EXPECT_FALSE(simd_tier_from_name("", &tier));
+}
+
+TEST(cpu_features_tests, host_tier_is_supported) {
+    const unsigned int features = cpu_features();
+    const simd_tier tier = host_simd_tier();
+
+    if (tier >= simd_tier_sse2) {
+        EXPECT_TRUE((features & cpu_feature::sse2) != 0);
+    }
+    if (tier >= simd_tier_sse41) {
+        EXPECT_TRUE((features & cpu_feature::sse41) != 0);
+    }
+    if (tier >= simd_tier_avx) {
+        EXPECT_TRUE((features & cpu_feature::avx) != 0);
+    }
+    if (tier >= simd_tier_avx2) {
+        EXPECT_TRUE((features & cpu_feature::avx2) != 0);
+        EXPECT_TRUE((features & cpu_feature::fma) != 0);
+    }
+    if (tier >= simd_tier_avx512) {
+        EXPECT_TRUE((features & cpu_feature::avx512f) != 0);
+    }
+}
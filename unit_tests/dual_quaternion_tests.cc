@@ -0,0 +1,130 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/dual_quaternion.h"
+#include "v8/math/dual_quaternion_skinning.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/quaternion.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+#include "test_helpers.h"
+
+using v8::math::dual_quaternionF;
+using v8::math::matrix_4X4F;
+using v8::math::quaternionF;
+using v8::math::vector3F;
+using test_helpers::expect_near;
+using test_helpers::random_rotation;
+
+TEST(dual_quaternion_tests, matches_matrix) {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> unit(-10.0f, 10.0f);
+
+    const vector3F translation(1.0f, -2.0f, 3.0f);
+    const dual_quaternionF dq(quaternionF::identity, translation);
+    expect_near(translation, dq.get_translation());
+
+    for (int i = 0; i < 50; ++i) {
+        const dual_quaternionF a(random_rotation(&gen), 
+                                 vector3F(unit(gen), unit(gen), unit(gen)));
+        const dual_quaternionF b(random_rotation(&gen), 
+                                 vector3F(unit(gen), unit(gen), unit(gen)));
+        const vector3F p(unit(gen), unit(gen), unit(gen));
+
+        matrix_4X4F mtx;
+        a.get_matrix(&mtx);
+        vector3F expected(p);
+        mtx.transform_affine_point(&expected);
+        expect_near(expected, a.transform_point(p));
+
+        expect_near(a.transform_point(b.transform_point(p)), 
+                    (a * b).transform_point(p));
+
+        dual_quaternionF inv(a);
+        inv.make_conjugate();
+        expect_near(p, inv.transform_point(a.transform_point(p)));
+    }
+}
+
+TEST(dual_quaternion_tests, skinning_matches_reference) {
+    const size_t kBoneCount = 20;
+    const size_t kVertexCount = 1027;
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> positive(0.0f, 1.0f);
+
+    std::vector<dual_quaternionF> palette;
+    for (size_t i = 0; i < kBoneCount; ++i)
+        palette.push_back(dual_quaternionF(
+            random_rotation(&gen), 
+            vector3F(unit(gen), unit(gen), unit(gen)) * 5.0f));
+
+    v8::math::vector3_soaF positions(kVertexCount);
+    v8::math::vector3_soaF normals(kVertexCount);
+    std::vector<uint16_t> indices(4 * kVertexCount);
+    std::vector<float> weights(4 * kVertexCount);
+    for (size_t i = 0; i < kVertexCount; ++i) {
+        positions.set(i, vector3F(unit(gen), unit(gen), unit(gen)) * 3.0f);
+        normals.set(i, vector3F(unit(gen), unit(gen), unit(gen)));
+
+        //
+        // 1 to 4 bones, the unused influences have a weight of 0.
+        const size_t used = 1 + i % 4;
+        float sum = 0.0f;
+        for (size_t k = 0; k < 4; ++k) {
+            indices[4 * i + k] = static_cast<uint16_t>(gen() % kBoneCount);
+            weights[4 * i + k] = k < used ? positive(gen) + 0.01f : 0.0f;
+            sum += weights[4 * i + k];
+        }
+        for (size_t k = 0; k < 4; ++k)
+            weights[4 * i + k] /= sum;
+    }
+
+    for (unsigned int threads = 1; threads <= 3; threads += 2) {
+        v8::math::vector3_soaF skinned_positions;
+        v8::math::vector3_soaF skinned_normals;
+        v8::math::skin_dual_quaternion(&palette[0], &indices[0], &weights[0],
+                                       positions, &normals, &skinned_positions,
+                                       &skinned_normals, threads);
+        ASSERT_EQ(kVertexCount, skinned_positions.size());
+        ASSERT_EQ(kVertexCount, skinned_normals.size());
+
+        for (size_t i = 0; i < kVertexCount; ++i) {
+            const uint16_t* bones = &indices[4 * i];
+            dual_quaternionF blended(quaternionF::null, quaternionF::null);
+            for (size_t k = 0; k < 4; ++k) {
+                const dual_quaternionF& dq = palette[bones[k]];
+                float w = weights[4 * i + k];
+                if (dot_product(palette[bones[0]].real_, dq.real_) < 0.0f)
+                    w = -w;
+                for (size_t j = 0; j < 4; ++j) {
+                    blended.real_.elements_[j] += w * dq.real_.elements_[j];
+                    blended.dual_.elements_[j] += w * dq.dual_.elements_[j];
+                }
+            }
+            blended.normalize();
+
+            expect_near(blended.transform_point(positions.get(i)), 
+                        skinned_positions.get(i));
+            expect_near(blended.transform_vector(normals.get(i)), 
+                        skinned_normals.get(i));
+        }
+    }
+
+    //
+    // Rigid vertices follow their bone, normals are optional.
+    std::fill(weights.begin(), weights.end(), 0.0f);
+    for (size_t i = 0; i < kVertexCount; ++i)
+        weights[4 * i] = 1.0f;
+
+    v8::math::vector3_soaF skinned_positions;
+    v8::math::skin_dual_quaternion(&palette[0], &indices[0], &weights[0],
+                                   positions, nullptr, &skinned_positions, 
+                                   nullptr);
+    for (size_t i = 0; i < kVertexCount; i += 5) {
+        expect_near(palette[indices[4 * i]].transform_point(positions.get(i)),
+                    skinned_positions.get(i));
+    }
+}
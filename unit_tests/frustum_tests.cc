@@ -0,0 +1,113 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/camera.h"
+#include "v8/math/frustum.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+#include "test_helpers.h"
+
+using v8::math::camera;
+using v8::math::frustum;
+using v8::math::vector3F;
+using test_helpers::make_test_camera;
+
+namespace {
+
+void
+expect_plane(
+    const frustum& f, int plane_id, float nx, float ny, float nz, float d
+    )
+{
+    const v8::math::plane& p = f.get_plane(plane_id);
+    EXPECT_NEAR(nx, p.normal_.x_, 1.0e-5f);
+    EXPECT_NEAR(ny, p.normal_.y_, 1.0e-5f);
+    EXPECT_NEAR(nz, p.normal_.z_, 1.0e-5f);
+    EXPECT_NEAR(d, p.offset_, 1.0e-3f);
+
+    EXPECT_EQ(p.normal_.x_, f.normals_x()[plane_id]);
+    EXPECT_EQ(p.normal_.y_, f.normals_y()[plane_id]);
+    EXPECT_EQ(p.normal_.z_, f.normals_z()[plane_id]);
+    EXPECT_EQ(p.offset_, f.offsets()[plane_id]);
+}
+
+} // anonymous namespace
+
+TEST(frustum_tests, extract_planes) {
+    //
+    // 90 degrees vertical fov, square aspect, looking down +z from the 
+    // origin, so the side planes are x = +/- z and y = +/- z.
+    const frustum f = make_test_camera(
+        90.0f, 1.0f, 1.0f, 100.0f, vector3F::zero, vector3F(0.0f, 0.0f, 1.0f)
+        ).get_frustum();
+    const float k = 0.70710678f;
+
+    expect_plane(f, frustum::Plane_Left, k, 0.0f, k, 0.0f);
+    expect_plane(f, frustum::Plane_Right, -k, 0.0f, k, 0.0f);
+    expect_plane(f, frustum::Plane_Bottom, 0.0f, k, k, 0.0f);
+    expect_plane(f, frustum::Plane_Top, 0.0f, -k, k, 0.0f);
+    expect_plane(f, frustum::Plane_Near, 0.0f, 0.0f, 1.0f, -1.0f);
+    expect_plane(f, frustum::Plane_Far, 0.0f, 0.0f, -1.0f, 100.0f);
+}
+
+TEST(frustum_tests, classify_sphere) {
+    const frustum f = make_test_camera(
+        90.0f, 1.0f, 1.0f, 100.0f, vector3F::zero, vector3F(0.0f, 0.0f, 1.0f)
+        ).get_frustum();
+
+    EXPECT_EQ(v8::math::cull_inside, 
+              f.classify_sphere(vector3F(0.0f, 0.0f, 50.0f), 1.0f));
+    EXPECT_EQ(v8::math::cull_intersect,
+              f.classify_sphere(vector3F(0.0f, 0.0f, 50.0f), 60.0f));
+    EXPECT_EQ(v8::math::cull_intersect,
+              f.classify_sphere(vector3F(0.0f, 0.0f, 0.5f), 1.0f));
+    EXPECT_EQ(v8::math::cull_outside,
+              f.classify_sphere(vector3F(0.0f, 0.0f, -5.0f), 1.0f));
+    EXPECT_EQ(v8::math::cull_outside,
+              f.classify_sphere(vector3F(0.0f, 0.0f, 110.0f), 5.0f));
+    EXPECT_EQ(v8::math::cull_outside,
+              f.classify_sphere(vector3F(20.0f, 0.0f, 10.0f), 2.0f));
+    EXPECT_EQ(v8::math::cull_intersect,
+              f.classify_sphere(vector3F(10.0f, 0.0f, 10.0f), 2.0f));
+}
+
+TEST(frustum_tests, classify_spheres_matches_single) {
+    camera cam(make_test_camera(90.0f, 1.0f, 1.0f, 100.0f, vector3F::zero,
+                                vector3F(0.0f, 0.0f, 1.0f)));
+    cam.look_at(vector3F(5.0f, -2.0f, 3.0f), vector3F(0.0f, 1.0f, 0.0f),
+                vector3F(-10.0f, 4.0f, 40.0f));
+    const frustum f = cam.get_frustum();
+
+    //
+    // Odd count, so the SIMD tail is used too.
+    const size_t count = 10003;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> pos(-120.0f, 120.0f);
+    std::uniform_real_distribution<float> rad(0.0f, 20.0f);
+    v8::math::vector3_soaF centers(count);
+    std::vector<float> radius(count);
+    for (size_t i = 0; i < count; ++i) {
+        centers.set(i, vector3F(pos(gen), pos(gen), pos(gen)));
+        radius[i] = rad(gen);
+    }
+
+    size_t counts[3] = { 0, 0, 0 };
+    for (unsigned int threads = 1; threads <= 4; threads += 3) {
+        std::vector<uint8_t> result(count, 0xFF);
+        v8::math::classify_spheres(f, centers, &radius[0], &result[0], threads);
+
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(f.classify_sphere(centers.get(i), radius[i]), result[i])
+                << "sphere " << i << ", " << threads << " threads";
+            if (threads == 1)
+                ++counts[result[i]];
+        }
+    }
+
+    //
+    // Make sure all the classes were exercised.
+    EXPECT_LT(0u, counts[v8::math::cull_inside]);
+    EXPECT_LT(0u, counts[v8::math::cull_intersect]);
+    EXPECT_LT(0u, counts[v8::math::cull_outside]);
+}
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/level_hierarchy.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/quaternion.h"
+#include "v8/math/transform_palette.h"
+#include "v8/math/vector3.h"
+#include "test_helpers.h"
+
+using v8::math::kInvalidNode;
+using v8::math::level_hierarchy;
+using v8::math::matrix_4X4F;
+using v8::math::quaternionF;
+using v8::math::vector3F;
+
+TEST(level_hierarchy_tests, build_sorts_by_level) {
+    //
+    // 3 -> 1 -> 0, 3 -> 2, 4 is a root.
+    const uint32_t parents[] = { 1, 3, 3, kInvalidNode, kInvalidNode };
+    level_hierarchy h(1);
+    h.build(parents, 5);
+
+    ASSERT_EQ(5u, h.node_count());
+    ASSERT_EQ(3u, h.level_count());
+    EXPECT_EQ(2u, h.level_size(0));
+    EXPECT_EQ(2u, h.level_size(1));
+    EXPECT_EQ(1u, h.level_size(2));
+    EXPECT_EQ(3u, h.node_at(0));
+    EXPECT_EQ(4u, h.node_at(1));
+    EXPECT_EQ(1u, h.node_at(2));
+    EXPECT_EQ(2u, h.node_at(3));
+    EXPECT_EQ(0u, h.node_at(4));
+
+    for (uint32_t node = 0; node < 5; ++node) {
+        EXPECT_EQ(node, h.node_at(h.sorted_index(node)));
+        const uint32_t parent = h.sorted_parents()[h.sorted_index(node)];
+        if (parents[node] == kInvalidNode)
+            EXPECT_EQ(kInvalidNode, parent);
+        else
+            EXPECT_EQ(h.sorted_index(parents[node]), parent);
+    }
+
+    h.set_local_transform(3, quaternionF::identity, vector3F(1.0f, 2.0f, 3.0f),
+                          vector3F(2.0f, 2.0f, 2.0f));
+    h.set_local_transform(1, quaternionF::identity, vector3F(1.0f, 0.0f, 0.0f),
+                          vector3F(1.0f, 1.0f, 1.0f));
+    h.update();
+
+    const matrix_4X4F world = h.world_matrix(0);
+    EXPECT_FLOAT_EQ(3.0f, world.a14_);
+    EXPECT_FLOAT_EQ(2.0f, world.a24_);
+    EXPECT_FLOAT_EQ(2.0f, world.a11_);
+    EXPECT_FLOAT_EQ(1.0f, world.a44_);
+    EXPECT_FLOAT_EQ(0.0f, world.a41_);
+}
+
+TEST(level_hierarchy_tests, update_matches_reference) {
+    std::mt19937 gen(31);
+    const size_t count = 20001;
+
+    //
+    // A random forest, with the nodes shuffled so parents can follow their
+    // children.
+    const std::vector<uint32_t> forest(
+        test_helpers::random_forest(count, 6, &gen));
+    std::vector<uint32_t> order(count);
+    for (size_t i = 0; i < count; ++i)
+        order[i] = static_cast<uint32_t>(i);
+    std::shuffle(order.begin(), order.end(), gen);
+
+    std::vector<uint32_t> parents(count, kInvalidNode);
+    for (size_t i = 0; i < count; ++i) {
+        if (forest[i] != kInvalidNode)
+            parents[order[i]] = order[forest[i]];
+    }
+
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> scale(0.7f, 1.3f);
+    std::vector<quaternionF> rotations(count);
+    std::vector<vector3F> translations(count);
+    std::vector<vector3F> scales(count);
+    for (size_t i = 0; i < count; ++i) {
+        rotations[i] = test_helpers::random_rotation(&gen);
+        translations[i] = vector3F(unit(gen), unit(gen), unit(gen));
+        scales[i] = vector3F(scale(gen), scale(gen), scale(gen));
+    }
+
+    //
+    // Reference: local matrices from the 4X4 palette builder, composed by
+    // walking up to the roots.
+    std::vector<matrix_4X4F> locals(count);
+    v8::math::make_transform_palette_4X4(&rotations[0], &translations[0], 
+                                         &scales[0], count, &locals[0]);
+
+    for (unsigned int threads = 1; threads <= 4; threads += 3) {
+        level_hierarchy h(threads);
+        h.build(&parents[0], count);
+        for (uint32_t i = 0; i < count; ++i)
+            h.set_local_transform(i, rotations[i], translations[i], scales[i]);
+        h.update();
+
+        size_t checked_levels = 0;
+        for (size_t level = 1; level < h.level_count(); ++level) {
+            const uint32_t first = static_cast<uint32_t>(h.level_first(level));
+            for (uint32_t pos = first; pos < first + h.level_size(level); ++pos) {
+                ASSERT_LT(h.sorted_parents()[pos], first);
+            }
+            ++checked_levels;
+        }
+        EXPECT_LT(3u, checked_levels);
+
+        for (uint32_t i = 0; i < count; i += 7) {
+            matrix_4X4F expected(locals[i]);
+            for (uint32_t p = parents[i]; p != kInvalidNode; p = parents[p])
+                expected = locals[p] * expected;
+
+            const matrix_4X4F world = h.world_matrix(i);
+            for (int k = 0; k < 16; ++k) {
+                ASSERT_NEAR(expected.elements_[k], world.elements_[k], 
+                            1.0e-3f * (1.0f + std::fabs(expected.elements_[k])))
+                    << "node " << i;
+            }
+        }
+    }
+}
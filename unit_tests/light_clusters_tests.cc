@@ -0,0 +1,84 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/aabb.h"
+#include "v8/math/camera.h"
+#include "v8/math/color.h"
+#include "v8/math/light.h"
+#include "v8/math/light_clusters.h"
+#include "v8/math/matrix4X4_batch.h"
+#include "v8/math/vector3.h"
+#include "test_helpers.h"
+
+using v8::math::camera;
+using v8::math::light;
+using v8::math::light_clusters;
+using v8::math::vector3F;
+using test_helpers::make_lights;
+using test_helpers::make_test_camera;
+
+TEST(light_clusters_tests, cluster_bounds) {
+    light_clusters clusters(16, 9, 24);
+    clusters.assign(make_test_camera(60.0f, 16.0f / 9.0f, 0.5f, 200.0f,
+                                     vector3F(3.0f, 2.0f, -20.0f),
+                                     vector3F(10.0f, 0.0f, 40.0f)),
+                    nullptr, 0);
+    ASSERT_EQ(16u * 9u * 24u, clusters.cluster_count());
+    EXPECT_EQ(0u, clusters.total_light_count());
+
+    const v8::math::aabbF first = clusters.cluster_bounds().get(0);
+    const v8::math::aabbF last = clusters.cluster_bounds().get(
+        clusters.cluster_count() - 1);
+    EXPECT_FLOAT_EQ(0.5f, first.min_.z_);
+    EXPECT_FLOAT_EQ(200.0f, last.max_.z_);
+
+    //
+    // Exponential slices.
+    EXPECT_EQ(0u, clusters.depth_slice(0.1f));
+    EXPECT_EQ(0u, clusters.depth_slice(0.6f));
+    EXPECT_EQ(12u, clusters.depth_slice(10.01f));
+    EXPECT_EQ(23u, clusters.depth_slice(199.0f));
+    EXPECT_EQ(23u, clusters.depth_slice(1000.0f));
+}
+
+TEST(light_clusters_tests, matches_brute_force) {
+    const camera cam(make_test_camera(60.0f, 16.0f / 9.0f, 0.5f, 200.0f,
+                                      vector3F(3.0f, 2.0f, -20.0f),
+                                      vector3F(10.0f, 0.0f, 40.0f)));
+    const std::vector<light> lights(make_lights(700, 41, 150.0f, true));
+
+    for (unsigned int threads = 1; threads <= 4; threads += 3) {
+        light_clusters clusters(16, 9, 24, threads);
+        clusters.assign(cam, &lights[0], lights.size());
+
+        std::vector<std::vector<uint32_t> > expected(clusters.cluster_count());
+        for (size_t i = 0; i < lights.size(); ++i) {
+            if (lights[i].get_type() == light::light_type_directional)
+                continue;
+
+            float x = lights[i].get_position().x_;
+            float y = lights[i].get_position().y_;
+            float z = lights[i].get_position().z_;
+            transform_affine_points_soa(cam.get_view_transform(), 
+                                        &x, &y, &z, &x, &y, &z, 1);
+            for (size_t c = 0; c < clusters.cluster_count(); ++c) {
+                if (aabb_sphere_overlap(clusters.cluster_bounds().get(c),
+                                        vector3F(x, y, z), 
+                                        lights[i].get_max_range()))
+                    expected[c].push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        size_t total = 0;
+        for (size_t c = 0; c < clusters.cluster_count(); ++c) {
+            ASSERT_EQ(expected[c].size(), clusters.light_count(c)) 
+                << "cluster " << c;
+            for (size_t i = 0; i < expected[c].size(); ++i)
+                ASSERT_EQ(expected[c][i], clusters.light_indices(c)[i]);
+            total += expected[c].size();
+        }
+        EXPECT_EQ(total, clusters.total_light_count());
+        EXPECT_LT(0u, total);
+    }
+}
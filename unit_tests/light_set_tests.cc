@@ -0,0 +1,147 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/color.h"
+#include "v8/math/light.h"
+#include "v8/math/light_set.h"
+#include "v8/math/math_constants.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+#include "test_helpers.h"
+
+using v8::math::light;
+using v8::math::light_set;
+using v8::math::vector3F;
+using test_helpers::make_lights;
+
+namespace {
+
+//
+// Reference values, computed directly from the light objects.
+void reference(
+    const light& l,
+    const vector3F& pt,
+    bool* in_range,
+    float* attenuation,
+    float* spot
+    ) {
+    const vector3F to_point = pt - l.get_position();
+    const float dist = to_point.magnitude();
+    const vector3F& att = l.get_attenuation_factors();
+
+    *in_range = dist <= l.get_max_range();
+    *attenuation = 1.0f / (att.x_ + att.y_ * dist + att.z_ * dist * dist);
+    *spot = 1.0f;
+    if (l.get_type() == light::light_type_spot) {
+        vector3F dir(l.get_direction());
+        dir.normalize();
+        const float cos_alpha = dot_product(to_point, dir) / dist;
+        if (cos_alpha < std::cos(l.get_spot_cone_angle()))
+            *spot = 0.0f;
+        else if (l.get_spot_power() != 0.0f)
+            *spot = std::pow(std::max(cos_alpha, 0.0f), l.get_spot_power());
+    }
+}
+
+} // anonymous namespace
+
+TEST(light_set_tests, storage) {
+    const v8::math::color c(1.0f, 1.0f, 1.0f, 1.0f);
+    const light lights[] = {
+        light(c, c, c, vector3F(0.0f, -1.0f, 0.0f)),
+        light(c, c, c, vector3F(1.0f, 2.0f, 3.0f), 
+              vector3F(1.0f, 0.1f, 0.01f), 10.0f),
+        light(c, c, c, vector3F(4.0f, 5.0f, 6.0f), vector3F(0.0f, 0.0f, 2.0f),
+              vector3F(1.0f, 0.0f, 0.0f), 20.0f, 8.0f, 0.5f)
+    };
+
+    light_set set(lights, 3);
+    ASSERT_EQ(2u, set.light_count());
+    EXPECT_EQ(vector3F(1.0f, 2.0f, 3.0f), set.positions().get(0));
+    EXPECT_EQ(vector3F(1.0f, 0.1f, 0.01f), set.attenuation().get(0));
+    EXPECT_EQ(vector3F::zero, set.directions().get(0));
+    EXPECT_FLOAT_EQ(10.0f, set.max_range()[0]);
+    EXPECT_FLOAT_EQ(0.0f, set.spot_power()[0]);
+
+    EXPECT_EQ(vector3F(0.0f, 0.0f, 1.0f), set.directions().get(1));
+    EXPECT_FLOAT_EQ(8.0f, set.spot_power()[1]);
+    EXPECT_FLOAT_EQ(0.5f, set.spot_cone_theta()[1]);
+    EXPECT_FLOAT_EQ(std::cos(0.5f), set.spot_cone_cos()[1]);
+
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT_EQ(2 + i, set.add(lights[1 + i % 2]));
+    EXPECT_EQ(102u, set.light_count());
+    EXPECT_EQ(vector3F(4.0f, 5.0f, 6.0f), set.positions().get(101));
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(light_set_tests, batch_functions_match_reference) {
+    //
+    // Odd light count, so the scalar tail is used too.
+    const std::vector<light> lights(make_lights(37, 5, 20.0f, false));
+    const light_set set(&lights[0], lights.size());
+    ASSERT_EQ(lights.size(), set.light_count());
+
+    const size_t point_count = 1001;
+    std::mt19937 gen(9);
+    std::uniform_real_distribution<float> pos(-25.0f, 25.0f);
+    v8::math::vector3_soaF points(point_count);
+    for (size_t i = 0; i < point_count; ++i)
+        points.set(i, vector3F(pos(gen), pos(gen), pos(gen)));
+
+    const size_t n = point_count * lights.size();
+    for (unsigned int threads = 1; threads <= 4; threads += 3) {
+        std::vector<uint8_t> in_range(n, 0xFF);
+        std::vector<float> attenuation(n, -1.0f);
+        std::vector<float> spot(n, -1.0f);
+        std::vector<float> intensity(n, -1.0f);
+        light_range_cull(set, points, &in_range[0], threads);
+        light_distance_attenuation(set, points, &attenuation[0], threads);
+        light_spot_falloff(set, points, &spot[0], threads);
+        evaluate_lights(set, points, &intensity[0], threads);
+
+        size_t lit = 0;
+        for (size_t p = 0; p < point_count; ++p) {
+            for (size_t l = 0; l < lights.size(); ++l) {
+                const size_t idx = p * lights.size() + l;
+                bool ref_in_range;
+                float ref_att, ref_spot;
+                reference(lights[l], points.get(p), &ref_in_range, &ref_att,
+                          &ref_spot);
+
+                ASSERT_EQ(ref_in_range, in_range[idx] != 0) << p << " " << l;
+                ASSERT_NEAR(ref_att, attenuation[idx], 1.0e-5f * ref_att);
+                ASSERT_NEAR(ref_spot, spot[idx], 1.0e-4f) << p << " " << l;
+                ASSERT_NEAR(ref_in_range ? ref_att * ref_spot : 0.0f, 
+                            intensity[idx], 1.0e-4f) << p << " " << l;
+                lit += intensity[idx] > 0.0f;
+            }
+        }
+        EXPECT_LT(0u, lit);
+    }
+}
+
+TEST(light_set_tests, spot_cone_edge) {
+    const v8::math::color c(1.0f, 1.0f, 1.0f, 1.0f);
+    light_set set;
+    set.add(light(c, c, c, vector3F::zero, vector3F(0.0f, 0.0f, 1.0f),
+                  vector3F(1.0f, 0.0f, 0.0f), 100.0f, 2.0f, 
+                  v8::math::constants::kPi / 4.0f));
+
+    v8::math::vector3_soaF points(4);
+    points.set(0, vector3F(0.0f, 0.0f, 10.0f));
+    points.set(1, vector3F(0.0f, 9.0f, 10.0f));
+    points.set(2, vector3F(0.0f, 11.0f, 10.0f));
+    points.set(3, vector3F(0.0f, 0.0f, -10.0f));
+
+    float falloff[4];
+    light_spot_falloff(set, points, falloff);
+    EXPECT_FLOAT_EQ(1.0f, falloff[0]);
+    EXPECT_NEAR(100.0f / 181.0f, falloff[1], 1.0e-5f);
+    EXPECT_FLOAT_EQ(0.0f, falloff[2]);
+    EXPECT_FLOAT_EQ(0.0f, falloff[3]);
+}
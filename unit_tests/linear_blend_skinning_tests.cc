@@ -0,0 +1,107 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/linear_blend_skinning.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/quaternion.h"
+#include "v8/math/transform_palette.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+#include "test_helpers.h"
+
+using v8::math::matrix_4X4F;
+using v8::math::quaternionF;
+using v8::math::vector3F;
+using test_helpers::expect_near;
+using test_helpers::random_rotation;
+
+TEST(linear_blend_skinning_tests, matches_reference) {
+    const size_t kBoneCount = 30;
+    const size_t kVertexCount = 1027;
+    std::mt19937 gen(23);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> positive(0.01f, 1.0f);
+
+    std::vector<quaternionF> rotations(kBoneCount);
+    std::vector<vector3F> translations(kBoneCount);
+    std::vector<vector3F> scales(kBoneCount);
+    for (size_t i = 0; i < kBoneCount; ++i) {
+        rotations[i] = random_rotation(&gen);
+        translations[i] = vector3F(unit(gen), unit(gen), unit(gen));
+        scales[i] = vector3F(1.0f + 0.2f * unit(gen), 1.0f, 1.0f);
+    }
+    std::vector<matrix_4X4F> palette(kBoneCount);
+    std::vector<float> palette_3X4(12 * kBoneCount);
+    v8::math::make_transform_palette_4X4(&rotations[0], &translations[0],
+                                         &scales[0], kBoneCount, &palette[0]);
+    v8::math::make_transform_palette_3X4(&rotations[0], &translations[0],
+                                         &scales[0], kBoneCount, 
+                                         &palette_3X4[0]);
+
+    v8::math::vector3_soaF positions(kVertexCount);
+    v8::math::vector3_soaF normals(kVertexCount);
+    for (size_t i = 0; i < kVertexCount; ++i) {
+        positions.set(i, vector3F(unit(gen), unit(gen), unit(gen)) * 3.0f);
+        normals.set(i, vector3F(unit(gen), unit(gen), unit(gen)));
+    }
+
+    const v8::math::skinning_influences influence_counts[] = {
+        v8::math::skinning_influences_1, v8::math::skinning_influences_2,
+        v8::math::skinning_influences_4, v8::math::skinning_influences_8
+    };
+    for (size_t c = 0; c < 4; ++c) {
+        const v8::math::skinning_influences influences = influence_counts[c];
+        std::vector<uint16_t> indices(influences * kVertexCount);
+        std::vector<float> weights(influences * kVertexCount);
+        for (size_t i = 0; i < kVertexCount; ++i) {
+            float sum = 0.0f;
+            for (size_t k = 0; k < influences; ++k) {
+                indices[influences * i + k] = 
+                    static_cast<uint16_t>(gen() % kBoneCount);
+                weights[influences * i + k] = positive(gen);
+                sum += weights[influences * i + k];
+            }
+            for (size_t k = 0; k < influences; ++k)
+                weights[influences * i + k] /= sum;
+        }
+
+        for (unsigned int threads = 1; threads <= 3; threads += 2) {
+            v8::math::vector3_soaF skinned_positions;
+            v8::math::vector3_soaF skinned_normals;
+            v8::math::vector3_soaF skinned_positions_3X4;
+            v8::math::skin_linear_blend(&palette[0], &indices[0], &weights[0],
+                                        influences, positions, &normals,
+                                        &skinned_positions, &skinned_normals,
+                                        threads);
+            v8::math::skin_linear_blend(&palette_3X4[0], &indices[0], 
+                                        &weights[0], influences, positions, 
+                                        nullptr, &skinned_positions_3X4, 
+                                        nullptr, threads);
+            ASSERT_EQ(kVertexCount, skinned_positions.size());
+            ASSERT_EQ(kVertexCount, skinned_normals.size());
+            ASSERT_EQ(kVertexCount, skinned_positions_3X4.size());
+
+            for (size_t i = 0; i < kVertexCount; ++i) {
+                matrix_4X4F blended;
+                for (size_t j = 0; j < 16; ++j)
+                    blended.elements_[j] = 0.0f;
+                for (size_t k = 0; k < influences; ++k) {
+                    const matrix_4X4F& bone = palette[indices[influences * i + k]];
+                    const float w = weights[influences * i + k];
+                    for (size_t j = 0; j < 16; ++j)
+                        blended.elements_[j] += w * bone.elements_[j];
+                }
+
+                vector3F pos(positions.get(i));
+                blended.transform_affine_point(&pos);
+                vector3F normal(normals.get(i));
+                blended.transform_affine_vector(&normal);
+
+                expect_near(pos, skinned_positions.get(i));
+                expect_near(pos, skinned_positions_3X4.get(i));
+                expect_near(normal, skinned_normals.get(i));
+            }
+        }
+    }
+}
@@ -0,0 +1,1137 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/base/parallel_for.h"
+#include "v8/base/string_util.h"
+#include "v8/math/aabb.h"
+#include "v8/math/aabb_soa.h"
+#include "v8/math/animation_clip.h"
+#include "v8/math/camera.h"
+#include "v8/math/color.h"
+#include "v8/math/color_pack.h"
+#include "v8/math/compact_transform.h"
+#include "v8/math/dual_quaternion.h"
+#include "v8/math/dual_quaternion_skinning.h"
+#include "v8/math/frustum.h"
+#include "v8/math/level_hierarchy.h"
+#include "v8/math/light.h"
+#include "v8/math/light_clusters.h"
+#include "v8/math/light_set.h"
+#include "v8/math/linear_blend_skinning.h"
+#include "v8/math/matrix3X3.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/matrix4X4_batch.h"
+#include "v8/math/occlusion_buffer.h"
+#include "v8/math/quaternion.h"
+#include "v8/math/quaternion_soa.h"
+#include "v8/math/scene_hierarchy.h"
+#include "v8/math/shadow_cascades.h"
+#include "v8/math/transform.h"
+#include "v8/math/transform_palette.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+#include "v8/math/vector_expression.h"
+#include "v8/math/visibility_culler.h"
+
+//
+// Micro benchmarks for the math library. They are disabled by default,
+// run them with :
+// unit_tests --gtest_also_run_disabled_tests --gtest_filter=*benchmarks*
+
+namespace {
+
+const int kBenchmarkRepeatCount = 20;
+
+template<typename Fn>
+double
+measure_ms(Fn fn) {
+    typedef std::chrono::high_resolution_clock clock_t;
+    const clock_t::time_point start = clock_t::now();
+    for (int i = 0; i < kBenchmarkRepeatCount; ++i)
+        fn();
+    const clock_t::time_point end = clock_t::now();
+    return std::chrono::duration<double, std::milli>(end - start).count()
+        / kBenchmarkRepeatCount;
+}
+
+void
+report(const char* name, double ms, size_t item_count) {
+    std::printf("%-48s %10.3f ms %10.2f ns/item\n",
+                name, ms, (ms * 1.0e6) / static_cast<double>(item_count));
+}
+
+void
+fill_random(std::vector<v8::math::matrix_4X4F>* mtx, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (size_t i = 0; i < mtx->size(); ++i) {
+        for (size_t j = 0; j < 16; ++j)
+            (*mtx)[i].elements_[j] = dist(gen);
+    }
+}
+
+} // anonymous namespace
+
+TEST(math_benchmarks, DISABLED_matrix4X4F_multiply) {
+    using v8::math::matrix_4X4F;
+
+    const size_t kMatrixCount = 50000;
+    std::vector<matrix_4X4F> lhs(kMatrixCount);
+    std::vector<matrix_4X4F> rhs(kMatrixCount);
+    std::vector<matrix_4X4F> res(kMatrixCount);
+    fill_random(&lhs, 1);
+    fill_random(&rhs, 2);
+
+    const double generic_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kMatrixCount; ++i)
+            v8::math::internals::matrix4X4_multiply(lhs[i], rhs[i], &res[i]);
+    });
+    const float generic_check = res[kMatrixCount / 2].a11_;
+
+    const double specialized_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kMatrixCount; ++i)
+            res[i] = lhs[i] * rhs[i];
+    });
+
+    report("matrix_4X4F multiply (generic template)", generic_ms, kMatrixCount);
+    report("matrix_4X4F multiply (operator*)", specialized_ms, kMatrixCount);
+    EXPECT_FLOAT_EQ(generic_check, res[kMatrixCount / 2].a11_);
+}
+
+TEST(math_benchmarks, DISABLED_matrix4X4F_transform_points) {
+    using v8::math::matrix_4X4F;
+    using v8::math::vector3F;
+
+    const size_t kPointCount = 1000000;
+    std::vector<matrix_4X4F> mtx(1);
+    fill_random(&mtx, 3);
+
+    std::vector<vector3F> input(kPointCount, vector3F(1.0f, 2.0f, 3.0f));
+    std::vector<vector3F> output(kPointCount);
+
+    const double loop_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kPointCount; ++i) {
+            output[i] = input[i];
+            mtx[0].transform_affine_point(&output[i]);
+        }
+    });
+    const double batch_ms = measure_ms([&]() {
+        v8::math::transform_affine_points(
+            mtx[0], input.data(), output.data(), kPointCount);
+    });
+    const double batch_mt_ms = measure_ms([&]() {
+        v8::math::transform_affine_points(
+            mtx[0], input.data(), output.data(), kPointCount, 0);
+    });
+
+    report("transform_affine_point (loop)", loop_ms, kPointCount);
+    report("transform_affine_points (batch)", batch_ms, kPointCount);
+    report("transform_affine_points (batch, all threads)", batch_mt_ms,
+           kPointCount);
+
+    //
+    // Every kernel tier supported by this machine, single threaded.
+    for (int t = v8::base::simd_tier_scalar; 
+         t <= v8::base::host_simd_tier(); ++t) {
+        const v8::math::internals::batch_transform_kernel_table& table =
+            v8::math::internals::batch_transform_kernels_for_tier(
+                static_cast<v8::base::simd_tier>(t));
+        if (table.tier != t)
+            continue;
+
+        const double tier_ms = measure_ms([&]() {
+            table.affine_points_aos(
+                mtx[0], input.data(), output.data(), kPointCount);
+        });
+
+        char name[64];
+        v8::base::snprintf(name, sizeof(name), "transform_affine_points (%s)",
+                           v8::base::simd_tier_name(table.tier));
+        report(name, tier_ms, kPointCount);
+    }
+}
+
+TEST(math_benchmarks, DISABLED_matrix4X4F_inverse) {
+    using v8::math::matrix_4X4F;
+
+    const size_t kMatrixCount = 50000;
+    std::vector<matrix_4X4F> input(kMatrixCount);
+    std::vector<matrix_4X4F> res(kMatrixCount);
+    fill_random(&input, 4);
+    for (size_t i = 0; i < kMatrixCount; ++i) {
+        input[i].a41_ = input[i].a42_ = input[i].a43_ = 0.0f;
+        input[i].a44_ = 1.0f;
+        //
+        // Keep the matrices away from singular.
+        input[i].a11_ += 4.0f;
+        input[i].a22_ += 4.0f;
+        input[i].a33_ += 4.0f;
+    }
+
+    const double generic_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kMatrixCount; ++i)
+            v8::math::internals::matrix4X4_inverse(input[i], &res[i]);
+    });
+    const double specialized_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kMatrixCount; ++i)
+            input[i].get_inverse(&res[i]);
+    });
+    const double affine_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kMatrixCount; ++i)
+            input[i].get_inverse_affine(&res[i]);
+    });
+    const double batch_ms = measure_ms([&]() {
+        v8::math::invert_matrices(input.data(), res.data(), kMatrixCount, 0);
+    });
+
+    report("matrix_4X4F inverse (generic template)", generic_ms, kMatrixCount);
+    report("matrix_4X4F inverse (get_inverse)", specialized_ms, kMatrixCount);
+    report("matrix_4X4F inverse (get_inverse_affine)", affine_ms, kMatrixCount);
+    report("matrix_4X4F inverse (batch, all threads)", batch_ms, kMatrixCount);
+}
+
+TEST(math_benchmarks, DISABLED_vector3F_soa_normalize) {
+    using v8::math::vector3F;
+
+    const size_t kVectorCount = 1000000;
+    std::vector<vector3F> aos(kVectorCount, vector3F(1.0f, 2.0f, 3.0f));
+    v8::math::vector3_soaF soa(aos.data(), kVectorCount);
+
+    const double aos_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kVectorCount; ++i) {
+            aos[i] *= 2.0f;
+            aos[i].normalize();
+        }
+    });
+    const double soa_ms = measure_ms([&]() {
+        soa *= 2.0f;
+        soa.normalize();
+    });
+
+    report("vector3F scale + normalize (AoS loop)", aos_ms, kVectorCount);
+    report("vector3_soaF scale + normalize", soa_ms, kVectorCount);
+}
+
+TEST(math_benchmarks, DISABLED_quaternionF_slerp) {
+    using v8::math::quaternionF;
+    using v8::math::vector3F;
+
+    const size_t kRotationCount = 100000;
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<quaternionF> a(kRotationCount);
+    std::vector<quaternionF> b(kRotationCount);
+    std::vector<quaternionF> out(kRotationCount);
+    for (size_t i = 0; i < kRotationCount; ++i) {
+        a[i].make_from_axis_angle(3.0f * dist(gen), 
+                                  vector3F(dist(gen), dist(gen), 2.0f));
+        b[i].make_from_axis_angle(3.0f * dist(gen), 
+                                  vector3F(2.0f, dist(gen), dist(gen)));
+    }
+
+    v8::math::quaternion_soaF sa(a.data(), kRotationCount);
+    v8::math::quaternion_soaF sb(b.data(), kRotationCount);
+    v8::math::quaternion_soaF sout(kRotationCount);
+
+    const double slerp_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kRotationCount; ++i)
+            out[i] = v8::math::slerp(a[i], b[i], 0.3f);
+    });
+    const double fast_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kRotationCount; ++i)
+            out[i] = v8::math::slerp_fast(a[i], b[i], 0.3f);
+    });
+    const double soa_slerp_ms = measure_ms([&]() {
+        v8::math::slerp(sa, sb, 0.3f, &sout);
+    });
+    const double soa_nlerp_ms = measure_ms([&]() {
+        v8::math::nlerp(sa, sb, 0.3f, &sout);
+    });
+    const double soa_fast_ms = measure_ms([&]() {
+        v8::math::slerp_fast(sa, sb, 0.3f, &sout);
+    });
+
+    report("quaternionF slerp (loop)", slerp_ms, kRotationCount);
+    report("quaternionF slerp_fast (loop)", fast_ms, kRotationCount);
+    report("quaternion_soaF slerp", soa_slerp_ms, kRotationCount);
+    report("quaternion_soaF nlerp", soa_nlerp_ms, kRotationCount);
+    report("quaternion_soaF slerp_fast", soa_fast_ms, kRotationCount);
+}
+
+TEST(math_benchmarks, DISABLED_transform_palette) {
+    using v8::math::matrix_3X3F;
+    using v8::math::matrix_4X4F;
+    using v8::math::quaternionF;
+    using v8::math::vector3F;
+
+    const size_t kBoneCount = 100000;
+    std::mt19937 gen(13);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<quaternionF> rotations(kBoneCount);
+    std::vector<vector3F> translations(kBoneCount);
+    for (size_t i = 0; i < kBoneCount; ++i) {
+        rotations[i].make_from_axis_angle(
+            3.0f * dist(gen), vector3F(dist(gen), dist(gen), 2.0f));
+        translations[i] = vector3F(dist(gen), dist(gen), dist(gen));
+    }
+    std::vector<matrix_4X4F> palette(kBoneCount);
+
+    const double loop_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kBoneCount; ++i) {
+            matrix_3X3F r;
+            rotations[i].extract_rotation_matrix(&r);
+            matrix_4X4F& m = palette[i];
+            m.a11_ = r.a11_; m.a12_ = r.a12_; m.a13_ = r.a13_;
+            m.a21_ = r.a21_; m.a22_ = r.a22_; m.a23_ = r.a23_;
+            m.a31_ = r.a31_; m.a32_ = r.a32_; m.a33_ = r.a33_;
+            m.a14_ = translations[i].x_;
+            m.a24_ = translations[i].y_;
+            m.a34_ = translations[i].z_;
+            m.a41_ = m.a42_ = m.a43_ = 0.0f;
+            m.a44_ = 1.0f;
+        }
+    });
+    const double batch_ms = measure_ms([&]() {
+        v8::math::make_transform_palette_4X4(
+            rotations.data(), translations.data(), kBoneCount, palette.data());
+    });
+
+    report("palette 4X4 (extract_rotation_matrix loop)", loop_ms, kBoneCount);
+    report("palette 4X4 (make_transform_palette_4X4)", batch_ms, kBoneCount);
+}
+
+TEST(math_benchmarks, DISABLED_color_pack) {
+    using v8::math::color;
+
+    const size_t kPixelCount = 1920 * 1080;
+    std::mt19937 gen(17);
+    std::vector<uint32_t> packed(kPixelCount);
+    for (size_t i = 0; i < kPixelCount; ++i)
+        packed[i] = static_cast<uint32_t>(gen());
+    std::vector<color> colors(kPixelCount);
+
+    const double unpack_loop_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kPixelCount; ++i)
+            colors[i] = color::from_u32_rgba(packed[i]);
+    });
+    const double pack_loop_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kPixelCount; ++i)
+            packed[i] = colors[i].to_uint32_rgba();
+    });
+    const double unpack_ms = measure_ms([&]() {
+        v8::math::unpack_colors<v8::math::color_format_rgba>(
+            packed.data(), colors.data(), kPixelCount);
+    });
+    const double pack_ms = measure_ms([&]() {
+        v8::math::pack_colors<v8::math::color_format_rgba>(
+            colors.data(), packed.data(), kPixelCount);
+    });
+
+    report("color unpack 1080p (from_u32_rgba loop)", unpack_loop_ms, kPixelCount);
+    report("color pack 1080p (to_uint32_rgba loop)", pack_loop_ms, kPixelCount);
+    report("color unpack 1080p (unpack_colors)", unpack_ms, kPixelCount);
+    report("color pack 1080p (pack_colors)", pack_ms, kPixelCount);
+}
+
+TEST(math_benchmarks, DISABLED_normalize_precision) {
+    using namespace v8::math;
+
+    const size_t kVectorCount = 1000000;
+    std::vector<vector3F> aos(kVectorCount, vector3F(1.0f, 2.0f, 3.0f));
+    vector3_soaF soa(aos.data(), kVectorCount);
+
+    const double aos_exact_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kVectorCount; ++i)
+            aos[i].normalize();
+    });
+    const double aos_fast_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kVectorCount; ++i)
+            aos[i].normalize<precision_fast>();
+    });
+    const double soa_exact_ms = measure_ms([&]() {
+        soa.normalize<precision_exact>();
+    });
+    const double soa_fast_ms = measure_ms([&]() {
+        soa.normalize<precision_fast>();
+    });
+    const double soa_estimate_ms = measure_ms([&]() {
+        soa.normalize<precision_estimate>();
+    });
+
+    report("vector3F normalize (exact, AoS loop)", aos_exact_ms, kVectorCount);
+    report("vector3F normalize (fast, AoS loop)", aos_fast_ms, kVectorCount);
+    report("vector3_soaF normalize (exact)", soa_exact_ms, kVectorCount);
+    report("vector3_soaF normalize (fast)", soa_fast_ms, kVectorCount);
+    report("vector3_soaF normalize (estimate)", soa_estimate_ms, kVectorCount);
+}
+
+TEST(math_benchmarks, DISABLED_vector3F_expression_templates) {
+    using v8::math::vector3F;
+    using v8::math::expr::lazy;
+
+    const size_t kVectorCount = 100000;
+    std::mt19937 gen(19);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<vector3F> a(kVectorCount);
+    std::vector<vector3F> b(kVectorCount);
+    std::vector<vector3F> c(kVectorCount);
+    for (size_t i = 0; i < kVectorCount; ++i) {
+        a[i] = vector3F(dist(gen), dist(gen), dist(gen));
+        b[i] = vector3F(dist(gen), dist(gen), dist(gen));
+        c[i] = vector3F(dist(gen), dist(gen), dist(gen));
+    }
+    std::vector<vector3F> out(kVectorCount);
+    const float s = 0.75f;
+    const float t = 1.25f;
+
+    const double eager_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kVectorCount; ++i)
+            out[i] = a[i] * s + b[i] * t - c[i] * 0.5f + a[i];
+    });
+    const double lazy_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kVectorCount; ++i)
+            out[i] = lazy(a[i]) * s + lazy(b[i]) * t - lazy(c[i]) * 0.5f + a[i];
+    });
+
+    report("vector3F a*s + b*t - c*k + a (operators)", eager_ms, kVectorCount);
+    report("vector3F a*s + b*t - c*k + a (expressions)", lazy_ms, kVectorCount);
+}
+
+TEST(math_benchmarks, DISABLED_frustum_cull_spheres) {
+    using v8::math::vector3F;
+
+    v8::math::camera cam;
+    cam.set_symmetric_frustrum(60.0f, 16.0f / 9.0f, 0.5f, 1000.0f);
+    cam.look_at(vector3F(0.0f, 10.0f, 0.0f), vector3F(0.0f, 1.0f, 0.0f),
+                vector3F(100.0f, 0.0f, 200.0f));
+    const v8::math::frustum f = cam.get_frustum();
+
+    const size_t kSphereCount = 100000;
+    std::mt19937 gen(23);
+    std::uniform_real_distribution<float> pos(-1000.0f, 1000.0f);
+    std::uniform_real_distribution<float> rad(0.5f, 10.0f);
+    v8::math::vector3_soaF centers(kSphereCount);
+    std::vector<float> radius(kSphereCount);
+    for (size_t i = 0; i < kSphereCount; ++i) {
+        centers.set(i, vector3F(pos(gen), pos(gen), pos(gen)));
+        radius[i] = rad(gen);
+    }
+    std::vector<uint8_t> result(kSphereCount);
+
+    const double single_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kSphereCount; ++i)
+            result[i] = static_cast<uint8_t>(
+                f.classify_sphere(centers.get(i), radius[i]));
+    });
+    const double batch_ms = measure_ms([&]() {
+        v8::math::classify_spheres(f, centers, &radius[0], &result[0]);
+    });
+    const double mt_ms = measure_ms([&]() {
+        v8::math::classify_spheres(f, centers, &radius[0], &result[0], 0);
+    });
+
+    report("frustum sphere test (per sphere)", single_ms, kSphereCount);
+    report("frustum sphere test (classify_spheres)", batch_ms, kSphereCount);
+    report("frustum sphere test (all threads)", mt_ms, kSphereCount);
+}
+
+TEST(math_benchmarks, DISABLED_aabb_transform) {
+    using v8::math::aabbF;
+    using v8::math::vector3F;
+
+    const size_t kBoxCount = 100000;
+    std::mt19937 gen(29);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+    std::vector<aabbF> boxes(kBoxCount);
+    for (size_t i = 0; i < kBoxCount; ++i) {
+        const vector3F a(dist(gen), dist(gen), dist(gen));
+        const vector3F b(dist(gen), dist(gen), dist(gen));
+        boxes[i] = aabbF::empty().add_point(a).add_point(b);
+    }
+    const v8::math::aabb_soaF soa(&boxes[0], kBoxCount);
+    std::vector<v8::math::matrix_4X4F> mtx_storage(1);
+    fill_random(&mtx_storage, 31);
+    const v8::math::matrix_4X4F& mtx = mtx_storage[0];
+
+    std::vector<aabbF> out(kBoxCount);
+    v8::math::aabb_soaF soa_out(kBoxCount);
+
+    const double single_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kBoxCount; ++i)
+            out[i] = transform_aabb(mtx, boxes[i]);
+    });
+    const double batch_ms = measure_ms([&]() {
+        transform_aabbs(mtx, soa, &soa_out);
+    });
+
+    report("aabbF transform (per box)", single_ms, kBoxCount);
+    report("aabbF transform (aabb_soa)", batch_ms, kBoxCount);
+}
+
+TEST(math_benchmarks, DISABLED_visibility_culler_scaling) {
+    using v8::math::vector3F;
+
+    const size_t kInstanceCount = 1000000;
+    const size_t kViewCount = 8;
+    std::mt19937 gen(37);
+    std::uniform_real_distribution<float> pos(-1000.0f, 1000.0f);
+    std::uniform_real_distribution<float> rad(0.5f, 10.0f);
+    v8::math::vector3_soaF centers(kInstanceCount);
+    std::vector<float> radius(kInstanceCount);
+    for (size_t i = 0; i < kInstanceCount; ++i) {
+        centers.set(i, vector3F(pos(gen), pos(gen), pos(gen)));
+        radius[i] = rad(gen);
+    }
+
+    std::vector<v8::math::camera> cameras(kViewCount);
+    for (size_t i = 0; i < kViewCount; ++i) {
+        const float angle = 6.2831853f * i / kViewCount;
+        cameras[i].set_symmetric_frustrum(60.0f, 16.0f / 9.0f, 0.5f, 1000.0f);
+        cameras[i].look_at(vector3F(0.0f, 0.0f, 0.0f), 
+                           vector3F(0.0f, 1.0f, 0.0f),
+                           vector3F(std::cos(angle), 0.0f, std::sin(angle)));
+    }
+
+    //
+    // 1, 2, 4, ... threads, up to the number of hardware threads.
+    const unsigned int hw_threads = v8::base::effective_thread_count(0);
+    for (unsigned int threads = 1; ; threads *= 2) {
+        if (threads > hw_threads)
+            threads = hw_threads;
+
+        v8::math::visibility_culler culler(threads);
+        culler.cull(&cameras[0], kViewCount, centers, &radius[0]);
+        const double ms = measure_ms([&]() {
+            culler.cull(&cameras[0], kViewCount, centers, &radius[0]);
+        });
+
+        char name[64];
+        v8::base::snprintf(name, sizeof(name), 
+                           "visibility_culler 1M x 8 views, %u threads", threads);
+        report(name, ms, kInstanceCount * kViewCount);
+
+        if (threads == hw_threads)
+            break;
+    }
+}
+
+TEST(math_benchmarks, DISABLED_shadow_cascades) {
+    using v8::math::vector3F;
+
+    const size_t kViewCount = 64;
+    std::vector<v8::math::camera> cameras(kViewCount);
+    for (size_t i = 0; i < kViewCount; ++i) {
+        const float angle = 6.2831853f * i / kViewCount;
+        cameras[i].set_symmetric_frustrum(60.0f, 16.0f / 9.0f, 0.5f, 500.0f);
+        cameras[i].look_at(vector3F(0.0f, 10.0f, 0.0f), 
+                           vector3F(0.0f, 1.0f, 0.0f),
+                           vector3F(std::cos(angle), 10.0f, std::sin(angle)));
+    }
+
+    const v8::math::color white(1.0f, 1.0f, 1.0f, 1.0f);
+    const v8::math::light sun(white, white, white, 
+                              vector3F(0.3f, -1.0f, 0.4f).normalize());
+    v8::math::shadow_cascade_params params;
+    params.cascade_count = 4;
+    v8::math::shadow_cascade cascades[kViewCount][4];
+
+    const double ms = measure_ms([&]() {
+        for (size_t i = 0; i < kViewCount; ++i)
+            compute_shadow_cascades(cameras[i], sun, params, cascades[i]);
+    });
+
+    report("compute_shadow_cascades, 4 cascades (per view)", ms, kViewCount);
+}
+
+TEST(math_benchmarks, DISABLED_light_clusters) {
+    using v8::math::vector3F;
+
+    //
+    // 64 pixel tiles at 1920x1080, 24 depth slices.
+    v8::math::camera cam;
+    cam.set_symmetric_frustrum(60.0f, 16.0f / 9.0f, 0.5f, 500.0f);
+    cam.look_at(vector3F(0.0f, 10.0f, 0.0f), vector3F(0.0f, 1.0f, 0.0f),
+                vector3F(0.0f, 10.0f, 100.0f));
+
+    const size_t kLightCount = 10000;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> pos(-250.0f, 250.0f);
+    std::uniform_real_distribution<float> range(1.0f, 15.0f);
+    const v8::math::color white(1.0f, 1.0f, 1.0f, 1.0f);
+    std::vector<v8::math::light> lights;
+    lights.reserve(kLightCount);
+    for (size_t i = 0; i < kLightCount; ++i)
+        lights.push_back(v8::math::light(
+            white, white, white, 
+            vector3F(pos(gen), 0.1f * pos(gen), pos(gen) + 250.0f),
+            vector3F(1.0f, 0.0f, 0.0f), range(gen)));
+
+    v8::math::light_clusters clusters(30, 17, 24);
+    clusters.assign(cam, &lights[0], lights.size());
+    const double ms = measure_ms([&]() {
+        clusters.assign(cam, &lights[0], lights.size());
+    });
+
+    char name[64];
+    v8::base::snprintf(name, sizeof(name), 
+                       "light_clusters::assign, %u entries (per light)",
+                       static_cast<unsigned>(clusters.total_light_count()));
+    report(name, ms, kLightCount);
+}
+
+TEST(math_benchmarks, DISABLED_light_set_evaluate) {
+    using v8::math::vector3F;
+
+    const size_t kLightCount = 64;
+    const size_t kPointCount = 16384;
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+    const v8::math::color white(1.0f, 1.0f, 1.0f, 1.0f);
+    std::vector<v8::math::light> lights;
+    for (size_t i = 0; i < kLightCount; ++i) {
+        const vector3F p(pos(gen), pos(gen), pos(gen));
+        if (i % 2) {
+            lights.push_back(v8::math::light(
+                white, white, white, p, vector3F(pos(gen), pos(gen), pos(gen)),
+                vector3F(1.0f, 0.1f, 0.01f), 40.0f, 16.0f, 0.7f));
+        } else {
+            lights.push_back(v8::math::light(
+                white, white, white, p, vector3F(1.0f, 0.1f, 0.01f), 40.0f));
+        }
+    }
+
+    v8::math::vector3_soaF points(kPointCount);
+    for (size_t i = 0; i < kPointCount; ++i)
+        points.set(i, vector3F(pos(gen), pos(gen), pos(gen)));
+
+    //
+    // Baseline: the same math, reading the fields from the light objects.
+    std::vector<float> intensity(kPointCount * kLightCount);
+    const double aos_ms = measure_ms([&]() {
+        for (size_t p = 0; p < kPointCount; ++p) {
+            const vector3F pt(points.get(p));
+            for (size_t l = 0; l < kLightCount; ++l) {
+                const v8::math::light& lt = lights[l];
+                const vector3F d(pt - lt.get_position());
+                const float dist = d.magnitude();
+                float value = 0.0f;
+                if (dist <= lt.get_max_range()) {
+                    const vector3F& a = lt.get_attenuation_factors();
+                    value = 1.0f / (a.x_ + a.y_ * dist + a.z_ * dist * dist);
+                    if (lt.get_type() == v8::math::light::light_type_spot) {
+                        vector3F dir(lt.get_direction());
+                        const float c = dot_product(d, dir.normalize()) / dist;
+                        value *= c < std::cos(lt.get_spot_cone_angle()) 
+                            ? 0.0f : std::pow(std::max(c, 0.0f), lt.get_spot_power());
+                    }
+                }
+                intensity[p * kLightCount + l] = value;
+            }
+        }
+    });
+    report("light objects, intensity (per light * point)", aos_ms, 
+           kPointCount * kLightCount);
+
+    const v8::math::light_set set(&lights[0], lights.size());
+    const double soa_ms = measure_ms([&]() {
+        evaluate_lights(set, points, &intensity[0]);
+    });
+    report("evaluate_lights (per light * point)", soa_ms, 
+           kPointCount * kLightCount);
+}
+
+TEST(math_benchmarks, DISABLED_occlusion_buffer) {
+    using v8::math::vector3F;
+
+    //
+    // A city block grid, every building is a box occluder (12 triangles).
+    const vector3F corners[] = {
+        vector3F(0.0f, 0.0f, 0.0f), vector3F(1.0f, 0.0f, 0.0f),
+        vector3F(1.0f, 1.0f, 0.0f), vector3F(0.0f, 1.0f, 0.0f),
+        vector3F(0.0f, 0.0f, 1.0f), vector3F(1.0f, 0.0f, 1.0f),
+        vector3F(1.0f, 1.0f, 1.0f), vector3F(0.0f, 1.0f, 1.0f)
+    };
+    const uint32_t box_indices[] = {
+        0, 1, 2, 0, 2, 3,  4, 6, 5, 4, 7, 6,  0, 4, 5, 0, 5, 1,
+        3, 2, 6, 3, 6, 7,  0, 3, 7, 0, 7, 4,  1, 5, 6, 1, 6, 2
+    };
+
+    const size_t kBuildingsPerSide = 48;
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> height(5.0f, 40.0f);
+    std::vector<vector3F> vertices;
+    std::vector<uint32_t> indices;
+    for (size_t i = 0; i < kBuildingsPerSide; ++i) {
+        for (size_t j = 0; j < kBuildingsPerSide; ++j) {
+            const vector3F origin(-240.0f + 10.0f * i, 0.0f, 10.0f * j);
+            const float h = height(gen);
+            const uint32_t base = static_cast<uint32_t>(vertices.size());
+            for (size_t k = 0; k < 8; ++k) {
+                vertices.push_back(origin + vector3F(
+                    6.0f * corners[k].x_, h * corners[k].y_, 6.0f * corners[k].z_));
+            }
+            for (size_t k = 0; k < 36; ++k)
+                indices.push_back(base + box_indices[k]);
+        }
+    }
+
+    const size_t kOccludeeCount = 100000;
+    std::uniform_real_distribution<float> x_pos(-240.0f, 240.0f);
+    std::uniform_real_distribution<float> z_pos(0.0f, 480.0f);
+    v8::math::aabb_soaF occludees(kOccludeeCount);
+    for (size_t i = 0; i < kOccludeeCount; ++i) {
+        const vector3F c(x_pos(gen), 1.0f, z_pos(gen));
+        occludees.set(i, v8::math::aabbF(c - vector3F(1.0f, 1.0f, 1.0f),
+                                         c + vector3F(1.0f, 1.0f, 1.0f)));
+    }
+
+    v8::math::camera cam;
+    cam.set_symmetric_frustrum(60.0f, 2.0f, 0.5f, 1000.0f);
+    cam.look_at(vector3F(0.0f, 8.0f, -20.0f), vector3F(0.0f, 1.0f, 0.0f),
+                vector3F(0.0f, 8.0f, 100.0f));
+
+    const unsigned int hw_threads = v8::base::effective_thread_count(0);
+    std::vector<uint8_t> result(kOccludeeCount);
+    for (unsigned int threads = 1; ; threads *= 2) {
+        if (threads > hw_threads)
+            threads = hw_threads;
+
+        v8::math::occlusion_buffer buffer(320, 160, threads);
+        const double render_ms = measure_ms([&]() {
+            buffer.begin_frame(cam);
+            buffer.add_occluder(v8::math::matrix_4X4F::identity, &vertices[0], 
+                                vertices.size(), &indices[0], indices.size());
+            buffer.render();
+        });
+
+        const double test_ms = measure_ms([&]() {
+            buffer.occluded_aabbs(occludees, &result[0]);
+        });
+
+        size_t occluded = 0;
+        for (size_t i = 0; i < kOccludeeCount; ++i)
+            occluded += result[i];
+
+        char name[64];
+        v8::base::snprintf(name, sizeof(name), 
+                           "occlusion render, %u threads (per triangle)", threads);
+        report(name, render_ms, indices.size() / 3);
+        v8::base::snprintf(name, sizeof(name), 
+                           "occlusion test, %u threads, %u%% hidden", threads,
+                           static_cast<unsigned>(occluded * 100 / kOccludeeCount));
+        report(name, test_ms, kOccludeeCount);
+
+        if (threads == hw_threads)
+            break;
+    }
+}
+
+TEST(math_benchmarks, DISABLED_scene_hierarchy_update) {
+    using v8::math::vector3F;
+
+    //
+    // 1M nodes, in trees of 1011 nodes: a root with 10 children, each
+    // with 10 children of 9 leaves.
+    const size_t kNodeCount = 1000000;
+    v8::math::scene_hierarchy scene;
+    scene.reserve(kNodeCount);
+    const v8::math::transformF local(vector3F(1.0f, 0.0f, 0.0f));
+    while (scene.node_count() < kNodeCount) {
+        const uint32_t root = scene.add_node(v8::math::kInvalidNode, local);
+        for (size_t i = 0; i < 10 && scene.node_count() < kNodeCount; ++i) {
+            const uint32_t a = scene.add_node(root, local);
+            for (size_t j = 0; j < 10 && scene.node_count() < kNodeCount; ++j) {
+                const uint32_t b = scene.add_node(a, local);
+                for (size_t k = 0; k < 9 && scene.node_count() < kNodeCount; ++k)
+                    scene.add_node(b, local);
+            }
+        }
+    }
+    scene.update();
+
+    const double all_ms = measure_ms([&]() {
+        scene.update_all();
+    });
+    report("scene_hierarchy::update_all, 1M nodes (per node)", all_ms, kNodeCount);
+
+    //
+    // 100 random inner nodes move, with their subtrees.
+    std::mt19937 gen(11);
+    const double dirty_ms = measure_ms([&]() {
+        for (size_t i = 0; i < 100; ++i) {
+            uint32_t node = static_cast<uint32_t>(gen() % kNodeCount);
+            while (scene.first_child(node) == v8::math::kInvalidNode || 
+                   scene.parent(node) == v8::math::kInvalidNode)
+                node = static_cast<uint32_t>(gen() % kNodeCount);
+            scene.set_local_transform(node, local);
+        }
+        scene.update();
+    });
+
+    char name[64];
+    v8::base::snprintf(name, sizeof(name), 
+                       "scene_hierarchy::update, %u dirty (per node)",
+                       static_cast<unsigned>(scene.last_update_count()));
+    report(name, dirty_ms, scene.last_update_count());
+}
+
+TEST(math_benchmarks, DISABLED_level_hierarchy_update) {
+    //
+    // 1M nodes, in trees of 1011 nodes, like the scene_hierarchy benchmark.
+    const size_t kNodeCount = 1000000;
+    std::vector<uint32_t> parents(kNodeCount, v8::math::kInvalidNode);
+    for (size_t i = 0; i < kNodeCount; ++i) {
+        const size_t tree = i - i % 1011;
+        const size_t k = i - tree;
+        if (k == 0)
+            continue;
+        if (k <= 10)
+            parents[i] = static_cast<uint32_t>(tree);
+        else if (k <= 110)
+            parents[i] = static_cast<uint32_t>(tree + 1 + (k - 11) / 10);
+        else
+            parents[i] = static_cast<uint32_t>(tree + 11 + (k - 111) / 9);
+    }
+
+    const unsigned int hw_threads = v8::base::effective_thread_count(0);
+    for (unsigned int threads = 1; ; threads *= 2) {
+        if (threads > hw_threads)
+            threads = hw_threads;
+
+        v8::math::level_hierarchy h(threads);
+        h.build(&parents[0], kNodeCount);
+        h.update();
+        const double ms = measure_ms([&]() {
+            h.update();
+        });
+
+        char name[64];
+        v8::base::snprintf(name, sizeof(name), 
+                           "level_hierarchy::update 1M, %u threads", threads);
+        report(name, ms, kNodeCount);
+
+        if (threads == hw_threads)
+            break;
+    }
+}
+
+TEST(math_benchmarks, DISABLED_compact_transform) {
+    using v8::math::vector3F;
+
+    //
+    // world[i] = parent[i] * local[i] and a point transform per element,
+    // with transformF and compact_transformF. The bytes column is the 
+    // size of the three arrays.
+    const size_t kCount = 1000000;
+    std::mt19937 gen(41);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<v8::math::transformF> parents;
+    std::vector<v8::math::compact_transformF> compact_parents;
+    parents.reserve(kCount);
+    compact_parents.reserve(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        v8::math::quaternionF q(unit(gen), unit(gen), unit(gen), unit(gen));
+        q.normalize();
+        const vector3F t(unit(gen), unit(gen), unit(gen));
+        v8::math::matrix_3X3F rotation;
+        q.extract_rotation_matrix(&rotation);
+        parents.push_back(v8::math::transformF(rotation, true, t, 1.5f));
+        compact_parents.push_back(v8::math::compact_transformF(q, t, 1.5f));
+    }
+    std::vector<v8::math::transformF> locals(parents.rbegin(), parents.rend());
+    std::vector<v8::math::transformF> worlds(kCount);
+    std::vector<v8::math::compact_transformF> compact_locals(
+        compact_parents.rbegin(), compact_parents.rend());
+    std::vector<v8::math::compact_transformF> compact_worlds(kCount);
+    std::vector<vector3F> points(kCount);
+
+    std::printf("transformF: %u bytes, compact_transformF: %u bytes\n",
+                static_cast<unsigned>(sizeof(v8::math::transformF)),
+                static_cast<unsigned>(sizeof(v8::math::compact_transformF)));
+
+    const double full_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kCount; ++i) {
+            worlds[i] = locals[i] * parents[i];
+            worlds[i].get_transform_matrix().transform_affine_point(&points[i]);
+        }
+    });
+    report("transformF compose + point, 1M", full_ms, kCount);
+    std::printf("%-48s %10.1f MB/s\n", "transformF bandwidth",
+                3.0 * kCount * sizeof(v8::math::transformF) / (full_ms * 1.0e3));
+
+    const double compact_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kCount; ++i) {
+            compact_worlds[i] = compact_parents[i] * compact_locals[i];
+            points[i] = compact_worlds[i].transform_point(points[i]);
+        }
+    });
+    report("compact_transformF compose + point, 1M", compact_ms, kCount);
+    std::printf("%-48s %10.1f MB/s\n", "compact_transformF bandwidth",
+                3.0 * kCount * sizeof(v8::math::compact_transformF) 
+                    / (compact_ms * 1.0e3));
+}
+
+TEST(math_benchmarks, DISABLED_transform_compose) {
+    using v8::math::vector3F;
+
+    //
+    // world = parent * local, for 1M parent matrices and local transforms,
+    // through the cached 4X4 matrix of the local transform and with 
+    // compose_affine().
+    const size_t kCount = 1000000;
+    std::mt19937 gen(43);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<v8::math::transformF> locals;
+    locals.reserve(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        v8::math::matrix_3X3F rotation;
+        rotation.make_euler_xyz(unit(gen), unit(gen), unit(gen));
+        locals.push_back(v8::math::transformF(
+            rotation, true, vector3F(unit(gen), unit(gen), unit(gen)), 1.5f));
+    }
+    std::vector<v8::math::matrix_4X4F> parents(kCount);
+    for (size_t i = 0; i < kCount; ++i)
+        locals[kCount - 1 - i].get_transform_matrix(&parents[i]);
+    std::vector<v8::math::matrix_4X4F> worlds(kCount);
+
+    const double matrix_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kCount; ++i) {
+            locals[i].set_scale_component(1.5f);
+            worlds[i] = parents[i] * locals[i].get_transform_matrix();
+        }
+    });
+    report("parent * local.get_transform_matrix(), 1M", matrix_ms, kCount);
+
+    const double affine_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kCount; ++i) {
+            locals[i].set_scale_component(1.5f);
+            v8::math::compose_affine(parents[i], locals[i], &worlds[i]);
+        }
+    });
+    report("compose_affine(parent, local), 1M", affine_ms, kCount);
+
+    std::vector<v8::math::transformF> world_transforms(kCount);
+    const double compose_ms = measure_ms([&]() {
+        v8::math::compose_transforms(&locals[0], &locals[0], kCount,
+                                     &world_transforms[0]);
+    });
+    report("compose_transforms, 1M", compose_ms, kCount);
+}
+
+TEST(math_benchmarks, DISABLED_dual_quaternion_skinning) {
+    using v8::math::vector3F;
+
+    //
+    // 1M vertices with 4 influences each, 64 bones, positions and normals.
+    const size_t kVertexCount = 1000000;
+    const size_t kBoneCount = 64;
+    std::mt19937 gen(47);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<v8::math::dual_quaternionF> palette;
+    for (size_t i = 0; i < kBoneCount; ++i) {
+        v8::math::quaternionF q(unit(gen), unit(gen), unit(gen), unit(gen));
+        q.normalize();
+        palette.push_back(v8::math::dual_quaternionF(
+            q, vector3F(unit(gen), unit(gen), unit(gen))));
+    }
+
+    v8::math::vector3_soaF positions(kVertexCount);
+    v8::math::vector3_soaF normals(kVertexCount);
+    std::vector<uint16_t> indices(4 * kVertexCount);
+    std::vector<float> weights(4 * kVertexCount, 0.25f);
+    for (size_t i = 0; i < kVertexCount; ++i) {
+        positions.set(i, vector3F(unit(gen), unit(gen), unit(gen)));
+        normals.set(i, vector3F(0.0f, 1.0f, 0.0f));
+        for (size_t k = 0; k < 4; ++k)
+            indices[4 * i + k] = static_cast<uint16_t>(gen() % kBoneCount);
+    }
+
+    v8::math::vector3_soaF skinned_positions;
+    v8::math::vector3_soaF skinned_normals;
+    const unsigned int hw_threads = v8::base::effective_thread_count(0);
+    for (unsigned int threads = 1; ; threads *= 2) {
+        if (threads > hw_threads)
+            threads = hw_threads;
+
+        const double ms = measure_ms([&]() {
+            v8::math::skin_dual_quaternion(&palette[0], &indices[0], 
+                                           &weights[0], positions, &normals,
+                                           &skinned_positions, 
+                                           &skinned_normals, threads);
+        });
+
+        char name[64];
+        v8::base::snprintf(name, sizeof(name), 
+                           "skin_dual_quaternion 1M, %u threads", threads);
+        report(name, ms, kVertexCount);
+
+        if (threads == hw_threads)
+            break;
+    }
+}
+
+TEST(math_benchmarks, DISABLED_linear_blend_skinning) {
+    using v8::math::vector3F;
+
+    //
+    // 1M vertices, 64 bones, positions and normals, 1/2/4/8 influences.
+    const size_t kVertexCount = 1000000;
+    const size_t kBoneCount = 64;
+    std::mt19937 gen(53);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<float> palette(12 * kBoneCount);
+    for (size_t i = 0; i < palette.size(); ++i)
+        palette[i] = unit(gen);
+
+    v8::math::vector3_soaF positions(kVertexCount);
+    v8::math::vector3_soaF normals(kVertexCount);
+    for (size_t i = 0; i < kVertexCount; ++i) {
+        positions.set(i, vector3F(unit(gen), unit(gen), unit(gen)));
+        normals.set(i, vector3F(0.0f, 1.0f, 0.0f));
+    }
+
+    std::vector<uint16_t> indices(8 * kVertexCount);
+    for (size_t i = 0; i < indices.size(); ++i)
+        indices[i] = static_cast<uint16_t>(gen() % kBoneCount);
+
+    v8::math::vector3_soaF skinned_positions;
+    v8::math::vector3_soaF skinned_normals;
+    const unsigned int hw_threads = v8::base::effective_thread_count(0);
+    const v8::math::skinning_influences influence_counts[] = {
+        v8::math::skinning_influences_1, v8::math::skinning_influences_2,
+        v8::math::skinning_influences_4, v8::math::skinning_influences_8
+    };
+    for (size_t c = 0; c < 4; ++c) {
+        const v8::math::skinning_influences influences = influence_counts[c];
+        const std::vector<float> weights(influences * kVertexCount, 
+                                         1.0f / influences);
+        for (unsigned int threads = 1; ; threads *= 2) {
+            if (threads > hw_threads)
+                threads = hw_threads;
+
+            const double ms = measure_ms([&]() {
+                v8::math::skin_linear_blend(&palette[0], &indices[0], 
+                                            &weights[0], influences, 
+                                            positions, &normals,
+                                            &skinned_positions, 
+                                            &skinned_normals, threads);
+            });
+
+            char name[64];
+            v8::base::snprintf(name, sizeof(name), 
+                               "skin_linear_blend 1M, %u bones, %u threads",
+                               static_cast<unsigned>(influences), threads);
+            report(name, ms, kVertexCount);
+
+            if (threads == hw_threads)
+                break;
+        }
+    }
+}
+
+TEST(math_benchmarks, DISABLED_animation_sampling) {
+    using v8::math::quaternionF;
+    using v8::math::vector3F;
+
+    //
+    // 10s clip at 30 Hz, 64 tracks of smooth motion, 2000 characters 
+    // playing it at different times.
+    const size_t kTrackCount = 64;
+    const size_t kFrameCount = 301;
+    const size_t kSamplerCount = 2000;
+    const float kSampleRate = 30.0f;
+    std::mt19937 gen(59);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<vector3F> axes(kTrackCount);
+    std::vector<float> phases(kTrackCount);
+    for (size_t track = 0; track < kTrackCount; ++track) {
+        axes[track] = vector3F(unit(gen), unit(gen), unit(gen) + 2.0f);
+        phases[track] = 3.0f * unit(gen);
+    }
+
+    std::vector<quaternionF> rotations(kTrackCount * kFrameCount);
+    std::vector<vector3F> translations(kTrackCount * kFrameCount);
+    for (size_t frame = 0; frame < kFrameCount; ++frame) {
+        const float t = frame / kSampleRate;
+        for (size_t track = 0; track < kTrackCount; ++track) {
+            const float p = phases[track];
+            rotations[frame * kTrackCount + track] = 
+                quaternionF(1.5f * std::sin(2.0f * t + p), axes[track]);
+            translations[frame * kTrackCount + track] = vector3F(
+                std::sin(t + p), 0.1f * std::cos(3.0f * t), p);
+        }
+    }
+
+    v8::math::animation_clip clip;
+    clip.build(&rotations[0], &translations[0], kTrackCount, kFrameCount, 
+               kSampleRate);
+    const size_t raw_bytes = 
+        rotations.size() * sizeof(quaternionF) + translations.size() * sizeof(vector3F);
+    std::printf("animation_clip %u tracks : %u of %u keys, %u of %u bytes\n",
+                static_cast<unsigned>(kTrackCount),
+                static_cast<unsigned>(clip.total_key_count()),
+                static_cast<unsigned>(rotations.size()),
+                static_cast<unsigned>(clip.size_in_bytes()),
+                static_cast<unsigned>(raw_bytes));
+
+    std::vector<v8::math::animation_sampler> samplers(kSamplerCount);
+    std::vector<float> times(kSamplerCount);
+    for (size_t i = 0; i < kSamplerCount; ++i) {
+        samplers[i].set_clip(&clip);
+        times[i] = 0.5f * (unit(gen) + 1.0f) * clip.duration();
+    }
+
+    //
+    // Reference : nlerp/lerp of the uncompressed frames.
+    std::vector<quaternionF> raw_rotations(kTrackCount);
+    std::vector<vector3F> raw_translations(kTrackCount);
+    const double raw_ms = measure_ms([&]() {
+        for (size_t i = 0; i < kSamplerCount; ++i) {
+            const float frame = std::min(times[i] * kSampleRate, 
+                                         static_cast<float>(kFrameCount - 1));
+            const size_t f0 = std::min(static_cast<size_t>(frame), kFrameCount - 2);
+            const float alpha = frame - f0;
+            const quaternionF* r = &rotations[f0 * kTrackCount];
+            const vector3F* p = &translations[f0 * kTrackCount];
+            for (size_t track = 0; track < kTrackCount; ++track) {
+                raw_rotations[track] = v8::math::nlerp(
+                    r[track], r[track + kTrackCount], alpha);
+                raw_translations[track] = p[track] 
+                    + (p[track + kTrackCount] - p[track]) * alpha;
+            }
+        }
+    });
+    report("raw frames nlerp 2000 x 64 tracks", raw_ms, kSamplerCount * kTrackCount);
+
+    const unsigned int hw_threads = v8::base::effective_thread_count(0);
+    for (unsigned int threads = 1; ; threads *= 2) {
+        if (threads > hw_threads)
+            threads = hw_threads;
+
+        const double ms = measure_ms([&]() {
+            for (size_t i = 0; i < kSamplerCount; ++i) {
+                times[i] += 1.0f / 60.0f;
+                if (times[i] > clip.duration())
+                    times[i] = 0.0f;
+            }
+            v8::math::sample_animations(&samplers[0], &times[0], 
+                                        kSamplerCount, threads);
+        });
+
+        char name[64];
+        v8::base::snprintf(name, sizeof(name), 
+                           "sample_animations 2000 x 64 tracks, %u threads",
+                           threads);
+        report(name, ms, kSamplerCount * kTrackCount);
+
+        if (threads == hw_threads)
+            break;
+    }
+}
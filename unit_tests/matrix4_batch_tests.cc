@@ -0,0 +1,301 @@
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/matrix4X4.h"
+#include "v8/math/matrix4X4_batch.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector4.h"
+#include "test_helpers.h"
+
+using v8::math::matrix_4X4F;
+using v8::math::vector3F;
+using v8::math::vector4F;
+using test_helpers::expect_near;
+using test_helpers::random_vectors;
+
+namespace {
+
+const matrix_4X4F kTestMatrix(
+    0.5f, -1.0f, 2.0f, 3.0f,
+    1.5f, 0.25f, -0.75f, -2.0f,
+    -1.0f, 2.5f, 1.0f, 4.0f,
+    0.1f, 0.2f, -0.3f, 1.0f);
+
+//
+// The AVX2 kernels use FMA, so the results can differ slightly from the
+// scalar ones.
+const float kBatchTolerance = 1.0e-4f;
+
+struct test_vertex {
+    float   position[3];
+    float   normal[3];
+    float   texcoord[2];
+};
+
+} // anonymous namespace
+
+TEST(matrix4_batch_tests, affine_points_and_vectors) {
+    const matrix_4X4F mtx(kTestMatrix);
+    //
+    // 23 is not a multiple of 4 or 8, so the scalar tail gets exercised too.
+    for (size_t count = 0; count < 23; ++count) {
+        const std::vector<vector3F> input(random_vectors(count, 7));
+        std::vector<vector3F> points(count);
+        std::vector<vector3F> vectors(count);
+
+        v8::math::transform_affine_points(
+            mtx, input.data(), points.data(), count);
+        v8::math::transform_affine_vectors(
+            mtx, input.data(), vectors.data(), count);
+
+        for (size_t i = 0; i < count; ++i) {
+            vector3F pt(input[i]);
+            mtx.transform_affine_point(&pt);
+            expect_near(pt, points[i], kBatchTolerance);
+
+            vector3F vec(input[i]);
+            mtx.transform_affine_vector(&vec);
+            expect_near(vec, vectors[i], kBatchTolerance);
+        }
+    }
+}
+
+TEST(matrix4_batch_tests, affine_points_in_place) {
+    const matrix_4X4F mtx(kTestMatrix);
+    const size_t kCount = 37;
+    const std::vector<vector3F> input(random_vectors(kCount, 11));
+
+    std::vector<vector3F> points(input);
+    v8::math::transform_affine_points(mtx, points.data(), kCount);
+    std::vector<vector3F> vectors(input);
+    v8::math::transform_affine_vectors(mtx, vectors.data(), kCount);
+
+    for (size_t i = 0; i < kCount; ++i) {
+        vector3F pt(input[i]);
+        mtx.transform_affine_point(&pt);
+        expect_near(pt, points[i], kBatchTolerance);
+
+        vector3F vec(input[i]);
+        mtx.transform_affine_vector(&vec);
+        expect_near(vec, vectors[i], kBatchTolerance);
+    }
+}
+
+TEST(matrix4_batch_tests, homogeneous_points) {
+    const matrix_4X4F mtx(kTestMatrix);
+    const size_t kCount = 19;
+    const std::vector<vector3F> src(random_vectors(kCount, 3));
+
+    std::vector<vector4F> input(kCount);
+    for (size_t i = 0; i < kCount; ++i)
+        input[i] = vector4F(src[i].x_, src[i].y_, src[i].z_,
+                            static_cast<float>(i % 3));
+
+    std::vector<vector4F> output(kCount);
+    v8::math::transform_homogeneous_points(
+        mtx, input.data(), output.data(), kCount);
+    v8::math::transform_homogeneous_points(mtx, input.data(), kCount);
+
+    for (size_t i = 0; i < kCount; ++i) {
+        vector4F expected(src[i].x_, src[i].y_, src[i].z_,
+                          static_cast<float>(i % 3));
+        mtx.transform_homogeneous_point(&expected);
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_NEAR(expected.elements_[j], output[i].elements_[j],
+                        kBatchTolerance);
+            EXPECT_NEAR(expected.elements_[j], input[i].elements_[j],
+                        kBatchTolerance);
+        }
+    }
+}
+
+TEST(matrix4_batch_tests, strided_vertices) {
+    const matrix_4X4F mtx(kTestMatrix);
+    const size_t kCount = 21;
+    const std::vector<vector3F> pos(random_vectors(kCount, 5));
+    const std::vector<vector3F> nrm(random_vectors(kCount, 6));
+
+    std::vector<test_vertex> vertices(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            vertices[i].position[j] = pos[i].elements_[j];
+            vertices[i].normal[j] = nrm[i].elements_[j];
+        }
+        vertices[i].texcoord[0] = vertices[i].texcoord[1] = -1.0f;
+    }
+
+    v8::math::transform_affine_points_strided<float>(
+        mtx, vertices[0].position, sizeof(test_vertex),
+        vertices[0].position, sizeof(test_vertex), kCount);
+    v8::math::transform_affine_vectors_strided<float>(
+        mtx, vertices[0].normal, sizeof(test_vertex),
+        vertices[0].normal, sizeof(test_vertex), kCount);
+
+    for (size_t i = 0; i < kCount; ++i) {
+        vector3F pt(pos[i]);
+        mtx.transform_affine_point(&pt);
+        expect_near(pt, vector3F(vertices[i].position[0],
+                                 vertices[i].position[1],
+                                 vertices[i].position[2]), kBatchTolerance);
+
+        vector3F vec(nrm[i]);
+        mtx.transform_affine_vector(&vec);
+        expect_near(vec, vector3F(vertices[i].normal[0],
+                                  vertices[i].normal[1],
+                                  vertices[i].normal[2]), kBatchTolerance);
+
+        EXPECT_EQ(-1.0f, vertices[i].texcoord[0]);
+        EXPECT_EQ(-1.0f, vertices[i].texcoord[1]);
+    }
+}
+
+TEST(matrix4_batch_tests, soa_points_and_vectors) {
+    const matrix_4X4F mtx(kTestMatrix);
+    const size_t kCount = 29;
+    const std::vector<vector3F> input(random_vectors(kCount, 13));
+
+    std::vector<float> x(kCount), y(kCount), z(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        x[i] = input[i].x_;
+        y[i] = input[i].y_;
+        z[i] = input[i].z_;
+    }
+
+    std::vector<float> vx(kCount), vy(kCount), vz(kCount);
+    v8::math::transform_affine_vectors_soa(
+        mtx, x.data(), y.data(), z.data(),
+        vx.data(), vy.data(), vz.data(), kCount);
+    v8::math::transform_affine_points_soa(
+        mtx, x.data(), y.data(), z.data(),
+        x.data(), y.data(), z.data(), kCount);
+
+    for (size_t i = 0; i < kCount; ++i) {
+        vector3F pt(input[i]);
+        mtx.transform_affine_point(&pt);
+        expect_near(pt, vector3F(x[i], y[i], z[i]), kBatchTolerance);
+
+        vector3F vec(input[i]);
+        mtx.transform_affine_vector(&vec);
+        expect_near(vec, vector3F(vx[i], vy[i], vz[i]), kBatchTolerance);
+    }
+}
+
+TEST(matrix4_batch_tests, multithreaded) {
+    const matrix_4X4F mtx(kTestMatrix);
+    const size_t kCount = v8::math::kBatchTransformGrainSize * 5 + 3;
+    const std::vector<vector3F> input(random_vectors(kCount, 17));
+
+    std::vector<vector3F> single(kCount);
+    std::vector<vector3F> multi(kCount);
+    v8::math::transform_affine_points(
+        mtx, input.data(), single.data(), kCount, 1);
+    v8::math::transform_affine_points(
+        mtx, input.data(), multi.data(), kCount, 0);
+
+    for (size_t i = 0; i < kCount; ++i)
+        expect_near(single[i], multi[i], kBatchTolerance);
+}
+
+TEST(matrix4_batch_tests, invert_matrices) {
+    const size_t kCount = 9;
+    std::vector<matrix_4X4F> input(kCount);
+    std::vector<matrix_4X4F> affine(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        const float k = static_cast<float>(i + 1);
+        input[i] = matrix_4X4F(2.0f * k, 3.0f, 1.0f, 5.0f,
+                               1.0f, 7.0f, 3.0f * k, 1.0f,
+                               4.0f, 2.0f, -3.0f, 2.0f,
+                               3.0f, 2.0f, 5.0f, k);
+        affine[i] = matrix_4X4F(k, 1.0f, 0.0f, -k,
+                                0.0f, 2.0f, 1.0f, 3.0f,
+                                1.0f, 0.0f, 3.0f, 2.0f * k,
+                                0.0f, 0.0f, 0.0f, 1.0f);
+    }
+
+    std::vector<matrix_4X4F> inverses(kCount);
+    v8::math::invert_matrices(input.data(), inverses.data(), kCount);
+    std::vector<matrix_4X4F> affine_inverses(affine);
+    v8::math::invert_affine_matrices(
+        affine_inverses.data(), affine_inverses.data(), kCount, 0);
+
+    for (size_t i = 0; i < kCount; ++i) {
+        matrix_4X4F expected;
+        input[i].get_inverse(&expected);
+        matrix_4X4F expected_affine;
+        affine[i].get_inverse_affine(&expected_affine);
+
+        for (int j = 0; j < 16; ++j) {
+            EXPECT_EQ(expected.elements_[j], inverses[i].elements_[j]);
+            EXPECT_EQ(expected_affine.elements_[j], 
+                      affine_inverses[i].elements_[j]);
+        }
+    }
+}
+
+TEST(matrix4_batch_tests, kernel_tiers) {
+    using namespace v8::math::internals;
+
+    const matrix_4X4F mtx(kTestMatrix);
+    const size_t kCount = 35;
+    const std::vector<vector3F> input(random_vectors(kCount, 19));
+
+    std::vector<vector4F> input4(kCount);
+    for (size_t i = 0; i < kCount; ++i)
+        input4[i] = vector4F(input[i].x_, input[i].y_, input[i].z_, 0.5f);
+
+    std::vector<vector3F> expected_points(kCount);
+    std::vector<vector3F> expected_vectors(kCount);
+    std::vector<vector4F> expected_hpoints(kCount);
+    typedef batch_transform_scalar_kernels<float> scalar_kernels_t;
+    scalar_kernels_t::affine_aos<true>(
+        mtx, input.data(), expected_points.data(), kCount);
+    scalar_kernels_t::affine_aos<false>(
+        mtx, input.data(), expected_vectors.data(), kCount);
+    scalar_kernels_t::homogeneous_aos(
+        mtx, input4.data(), expected_hpoints.data(), kCount);
+
+    const v8::base::simd_tier host_tier = v8::base::host_simd_tier();
+    for (int t = v8::base::simd_tier_scalar; t <= host_tier; ++t) {
+        const batch_transform_kernel_table& table = 
+            batch_transform_kernels_for_tier(static_cast<v8::base::simd_tier>(t));
+        EXPECT_LE(table.tier, t);
+
+        std::vector<vector3F> points(kCount);
+        std::vector<vector3F> vectors(kCount);
+        std::vector<vector4F> hpoints(kCount);
+        table.affine_points_aos(mtx, input.data(), points.data(), kCount);
+        table.affine_vectors_aos(mtx, input.data(), vectors.data(), kCount);
+        table.homogeneous_aos(mtx, input4.data(), hpoints.data(), kCount);
+
+        std::vector<float> x(kCount), y(kCount), z(kCount);
+        for (size_t i = 0; i < kCount; ++i) {
+            x[i] = input[i].x_;
+            y[i] = input[i].y_;
+            z[i] = input[i].z_;
+        }
+        table.affine_points_soa(mtx, x.data(), y.data(), z.data(),
+                                x.data(), y.data(), z.data(), kCount);
+
+        for (size_t i = 0; i < kCount; ++i) {
+            expect_near(expected_points[i], points[i], kBatchTolerance);
+            expect_near(expected_vectors[i], vectors[i], kBatchTolerance);
+            expect_near(expected_points[i], vector3F(x[i], y[i], z[i]),
+                        kBatchTolerance);
+            for (int j = 0; j < 4; ++j)
+                EXPECT_NEAR(expected_hpoints[i].elements_[j], 
+                            hpoints[i].elements_[j], kBatchTolerance);
+        }
+    }
+}
+
+TEST(matrix4_batch_tests, parallel_for_covers_range) {
+    const size_t kCount = 1000;
+    std::vector<int> visited(kCount, 0);
+    v8::base::parallel_for(kCount, 64, 4, [&visited](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i)
+            ++visited[i];
+    });
+
+    for (size_t i = 0; i < kCount; ++i)
+        EXPECT_EQ(1, visited[i]);
+}
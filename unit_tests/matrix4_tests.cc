@@ -7,6 +7,7 @@
 typedef v8::math::matrix_3X3<int> matrix_3X3I;
 typedef v8::math::matrix_4X4<int> matrix_4X4I;
 typedef v8::math::vector4<int> vector4I;
+using v8::math::matrix_4X4F;
 
 template<typename OutputIter, typename real_t>
 void
@@ -89,6 +90,28 @@ TEST(matrix4tests, multiplication) {
     EXPECT_EQ(multMatrix, firstMtx * secondMtx);
 }
 
+TEST(matrix4tests, multiplication_float) {
+    const matrix_4X4F lhs(0.25f, -1.5f, 3.125f, 7.0f,
+                          -2.0f, 0.1f, 0.3f, -4.75f,
+                          9.5f, 1.0f / 3.0f, -0.7f, 2.0f,
+                          0.0f, 0.0f, 0.0f, 1.0f);
+    const matrix_4X4F rhs(1.1f, 2.2f, -3.3f, 0.4f,
+                          -0.5f, 6.6f, 0.07f, 8.0f,
+                          0.9f, -1.0f, 1.0f / 7.0f, 1.2f,
+                          13.0f, 0.0f, -0.25f, 1.0f);
+
+    matrix_4X4F expected;
+    v8::math::internals::matrix4X4_multiply(lhs, rhs, &expected);
+    const matrix_4X4F result = lhs * rhs;
+
+    for (int i = 0; i < 16; ++i)
+        EXPECT_FLOAT_EQ(expected.elements_[i], result.elements_[i]);
+
+    matrix_4X4F in_place(lhs);
+    in_place = in_place * rhs;
+    EXPECT_EQ(expected, in_place);
+}
+
 TEST(matrix4tests, scalar_mul_divide) {
     int initVal[16];
     gen_arithmetic_progression(initVal, 16, 1, 0);
@@ -129,6 +152,68 @@ TEST(matrix4tests, determinant) {
     EXPECT_TRUE(m1.is_invertible());
 }
 
+TEST(matrix4tests, determinant_non_symmetric) {
+    matrix_4X4I m1(2, 3, 1, 5,
+                   1, 7, 3, 1,
+                   4, 2, -3, 2,
+                   3, 2, 5, 1);
+
+    EXPECT_EQ(715, m1.determinant());
+}
+
+TEST(matrix4tests, inverse) {
+    const matrix_4X4F mtx(2.0f, 3.0f, 1.0f, 5.0f,
+                          1.0f, 7.0f, 3.0f, 1.0f,
+                          4.0f, 2.0f, -3.0f, 2.0f,
+                          3.0f, 2.0f, 5.0f, 1.0f);
+
+    matrix_4X4F generic;
+    v8::math::internals::matrix4X4_inverse(mtx, &generic);
+    matrix_4X4F inverse;
+    mtx.get_inverse(&inverse);
+
+    matrix_4X4F inverted(mtx);
+    inverted.invert();
+
+    const matrix_4X4F product(mtx * inverse);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_NEAR(i == j ? 1.0f : 0.0f, product(i + 1, j + 1), 1.0e-5f);
+            EXPECT_NEAR(generic(i + 1, j + 1), inverse(i + 1, j + 1), 1.0e-6f);
+            EXPECT_FLOAT_EQ(inverse(i + 1, j + 1), inverted(i + 1, j + 1));
+        }
+    }
+}
+
+TEST(matrix4tests, inverse_affine) {
+    //
+    // Rotation around the y axis, non uniform scale and translation.
+    const float kSin = 0.6f;
+    const float kCos = 0.8f;
+    const matrix_4X4F mtx(2.0f * kCos, 0.0f, 3.0f * kSin, 4.0f,
+                          0.0f, 0.5f, 0.0f, -2.0f,
+                          -2.0f * kSin, 0.0f, 3.0f * kCos, 7.0f,
+                          0.0f, 0.0f, 0.0f, 1.0f);
+
+    matrix_4X4F expected;
+    v8::math::internals::matrix4X4_inverse(mtx, &expected);
+
+    matrix_4X4F affine_inverse;
+    mtx.get_inverse_affine(&affine_inverse);
+
+    matrix_4X4F inverted(mtx);
+    inverted.invert_affine();
+
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_NEAR(expected(i + 1, j + 1), affine_inverse(i + 1, j + 1),
+                        1.0e-5f);
+            EXPECT_FLOAT_EQ(affine_inverse(i + 1, j + 1),
+                            inverted(i + 1, j + 1));
+        }
+    }
+}
+
 TEST(matrix4tests, adjoint) {
     matrix_4X4I mtx(10, 9, 2, 15,
                     8, 6, 9, 4, 
@@ -0,0 +1,280 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/aabb.h"
+#include "v8/math/aabb_soa.h"
+#include "v8/math/camera.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/occlusion_buffer.h"
+#include "v8/math/vector3.h"
+#include "test_helpers.h"
+
+using v8::math::aabbF;
+using v8::math::camera;
+using v8::math::matrix_4X4F;
+using v8::math::occlusion_buffer;
+using v8::math::vector3F;
+using test_helpers::make_test_camera;
+
+namespace {
+
+const size_t kWidth = 256;
+const size_t kHeight = 128;
+
+//
+// A 6x6 quad, facing the camera, at z = 10.
+const vector3F kQuad[] = {
+    vector3F(-3.0f, -3.0f, 10.0f), vector3F(3.0f, -3.0f, 10.0f),
+    vector3F(3.0f, 3.0f, 10.0f), vector3F(-3.0f, 3.0f, 10.0f)
+};
+const uint32_t kQuadIndices[] = { 0, 1, 2, 0, 2, 3 };
+
+struct screen_vertex {
+    double x;
+    double y;
+    double z;
+};
+
+screen_vertex
+project(const matrix_4X4F& pv, const vector3F& p) {
+    const double cx = pv.a11_ * p.x_ + pv.a12_ * p.y_ + pv.a13_ * p.z_ + pv.a14_;
+    const double cy = pv.a21_ * p.x_ + pv.a22_ * p.y_ + pv.a23_ * p.z_ + pv.a24_;
+    const double cz = pv.a31_ * p.x_ + pv.a32_ * p.y_ + pv.a33_ * p.z_ + pv.a34_;
+    const double cw = pv.a41_ * p.x_ + pv.a42_ * p.y_ + pv.a43_ * p.z_ + pv.a44_;
+    const screen_vertex v = { 
+        (cx / cw + 1.0) * 0.5 * kWidth, (1.0 - cy / cw) * 0.5 * kHeight, cz / cw 
+    };
+    return v;
+}
+
+} // anonymous namespace
+
+TEST(occlusion_buffer_tests, occludees) {
+    occlusion_buffer buffer(kWidth, kHeight, 1);
+    ASSERT_EQ(9u, buffer.mip_count());
+    EXPECT_EQ(1u, buffer.mip_width(8));
+    EXPECT_EQ(1u, buffer.mip_height(8));
+
+    const camera cam(make_test_camera(60.0f, 2.0f, 1.0f, 100.0f, vector3F::zero,
+                                      vector3F(0.0f, 0.0f, 1.0f)));
+    buffer.begin_frame(cam);
+    buffer.render();
+    const aabbF behind(vector3F(-1.0f, -1.0f, 20.0f), vector3F(1.0f, 1.0f, 22.0f));
+    EXPECT_FALSE(buffer.is_occluded(behind));
+
+    buffer.begin_frame(cam);
+    buffer.add_occluder(matrix_4X4F::identity, kQuad, 4, kQuadIndices, 6);
+    buffer.render();
+    EXPECT_EQ(2u, buffer.triangle_count());
+
+    EXPECT_TRUE(buffer.is_occluded(behind));
+    EXPECT_TRUE(buffer.is_occluded(
+        aabbF(vector3F(-4.0f, -4.0f, 50.0f), vector3F(4.0f, 4.0f, 60.0f))));
+    EXPECT_FALSE(buffer.is_occluded(
+        aabbF(vector3F(-1.0f, -1.0f, 5.0f), vector3F(1.0f, 1.0f, 6.0f))));
+    EXPECT_FALSE(buffer.is_occluded(
+        aabbF(vector3F(-1.0f, -1.0f, 8.0f), vector3F(1.0f, 1.0f, 12.0f))));
+    EXPECT_FALSE(buffer.is_occluded(
+        aabbF(vector3F(-10.0f, -1.0f, 20.0f), vector3F(10.0f, 1.0f, 22.0f))));
+    EXPECT_FALSE(buffer.is_occluded(
+        aabbF(vector3F(-1.0f, -1.0f, -5.0f), vector3F(1.0f, 1.0f, 20.0f))));
+    EXPECT_FALSE(buffer.is_occluded(
+        aabbF(vector3F(100.0f, -1.0f, 20.0f), vector3F(101.0f, 1.0f, 22.0f))));
+
+    //
+    // Moving the occluder with its world matrix.
+    matrix_4X4F world(matrix_4X4F::identity);
+    world.a14_ = 20.0f;
+    buffer.begin_frame(cam);
+    buffer.add_occluder(world, kQuad, 4, kQuadIndices, 6);
+    buffer.render();
+    EXPECT_FALSE(buffer.is_occluded(behind));
+}
+
+TEST(occlusion_buffer_tests, rasterization_matches_reference) {
+    const camera cam(make_test_camera(60.0f, 2.0f, 1.0f, 100.0f, vector3F::zero,
+                                      vector3F(0.0f, 0.0f, 1.0f)));
+    const matrix_4X4F& pv = cam.get_projection_wiew_transform();
+
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<float> xy(-12.0f, 12.0f);
+    std::uniform_real_distribution<float> depth(3.0f, 60.0f);
+    std::uniform_real_distribution<float> offset(-4.0f, 4.0f);
+    const size_t kTriangleCount = 300;
+    std::vector<vector3F> vertices;
+    std::vector<uint32_t> indices;
+    for (size_t i = 0; i < kTriangleCount; ++i) {
+        const vector3F c(xy(gen), xy(gen), depth(gen));
+        for (int k = 0; k < 3; ++k) {
+            indices.push_back(static_cast<uint32_t>(vertices.size()));
+            vertices.push_back(c + vector3F(offset(gen), offset(gen), offset(gen)));
+        }
+    }
+
+    occlusion_buffer buffer(kWidth, kHeight, 1);
+    buffer.begin_frame(cam);
+    buffer.add_occluder(matrix_4X4F::identity, &vertices[0], vertices.size(),
+                        &indices[0], indices.size());
+    buffer.render();
+    EXPECT_GE(kTriangleCount, buffer.triangle_count());
+    EXPECT_LT(kTriangleCount / 2, buffer.triangle_count());
+
+    std::vector<screen_vertex> screen(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i)
+        screen[i] = project(pv, vertices[i]);
+
+    size_t checked = 0;
+    size_t covered = 0;
+    const float* result = buffer.mip_data(0);
+    for (size_t y = 0; y < kHeight; ++y) {
+        for (size_t x = 0; x < kWidth; ++x) {
+            const double px = x + 0.5;
+            const double py = y + 0.5;
+            double expected = 1.0;
+            bool ambiguous = false;
+
+            for (size_t t = 0; t < kTriangleCount; ++t) {
+                const screen_vertex& a = screen[3 * t];
+                const screen_vertex& b = screen[3 * t + 1];
+                const screen_vertex& c = screen[3 * t + 2];
+                const double area = (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+                const double l0 = ((b.x - px) * (c.y - py) - (c.x - px) * (b.y - py)) / area;
+                const double l1 = ((c.x - px) * (a.y - py) - (a.x - px) * (c.y - py)) / area;
+                const double l2 = 1.0 - l0 - l1;
+                const double margin = 1.0e-3;
+                if (l0 < -margin || l1 < -margin || l2 < -margin)
+                    continue;
+                if (l0 < margin || l1 < margin || l2 < margin) {
+                    ambiguous = true;
+                    break;
+                }
+                expected = std::min(expected, l0 * a.z + l1 * b.z + l2 * c.z);
+            }
+
+            if (ambiguous)
+                continue;
+            ASSERT_NEAR(expected, result[y * kWidth + x], 1.0e-4) 
+                << x << ", " << y;
+            ++checked;
+            covered += expected < 1.0;
+        }
+    }
+    EXPECT_LT(kWidth * kHeight * 9 / 10, checked);
+    EXPECT_LT(kWidth * kHeight / 4, covered);
+
+    //
+    // Every texel of a mip holds the farthest depth of the texels under it.
+    for (size_t level = 1; level < buffer.mip_count(); ++level) {
+        const float* src = buffer.mip_data(level - 1);
+        const float* dst = buffer.mip_data(level);
+        const size_t sw = buffer.mip_width(level - 1);
+        const size_t sh = buffer.mip_height(level - 1);
+        for (size_t y = 0; y < buffer.mip_height(level); ++y) {
+            for (size_t x = 0; x < buffer.mip_width(level); ++x) {
+                float farthest = 0.0f;
+                for (size_t j = 2 * y; j < std::min(2 * y + 2, sh); ++j) {
+                    for (size_t i = 2 * x; i < std::min(2 * x + 2, sw); ++i)
+                        farthest = std::max(farthest, src[j * sw + i]);
+                }
+                ASSERT_EQ(farthest, dst[y * buffer.mip_width(level) + x]);
+            }
+        }
+    }
+}
+
+TEST(occlusion_buffer_tests, near_plane_clipping) {
+    const camera cam(make_test_camera(60.0f, 2.0f, 1.0f, 100.0f, vector3F::zero,
+                                      vector3F(0.0f, 0.0f, 1.0f)));
+
+    //
+    // A floor that starts behind the camera.
+    const vector3F floor[] = {
+        vector3F(-50.0f, -2.0f, -10.0f), vector3F(50.0f, -2.0f, -10.0f),
+        vector3F(50.0f, -2.0f, 90.0f), vector3F(-50.0f, -2.0f, 90.0f)
+    };
+
+    occlusion_buffer buffer(kWidth, kHeight, 1);
+    buffer.begin_frame(cam);
+    buffer.add_occluder(matrix_4X4F::identity, floor, 4, kQuadIndices, 6);
+    buffer.render();
+
+    const float* depth = buffer.mip_data(0);
+    size_t covered = 0;
+    for (size_t i = 0; i < kWidth * kHeight; ++i) {
+        ASSERT_LE(0.0f, depth[i]);
+        ASSERT_GE(1.0f, depth[i]);
+        covered += depth[i] < 1.0f;
+    }
+
+    //
+    // The bottom half of the screen sees the floor, the top half doesn't.
+    EXPECT_LT(kWidth * kHeight / 3, covered);
+    EXPECT_GT(kWidth * kHeight / 2, covered);
+    EXPECT_EQ(1.0f, depth[0]);
+    EXPECT_GT(1.0f, depth[(kHeight - 1) * kWidth]);
+
+    EXPECT_TRUE(buffer.is_occluded(
+        aabbF(vector3F(-1.0f, -8.0f, 20.0f), vector3F(1.0f, -5.0f, 22.0f))));
+    EXPECT_FALSE(buffer.is_occluded(
+        aabbF(vector3F(-1.0f, -1.0f, 20.0f), vector3F(1.0f, 1.0f, 22.0f))));
+}
+
+TEST(occlusion_buffer_tests, threads_and_batch_test) {
+    const camera cam(make_test_camera(60.0f, 2.0f, 1.0f, 100.0f, vector3F::zero,
+                                      vector3F(0.0f, 0.0f, 1.0f)));
+    std::mt19937 gen(23);
+    std::uniform_real_distribution<float> xy(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> depth(5.0f, 40.0f);
+
+    std::vector<vector3F> vertices;
+    std::vector<uint32_t> indices;
+    for (size_t i = 0; i < 2000; ++i) {
+        const vector3F c(xy(gen), xy(gen), depth(gen));
+        const uint32_t base = static_cast<uint32_t>(vertices.size());
+        for (size_t k = 0; k < 4; ++k)
+            vertices.push_back(c + 0.5f * kQuad[k] - vector3F(0.0f, 0.0f, 5.0f));
+        for (size_t k = 0; k < 6; ++k)
+            indices.push_back(base + kQuadIndices[k]);
+    }
+
+    std::vector<aabbF> boxes;
+    for (size_t i = 0; i < 5001; ++i) {
+        const vector3F c(xy(gen), xy(gen), 2.0f * depth(gen));
+        boxes.push_back(aabbF(c - vector3F(0.5f, 0.5f, 0.5f), 
+                              c + vector3F(0.5f, 0.5f, 0.5f)));
+    }
+    const v8::math::aabb_soaF soa(&boxes[0], boxes.size());
+
+    occlusion_buffer single(kWidth, kHeight, 1);
+    single.begin_frame(cam);
+    single.add_occluder(matrix_4X4F::identity, &vertices[0], vertices.size(),
+                        &indices[0], indices.size());
+    single.render();
+
+    occlusion_buffer multi(kWidth, kHeight, 4);
+    multi.begin_frame(cam);
+    for (size_t i = 0; i < indices.size(); i += 600) {
+        multi.add_occluder(matrix_4X4F::identity, &vertices[0], vertices.size(),
+                           &indices[i], std::min<size_t>(600, indices.size() - i));
+    }
+    multi.render();
+
+    EXPECT_EQ(single.triangle_count(), multi.triangle_count());
+    for (size_t level = 0; level < single.mip_count(); ++level) {
+        const size_t count = single.mip_width(level) * single.mip_height(level);
+        for (size_t i = 0; i < count; ++i)
+            ASSERT_EQ(single.mip_data(level)[i], multi.mip_data(level)[i]);
+    }
+
+    std::vector<uint8_t> result(boxes.size(), 0xFF);
+    multi.occluded_aabbs(soa, &result[0]);
+    size_t occluded = 0;
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        ASSERT_EQ(single.is_occluded(boxes[i]), result[i] != 0) << i;
+        occluded += result[i];
+    }
+    EXPECT_LT(0u, occluded);
+    EXPECT_GT(boxes.size(), occluded);
+}
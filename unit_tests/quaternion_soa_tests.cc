@@ -0,0 +1,109 @@
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/quaternion.h"
+#include "v8/math/quaternion_soa.h"
+#include "v8/math/vector3.h"
+#include "test_helpers.h"
+
+using v8::math::quaternionF;
+using v8::math::quaternion_soaF;
+using v8::math::vector3F;
+using test_helpers::random_rotations;
+
+namespace {
+
+//
+// Largest component error of slerp_fast() compared to slerp().
+const float kSlerpFastTolerance = 5.0e-4f;
+
+//
+// q and -q are the same rotation.
+void
+expect_same_rotation(const quaternionF& expected, const quaternionF& actual, 
+                     float tolerance) {
+    const float sign = 
+        v8::math::dot_product(expected, actual) < 0.0f ? -1.0f : 1.0f;
+    for (size_t i = 0; i < 4; ++i)
+        EXPECT_NEAR(expected.elements_[i], sign * actual.elements_[i], tolerance);
+    EXPECT_NEAR(1.0f, actual.magnitude(), 1.0e-5f);
+}
+
+} // anonymous namespace
+
+TEST(quaternion_soa_tests, storage) {
+    quaternion_soaF stream(13);
+    EXPECT_EQ(13u, stream.size());
+    EXPECT_EQ(0u, stream.capacity() % quaternion_soaF::kElementsPerBlock);
+    for (size_t c = 0; c < 4; ++c) {
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(stream.components()[c]) % 
+                      quaternion_soaF::kAlignment);
+    }
+
+    for (size_t i = 0; i < stream.size(); ++i)
+        EXPECT_TRUE(quaternionF::identity == stream.get(i));
+
+    const quaternionF q(0.5f, 0.5f, 0.5f, 0.5f);
+    stream.set(7, q);
+    stream.resize(50);
+    EXPECT_TRUE(q == stream.get(7));
+    EXPECT_TRUE(quaternionF::identity == stream.get(49));
+
+    const std::vector<quaternionF> src(random_rotations(21, 1));
+    quaternion_soaF copy(src.data(), src.size());
+    std::vector<quaternionF> dst(src.size());
+    copy.copy_to(dst.data());
+    for (size_t i = 0; i < src.size(); ++i)
+        EXPECT_TRUE(src[i] == dst[i]);
+}
+
+TEST(quaternion_soa_tests, normalize) {
+    std::vector<quaternionF> src(random_rotations(19, 2));
+    for (size_t i = 0; i < src.size(); ++i)
+        src[i] *= static_cast<float>(i + 1);
+
+    quaternion_soaF stream(src.data(), src.size());
+    stream.normalize();
+    for (size_t i = 0; i < src.size(); ++i)
+        expect_same_rotation(v8::math::normal_of(src[i]), stream.get(i), 1.0e-5f);
+}
+
+TEST(quaternion_soa_tests, interpolation) {
+    const size_t kCount = 1027;
+    const std::vector<quaternionF> a(random_rotations(kCount, 3));
+    const std::vector<quaternionF> b(random_rotations(kCount, 4));
+    const quaternion_soaF sa(a.data(), kCount);
+    const quaternion_soaF sb(b.data(), kCount);
+
+    const float t_values[] = { 0.0f, 0.1f, 0.5f, 0.77f, 1.0f };
+    for (size_t k = 0; k < 5; ++k) {
+        const float t = t_values[k];
+        quaternion_soaF out_nlerp, out_slerp, out_fast;
+        v8::math::nlerp(sa, sb, t, &out_nlerp);
+        v8::math::slerp(sa, sb, t, &out_slerp);
+        v8::math::slerp_fast(sa, sb, t, &out_fast, 0);
+
+        ASSERT_EQ(kCount, out_slerp.size());
+        for (size_t i = 0; i < kCount; ++i) {
+            const quaternionF expected = v8::math::slerp(a[i], b[i], t);
+            expect_same_rotation(v8::math::nlerp(a[i], b[i], t), 
+                                 out_nlerp.get(i), 1.0e-5f);
+            expect_same_rotation(expected, out_slerp.get(i), 1.0e-5f);
+            expect_same_rotation(expected, out_fast.get(i), kSlerpFastTolerance);
+        }
+    }
+}
+
+TEST(quaternion_soa_tests, in_place) {
+    const size_t kCount = 30;
+    const std::vector<quaternionF> a(random_rotations(kCount, 5));
+    const std::vector<quaternionF> b(random_rotations(kCount, 6));
+    quaternion_soaF sa(a.data(), kCount);
+    const quaternion_soaF sb(b.data(), kCount);
+
+    v8::math::slerp_fast(sa, sb, 0.25f, &sa);
+    for (size_t i = 0; i < kCount; ++i)
+        expect_same_rotation(v8::math::slerp(a[i], b[i], 0.25f), sa.get(i),
+                             kSlerpFastTolerance);
+}
@@ -27,4 +27,34 @@ TEST(quaternion_tests, constructors) {
     EXPECT_NEAR(0.077164f, q2.x_, Epsilon_Value);
     EXPECT_NEAR(0.192912f, q2.y_, Epsilon_Value);
     EXPECT_NEAR(0.154329f, q2.z_, Epsilon_Value);
-}
\ No newline at end of file
+}
+
+TEST(quaternion_tests, interpolation) {
+    const vector3F axis(0.0f, 0.0f, 1.0f);
+    const quaternionF q0(0.0f, axis);
+    const quaternionF q1(to_radians(90.0f), axis);
+    const quaternionF expected(to_radians(30.0f), axis);
+
+    const quaternionF qs = slerp(q0, q1, 1.0f / 3.0f);
+    const quaternionF qf = slerp_fast(q0, q1, 1.0f / 3.0f);
+    for (uint32_t i = 0; i < 4; ++i) {
+        EXPECT_NEAR(expected.elements_[i], qs.elements_[i], Epsilon_Value);
+        EXPECT_NEAR(expected.elements_[i], qf.elements_[i], Epsilon_Value);
+    }
+
+    //
+    // nlerp follows the same arc, but not at a constant rate.
+    const quaternionF qn = nlerp(q0, q1, 1.0f / 3.0f);
+    EXPECT_NEAR(1.0f, qn.magnitude(), Epsilon_Value);
+    EXPECT_GT(std::abs(expected.z_ - qn.z_), Epsilon_Value);
+
+    //
+    // -q1 is the same rotation, the result must not take the long way.
+    const quaternionF qneg = slerp(q0, -q1, 0.5f);
+    const quaternionF half(to_radians(45.0f), axis);
+    EXPECT_NEAR(1.0f, std::abs(dot_product(qneg, half)), Epsilon_Value);
+
+    const quaternionF ends[] = { slerp(q0, q1, 0.0f), slerp(q0, q1, 1.0f) };
+    EXPECT_NEAR(q0.w_, ends[0].w_, Epsilon_Value);
+    EXPECT_NEAR(q1.z_, ends[1].z_, Epsilon_Value);
+}
@@ -0,0 +1,129 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/matrix4X4.h"
+#include "v8/math/scene_hierarchy.h"
+#include "v8/math/transform.h"
+#include "v8/math/vector3.h"
+#include "test_helpers.h"
+
+using v8::math::kInvalidNode;
+using v8::math::matrix_4X4F;
+using v8::math::scene_hierarchy;
+using v8::math::transformF;
+using v8::math::vector3F;
+using test_helpers::random_transform;
+
+namespace {
+
+//
+// World matrix computed by walking up to the root.
+matrix_4X4F
+reference_world(const scene_hierarchy& h, uint32_t node) {
+    matrix_4X4F world(h.local_transform(node).get_transform_matrix());
+    for (uint32_t p = h.parent(node); p != kInvalidNode; p = h.parent(p))
+        world = h.local_transform(p).get_transform_matrix() * world;
+    return world;
+}
+
+void
+expect_worlds_match(const scene_hierarchy& h) {
+    for (uint32_t i = 0; i < h.node_count(); ++i) {
+        const matrix_4X4F expected(reference_world(h, i));
+        for (int k = 0; k < 16; ++k) {
+            ASSERT_NEAR(expected.elements_[k], h.world_matrix(i).elements_[k], 
+                        1.0e-3f) << "node " << i;
+        }
+    }
+}
+
+size_t
+subtree_size(const scene_hierarchy& h, uint32_t node) {
+    size_t size = 1;
+    for (uint32_t c = h.first_child(node); c != kInvalidNode; c = h.next_sibling(c))
+        size += subtree_size(h, c);
+    return size;
+}
+
+} // anonymous namespace
+
+TEST(scene_hierarchy_tests, links) {
+    scene_hierarchy h;
+    const uint32_t root = h.add_node(kInvalidNode, transformF());
+    const uint32_t a = h.add_node(root, transformF(vector3F(1.0f, 0.0f, 0.0f)));
+    const uint32_t b = h.add_node(root, transformF(vector3F(0.0f, 2.0f, 0.0f)));
+    const uint32_t c = h.add_node(a, transformF(2.0f));
+
+    EXPECT_EQ(4u, h.node_count());
+    EXPECT_EQ(kInvalidNode, h.parent(root));
+    EXPECT_EQ(a, h.first_child(root));
+    EXPECT_EQ(b, h.next_sibling(a));
+    EXPECT_EQ(kInvalidNode, h.next_sibling(b));
+    EXPECT_EQ(c, h.first_child(a));
+    EXPECT_EQ(kInvalidNode, h.first_child(b));
+    EXPECT_TRUE(h.is_dirty(c));
+
+    h.update();
+    EXPECT_EQ(4u, h.last_update_count());
+    EXPECT_FALSE(h.is_dirty(c));
+    EXPECT_FLOAT_EQ(1.0f, h.world_matrix(c).a14_);
+    EXPECT_FLOAT_EQ(2.0f, h.world_matrix(c).a11_);
+    EXPECT_FLOAT_EQ(2.0f, h.world_matrix(b).a24_);
+
+    h.update();
+    EXPECT_EQ(0u, h.last_update_count());
+
+    h.set_local_transform(root, transformF(vector3F(0.0f, 0.0f, 5.0f)));
+    h.set_local_transform(c, transformF(3.0f));
+    h.update();
+    EXPECT_EQ(4u, h.last_update_count());
+    EXPECT_FLOAT_EQ(5.0f, h.world_matrix(c).a34_);
+    EXPECT_FLOAT_EQ(3.0f, h.world_matrix(c).a11_);
+}
+
+TEST(scene_hierarchy_tests, dirty_subtrees_match_reference) {
+    std::mt19937 gen(29);
+    scene_hierarchy hierarchy;
+    scene_hierarchy* h = &hierarchy;
+    const std::vector<uint32_t> parents(
+        test_helpers::random_forest(3000, 8, &gen));
+    h->reserve(parents.size());
+    for (size_t i = 0; i < parents.size(); ++i)
+        h->add_node(parents[i], random_transform(&gen));
+    h->update();
+    EXPECT_EQ(3000u, h->last_update_count());
+    expect_worlds_match(*h);
+
+    for (int round = 0; round < 5; ++round) {
+        //
+        // Change a few nodes, some of them nested in the others' subtrees.
+        std::vector<uint8_t> in_moved_subtree(h->node_count(), 0);
+        for (int i = 0; i < 20; ++i) {
+            const uint32_t node = static_cast<uint32_t>(gen() % h->node_count());
+            h->set_local_transform(node, random_transform(&gen));
+            in_moved_subtree[node] = 1;
+        }
+
+        size_t expected_count = 0;
+        for (uint32_t i = 0; i < h->node_count(); ++i) {
+            const uint32_t p = h->parent(i);
+            if (p != kInvalidNode && in_moved_subtree[p])
+                in_moved_subtree[i] = 1;
+            expected_count += in_moved_subtree[i];
+        }
+
+        h->update();
+        EXPECT_EQ(expected_count, h->last_update_count());
+        expect_worlds_match(*h);
+    }
+
+    const uint32_t node = 7;
+    h->set_local_transform(node, random_transform(&gen));
+    h->update();
+    EXPECT_EQ(subtree_size(*h, node), h->last_update_count());
+
+    h->update_all();
+    EXPECT_EQ(h->node_count(), h->last_update_count());
+    expect_worlds_match(*h);
+}
@@ -0,0 +1,169 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include "v8/math/camera.h"
+#include "v8/math/color.h"
+#include "v8/math/light.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/shadow_cascades.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector4.h"
+#include "test_helpers.h"
+
+using v8::math::camera;
+using v8::math::light;
+using v8::math::shadow_cascade;
+using v8::math::shadow_cascade_params;
+using v8::math::vector3F;
+using test_helpers::make_test_camera;
+
+namespace {
+
+const v8::math::color kWhite(1.0f, 1.0f, 1.0f, 1.0f);
+
+const light kSun(kWhite, kWhite, kWhite, 
+                 vector3F(0.3f, -1.0f, 0.4f).normalize());
+
+//
+// Center of the light space window, in texels.
+void
+window_center_in_texels(
+    const shadow_cascade& cascade, unsigned int map_size, float* x, float* y
+    )
+{
+    const float half_size = 1.0f / cascade.light_projection.a11_;
+    const float texel = 2.0f * half_size / static_cast<float>(map_size);
+    *x = -cascade.light_projection.a14_ * half_size / texel;
+    *y = -cascade.light_projection.a24_ * half_size / texel;
+}
+
+} // anonymous namespace
+
+TEST(shadow_cascades_tests, splits) {
+    const camera cam(make_test_camera(60.0f, 16.0f / 9.0f, 0.5f, 400.0f,
+                                      vector3F(0.0f, 10.0f, 0.0f),
+                                      vector3F(0.0f, 10.0f, 1.0f)));
+    shadow_cascade_params params;
+    params.cascade_count = 4;
+    shadow_cascade cascades[4];
+
+    params.split_lambda = 0.0f;
+    compute_shadow_cascades(cam, kSun, params, cascades);
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_NEAR(0.5f + 399.5f * i / 4.0f, cascades[i].split_near, 1.0e-3f);
+        EXPECT_NEAR(0.5f + 399.5f * (i + 1) / 4.0f, cascades[i].split_far, 1.0e-3f);
+    }
+
+    params.split_lambda = 1.0f;
+    compute_shadow_cascades(cam, kSun, params, cascades);
+    EXPECT_FLOAT_EQ(0.5f, cascades[0].split_near);
+    EXPECT_FLOAT_EQ(400.0f, cascades[3].split_far);
+    for (size_t i = 1; i < 4; ++i) {
+        EXPECT_NEAR(0.5f * std::pow(800.0f, i / 4.0f), cascades[i].split_near,
+                    1.0e-3f * cascades[i].split_near);
+        EXPECT_EQ(cascades[i - 1].split_far, cascades[i].split_near);
+    }
+}
+
+TEST(shadow_cascades_tests, orthographic_splits) {
+    //
+    // An orthographic camera may have its near plane at 0; the splits
+    // are uniform whatever split_lambda is.
+    camera cam;
+    cam.set_frustrum(0.0f, 100.0f, -10.0f, 10.0f, -20.0f, 20.0f, 
+                     camera::Projection_Orthographic);
+    cam.look_at(vector3F(0.0f, 10.0f, 0.0f), vector3F(0.0f, 1.0f, 0.0f),
+                vector3F(3.0f, 8.0f, 40.0f));
+    shadow_cascade_params params;
+    params.cascade_count = 4;
+    params.split_lambda = 0.75f;
+    shadow_cascade cascades[4];
+    compute_shadow_cascades(cam, kSun, params, cascades);
+
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_NEAR(25.0f * i, cascades[i].split_near, 1.0e-3f);
+        EXPECT_NEAR(25.0f * (i + 1), cascades[i].split_far, 1.0e-3f);
+
+        //
+        // Every slice has the same window, so the same bounding sphere.
+        EXPECT_NEAR(cascades[0].sphere_radius, cascades[i].sphere_radius, 
+                    1.0e-3f);
+        for (size_t j = 0; j < 8; ++j) {
+            EXPECT_LE(distance(cascades[i].corners[j], cascades[i].sphere_center),
+                      cascades[i].sphere_radius * 1.0001f);
+        }
+        for (size_t j = 0; j < 16; ++j)
+            EXPECT_TRUE(std::isfinite(
+                cascades[i].light_view_projection.elements_[j]));
+    }
+}
+
+TEST(shadow_cascades_tests, cascades_cover_slices) {
+    const camera cam(make_test_camera(60.0f, 16.0f / 9.0f, 0.5f, 400.0f,
+                                      vector3F(5.0f, 10.0f, -3.0f),
+                                      vector3F(40.0f, 0.0f, 60.0f)));
+    shadow_cascade_params params;
+    params.cascade_count = 3;
+    params.caster_depth_extension = 50.0f;
+    shadow_cascade cascades[3];
+    compute_shadow_cascades(cam, kSun, params, cascades);
+
+    for (size_t i = 0; i < params.cascade_count; ++i) {
+        const shadow_cascade& cascade = cascades[i];
+        for (size_t j = 0; j < 8; ++j) {
+            const vector3F& corner = cascade.corners[j];
+            EXPECT_LE(distance(corner, cascade.sphere_center),
+                      cascade.sphere_radius * 1.0001f);
+
+            //
+            // Every corner must land inside the light's clip volume.
+            v8::math::vector4F clip(corner.x_, corner.y_, corner.z_, 1.0f);
+            cascade.light_view_projection.transform_affine_point(&clip);
+            EXPECT_LE(std::fabs(clip.x_), 1.0f) << "cascade " << i;
+            EXPECT_LE(std::fabs(clip.y_), 1.0f) << "cascade " << i;
+            EXPECT_GE(clip.z_, 0.0f) << "cascade " << i;
+            EXPECT_LE(clip.z_, 1.0f) << "cascade " << i;
+        }
+
+        //
+        // The corners must agree with the camera's own frustum. The far
+        // plane extracted from P * V is off by about 0.01 at 400 units.
+        const v8::math::frustum f(cam.get_frustum());
+        for (size_t j = 0; j < 8; ++j)
+            EXPECT_NE(v8::math::cull_outside, 
+                      f.classify_sphere(cascade.corners[j], 0.05f));
+    }
+}
+
+TEST(shadow_cascades_tests, stable_under_camera_motion) {
+    shadow_cascade_params params;
+    params.cascade_count = 4;
+    params.shadow_map_size = 1024;
+
+    shadow_cascade before[4];
+    shadow_cascade after[4];
+    compute_shadow_cascades(
+        make_test_camera(60.0f, 16.0f / 9.0f, 0.5f, 400.0f,
+                         vector3F(0.0f, 10.0f, 0.0f), vector3F(0.0f, 10.0f, 1.0f)),
+        kSun, params, before);
+    compute_shadow_cascades(
+        make_test_camera(60.0f, 16.0f / 9.0f, 0.5f, 400.0f,
+                         vector3F(0.37f, 10.2f, 1.3f), vector3F(-20.0f, 3.0f, 8.0f)),
+        kSun, params, after);
+
+    for (size_t i = 0; i < params.cascade_count; ++i) {
+        //
+        // Same texel size, whatever the camera does.
+        EXPECT_FLOAT_EQ(before[i].sphere_radius, after[i].sphere_radius);
+        EXPECT_FLOAT_EQ(before[i].light_projection.a11_, 
+                        after[i].light_projection.a11_);
+        EXPECT_FLOAT_EQ(before[i].light_projection.a22_, 
+                        after[i].light_projection.a22_);
+
+        //
+        // The window only moves by whole texels.
+        float x, y;
+        window_center_in_texels(after[i], params.shadow_map_size, &x, &y);
+        EXPECT_NEAR(std::floor(x + 0.5f), x, 1.0e-2f);
+        EXPECT_NEAR(std::floor(y + 0.5f), y, 1.0e-2f);
+    }
+}
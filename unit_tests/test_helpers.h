@@ -0,0 +1,239 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/aabb.h"
+#include "v8/math/camera.h"
+#include "v8/math/color.h"
+#include "v8/math/light.h"
+#include "v8/math/matrix3X3.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/quaternion.h"
+#include "v8/math/scene_hierarchy.h"
+#include "v8/math/transform.h"
+#include "v8/math/vector3.h"
+
+/**
+ * \file    test_helpers.h
+ *
+ * \brief   Fixtures and comparisons shared by several unit test files.
+ */
+
+namespace test_helpers {
+
+/**
+ * \brief   Generates count vectors, with components in [-extent, extent].
+ */
+inline
+std::vector<v8::math::vector3F>
+random_vectors(
+    size_t count,
+    unsigned seed,
+    float extent = 10.0f
+    )
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(-extent, extent);
+    std::vector<v8::math::vector3F> v(count);
+    for (size_t i = 0; i < count; ++i)
+        v[i] = v8::math::vector3F(dist(gen), dist(gen), dist(gen));
+    return v;
+}
+
+/**
+ * \brief   Unit quaternion, made by normalizing four components drawn
+ *          from [-1, 1].
+ */
+inline
+v8::math::quaternionF
+random_rotation(
+    std::mt19937* gen
+    )
+{
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    v8::math::quaternionF q;
+    do {
+        q = v8::math::quaternionF(unit(*gen), unit(*gen), unit(*gen),
+                                  unit(*gen));
+    } while (q.magnitude() < 0.1f);
+    q.normalize();
+    return q;
+}
+
+inline
+std::vector<v8::math::quaternionF>
+random_rotations(
+    size_t count,
+    unsigned seed
+    )
+{
+    std::mt19937 gen(seed);
+    std::vector<v8::math::quaternionF> q(count);
+    for (size_t i = 0; i < count; ++i)
+        q[i] = random_rotation(&gen);
+    return q;
+}
+
+/**
+ * \brief   Camera with a symmetric perspective projection, placed at origin
+ *          and looking at target, with +y as the up vector.
+ */
+inline
+v8::math::camera
+make_test_camera(
+    float fov_y,
+    float aspect_ratio,
+    float near_plane,
+    float far_plane,
+    const v8::math::vector3F& origin,
+    const v8::math::vector3F& target
+    )
+{
+    v8::math::camera cam;
+    cam.set_symmetric_frustrum(fov_y, aspect_ratio, near_plane, far_plane);
+    cam.look_at(origin, v8::math::vector3F(0.0f, 1.0f, 0.0f), target);
+    return cam;
+}
+
+/**
+ * \brief   Generates count boxes, centered in [-50, 50]^3, with half
+ *          extents in [0, 10].
+ */
+inline
+std::vector<v8::math::aabbF>
+random_boxes(
+    size_t count,
+    unsigned seed
+    )
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> ext(0.0f, 10.0f);
+    std::vector<v8::math::aabbF> boxes;
+    for (size_t i = 0; i < count; ++i) {
+        const v8::math::vector3F c(pos(gen), pos(gen), pos(gen));
+        const v8::math::vector3F e(ext(gen), ext(gen), ext(gen));
+        boxes.push_back(v8::math::aabbF(c - e, c + e));
+    }
+    return boxes;
+}
+
+/**
+ * \brief   Generates count random point and spot lights, positioned in
+ *          [-extent, extent]^3. Every odd light is a spot light and one
+ *          spot light in five has a spot power of 0. When with_directional
+ *          is true, every 7th light is a directional light instead.
+ */
+inline
+std::vector<v8::math::light>
+make_lights(
+    size_t count,
+    unsigned seed,
+    float extent,
+    bool with_directional
+    )
+{
+    using v8::math::light;
+    using v8::math::vector3F;
+
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> pos(-extent, extent);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const v8::math::color c(1.0f, 1.0f, 1.0f, 1.0f);
+
+    std::vector<light> lights;
+    for (size_t i = 0; i < count; ++i) {
+        if (with_directional && i % 7 == 3) {
+            lights.push_back(light(c, c, c, vector3F(0.0f, -1.0f, 0.0f)));
+            continue;
+        }
+
+        const vector3F p(pos(gen), pos(gen), pos(gen));
+        const vector3F att(1.0f, 0.5f * unit(gen), 0.1f * unit(gen));
+        const float range = 0.5f + 24.5f * unit(gen);
+        if (i % 2) {
+            const vector3F dir(pos(gen), pos(gen), pos(gen));
+            const float power = (i % 5 == 1) ? 0.0f : 1.0f + 32.0f * unit(gen);
+            lights.push_back(light(c, c, c, p, dir, att, range, power,
+                                   0.2f + 1.2f * unit(gen)));
+        } else {
+            lights.push_back(light(c, c, c, p, att, range));
+        }
+    }
+    return lights;
+}
+
+/**
+ * \brief   Rotation made from three Euler angles, a translation in
+ *          [-10, 10]^3 and a uniform scale in [0.5, 1.5].
+ */
+inline
+v8::math::transformF
+random_transform(
+    std::mt19937* gen
+    )
+{
+    std::uniform_real_distribution<float> angle(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 1.5f);
+
+    v8::math::matrix_3X3F rotation;
+    rotation.make_euler_xyz(angle(*gen), angle(*gen), angle(*gen));
+    return v8::math::transformF(
+        rotation, true, v8::math::vector3F(pos(*gen), pos(*gen), pos(*gen)),
+        scale(*gen));
+}
+
+/**
+ * \brief   Parent of each node of a random forest, or kInvalidNode for a
+ *          root. The parent of node i is one of the window nodes before
+ *          it, so the trees get deep; about one node in ten is a root.
+ */
+inline
+std::vector<uint32_t>
+random_forest(
+    size_t count,
+    size_t window,
+    std::mt19937* gen
+    )
+{
+    std::vector<uint32_t> parents(count, v8::math::kInvalidNode);
+    for (size_t i = 1; i < count; ++i) {
+        if ((*gen)() % 10) {
+            const size_t w = i < window ? i : window;
+            parents[i] = static_cast<uint32_t>(i - 1 - (*gen)() % w);
+        }
+    }
+    return parents;
+}
+
+inline
+void
+expect_near(
+    const v8::math::vector3F& expected,
+    const v8::math::vector3F& actual,
+    float tolerance = 1.0e-4f
+    )
+{
+    EXPECT_NEAR(expected.x_, actual.x_, tolerance);
+    EXPECT_NEAR(expected.y_, actual.y_, tolerance);
+    EXPECT_NEAR(expected.z_, actual.z_, tolerance);
+}
+
+inline
+void
+expect_matrix_near(
+    const v8::math::matrix_4X4F& expected,
+    const v8::math::matrix_4X4F& actual,
+    float tolerance = 1.0e-4f
+    )
+{
+    for (size_t i = 0; i < 16; ++i)
+        EXPECT_NEAR(expected.elements_[i], actual.elements_[i], tolerance)
+            << "element " << i;
+}
+
+} // namespace test_helpers
@@ -0,0 +1,77 @@
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/base/parallel_for.h"
+#include "v8/base/thread_pool.h"
+
+using v8::base::parallel_region;
+using v8::base::thread_pool;
+
+TEST(thread_pool_tests, run_and_barrier) {
+    thread_pool pool(4);
+    ASSERT_EQ(4u, pool.thread_count());
+
+    for (int repeat = 0; repeat < 50; ++repeat) {
+        std::vector<unsigned int> phase1(4, 0);
+        std::vector<unsigned int> phase2(4, 0);
+        std::atomic<unsigned int> regions(0);
+
+        pool.run(0, [&](parallel_region& region) {
+            ASSERT_EQ(4u, region.thread_count());
+            ++regions;
+            phase1[region.thread_index()] = region.thread_index() + 1;
+            region.barrier();
+
+            //
+            // Every thread sees all the writes made before the barrier.
+            unsigned int sum = 0;
+            for (size_t i = 0; i < phase1.size(); ++i)
+                sum += phase1[i];
+            phase2[region.thread_index()] = sum;
+            region.barrier();
+        });
+
+        EXPECT_EQ(4u, regions.load());
+        for (size_t i = 0; i < phase2.size(); ++i)
+            EXPECT_EQ(10u, phase2[i]);
+    }
+
+    unsigned int threads = 0;
+    pool.run(2, [&](parallel_region& region) {
+        if (!region.thread_index())
+            threads = region.thread_count();
+    });
+    EXPECT_EQ(2u, threads);
+}
+
+TEST(thread_pool_tests, nested_jobs_run_inline) {
+    thread_pool pool(3);
+    std::atomic<unsigned int> inner_calls(0);
+
+    pool.run(0, [&](parallel_region&) {
+        pool.run(0, [&](parallel_region& inner) {
+            EXPECT_EQ(0u, inner.thread_index());
+            EXPECT_EQ(1u, inner.thread_count());
+            inner.barrier();
+            ++inner_calls;
+        });
+    });
+    EXPECT_EQ(3u, inner_calls.load());
+}
+
+TEST(thread_pool_tests, parallel_for_covers_range) {
+    const size_t kCount = 100003;
+    for (unsigned int threads = 1; threads <= 8; threads *= 2) {
+        std::vector<int> hits(kCount, 0);
+        v8::base::parallel_for(kCount, 64, threads,
+                               [&](size_t first, size_t last) {
+            EXPECT_EQ(0u, first % 64);
+            for (size_t i = first; i < last; ++i)
+                ++hits[i];
+        });
+
+        for (size_t i = 0; i < kCount; ++i)
+            ASSERT_EQ(1, hits[i]) << i;
+    }
+}
@@ -0,0 +1,112 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/matrix3X3.h"
+#include "v8/math/matrix4X4.h"
+#include "v8/math/quaternion.h"
+#include "v8/math/quaternion_soa.h"
+#include "v8/math/transform_palette.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+#include "test_helpers.h"
+
+using v8::math::matrix_3X3F;
+using v8::math::matrix_4X4F;
+using v8::math::quaternionF;
+using v8::math::vector3F;
+
+namespace {
+
+struct bone_pose {
+    bone_pose(size_t count, unsigned seed)
+        : rotations(test_helpers::random_rotations(count, seed)),
+          translations(test_helpers::random_vectors(count, seed + 1)),
+          scales(test_helpers::random_vectors(count, seed + 2, 1.0f))
+    {
+        for (size_t i = 0; i < count; ++i) {
+            //
+            // Not normalized on purpose, the palette functions must handle it.
+            rotations[i] *= 1.0f + 0.5f * static_cast<float>(i % 4);
+            scales[i] += vector3F(2.0f, 2.0f, 2.0f);
+        }
+    }
+
+    std::vector<quaternionF>    rotations;
+    std::vector<vector3F>       translations;
+    std::vector<vector3F>       scales;
+};
+
+//
+// Reference : T * R * S, built with extract_rotation_matrix().
+void
+expect_bone_matrix(
+    const quaternionF& q, const vector3F& t, const vector3F& s, 
+    const float* rows, size_t row_count
+    )
+{
+    matrix_3X3F r;
+    q.extract_rotation_matrix(&r);
+    const float scale[3] = { s.x_, s.y_, s.z_ };
+    const float translation[3] = { t.x_, t.y_, t.z_ };
+
+    for (size_t row = 0; row < 3; ++row) {
+        for (size_t col = 0; col < 3; ++col)
+            EXPECT_NEAR(r.elements_[row * 3 + col] * scale[col], 
+                        rows[row * 4 + col], 1.0e-5f);
+        EXPECT_FLOAT_EQ(translation[row], rows[row * 4 + 3]);
+    }
+
+    if (row_count == 4) {
+        EXPECT_EQ(0.0f, rows[12]);
+        EXPECT_EQ(0.0f, rows[13]);
+        EXPECT_EQ(0.0f, rows[14]);
+        EXPECT_EQ(1.0f, rows[15]);
+    }
+}
+
+} // anonymous namespace
+
+TEST(transform_palette_tests, aos) {
+    const size_t kBoneCount = 67;
+    const bone_pose pose(kBoneCount, 1);
+
+    std::vector<float> palette_3X4(kBoneCount * 12);
+    v8::math::make_transform_palette_3X4(
+        pose.rotations.data(), pose.translations.data(), pose.scales.data(),
+        kBoneCount, palette_3X4.data());
+
+    std::vector<matrix_4X4F> palette_4X4(kBoneCount);
+    v8::math::make_transform_palette_4X4(
+        pose.rotations.data(), pose.translations.data(), kBoneCount,
+        palette_4X4.data(), 0);
+
+    for (size_t i = 0; i < kBoneCount; ++i) {
+        expect_bone_matrix(pose.rotations[i], pose.translations[i], 
+                           pose.scales[i], &palette_3X4[i * 12], 3);
+        expect_bone_matrix(pose.rotations[i], pose.translations[i], 
+                           vector3F(1.0f, 1.0f, 1.0f), 
+                           palette_4X4[i].elements_, 4);
+    }
+}
+
+TEST(transform_palette_tests, soa) {
+    const size_t kBoneCount = 34;
+    const bone_pose pose(kBoneCount, 2);
+    const v8::math::quaternion_soaF rotations(pose.rotations.data(), kBoneCount);
+    const v8::math::vector3_soaF translations(pose.translations.data(), kBoneCount);
+    const v8::math::vector3_soaF scales(pose.scales.data(), kBoneCount);
+
+    std::vector<matrix_4X4F> palette_4X4(kBoneCount);
+    v8::math::make_transform_palette_4X4(
+        rotations, translations, &scales, palette_4X4.data());
+
+    std::vector<float> palette_3X4(kBoneCount * 12);
+    v8::math::make_transform_palette_3X4(
+        rotations, translations, palette_3X4.data());
+
+    for (size_t i = 0; i < kBoneCount; ++i) {
+        expect_bone_matrix(pose.rotations[i], pose.translations[i], 
+                           pose.scales[i], palette_4X4[i].elements_, 4);
+        expect_bone_matrix(pose.rotations[i], pose.translations[i], 
+                           vector3F(1.0f, 1.0f, 1.0f), &palette_3X4[i * 12], 3);
+    }
+}
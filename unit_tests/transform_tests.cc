@@ -1,6 +1,12 @@
+#include <random>
 #include <gtest/gtest.h>
 #include "v8/math/matrix4X4.h"
 #include "v8/math/transform.h"
+#include "test_helpers.h"
+
+using test_helpers::expect_matrix_near;
+using test_helpers::expect_near;
+using test_helpers::random_transform;
 
 TEST(transform_tests, default_constructor) {
     v8::math::transformF tfm;
@@ -93,4 +99,79 @@ TEST(transform_tests, invert) {
     EXPECT_TRUE(v8::math::operands_eq(0.5f, tr.get_scale_component()));
     EXPECT_EQ(rot.transpose(), tr.get_matrix_component());
     EXPECT_EQ(v8::math::vector3F(-5.0f, -5.0f, 5.0f), tr.get_translation_component());
-}
\ No newline at end of file
+}
+
+TEST(transform_tests, transform_point) {
+    std::mt19937 gen(3);
+    const v8::math::transformF tr(random_transform(&gen));
+    v8::math::vector3F expected(4.0f, 5.0f, -6.0f);
+    tr.get_transform_matrix().transform_affine_point(&expected);
+    const v8::math::vector3F pt(tr.transform_point(
+        v8::math::vector3F(4.0f, 5.0f, -6.0f)));
+    expect_near(expected, pt);
+
+    const v8::math::transformF identity;
+    EXPECT_EQ(v8::math::vector3F(4.0f, 5.0f, -6.0f), 
+              identity.transform_point(v8::math::vector3F(4.0f, 5.0f, -6.0f)));
+}
+
+TEST(transform_tests, compose) {
+    std::mt19937 gen(5);
+    const v8::math::transformF parent(random_transform(&gen));
+    const v8::math::transformF local(random_transform(&gen));
+    const v8::math::matrix_4X4F expected(
+        parent.get_transform_matrix() * local.get_transform_matrix());
+
+    //
+    // local * parent applies local first.
+    const v8::math::transformF world(local * parent);
+    expect_matrix_near(expected, world.get_transform_matrix());
+
+    v8::math::matrix_4X4F composed;
+    v8::math::compose_affine(parent.get_transform_matrix(), local, &composed);
+    expect_matrix_near(expected, composed);
+
+    v8::math::transformF worlds[3] = { local, v8::math::transformF(), local };
+    const v8::math::transformF parents[3] = { 
+        parent, parent, v8::math::transformF() 
+    };
+    v8::math::compose_transforms(parents, worlds, 3, worlds);
+    expect_matrix_near(expected, worlds[0].get_transform_matrix());
+    expect_matrix_near(parent.get_transform_matrix(), 
+                       worlds[1].get_transform_matrix());
+    expect_matrix_near(local.get_transform_matrix(),
+                       worlds[2].get_transform_matrix());
+
+    //
+    // Output written over the parents.
+    v8::math::transformF in_place[3] = {
+        parent, parent, v8::math::transformF()
+    };
+    const v8::math::transformF locals[3] = {
+        local, v8::math::transformF(), local
+    };
+    v8::math::compose_transforms(in_place, locals, 3, in_place);
+    expect_matrix_near(expected, in_place[0].get_transform_matrix());
+    expect_matrix_near(parent.get_transform_matrix(),
+                       in_place[1].get_transform_matrix());
+    expect_matrix_near(local.get_transform_matrix(),
+                       in_place[2].get_transform_matrix());
+}
+
+TEST(transform_tests, compose_non_rotation) {
+    v8::math::transformF shear(v8::math::matrix_3X3F(1.0f, 0.5f, 0.0f,
+                                                     0.0f, 1.0f, 0.0f,
+                                                     0.0f, 0.0f, 1.0f), 
+                               false);
+    std::mt19937 gen(7);
+    const v8::math::transformF rotation(random_transform(&gen));
+    const v8::math::transformF combined(shear * rotation);
+    EXPECT_FALSE(combined.is_rotation_or_reflection());
+
+    //
+    // Uses the general inverse, not the transpose.
+    v8::math::matrix_4X4F inv;
+    combined.compute_inverse(&inv);
+    expect_matrix_near(v8::math::matrix_4X4F::identity, 
+                       inv * combined.get_transform_matrix());
+}
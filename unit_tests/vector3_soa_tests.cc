@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+#include "test_helpers.h"
+
+using v8::math::vector3F;
+using v8::math::vector3_soaF;
+using test_helpers::expect_near;
+using test_helpers::random_vectors;
+
+namespace {
+
+const float kTolerance = 1.0e-5f;
+
+} // anonymous namespace
+
+TEST(vector3_soa_tests, storage) {
+    vector3_soaF stream(13);
+    EXPECT_EQ(13u, stream.size());
+    EXPECT_GE(stream.capacity(), 13u);
+    EXPECT_EQ(0u, stream.capacity() % vector3_soaF::kElementsPerBlock);
+
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(stream.x()) % vector3_soaF::kAlignment);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(stream.y()) % vector3_soaF::kAlignment);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(stream.z()) % vector3_soaF::kAlignment);
+
+    for (size_t i = 0; i < stream.size(); ++i)
+        EXPECT_TRUE(vector3F::zero == stream.get(i));
+
+    stream.set(5, vector3F(1.0f, 2.0f, 3.0f));
+    stream.resize(40);
+    EXPECT_TRUE(vector3F(1.0f, 2.0f, 3.0f) == stream.get(5));
+    EXPECT_TRUE(vector3F::zero == stream.get(39));
+
+    vector3_soaF copy(stream);
+    EXPECT_EQ(stream.size(), copy.size());
+    EXPECT_TRUE(vector3F(1.0f, 2.0f, 3.0f) == copy.get(5));
+}
+
+TEST(vector3_soa_tests, gather_scatter) {
+    const size_t kCount = 23;
+    const std::vector<vector3F> src(random_vectors(kCount, 1));
+
+    vector3_soaF stream(src.data(), kCount);
+    std::vector<vector3F> dst(kCount);
+    stream.copy_to(dst.data());
+
+    for (size_t i = 0; i < kCount; ++i) {
+        EXPECT_TRUE(src[i] == stream.get(i));
+        EXPECT_TRUE(src[i] == dst[i]);
+    }
+}
+
+TEST(vector3_soa_tests, arithmetic) {
+    const size_t kCount = 19;
+    const std::vector<vector3F> a(random_vectors(kCount, 2));
+    const std::vector<vector3F> b(random_vectors(kCount, 3));
+
+    vector3_soaF sa(a.data(), kCount);
+    const vector3_soaF sb(b.data(), kCount);
+
+    vector3_soaF sum(sa);
+    sum += sb;
+    vector3_soaF diff(sa);
+    diff -= sb;
+    vector3_soaF scaled(sa);
+    scaled *= 2.5f;
+    vector3_soaF lerped;
+    v8::math::lerp(sa, sb, 0.25f, &lerped);
+
+    for (size_t i = 0; i < kCount; ++i) {
+        expect_near(a[i] + b[i], sum.get(i), kTolerance);
+        expect_near(a[i] - b[i], diff.get(i), kTolerance);
+        expect_near(a[i] * 2.5f, scaled.get(i), kTolerance);
+        expect_near(a[i] + 0.25f * (b[i] - a[i]), lerped.get(i), kTolerance);
+    }
+}
+
+TEST(vector3_soa_tests, products_and_lengths) {
+    const size_t kCount = 17;
+    const std::vector<vector3F> a(random_vectors(kCount, 4));
+    const std::vector<vector3F> b(random_vectors(kCount, 5));
+
+    vector3_soaF sa(a.data(), kCount);
+    const vector3_soaF sb(b.data(), kCount);
+
+    std::vector<float> dots(kCount);
+    v8::math::dot_product(sa, sb, dots.data());
+    std::vector<float> lengths(kCount);
+    v8::math::magnitude(sa, lengths.data());
+    vector3_soaF crosses;
+    v8::math::cross_product(sa, sb, &crosses);
+
+    for (size_t i = 0; i < kCount; ++i) {
+        EXPECT_NEAR(v8::math::dot_product(a[i], b[i]), dots[i], 1.0e-4f);
+        EXPECT_NEAR(a[i].magnitude(), lengths[i], 1.0e-5f);
+        const vector3F expected(v8::math::cross_product(a[i], b[i]));
+        EXPECT_NEAR(expected.x_, crosses.get(i).x_, 1.0e-4f);
+        EXPECT_NEAR(expected.y_, crosses.get(i).y_, 1.0e-4f);
+        EXPECT_NEAR(expected.z_, crosses.get(i).z_, 1.0e-4f);
+    }
+
+    sa.normalize();
+    for (size_t i = 0; i < kCount; ++i) {
+        vector3F expected(a[i]);
+        expected.normalize();
+        expect_near(expected, sa.get(i), kTolerance);
+    }
+}
+
+TEST(vector3_soa_tests, min_max) {
+    for (size_t count = 1; count < 14; ++count) {
+        const std::vector<vector3F> src(random_vectors(count, 6));
+        const vector3_soaF stream(src.data(), count);
+
+        vector3F expected_min(src[0]);
+        vector3F expected_max(src[0]);
+        for (size_t i = 1; i < count; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                expected_min.elements_[j] = std::min(expected_min.elements_[j],
+                                                     src[i].elements_[j]);
+                expected_max.elements_[j] = std::max(expected_max.elements_[j],
+                                                     src[i].elements_[j]);
+            }
+        }
+
+        vector3F min_val;
+        vector3F max_val;
+        v8::math::min_max(stream, &min_val, &max_val);
+        EXPECT_TRUE(expected_min == min_val);
+        EXPECT_TRUE(expected_max == max_val);
+    }
+}
+
+TEST(vector3_soa_tests, normalize_precision) {
+    const size_t kCount = 31;
+    const std::vector<vector3F> src(random_vectors(kCount, 7));
+
+    vector3_soaF fast(src.data(), kCount);
+    vector3_soaF estimate(src.data(), kCount);
+    fast.normalize<v8::math::precision_fast>();
+    estimate.normalize<v8::math::precision_estimate>();
+
+    for (size_t i = 0; i < kCount; ++i) {
+        vector3F expected(src[i]);
+        expected.normalize();
+        expect_near(expected, fast.get(i), kTolerance);
+        EXPECT_NEAR(1.0f, estimate.get(i).magnitude(), 4.0e-4f);
+    }
+}
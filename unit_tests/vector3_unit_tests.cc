@@ -1,3 +1,4 @@
+#include <cmath>
 #include <gtest/gtest.h>
 #include "v8/math/vector3.h"
 
@@ -19,4 +20,37 @@ TEST(vector3_tests, spherical_coordinates_conversions) {
                 1.0e-3f);
     EXPECT_NEAR(33.6901f, v8::math::to_degrees(sph_coords.z_),
                 1.0e-3f);
-}
\ No newline at end of file
+}
+
+TEST(vector3_tests, normalize_precision) {
+    using namespace v8::math;
+
+    const float values[] = { 1.0e-6f, 0.01f, 0.5f, 1.0f, 2.0f, 3.0f, 1.0e4f, 3.7e8f };
+    float results[3][8];
+    inv_sqrt<precision_exact>(values, results[0], 8);
+    inv_sqrt<precision_fast>(values, results[1], 8);
+    inv_sqrt<precision_estimate>(values, results[2], 8);
+
+    for (size_t i = 0; i < 8; ++i) {
+        const float expected = 1.0f / std::sqrt(values[i]);
+        EXPECT_FLOAT_EQ(expected, inv_sqrt<precision_exact>(values[i]));
+        EXPECT_FLOAT_EQ(expected, results[0][i]);
+        EXPECT_NEAR(1.0f, inv_sqrt<precision_fast>(values[i]) / expected, 1.0e-6f);
+        EXPECT_NEAR(1.0f, results[1][i] / expected, 1.0e-6f);
+        EXPECT_NEAR(1.0f, inv_sqrt<precision_estimate>(values[i]) / expected, 4.0e-4f);
+        EXPECT_NEAR(1.0f, results[2][i] / expected, 4.0e-4f);
+    }
+
+    vector3F v0(3.0f, -4.0f, 12.0f);
+    vector3F v1(v0);
+    v0.normalize<precision_fast>();
+    v1.normalize<precision_estimate>();
+    EXPECT_NEAR(3.0f / 13.0f, v0.x_, 1.0e-6f);
+    EXPECT_NEAR(-4.0f / 13.0f, v0.y_, 1.0e-6f);
+    EXPECT_NEAR(12.0f / 13.0f, v0.z_, 1.0e-6f);
+    EXPECT_NEAR(1.0f, v1.magnitude(), 4.0e-4f);
+
+    vector3F zero(0.0f, 0.0f, 0.0f);
+    zero.normalize<precision_fast>();
+    EXPECT_TRUE(vector3F::zero == zero);
+}
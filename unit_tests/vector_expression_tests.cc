@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "v8/math/vector2.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector4.h"
+#include "v8/math/vector_expression.h"
+
+using v8::math::vector2F;
+using v8::math::vector3F;
+using v8::math::vector4F;
+using v8::math::expr::lazy;
+
+TEST(vector_expression_tests, vector3) {
+    const vector3F a(1.0f, 2.0f, 3.0f);
+    const vector3F b(-4.0f, 0.5f, 8.0f);
+    const vector3F c(0.25f, -1.0f, 2.0f);
+
+    const vector3F eager = a * 2.0f + b * 3.0f - c;
+    const vector3F fused = lazy(a) * 2.0f + lazy(b) * 3.0f - c;
+    EXPECT_TRUE(eager == fused);
+
+    const vector3F mixed = c - 0.5f * lazy(a) + b / 4.0f;
+    EXPECT_TRUE(c - a * 0.5f + b / 4.0f == mixed);
+
+    vector3F negated = -(lazy(a) + b);
+    EXPECT_TRUE(vector3F(3.0f, -2.5f, -11.0f) == negated);
+
+    //
+    // Assignment to one of the operands is fine, every component only
+    // depends on the same component of the operands.
+    vector3F accum(a);
+    accum = lazy(accum) * 2.0f - a;
+    EXPECT_TRUE(a == accum);
+
+    accum += lazy(b) - c;
+    EXPECT_TRUE(a + b - c == accum);
+
+    vector3F evaluated;
+    (lazy(a) + b).evaluate(&evaluated);
+    EXPECT_TRUE(a + b == evaluated);
+}
+
+TEST(vector_expression_tests, vector2_and_vector4) {
+    const vector2F a2(1.0f, 2.0f);
+    const vector2F b2(3.0f, -5.0f);
+    const vector2F r2 = lazy(a2) * 2.0f - b2;
+    EXPECT_TRUE(vector2F(-1.0f, 9.0f) == r2);
+
+    const vector4F a4(1.0f, 2.0f, 3.0f, 1.0f);
+    const vector4F b4(4.0f, 5.0f, 6.0f, 1.0f);
+    const vector4F r4 = lazy(b4) - a4 * 2.0f;
+    EXPECT_FLOAT_EQ(2.0f, r4.x_);
+    EXPECT_FLOAT_EQ(1.0f, r4.y_);
+    EXPECT_FLOAT_EQ(0.0f, r4.z_);
+    EXPECT_FLOAT_EQ(0.0f, r4.w_);
+}
+
+TEST(vector_expression_tests, division) {
+    typedef v8::math::vector2<int> vector2I;
+
+    const vector2I a(7, -9);
+    const vector2I b(3, 4);
+    const vector2I halved = (lazy(a) + b) / 2;
+    EXPECT_TRUE(vector2I(5, -2) == halved);
+    EXPECT_TRUE((a + b) / 2 == halved);
+
+    const vector3F x(1.0f, 2.0f, 3.0f);
+    const vector3F y(0.1f, -0.7f, 5.3f);
+    const vector3F divided = (lazy(x) - y) / 3.0f;
+    EXPECT_TRUE((x - y) / 3.0f == divided);
+}
@@ -0,0 +1,114 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "v8/math/camera.h"
+#include "v8/math/frustum.h"
+#include "v8/math/vector3.h"
+#include "v8/math/vector3_soa.h"
+#include "v8/math/visibility_culler.h"
+#include "test_helpers.h"
+
+using v8::math::camera;
+using v8::math::vector3F;
+using test_helpers::make_test_camera;
+
+namespace {
+
+struct instance_set {
+    instance_set() {}
+
+    instance_set(size_t count, unsigned seed)
+        : centers(test_helpers::random_vectors(count, seed, 200.0f).data(), 
+                  count)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> rad(0.0f, 5.0f);
+        radius.resize(count);
+        for (size_t i = 0; i < count; ++i)
+            radius[i] = rad(gen);
+    }
+
+    v8::math::vector3_soaF  centers;
+    std::vector<float>      radius;
+};
+
+const vector3F kViewTargets[] = {
+    vector3F(0.0f, 0.0f, 100.0f),
+    vector3F(100.0f, 0.0f, 0.0f),
+    vector3F(-50.0f, 20.0f, -80.0f),
+    vector3F(0.0f, -100.0f, 10.0f)
+};
+
+void
+expect_visible_lists(
+    const v8::math::visibility_culler& culler,
+    const std::vector<camera>& cameras,
+    const instance_set& instances
+    )
+{
+    ASSERT_EQ(cameras.size(), culler.view_count());
+    for (size_t view = 0; view < cameras.size(); ++view) {
+        const v8::math::frustum f = cameras[view].get_frustum();
+        std::vector<uint32_t> expected;
+        for (size_t i = 0; i < instances.centers.size(); ++i) {
+            if (f.classify_sphere(instances.centers.get(i), instances.radius[i])
+                != v8::math::cull_outside)
+                expected.push_back(static_cast<uint32_t>(i));
+        }
+
+        ASSERT_EQ(expected.size(), culler.visible_count(view)) << "view " << view;
+        for (size_t i = 0; i < expected.size(); ++i)
+            ASSERT_EQ(expected[i], culler.visible_indices(view)[i]) 
+                << "view " << view << ", element " << i;
+    }
+}
+
+} // anonymous namespace
+
+TEST(visibility_culler_tests, matches_single_sphere_tests) {
+    std::vector<camera> cameras;
+    for (size_t i = 0; i < _countof(kViewTargets); ++i) {
+        cameras.push_back(make_test_camera(60.0f + 10.0f * i, 1.5f, 1.0f, 150.0f,
+                                           vector3F::zero, kViewTargets[i]));
+    }
+
+    //
+    // Several chunks per view, the last one partially filled.
+    const instance_set instances(
+        3 * v8::math::kVisibilityCullChunkSize + 123, 17);
+
+    for (unsigned int threads = 1; threads <= 5; threads += 2) {
+        v8::math::visibility_culler culler(threads);
+        culler.cull(&cameras[0], cameras.size(), instances.centers, 
+                    &instances.radius[0]);
+        expect_visible_lists(culler, cameras, instances);
+    }
+}
+
+TEST(visibility_culler_tests, reuse) {
+    std::vector<camera> cameras;
+    for (size_t i = 0; i < _countof(kViewTargets); ++i) {
+        cameras.push_back(make_test_camera(60.0f + 10.0f * i, 1.5f, 1.0f, 150.0f,
+                                           vector3F::zero, kViewTargets[i]));
+    }
+    v8::math::visibility_culler culler(4);
+
+    const instance_set small(100, 19);
+    culler.cull(&cameras[0], cameras.size(), small.centers, &small.radius[0]);
+    expect_visible_lists(culler, cameras, small);
+
+    //
+    // More instances and fewer views than the previous call.
+    cameras.pop_back();
+    const instance_set large(
+        2 * v8::math::kVisibilityCullChunkSize + 1, 23);
+    culler.cull(&cameras[0], cameras.size(), large.centers, &large.radius[0]);
+    expect_visible_lists(culler, cameras, large);
+
+    const instance_set none;
+    culler.cull(&cameras[0], cameras.size(), none.centers, nullptr);
+    ASSERT_EQ(cameras.size(), culler.view_count());
+    for (size_t view = 0; view < cameras.size(); ++view)
+        EXPECT_EQ(0u, culler.visible_count(view));
+}